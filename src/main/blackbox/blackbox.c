@@ -51,6 +51,7 @@
 #include "fc/controlrate_profile.h"
 #include "fc/fc_core.h"
 #include "fc/rc_controls.h"
+#include "fc/rc_latency.h"
 #include "fc/rc_modes.h"
 #include "fc/runtime_config.h"
 #include "fc/settings.h"
@@ -306,6 +307,11 @@ static const blackboxDeltaFieldDefinition_t blackboxMainFields[] = {
     {"gyroPeakYaw",    1, UNSIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(UNSIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), FLIGHT_LOG_FIELD_CONDITION_GYRO_PEAKS_YAW},
     {"gyroPeakYaw",    2, UNSIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(UNSIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), FLIGHT_LOG_FIELD_CONDITION_GYRO_PEAKS_YAW},
 
+    /* RC latency per pipeline stage: frame->RX task, RX task->PID, PID->motor write [us] */
+    {"rcLatency",   0, UNSIGNED, .Ipredict = PREDICT(0),       .Iencode = ENCODING(UNSIGNED_VB), .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), FLIGHT_LOG_FIELD_CONDITION_RC_LATENCY},
+    {"rcLatency",   1, UNSIGNED, .Ipredict = PREDICT(0),       .Iencode = ENCODING(UNSIGNED_VB), .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), FLIGHT_LOG_FIELD_CONDITION_RC_LATENCY},
+    {"rcLatency",   2, UNSIGNED, .Ipredict = PREDICT(0),       .Iencode = ENCODING(UNSIGNED_VB), .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), FLIGHT_LOG_FIELD_CONDITION_RC_LATENCY},
+
 
     {"accSmooth",   0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), FLIGHT_LOG_FIELD_CONDITION_ACC},
     {"accSmooth",   1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), FLIGHT_LOG_FIELD_CONDITION_ACC},
@@ -488,6 +494,8 @@ typedef struct blackboxMainState_s {
     int16_t gyroPeaksPitch[DYN_NOTCH_PEAK_COUNT];
     int16_t gyroPeaksYaw[DYN_NOTCH_PEAK_COUNT];
 
+    uint16_t rcLatency[RC_LATENCY_STAGE_COUNT];
+
     int16_t accADC[XYZ_AXIS_COUNT];
     int16_t accVib;
     int16_t attitude[XYZ_AXIS_COUNT];
@@ -733,6 +741,9 @@ static bool testBlackboxConditionUncached(FlightLogFieldCondition condition)
     case FLIGHT_LOG_FIELD_CONDITION_GYRO_PEAKS_YAW:
         return blackboxIncludeFlag(BLACKBOX_FEATURE_GYRO_PEAKS_YAW);
 
+    case FLIGHT_LOG_FIELD_CONDITION_RC_LATENCY:
+        return blackboxIncludeFlag(BLACKBOX_FEATURE_RC_LATENCY);
+
     case FLIGHT_LOG_FIELD_CONDITION_NEVER:
         return false;
 
@@ -919,6 +930,12 @@ static void writeIntraframe(void)
         blackboxWriteUnsignedVB(blackboxCurrent->gyroPeaksYaw[2]);
     }
 
+    if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_RC_LATENCY)) {
+        for (int i = 0; i < RC_LATENCY_STAGE_COUNT; i++) {
+            blackboxWriteUnsignedVB(blackboxCurrent->rcLatency[i]);
+        }
+    }
+
     if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_ACC)) {
         blackboxWriteSigned16VBArray(blackboxCurrent->accADC, XYZ_AXIS_COUNT);
         blackboxWriteUnsignedVB(blackboxCurrent->accVib);
@@ -1185,6 +1202,12 @@ static void writeInterframe(void)
         blackboxWriteArrayUsingAveragePredictor16(offsetof(blackboxMainState_t, gyroPeaksYaw), DYN_NOTCH_PEAK_COUNT);
     }
 
+    if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_RC_LATENCY)) {
+        for (int i = 0; i < RC_LATENCY_STAGE_COUNT; i++) {
+            blackboxWriteSignedVB(blackboxCurrent->rcLatency[i] - blackboxLast->rcLatency[i]);
+        }
+    }
+
     if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_ACC)) {
         blackboxWriteArrayUsingAveragePredictor16(offsetof(blackboxMainState_t, accADC), XYZ_AXIS_COUNT);
         blackboxWriteSignedVB(blackboxCurrent->accVib - blackboxLast->accVib);
@@ -1617,6 +1640,10 @@ static void loadMainState(timeUs_t currentTimeUs)
     }
     blackboxCurrent->accVib = lrintf(accGetVibrationLevel() * acc.dev.acc_1G);
 
+    for (int i = 0; i < RC_LATENCY_STAGE_COUNT; i++) {
+        blackboxCurrent->rcLatency[i] = rcLatencyGetLastUs(i);
+    }
+
     if (STATE(FIXED_WING_LEGACY)) {
 
         // log requested pitch in decidegrees
@@ -66,6 +66,8 @@ typedef enum FlightLogFieldCondition {
     FLIGHT_LOG_FIELD_CONDITION_GYRO_PEAKS_PITCH,
     FLIGHT_LOG_FIELD_CONDITION_GYRO_PEAKS_YAW,
 
+    FLIGHT_LOG_FIELD_CONDITION_RC_LATENCY,
+
     FLIGHT_LOG_FIELD_CONDITION_NEVER,
 
     FLIGHT_LOG_FIELD_CONDITION_FIRST = FLIGHT_LOG_FIELD_CONDITION_ALWAYS,
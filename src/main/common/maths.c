@@ -516,6 +516,233 @@ bool sensorCalibrationSolveForScale(sensorCalibrationState_t * state, float resu
     return sensorCalibrationValidateResult(result);
 }
 
+/**
+ * Streaming ellipsoid fit for hard and soft iron calibration.
+ * Recursive least squares on A*x^2 + B*y^2 + C*z^2 + 2D*xy + 2E*xz + 2F*yz + 2G*x + 2H*y + 2I*z = 1,
+ * one O(n^2) update per sample instead of accumulating and solving the normal equations.
+ */
+#define SENSOR_ELLIPSOID_INITIAL_COVARIANCE     1.0e4f
+#define SENSOR_ELLIPSOID_MAX_COVARIANCE         1.0e6f  // Stop forgetting when not excited to prevent covariance windup
+#define SENSOR_ELLIPSOID_SQRT_ITERATIONS        12
+
+void sensorEllipsoidCalibrationReset(sensorEllipsoidCalibrationState_t * state, float forgetFactor)
+{
+    memset(state, 0, sizeof(*state));
+
+    for (int i = 0; i < SENSOR_ELLIPSOID_PARAM_COUNT; i++) {
+        state->P[i][i] = SENSOR_ELLIPSOID_INITIAL_COVARIANCE;
+    }
+
+    state->forgetFactor = forgetFactor;
+}
+
+static int sensorEllipsoidCalibrationBin(const sensorEllipsoidCalibrationState_t * state, const float sample[3])
+{
+    float d[3];
+    int major = 0;
+
+    for (int i = 0; i < 3; i++) {
+        d[i] = sample[i] - (state->axisMin[i] + state->axisMax[i]) / 2;
+        if (fabsf(d[i]) > fabsf(d[major])) {
+            major = i;
+        }
+    }
+
+    // Face by major axis and sign, quadrant by the signs of the two remaining axes
+    const int minor1 = (major + 1) % 3;
+    const int minor2 = (major + 2) % 3;
+    return major * 8 + (d[major] < 0 ? 4 : 0) + (d[minor1] < 0 ? 2 : 0) + (d[minor2] < 0 ? 1 : 0);
+}
+
+void sensorEllipsoidCalibrationPushSample(sensorEllipsoidCalibrationState_t * state, const float sample[3])
+{
+    if (state->sampleCount == 0) {
+        state->scale = MAX(1.0f, calc_length_pythagorean_3D(sample[0], sample[1], sample[2]));
+        for (int i = 0; i < 3; i++) {
+            state->axisMin[i] = state->axisMax[i] = sample[i];
+        }
+    }
+
+    for (int i = 0; i < 3; i++) {
+        state->axisMin[i] = MIN(state->axisMin[i], sample[i]);
+        state->axisMax[i] = MAX(state->axisMax[i], sample[i]);
+    }
+
+    const int bin = sensorEllipsoidCalibrationBin(state, sample);
+    if (state->binSamples[bin] < UINT8_MAX) {
+        state->binSamples[bin]++;
+    }
+    state->sampleCount++;
+
+    const float x = sample[0] / state->scale;
+    const float y = sample[1] / state->scale;
+    const float z = sample[2] / state->scale;
+    const float h[SENSOR_ELLIPSOID_PARAM_COUNT] = { x * x, y * y, z * z, 2 * x * y, 2 * x * z, 2 * y * z, 2 * x, 2 * y, 2 * z };
+
+    float Ph[SENSOR_ELLIPSOID_PARAM_COUNT];
+    float hPh = 0;
+    float hTheta = 0;
+    bool windup = false;
+
+    for (int i = 0; i < SENSOR_ELLIPSOID_PARAM_COUNT; i++) {
+        Ph[i] = 0;
+        for (int j = 0; j < SENSOR_ELLIPSOID_PARAM_COUNT; j++) {
+            Ph[i] += state->P[i][j] * h[j];
+        }
+        hPh += h[i] * Ph[i];
+        hTheta += h[i] * state->theta[i];
+        windup |= state->P[i][i] > SENSOR_ELLIPSOID_MAX_COVARIANCE;
+    }
+
+    const float lambda = windup ? 1.0f : state->forgetFactor;
+    const float gain = 1.0f / (lambda + hPh);
+    const float error = 1.0f - hTheta;
+
+    for (int i = 0; i < SENSOR_ELLIPSOID_PARAM_COUNT; i++) {
+        state->theta[i] += Ph[i] * gain * error;
+
+        // P is symmetric, update one triangle and mirror it to keep it that way
+        for (int j = i; j < SENSOR_ELLIPSOID_PARAM_COUNT; j++) {
+            state->P[i][j] = (state->P[i][j] - Ph[i] * Ph[j] * gain) / lambda;
+            state->P[j][i] = state->P[i][j];
+        }
+    }
+}
+
+int sensorEllipsoidCalibrationCoverage(const sensorEllipsoidCalibrationState_t * state, uint8_t minSamplesPerBin)
+{
+    int coveredBins = 0;
+
+    for (int i = 0; i < SENSOR_ELLIPSOID_COVERAGE_BINS; i++) {
+        if (state->binSamples[i] >= minSamplesPerBin) {
+            coveredBins++;
+        }
+    }
+
+    return coveredBins;
+}
+
+static float matrix3Determinant(const float m[3][3])
+{
+    return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+           m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+           m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+}
+
+static bool matrix3Inverse(const float m[3][3], float result[3][3])
+{
+    const float det = matrix3Determinant(m);
+    if (fabsf(det) < 1e-12f) {
+        return false;
+    }
+
+    result[0][0] = (m[1][1] * m[2][2] - m[1][2] * m[2][1]) / det;
+    result[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) / det;
+    result[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) / det;
+    result[1][0] = (m[1][2] * m[2][0] - m[1][0] * m[2][2]) / det;
+    result[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) / det;
+    result[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) / det;
+    result[2][0] = (m[1][0] * m[2][1] - m[1][1] * m[2][0]) / det;
+    result[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) / det;
+    result[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) / det;
+
+    return true;
+}
+
+// Square root of a symmetric positive definite matrix, Denman-Beavers iteration
+static bool matrix3SquareRoot(const float m[3][3], float result[3][3])
+{
+    float Y[3][3];
+    float Z[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+
+    memcpy(Y, m, sizeof(Y));
+
+    for (int iteration = 0; iteration < SENSOR_ELLIPSOID_SQRT_ITERATIONS; iteration++) {
+        float Yinv[3][3];
+        float Zinv[3][3];
+
+        if (!matrix3Inverse(Y, Yinv) || !matrix3Inverse(Z, Zinv)) {
+            return false;
+        }
+
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                Y[i][j] = (Y[i][j] + Zinv[i][j]) / 2;
+                Z[i][j] = (Z[i][j] + Yinv[i][j]) / 2;
+            }
+        }
+    }
+
+    memcpy(result, Y, sizeof(Y));
+    return true;
+}
+
+bool sensorEllipsoidCalibrationSolve(const sensorEllipsoidCalibrationState_t * state, sensorEllipsoidCalibration_t * result)
+{
+    const float * t = state->theta;
+    const float M[3][3] = {
+        { t[0], t[3], t[4] },
+        { t[3], t[1], t[5] },
+        { t[4], t[5], t[2] },
+    };
+
+    if (state->sampleCount < SENSOR_ELLIPSOID_PARAM_COUNT) {
+        return false;
+    }
+
+    // Centre: M * c = -b
+    float Minv[3][3];
+    if (!matrix3Inverse(M, Minv)) {
+        return false;
+    }
+
+    float c[3];
+    for (int i = 0; i < 3; i++) {
+        c[i] = -(Minv[i][0] * t[6] + Minv[i][1] * t[7] + Minv[i][2] * t[8]);
+    }
+
+    // (v - c)' * M * (v - c) = 1 + c' * M * c, normalise to a unit ellipsoid
+    float radiusSq = 1.0f;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            radiusSq += c[i] * M[i][j] * c[j];
+        }
+    }
+
+    float Mn[3][3];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            Mn[i][j] = M[i][j] / radiusSq;
+        }
+    }
+
+    // Must be an ellipsoid: positive definite by leading principal minors
+    if (!(radiusSq > 0 && Mn[0][0] > 0 && (Mn[0][0] * Mn[1][1] - Mn[0][1] * Mn[1][0]) > 0 && matrix3Determinant(Mn) > 0)) {
+        return false;
+    }
+
+    float W[3][3];
+    if (!matrix3SquareRoot(Mn, W)) {
+        return false;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        result->offset[i] = c[i] * state->scale;
+        if (!isfinite(result->offset[i])) {
+            return false;
+        }
+
+        for (int j = 0; j < 3; j++) {
+            result->softIron[i][j] = W[i][j] / state->scale;
+            if (!isfinite(result->softIron[i][j])) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 float gaussian(const float x, const float mu, const float sigma) {
     return exp(-pow((double)(x - mu), 2) / (2 * pow((double)sigma, 2)));
 }
@@ -149,6 +149,30 @@ void sensorCalibrationPushSampleForScaleCalculation(sensorCalibrationState_t * s
 bool sensorCalibrationSolveForOffset(sensorCalibrationState_t * state, float result[3]);
 bool sensorCalibrationSolveForScale(sensorCalibrationState_t * state, float result[3]);
 
+#define SENSOR_ELLIPSOID_PARAM_COUNT        9
+#define SENSOR_ELLIPSOID_COVERAGE_BINS      24      // Cube faces split into quadrants
+
+typedef struct {
+    float P[SENSOR_ELLIPSOID_PARAM_COUNT][SENSOR_ELLIPSOID_PARAM_COUNT];
+    float theta[SENSOR_ELLIPSOID_PARAM_COUNT];
+    float forgetFactor;
+    float scale;                // Samples are normalised to keep the regression well conditioned
+    float axisMin[3];
+    float axisMax[3];
+    uint32_t sampleCount;
+    uint8_t binSamples[SENSOR_ELLIPSOID_COVERAGE_BINS];
+} sensorEllipsoidCalibrationState_t;
+
+typedef struct {
+    float offset[3];
+    float softIron[3][3];       // Symmetric, maps (sample - offset) onto the unit sphere
+} sensorEllipsoidCalibration_t;
+
+void sensorEllipsoidCalibrationReset(sensorEllipsoidCalibrationState_t * state, float forgetFactor);
+void sensorEllipsoidCalibrationPushSample(sensorEllipsoidCalibrationState_t * state, const float sample[3]);
+int sensorEllipsoidCalibrationCoverage(const sensorEllipsoidCalibrationState_t * state, uint8_t minSamplesPerBin);
+bool sensorEllipsoidCalibrationSolve(const sensorEllipsoidCalibrationState_t * state, sensorEllipsoidCalibration_t * result);
+
 int gcd(int num, int denom);
 int32_t applyDeadband(int32_t value, int32_t deadband);
 int32_t applyDeadbandRescaled(int32_t value, int32_t deadband, int32_t min, int32_t max);
@@ -0,0 +1,106 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/number_format.h"
+
+// Enough for UINT32_MAX
+#define NUMBER_FORMAT_MAX_DIGITS    10
+
+static const uint32_t powersOf10[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+};
+
+// Writes the digits of value least significant first, returns how many were written
+static uint8_t formatReversedDigits(char *digits, uint32_t value)
+{
+    uint8_t count = 0;
+    do {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+    return count;
+}
+
+static char *formatInteger(char *buf, uint32_t magnitude, bool negative, uint8_t width, bool zeroPad)
+{
+    char digits[NUMBER_FORMAT_MAX_DIGITS];
+    uint8_t count = formatReversedDigits(digits, magnitude);
+    int padding = width - count - (negative ? 1 : 0);
+
+    if (!zeroPad) {
+        for (; padding > 0; padding--) {
+            *buf++ = ' ';
+        }
+    }
+
+    if (negative) {
+        *buf++ = '-';
+    }
+
+    for (; padding > 0; padding--) {
+        *buf++ = '0';
+    }
+
+    while (count) {
+        *buf++ = digits[--count];
+    }
+
+    *buf = '\0';
+    return buf;
+}
+
+char *formatUnsigned(char *buf, uint32_t value, uint8_t width, bool zeroPad)
+{
+    return formatInteger(buf, value, false, width, zeroPad);
+}
+
+char *formatSigned(char *buf, int32_t value, uint8_t width, bool zeroPad)
+{
+    // Negate as unsigned, INT32_MIN has no positive counterpart
+    return formatInteger(buf, value < 0 ? -(uint32_t)value : (uint32_t)value, value < 0, width, zeroPad);
+}
+
+char *formatFixedPoint(char *buf, int32_t value, uint8_t decimals, uint8_t width)
+{
+    if (decimals == 0) {
+        return formatSigned(buf, value, width, false);
+    }
+
+    if (decimals >= NUMBER_FORMAT_MAX_DIGITS) {
+        decimals = NUMBER_FORMAT_MAX_DIGITS - 1;
+    }
+
+    const bool negative = value < 0;
+    const uint32_t magnitude = negative ? -(uint32_t)value : (uint32_t)value;
+    const uint32_t divisor = powersOf10[decimals];
+    const uint32_t integerPart = magnitude / divisor;
+
+    // Integer part including sign, then the point and the fractional digits
+    buf = formatInteger(buf, integerPart, negative, width > decimals + 1 ? width - decimals - 1 : 0, false);
+    *buf++ = '.';
+    return formatUnsigned(buf, magnitude - integerPart * divisor, decimals, true);
+}
+
+char *formatChar(char *buf, char c)
+{
+    *buf++ = c;
+    *buf = '\0';
+    return buf;
+}
@@ -0,0 +1,37 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Formatters for the numeric layouts the OSD and CLI produce all the time. Unlike tfp_sprintf()
+ * they don't parse a format string nor go through a putc callback per character. All of them
+ * write a NUL terminated string and return a pointer to the terminator, so calls can be chained.
+ * Width is a minimum like in printf, numbers that don't fit are never truncated.
+ */
+
+// Same as "%*u", or "%0*u" if zeroPad is set
+char *formatUnsigned(char *buf, uint32_t value, uint8_t width, bool zeroPad);
+// Same as "%*d", or "%0*d" if zeroPad is set
+char *formatSigned(char *buf, int32_t value, uint8_t width, bool zeroPad);
+// value / 10^decimals, space padded to width, e.g. -1234 with 2 decimals gives "-12.34" and -5 gives "-0.05"
+char *formatFixedPoint(char *buf, int32_t value, uint8_t decimals, uint8_t width);
+// Appends a single character, mostly for unit symbols
+char *formatChar(char *buf, char c);
@@ -30,6 +30,7 @@
 #include "config/config_eeprom.h"
 #include "config/config_streamer.h"
 #include "config/parameter_group.h"
+#include "config/parameter_group_ids.h"
 
 #include "drivers/system.h"
 #include "drivers/flash.h"
@@ -40,7 +41,12 @@
     void config_streamer_impl_unlock(void);
 #endif
 
-static uint16_t eepromConfigSize;
+// End of the last committed record, NULL when the config is not valid
+static const uint8_t *configLogEnd;
+// The config was saved in the format used before the log
+static bool configIsLegacy;
+// Sequence number of the last commit
+static uint16_t configLogSequence;
 
 typedef enum {
     CR_CLASSICATION_SYSTEM   = 0,
@@ -52,12 +58,24 @@ typedef enum {
 
 #define CR_CLASSIFICATION_MASK (0x3)
 
+// pgn of the record closing each save. Its data is a sequence number,
+// incremented on each save, followed by padding.
+#define CONFIG_RECORD_COMMIT PG_ID_INVALID
+
 // Header for the saved copy.
 typedef struct {
     uint8_t format;
 } PG_PACKED configHeader_t;
 
 // Header for each stored PG.
+//
+// The saved copy is a log of records. A save appends a record for each
+// PG instance that changed since the previous one, followed by a commit
+// record. Later records replace earlier ones for the same PG instance and
+// records without a commit after them (an interrupted save) are ignored.
+// When the log is full it's compacted, rewriting every PG from the start.
+// Data left after the end of a compacted log is told apart by the commit
+// sequence numbers, which must increase by one.
 typedef struct {
     // split up.
     uint16_t size;
@@ -67,14 +85,28 @@ typedef struct {
     // lower 2 bits used to indicate system or profile number, see CR_CLASSIFICATION_MASK
     uint8_t flags;
 
+    // covers the fields above and the PG data
+    uint16_t crc;
+
     uint8_t pg[];
 } PG_PACKED configRecord_t;
 
-// Footer for the saved copy.
+// Format saved before the log: a single copy of every PG, followed by a
+// footer and a checksum. It's still loaded so settings survive the
+// upgrade, the next save compacts it into a log.
+#define EEPROM_CONF_VERSION_LEGACY 126
+
+typedef struct {
+    uint16_t size;
+    pgn_t pgn;
+    uint8_t version;
+    uint8_t flags;
+    uint8_t pg[];
+} PG_PACKED configLegacyRecord_t;
+
 typedef struct {
     uint16_t terminator;
-} PG_PACKED configFooter_t;
-// checksum is appended just after footer. It is not included in footer to make checksum calculation consistent
+} PG_PACKED configLegacyFooter_t;
 
 // Used to check the compiler packing at build time.
 typedef struct {
@@ -115,8 +147,9 @@ void initEEPROM(void)
     BUILD_BUG_ON(sizeof(packingTest_t) != 5);
 
     BUILD_BUG_ON(sizeof(configHeader_t) != 1);
-    BUILD_BUG_ON(sizeof(configFooter_t) != 2);
-    BUILD_BUG_ON(sizeof(configRecord_t) != 6);
+    BUILD_BUG_ON(sizeof(configRecord_t) != 8);
+    // Both formats share the fields before the CRC
+    BUILD_BUG_ON(offsetof(configRecord_t, crc) != sizeof(configLegacyRecord_t));
 
 #if defined(CONFIG_IN_EXTERNAL_FLASH)
     bool eepromLoaded = loadEEPROMFromExternalFlash();
@@ -129,31 +162,33 @@ void initEEPROM(void)
 #endif
 }
 
-// Scan the EEPROM config. Returns true if the config is valid.
-bool isEEPROMContentValid(void)
+static uint16_t configRecordCrc(const configRecord_t *record, const void *data, size_t size)
+{
+    const uint16_t crc = crc16_ccitt_update(0, record, offsetof(configRecord_t, crc));
+    return crc16_ccitt_update(crc, data, size);
+}
+
+static bool isLegacyContentValid(void)
 {
     const uint8_t *p = &__config_start;
     const configHeader_t *header = (const configHeader_t *)p;
 
-    if (header->format != EEPROM_CONF_VERSION) {
-        return false;
-    }
     uint16_t crc = crc16_ccitt_update(0, header, sizeof(*header));
     p += sizeof(*header);
 
     for (;;) {
-        const configRecord_t *record = (const configRecord_t *)p;
-
-        if (record->size == 0) {
-            // Found the end.  Stop scanning.
-            break;
-        }
+        const configLegacyRecord_t *record = (const configLegacyRecord_t *)p;
 
         if (p + sizeof(*record) >= &__config_end) {
             // Too big. Further checking for size doesn't make sense
             return false;
         }
 
+        if (record->size == 0) {
+            // Found the end.  Stop scanning.
+            break;
+        }
+
         if (p + record->size >= &__config_end || record->size < sizeof(*record)) {
             // Too big or too small.
             return false;
@@ -164,48 +199,131 @@ bool isEEPROMContentValid(void)
         p += record->size;
     }
 
-    const configFooter_t *footer = (const configFooter_t *)p;
+    const uint8_t *recordsEnd = p;
+    const configLegacyFooter_t *footer = (const configLegacyFooter_t *)p;
     crc = crc16_ccitt_update(crc, footer, sizeof(*footer));
     p += sizeof(*footer);
-    const uint16_t checkSum = *(uint16_t *)p;
-    p += sizeof(checkSum);
-    eepromConfigSize = p - &__config_start;
-    return crc == checkSum;
-}
 
-uint16_t getEEPROMConfigSize(void)
-{
-    return eepromConfigSize;
+    uint16_t checkSum;
+    if (p + sizeof(checkSum) > &__config_end) {
+        return false;
+    }
+    memcpy(&checkSum, p, sizeof(checkSum));
+    if (crc != checkSum) {
+        return false;
+    }
+
+    configLogEnd = recordsEnd;
+    configIsLegacy = true;
+    return true;
 }
 
-// find config record for reg + classification (profile info) in EEPROM
-// return NULL when record is not found
-// this function assumes that EEPROM content is valid
-static const configRecord_t *findEEPROM(const pgRegistry_t *reg, configRecordFlags_e classification)
+// Scan the EEPROM config. Returns true if the config is valid.
+bool isEEPROMContentValid(void)
 {
     const uint8_t *p = &__config_start;
-    p += sizeof(configHeader_t);             // skip header
-    while (true) {
+    const configHeader_t *header = (const configHeader_t *)p;
+
+    configLogEnd = NULL;
+    configIsLegacy = false;
+
+    if (header->format == EEPROM_CONF_VERSION_LEGACY) {
+        return isLegacyContentValid();
+    }
+
+    if (header->format != EEPROM_CONF_VERSION) {
+        return false;
+    }
+    p += sizeof(*header);
+
+    // The log ends at the first record that doesn't make sense, which
+    // is usually erased memory
+    for (;;) {
         const configRecord_t *record = (const configRecord_t *)p;
-        // Ensure that the record header fits into config memory, otherwise accessing size and flags may cause a hardfault.
-        if (p + sizeof(*record) >= &__config_end) {
+
+        if (p + sizeof(*record) > &__config_end) {
             break;
         }
 
-        // Check that record header makes sense
-        if (record->size == 0 || p + record->size >= &__config_end || record->size < sizeof(*record)) {
+        if (record->size < sizeof(*record) || p + record->size > &__config_end) {
             break;
         }
 
-        // Check if this is the record we're looking for (check for size)
+        if (record->crc != configRecordCrc(record, record->pg, record->size - sizeof(*record))) {
+            break;
+        }
+
+        if (record->pgn == CONFIG_RECORD_COMMIT) {
+            uint16_t sequence;
+            if (record->size < sizeof(*record) + sizeof(sequence)) {
+                break;
+            }
+            memcpy(&sequence, record->pg, sizeof(sequence));
+            if (configLogEnd && sequence != (uint16_t)(configLogSequence + 1)) {
+                // Left over from before the last compaction
+                break;
+            }
+            configLogEnd = p + record->size;
+            configLogSequence = sequence;
+        }
+
+        p += record->size;
+    }
+
+    return configLogEnd != NULL;
+}
+
+// Offset of the PG data in a record. Legacy records have no CRC.
+static size_t configRecordDataOffset(void)
+{
+    return configIsLegacy ? sizeof(configLegacyRecord_t) : sizeof(configRecord_t);
+}
+
+// find the latest config record for reg + classification (profile info) in EEPROM
+// return NULL when record is not found
+// this function assumes that EEPROM content is valid. Only the fields
+// before the CRC may be used, the PG data starts at configRecordDataOffset().
+static const configRecord_t *findEEPROM(const pgRegistry_t *reg, configRecordFlags_e classification)
+{
+    const configRecord_t *found = NULL;
+    const uint8_t *p = &__config_start;
+    p += sizeof(configHeader_t);             // skip header
+    while (p < configLogEnd) {
+        const configRecord_t *record = (const configRecord_t *)p;
+
+        // Keep looking, later records replace earlier ones
         if (pgN(reg) == record->pgn && (record->flags & CR_CLASSIFICATION_MASK) == classification) {
-            return record;
+            found = record;
         }
 
         p += record->size;
     }
-    // record not found
-    return NULL;
+    return found;
+}
+
+// Size of the records the config is loaded from. Replaced records and
+// ones from interrupted saves are not counted.
+uint16_t getEEPROMConfigSize(void)
+{
+    if (!configLogEnd) {
+        return 0;
+    }
+
+    uint16_t size = sizeof(configHeader_t);
+
+    PG_FOREACH(reg) {
+        const uint8_t profileCount = pgIsSystem(reg) ? 1 : MAX_PROFILE_COUNT;
+
+        for (uint8_t profileIndex = 0; profileIndex < profileCount; profileIndex++) {
+            const configRecordFlags_e classification = pgIsSystem(reg) ? CR_CLASSICATION_SYSTEM : ((profileIndex + 1) & CR_CLASSIFICATION_MASK);
+            const configRecord_t *record = findEEPROM(reg, classification);
+            if (record) {
+                size += record->size;
+            }
+        }
+    }
+
+    return size;
 }
 
 // Initialize all PG records from EEPROM.
@@ -227,7 +345,7 @@ bool loadEEPROM(void)
             const configRecord_t *rec = findEEPROM(reg, cls);
             if (rec) {
                 // config from EEPROM is available, use it to initialize PG. pgLoad will handle version mismatch
-                pgLoad(reg, profileIndex, rec->pg, rec->size - offsetof(configRecord_t, pg), rec->version);
+                pgLoad(reg, profileIndex, (const uint8_t *)rec + configRecordDataOffset(), rec->size - configRecordDataOffset(), rec->version);
             } else {
                 pgReset(reg, profileIndex);
             }
@@ -236,81 +354,156 @@ bool loadEEPROM(void)
     return true;
 }
 
-static bool writeSettingsToEEPROM(void)
+static bool writeRecord(config_streamer_t *streamer, configRecord_t *record, const void *data, size_t size)
 {
-    config_streamer_t streamer;
-    config_streamer_init(&streamer);
+    record->size = sizeof(*record) + size;
+    record->crc = configRecordCrc(record, data, size);
 
-    config_streamer_start(&streamer, (uintptr_t)&__config_start, &__config_end - &__config_start);
+    if (config_streamer_write(streamer, (uint8_t *)record, sizeof(*record)) < 0) {
+        return false;
+    }
+    return config_streamer_write(streamer, data, size) >= 0;
+}
 
-    configHeader_t header = {
-        .format = EEPROM_CONF_VERSION,
+// Closes a save. It's padded so the next save starts at a streamer
+// buffer boundary.
+static bool writeCommitRecord(config_streamer_t *streamer)
+{
+    uint8_t data[sizeof(uint16_t) + CONFIG_STREAMER_BUFFER_SIZE] = { 0 };
+    const uint16_t sequence = configLogSequence + 1;
+    memcpy(data, &sequence, sizeof(sequence));
+
+    const uintptr_t end = streamer->address + streamer->at + sizeof(configRecord_t) + sizeof(sequence) - (uintptr_t)&__config_start;
+    configRecord_t record = {
+        .pgn = CONFIG_RECORD_COMMIT,
     };
 
-    if (config_streamer_write(&streamer, (uint8_t *)&header, sizeof(header)) < 0) {
-        return false;
-    }
-    uint16_t crc = crc16_ccitt_update(0, (uint8_t *)&header, sizeof(header));
+    return writeRecord(streamer, &record, data, sizeof(sequence) + (CONFIG_STREAMER_BUFFER_SIZE - end % CONFIG_STREAMER_BUFFER_SIZE) % CONFIG_STREAMER_BUFFER_SIZE);
+}
+
+// True when the latest saved record for a PG instance matches its
+// current value
+static bool isRecordCurrent(const pgRegistry_t *reg, configRecordFlags_e classification, const uint8_t *address)
+{
+    const configRecord_t *record = findEEPROM(reg, classification);
+    const uint16_t regSize = pgSize(reg);
+
+    return record && record->version == pgVersion(reg) &&
+        record->size == configRecordDataOffset() + regSize &&
+        memcmp((const uint8_t *)record + configRecordDataOffset(), address, regSize) == 0;
+}
+
+// Writes a record for each PG instance, or only for the ones that changed
+// since the last save. With a NULL streamer nothing is written. Returns
+// the size of the records or -1 on error.
+static int writeRecords(config_streamer_t *streamer, bool changedOnly)
+{
+    int size = 0;
+
     PG_FOREACH(reg) {
         const uint16_t regSize = pgSize(reg);
-        configRecord_t record = {
-            .size = sizeof(configRecord_t) + regSize,
-            .pgn = pgN(reg),
-            .version = pgVersion(reg),
-            .flags = 0
-        };
+        // one instance for each profile
+        const uint8_t profileCount = pgIsSystem(reg) ? 1 : MAX_PROFILE_COUNT;
 
-        if (pgIsSystem(reg)) {
-            // write the only instance
-            record.flags |= CR_CLASSICATION_SYSTEM;
-            if (config_streamer_write(&streamer, (uint8_t *)&record, sizeof(record)) < 0) {
-                return false;
-            }
-            crc = crc16_ccitt_update(crc, (uint8_t *)&record, sizeof(record));
-            if (config_streamer_write(&streamer, reg->address, regSize) < 0) {
-                return false;
+        for (uint8_t profileIndex = 0; profileIndex < profileCount; profileIndex++) {
+            const configRecordFlags_e classification = pgIsSystem(reg) ? CR_CLASSICATION_SYSTEM : ((profileIndex + 1) & CR_CLASSIFICATION_MASK);
+            const uint8_t *address = reg->address + (regSize * profileIndex);
+
+            if (changedOnly && isRecordCurrent(reg, classification, address)) {
+                continue;
             }
-            crc = crc16_ccitt_update(crc, reg->address, regSize);
-        } else {
-            // write one instance for each profile
-            for (uint8_t profileIndex = 0; profileIndex < MAX_PROFILE_COUNT; profileIndex++) {
-                record.flags = 0;
 
-                record.flags |= ((profileIndex + 1) & CR_CLASSIFICATION_MASK);
-                if (config_streamer_write(&streamer, (uint8_t *)&record, sizeof(record)) < 0) {
-                    return false;
-                }
-                crc = crc16_ccitt_update(crc, (uint8_t *)&record, sizeof(record));
-                const uint8_t *address = reg->address + (regSize * profileIndex);
-                if (config_streamer_write(&streamer, address, regSize) < 0) {
-                    return false;
+            size += sizeof(configRecord_t) + regSize;
+
+            if (streamer) {
+                configRecord_t record = {
+                    .pgn = pgN(reg),
+                    .version = pgVersion(reg),
+                    .flags = classification,
+                };
+                if (!writeRecord(streamer, &record, address, regSize)) {
+                    return -1;
                 }
-                crc = crc16_ccitt_update(crc, address, regSize);
             }
         }
     }
 
-    configFooter_t footer = {
-        .terminator = 0,
-    };
+    return size;
+}
+
+// Appending programs memory after the log without erasing it first
+static bool isConfigAreaErased(const uint8_t *p, size_t size)
+{
+#if defined(CONFIG_IN_FILE)
+    // Can be overwritten
+    UNUSED(p);
+    UNUSED(size);
+    return true;
+#else
+    for (size_t ii = 0; ii < size; ii++) {
+        if (p[ii] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
 
-    if (config_streamer_write(&streamer, (uint8_t *)&footer, sizeof(footer)) < 0) {
+static bool finishSettingsWrite(config_streamer_t *streamer)
+{
+    if (!writeCommitRecord(streamer)) {
         return false;
     }
-    crc = crc16_ccitt_update(crc, (uint8_t *)&footer, sizeof(footer));
 
-    // append checksum now
-    if (config_streamer_write(&streamer, (uint8_t *)&crc, sizeof(crc)) < 0) {
+    if (config_streamer_flush(streamer) < 0) {
         return false;
     }
 
-    if (config_streamer_flush(&streamer) < 0) {
+    return config_streamer_finish(streamer) == 0;
+}
+
+static bool writeSettingsToEEPROM(void)
+{
+    config_streamer_t streamer;
+    config_streamer_init(&streamer);
+
+    // The legacy format can't be appended to
+    if (isEEPROMContentValid() && !configIsLegacy) {
+        const int changedSize = writeRecords(NULL, true);
+        if (changedSize == 0) {
+            // Nothing to save
+            return true;
+        }
+
+        // Append the PGs that changed if there's room for them and the commit
+        const int size = changedSize + sizeof(configRecord_t) + sizeof(uint16_t) + CONFIG_STREAMER_BUFFER_SIZE - 1;
+        if (size <= &__config_end - configLogEnd && isConfigAreaErased(configLogEnd, size)) {
+            config_streamer_start(&streamer, (uintptr_t)configLogEnd, &__config_end - configLogEnd);
+
+            if (writeRecords(&streamer, true) < 0) {
+                return false;
+            }
+
+            return finishSettingsWrite(&streamer);
+        }
+    }
+
+    // Compact the log, writing every PG from the start
+    config_streamer_start(&streamer, (uintptr_t)&__config_start, &__config_end - &__config_start);
+
+    configHeader_t header = {
+        .format = EEPROM_CONF_VERSION,
+    };
+
+    if (config_streamer_write(&streamer, (uint8_t *)&header, sizeof(header)) < 0) {
         return false;
     }
 
-    bool success = config_streamer_finish(&streamer) == 0;
+    if (writeRecords(&streamer, false) < 0) {
+        return false;
+    }
 
-    return success;
+    return finishSettingsWrite(&streamer);
 }
 
 void writeConfigToEEPROM(void)
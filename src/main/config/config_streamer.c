@@ -20,15 +20,20 @@
 #include "drivers/system.h"
 #include "config/config_streamer.h"
 #include "build/build_config.h"
+#include "common/maths.h"
 
 #if !defined(CONFIG_IN_FLASH)
 SLOW_RAM uint8_t eepromData[EEPROM_SIZE];
 #endif
 
+// Unaligned data is copied through a buffer of this size on the stack
+#define CONFIG_STREAMER_STAGING_SIZE (CONFIG_STREAMER_BUFFER_SIZE > 64 ? CONFIG_STREAMER_BUFFER_SIZE : 64)
+
 // Helper functions
 extern void config_streamer_impl_unlock(void);
 extern void config_streamer_impl_lock(void);
-extern int config_streamer_impl_write_word(config_streamer_t *c, config_streamer_buffer_align_type_t *buffer);
+// Programs count buffers of CONFIG_STREAMER_BUFFER_SIZE bytes at c->address
+extern int config_streamer_impl_write_words(config_streamer_t *c, const config_streamer_buffer_align_type_t *buffer, uint32_t count);
 
 void config_streamer_init(config_streamer_t *c)
 {
@@ -37,7 +42,8 @@ void config_streamer_init(config_streamer_t *c)
 
 void config_streamer_start(config_streamer_t *c, uintptr_t base, int size)
 {
-    // base must start at FLASH_PAGE_SIZE boundary when using embedded flash.
+    // base must start at FLASH_PAGE_SIZE boundary when using embedded flash,
+    // or at a buffer boundary of already erased memory when appending.
     c->address = base;
     c->size = size;
     c->end = base + size;
@@ -55,14 +61,46 @@ int config_streamer_write(config_streamer_t *c, const uint8_t *p, uint32_t size)
         return -1;
     }
 
-    for (const uint8_t *pat = p; pat != (uint8_t*)p + size; pat++) {
-        c->buffer.b[c->at++] = *pat;
+    // Complete the buffered word first
+    if (c->at != 0) {
+        const uint32_t n = MIN(size, sizeof(c->buffer) - c->at);
+        memcpy(c->buffer.b + c->at, p, n);
+        c->at += n;
+        p += n;
+        size -= n;
 
         if (c->at == sizeof(c->buffer)) {
-            c->err = config_streamer_impl_write_word(c, &c->buffer.w);
+            c->err = config_streamer_impl_write_words(c, &c->buffer.w, 1);
             c->at = 0;
         }
     }
+
+    // Whole words are programmed straight from the source when it's aligned
+    if (c->at == 0 && size >= sizeof(c->buffer)) {
+        uint32_t count = size / sizeof(c->buffer);
+
+        if ((uintptr_t)p % sizeof(config_streamer_buffer_align_type_t) == 0) {
+            c->err = config_streamer_impl_write_words(c, (const config_streamer_buffer_align_type_t *)p, count);
+            p += count * sizeof(c->buffer);
+            size -= count * sizeof(c->buffer);
+        } else {
+            config_streamer_buffer_align_type_t staging[CONFIG_STREAMER_STAGING_SIZE / sizeof(config_streamer_buffer_align_type_t)];
+
+            while (count > 0) {
+                const uint32_t n = MIN(count, sizeof(staging) / sizeof(c->buffer));
+                memcpy(staging, p, n * sizeof(c->buffer));
+                c->err = config_streamer_impl_write_words(c, staging, n);
+                p += n * sizeof(c->buffer);
+                size -= n * sizeof(c->buffer);
+                count -= n;
+            }
+        }
+    }
+
+    // Keep the rest for the next write or the flush
+    memcpy(c->buffer.b + c->at, p, size);
+    c->at += size;
+
     return c->err;
 }
 
@@ -78,7 +116,7 @@ int config_streamer_flush(config_streamer_t *c)
             return -1;
         }
         memset(c->buffer.b + c->at, 0, sizeof(c->buffer) - c->at);
-        c->err = config_streamer_impl_write_word(c, &c->buffer.w);
+        c->err = config_streamer_impl_write_words(c, &c->buffer.w, 1);
         c->at = 0;
     }
     return c-> err;
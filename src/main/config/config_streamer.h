@@ -60,4 +60,5 @@ int config_streamer_status(config_streamer_t *c);
 
 #if defined(CONFIG_IN_FILE)
 bool configFileSetPath(char* path);
+void configFileSetSync(bool sync);
 #endif
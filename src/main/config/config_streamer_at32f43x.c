@@ -40,25 +40,28 @@ void config_streamer_impl_lock(void)
     flash_lock();
 }
 
-int config_streamer_impl_write_word(config_streamer_t *c, config_streamer_buffer_align_type_t *buffer)
+int config_streamer_impl_write_words(config_streamer_t *c, const config_streamer_buffer_align_type_t *buffer, uint32_t count)
 {
     if (c->err != 0) {
         return c->err;
     }
-    // Erases sectors from the start address
-    if (c->address % FLASH_PAGE_SIZE == 0) {
-        const flash_status_type status =flash_sector_erase(c->address);
-		   if (status != FLASH_OPERATE_DONE) {
-			   return -1;
-		   }
-	   }
-    
-    const flash_status_type status = flash_word_program(c->address, *buffer);
-    if (status != FLASH_OPERATE_DONE) {
-        return -2;
-    }
 
-    c->address += CONFIG_STREAMER_BUFFER_SIZE;
+    for (; count > 0; count--, buffer++) {
+        // Erases sectors from the start address
+        if (c->address % FLASH_PAGE_SIZE == 0) {
+            const flash_status_type status = flash_sector_erase(c->address);
+            if (status != FLASH_OPERATE_DONE) {
+                return -1;
+            }
+        }
+
+        const flash_status_type status = flash_word_program(c->address, *buffer);
+        if (status != FLASH_OPERATE_DONE) {
+            return -2;
+        }
+
+        c->address += CONFIG_STREAMER_BUFFER_SIZE;
+    }
     return 0;
 }
 
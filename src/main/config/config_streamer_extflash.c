@@ -39,37 +39,40 @@ void config_streamer_impl_lock(void)
     streamerLocked = true;
 }
 
-int config_streamer_impl_write_word(config_streamer_t *c, config_streamer_buffer_align_type_t *buffer)
+int config_streamer_impl_write_words(config_streamer_t *c, const config_streamer_buffer_align_type_t *buffer, uint32_t count)
 {
     if (streamerLocked) {
         return -1;
     }
 
-    uint32_t dataOffset = (uint32_t)(c->address - (uintptr_t)&eepromData[0]);
-
     const flashPartition_t *flashPartition = flashPartitionFindByType(FLASH_PARTITION_TYPE_CONFIG);
     const flashGeometry_t *flashGeometry = flashGetGeometry();
 
     uint32_t flashStartAddress = flashPartition->startSector * flashGeometry->sectorSize;
     uint32_t flashOverflowAddress = ((flashPartition->endSector + 1) * flashGeometry->sectorSize); // +1 to sector for inclusive
+    uint32_t flashSectorSize = flashGeometry->sectorSize;
 
-    uint32_t flashAddress = flashStartAddress + dataOffset;
-    if (flashAddress + CONFIG_STREAMER_BUFFER_SIZE > flashOverflowAddress) {
-        return -2; // address is past end of partition
-    }
+    const uint8_t *data = (const uint8_t *)buffer;
 
-    uint32_t flashSectorSize = flashGeometry->sectorSize;
+    for (; count > 0; count--, data += CONFIG_STREAMER_BUFFER_SIZE) {
+        uint32_t dataOffset = (uint32_t)(c->address - (uintptr_t)&eepromData[0]);
 
-    if (flashAddress % flashSectorSize == 0) {
-        flashEraseSector(flashAddress);
-    }
+        uint32_t flashAddress = flashStartAddress + dataOffset;
+        if (flashAddress + CONFIG_STREAMER_BUFFER_SIZE > flashOverflowAddress) {
+            return -2; // address is past end of partition
+        }
 
-    if (flashPageProgram(flashAddress, (uint8_t *)buffer, CONFIG_STREAMER_BUFFER_SIZE) == flashAddress) {
-        // returned same address: programming failed
-        return -3;
-    }
+        if (flashAddress % flashSectorSize == 0) {
+            flashEraseSector(flashAddress);
+        }
 
-    c->address += CONFIG_STREAMER_BUFFER_SIZE;
+        if (flashPageProgram(flashAddress, data, CONFIG_STREAMER_BUFFER_SIZE) == flashAddress) {
+            // returned same address: programming failed
+            return -3;
+        }
+
+        c->address += CONFIG_STREAMER_BUFFER_SIZE;
+    }
 
     return 0;
 }
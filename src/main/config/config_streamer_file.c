@@ -26,11 +26,15 @@
 
 #include <stdio.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
-
-#define FLASH_PAGE_SIZE  (0x400)
-
-static FILE *eepromFd = NULL;
+// The file is mapped once and kept in sync with eepromData, saving
+// only touches the pages that changed
+static uint8_t *eepromMap = NULL;
+static bool eepromSync = false;
 static bool streamerLocked = true;
 static char eepromPath[260] = EEPROM_FILENAME;
 
@@ -44,71 +48,91 @@ bool configFileSetPath(char* path)
     return true;
 }
 
+void configFileSetSync(bool sync)
+{
+    eepromSync = sync;
+}
+
 void config_streamer_impl_unlock(void)
 {
-    if (eepromFd != NULL) {
-        fprintf(stderr, "[EEPROM] Unable to load %s\n", eepromPath);
+    if (eepromMap != NULL) {
+        streamerLocked = false;
         return;
     }
 
     // open or create
-    eepromFd = fopen(eepromPath,"r+");
-    if (eepromFd != NULL) {
-        // obtain file size:
-        fseek(eepromFd , 0 , SEEK_END);
-        size_t size = ftell(eepromFd);
-        rewind(eepromFd);
-
-        size_t n = fread(eepromData, 1, sizeof(eepromData), eepromFd);
-        if (n == size) {
-            fprintf(stderr,"[EEPROM] Loaded '%s' (%ld of %ld bytes)\n", eepromPath, size, sizeof(eepromData));
-            streamerLocked = false;
-        } else {
-            fprintf(stderr, "[EEPROM] Failed to load '%s'\n", eepromPath);
-        }
+    const int fd = open(eepromPath, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "[EEPROM] Failed to open '%s': %s\n", eepromPath, strerror(errno));
+        return;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size > (off_t)sizeof(eepromData)) {
+        fprintf(stderr, "[EEPROM] Failed to load '%s'\n", eepromPath);
+        close(fd);
+        return;
+    }
+    const size_t size = st.st_size;
+
+    // Shorter files are extended with zeros
+    if (ftruncate(fd, sizeof(eepromData)) != 0) {
+        fprintf(stderr, "[EEPROM] Write failed: %s\n", strerror(errno));
+        close(fd);
+        return;
+    }
+
+    void *map = mmap(NULL, sizeof(eepromData), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    // The mapping stays valid after closing the file
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "[EEPROM] Failed to map '%s': %s\n", eepromPath, strerror(errno));
+        return;
+    }
+    eepromMap = map;
+
+    if (size > 0) {
+        memcpy(eepromData, eepromMap, sizeof(eepromData));
+        fprintf(stderr,"[EEPROM] Loaded '%s' (%ld of %ld bytes)\n", eepromPath, (long)size, (long)sizeof(eepromData));
     } else {
-        printf("[EEPROM] Created '%s', size = %ld\n", eepromPath, sizeof(eepromData));
-        streamerLocked = false;
-        if ((eepromFd = fopen(eepromPath, "w+")) == NULL) {
-            fprintf(stderr, "[EEPROM] Failed to create '%s'\n", eepromPath);
-            streamerLocked = true;
-        }
-        if (fwrite(eepromData, sizeof(eepromData), 1, eepromFd) != 1) {
-            fprintf(stderr, "[EEPROM] Write failed: %s\n", strerror(errno));
-            streamerLocked = true;
-        }
+        memcpy(eepromMap, eepromData, sizeof(eepromData));
+        printf("[EEPROM] Created '%s', size = %ld\n", eepromPath, (long)sizeof(eepromData));
     }
+    streamerLocked = false;
 }
 
 void config_streamer_impl_lock(void)
 {
-    // flush & close
-    if (eepromFd != NULL) {
-        fseek(eepromFd, 0, SEEK_SET);
-        fwrite(eepromData, 1, sizeof(eepromData), eepromFd);
-        fclose(eepromFd);
-        eepromFd = NULL;
+    if (eepromMap != NULL) {
+        // The kernel writes the pages back on its own, even if the process
+        // is killed. Syncing only matters if the host goes down.
+        if (eepromSync && msync(eepromMap, sizeof(eepromData), MS_SYNC) != 0) {
+            fprintf(stderr, "[EEPROM] Sync failed: %s\n", strerror(errno));
+        }
         fprintf(stderr, "[EEPROM] Saved '%s'\n", eepromPath);
-        streamerLocked = false;
     } else {
         fprintf(stderr, "[EEPROM] Unlock error\n");
     }
+    streamerLocked = true;
 }
 
-int config_streamer_impl_write_word(config_streamer_t *c, config_streamer_buffer_align_type_t *buffer)
+int config_streamer_impl_write_words(config_streamer_t *c, const config_streamer_buffer_align_type_t *buffer, uint32_t count)
 {
     if (streamerLocked) {
         return -1;
     }
 
-    if ((c->address >= (uintptr_t)eepromData) && (c->address < (uintptr_t)ARRAYEND(eepromData))) {
-        *((uint32_t*)c->address) = *buffer;
-        fprintf(stderr, "[EEPROM] Program word  %p = %08x\n", (void*)c->address, *((uint32_t*)c->address));
+    const uint32_t size = count * CONFIG_STREAMER_BUFFER_SIZE;
+
+    if ((c->address >= (uintptr_t)eepromData) && (c->address + size <= (uintptr_t)ARRAYEND(eepromData))) {
+        const uintptr_t offset = c->address - (uintptr_t)eepromData;
+        memcpy(eepromData + offset, buffer, size);
+        memcpy(eepromMap + offset, buffer, size);
     } else {
         fprintf(stderr, "[EEPROM] Program word %p out of range!\n", (void*)c->address);
     }
 
-    c->address += CONFIG_STREAMER_BUFFER_SIZE;
+    c->address += size;
     return 0;
 }
 
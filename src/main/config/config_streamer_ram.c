@@ -34,26 +34,21 @@ void config_streamer_impl_lock(void)
     streamerLocked = true;
 }
 
-int config_streamer_impl_write_word(config_streamer_t *c, config_streamer_buffer_align_type_t *buffer)
+int config_streamer_impl_write_words(config_streamer_t *c, const config_streamer_buffer_align_type_t *buffer, uint32_t count)
 {
     if (streamerLocked) {
         return -1;
     }
 
+    // Erased like flash, so appending to the config log sees the same
+    // memory as on hardware
     if (c->address == (uintptr_t)&eepromData[0]) {
-        ZERO_FARRAY(eepromData);
+        memset(eepromData, 0xFF, sizeof(eepromData));
     }
 
-    config_streamer_buffer_align_type_t *destAddr = (config_streamer_buffer_align_type_t *)c->address;
-    config_streamer_buffer_align_type_t *srcAddr = buffer;
+    memcpy((void *)c->address, buffer, count * CONFIG_STREAMER_BUFFER_SIZE);
 
-    uint8_t nRows = CONFIG_STREAMER_BUFFER_SIZE / sizeof(config_streamer_buffer_align_type_t);
-
-    do {
-        *destAddr++ = *srcAddr++;
-    } while(--nRows != 0);
-
-    c->address += CONFIG_STREAMER_BUFFER_SIZE;
+    c->address += count * CONFIG_STREAMER_BUFFER_SIZE;
 
     return 0;
 }
@@ -81,25 +81,27 @@ void config_streamer_impl_lock(void)
     FLASH_Lock();
 }
 
-int config_streamer_impl_write_word(config_streamer_t *c, config_streamer_buffer_align_type_t *buffer)
+int config_streamer_impl_write_words(config_streamer_t *c, const config_streamer_buffer_align_type_t *buffer, uint32_t count)
 {
     if (c->err != 0) {
         return c->err;
     }
 
-    if (c->address % FLASH_PAGE_SIZE == 0) {
-        const FLASH_Status status = FLASH_EraseSector(getFLASHSectorForEEPROM(c->address), VoltageRange_3);
+    for (; count > 0; count--, buffer++) {
+        if (c->address % FLASH_PAGE_SIZE == 0) {
+            const FLASH_Status status = FLASH_EraseSector(getFLASHSectorForEEPROM(c->address), VoltageRange_3);
+            if (status != FLASH_COMPLETE) {
+                return -1;
+            }
+        }
+
+        const FLASH_Status status = FLASH_ProgramWord(c->address, *buffer);
         if (status != FLASH_COMPLETE) {
-            return -1;
+            return -2;
         }
-    }
 
-    const FLASH_Status status = FLASH_ProgramWord(c->address, *buffer);
-    if (status != FLASH_COMPLETE) {
-        return -2;
+        c->address += CONFIG_STREAMER_BUFFER_SIZE;
     }
-
-    c->address += CONFIG_STREAMER_BUFFER_SIZE;
     return 0;
 }
 
@@ -108,34 +108,36 @@ void config_streamer_impl_lock(void)
     HAL_FLASH_Lock();
 }
 
-int config_streamer_impl_write_word(config_streamer_t *c, config_streamer_buffer_align_type_t *buffer)
+int config_streamer_impl_write_words(config_streamer_t *c, const config_streamer_buffer_align_type_t *buffer, uint32_t count)
 {
     if (c->err != 0) {
         return c->err;
     }
 
-    if (c->address % FLASH_PAGE_SIZE == 0) {
-        FLASH_EraseInitTypeDef EraseInitStruct = {
-            .TypeErase     = FLASH_TYPEERASE_SECTORS,
-            .VoltageRange  = FLASH_VOLTAGE_RANGE_3, // 2.7-3.6V
-            .NbSectors     = 1
-        };
-        EraseInitStruct.Sector = getFLASHSectorForEEPROM(c->address);
+    for (; count > 0; count--, buffer++) {
+        if (c->address % FLASH_PAGE_SIZE == 0) {
+            FLASH_EraseInitTypeDef EraseInitStruct = {
+                .TypeErase     = FLASH_TYPEERASE_SECTORS,
+                .VoltageRange  = FLASH_VOLTAGE_RANGE_3, // 2.7-3.6V
+                .NbSectors     = 1
+            };
+            EraseInitStruct.Sector = getFLASHSectorForEEPROM(c->address);
 
-        uint32_t SECTORError;
-        const HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&EraseInitStruct, &SECTORError);
-        if (status != HAL_OK){
-            return -1;
+            uint32_t SECTORError;
+            const HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&EraseInitStruct, &SECTORError);
+            if (status != HAL_OK){
+                return -1;
+            }
         }
-    }
 
-    const HAL_StatusTypeDef status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, c->address, (uint64_t)*buffer);
-    if (status != HAL_OK) {
-        return -2;
-    }
+        const HAL_StatusTypeDef status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, c->address, (uint64_t)*buffer);
+        if (status != HAL_OK) {
+            return -2;
+        }
 
-    c->address += CONFIG_STREAMER_BUFFER_SIZE;
-    return 0;    
+        c->address += CONFIG_STREAMER_BUFFER_SIZE;
+    }
+    return 0;
 }
 
 #endif
@@ -64,35 +64,39 @@ void config_streamer_impl_lock(void)
     HAL_FLASH_Lock();
 }
 
-int config_streamer_impl_write_word(config_streamer_t *c, config_streamer_buffer_align_type_t *buffer)
+int config_streamer_impl_write_words(config_streamer_t *c, const config_streamer_buffer_align_type_t *buffer, uint32_t count)
 {
     if (c->err != 0) {
         return c->err;
     }
 
-    if (c->address % FLASH_PAGE_SIZE == 0) {
-        FLASH_EraseInitTypeDef EraseInitStruct = {
-            .TypeErase     = FLASH_TYPEERASE_SECTORS,
-            .VoltageRange  = FLASH_VOLTAGE_RANGE_3, // 2.7-3.6V
-            .NbSectors     = 1,
-            .Banks         = FLASH_BANK_1
-        };
-        EraseInitStruct.Sector = getFLASHSectorForEEPROM(c->address);
+    const uint8_t *data = (const uint8_t *)buffer;
 
-        uint32_t SECTORError;
-        const HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&EraseInitStruct, &SECTORError);
+    for (; count > 0; count--, data += CONFIG_STREAMER_BUFFER_SIZE) {
+        if (c->address % FLASH_PAGE_SIZE == 0) {
+            FLASH_EraseInitTypeDef EraseInitStruct = {
+                .TypeErase     = FLASH_TYPEERASE_SECTORS,
+                .VoltageRange  = FLASH_VOLTAGE_RANGE_3, // 2.7-3.6V
+                .NbSectors     = 1,
+                .Banks         = FLASH_BANK_1
+            };
+            EraseInitStruct.Sector = getFLASHSectorForEEPROM(c->address);
+
+            uint32_t SECTORError;
+            const HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&EraseInitStruct, &SECTORError);
+            if (status != HAL_OK) {
+                return -1;
+            }
+        }
+
+        // On H7 HAL_FLASH_Program takes data address, not the raw word value
+        const HAL_StatusTypeDef status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_FLASHWORD, c->address, (uint32_t)data);
         if (status != HAL_OK) {
-            return -1;
+            return -2;
         }
-    }
 
-    // On H7 HAL_FLASH_Program takes data address, not the raw word value
-    const HAL_StatusTypeDef status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_FLASHWORD, c->address, (uint32_t)buffer);
-    if (status != HAL_OK) {
-        return -2;
+        c->address += CONFIG_STREAMER_BUFFER_SIZE;
     }
-
-    c->address += CONFIG_STREAMER_BUFFER_SIZE;
     return 0;
 }
 
@@ -115,6 +115,57 @@ void pgResetAll(int profileCount)
     }
 }
 
+static uint8_t pgCopyGeneration;
+
+// Saves every PG to its copy, e.g. to diff against defaults or to undo
+// a set of changes with pgRestoreAll()
+void pgBackupAll(int profileCount)
+{
+    pgCopyGeneration++;
+    PG_FOREACH(reg) {
+        if (pgIsProfile(reg)) {
+            memcpy(reg->copy, reg->address, pgSize(reg) * profileCount);
+        } else {
+            memcpy(reg->copy, reg->address, pgSize(reg));
+        }
+    }
+}
+
+void pgRestoreAll(int profileCount)
+{
+    PG_FOREACH(reg) {
+        if (pgIsProfile(reg)) {
+            memcpy(reg->address, reg->copy, pgSize(reg) * profileCount);
+        } else {
+            memcpy(reg->address, reg->copy, pgSize(reg));
+        }
+    }
+}
+
+// Exchanges every PG with its copy, i.e. applies a config prepared in the
+// copies while keeping the previous one to swap back
+void pgSwapAll(int profileCount)
+{
+    uint8_t tmp[32];
+
+    PG_FOREACH(reg) {
+        const int size = pgIsProfile(reg) ? pgSize(reg) * profileCount : pgSize(reg);
+        for (int offset = 0; offset < size; offset += sizeof(tmp)) {
+            const int chunk = MIN(size - offset, (int)sizeof(tmp));
+            memcpy(tmp, reg->address + offset, chunk);
+            memcpy(reg->address + offset, reg->copy + offset, chunk);
+            memcpy(reg->copy + offset, tmp, chunk);
+        }
+    }
+}
+
+// Changes each time pgBackupAll() overwrites the copies, so data kept in
+// them across calls can be checked for still being there
+uint8_t pgGetCopyGeneration(void)
+{
+    return pgCopyGeneration;
+}
+
 void pgActivateProfile(int profileIndex)
 {
     PG_FOREACH(reg) {
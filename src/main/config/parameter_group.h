@@ -235,6 +235,10 @@ const pgRegistry_t* pgFind(pgn_t pgn);
 void pgLoad(const pgRegistry_t* reg, int profileIndex, const void *from, int size, int version);
 int pgStore(const pgRegistry_t* reg, void *to, int size, uint8_t profileIndex);
 void pgResetAll(int profileCount);
+void pgBackupAll(int profileCount);
+void pgRestoreAll(int profileCount);
+void pgSwapAll(int profileCount);
+uint8_t pgGetCopyGeneration(void);
 void pgResetCurrent(const pgRegistry_t *reg);
 bool pgResetCopy(void *copy, pgn_t pgn);
 void pgReset(const pgRegistry_t* reg, int profileIndex);
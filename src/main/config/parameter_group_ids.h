@@ -126,7 +126,8 @@
 #define PG_FW_AUTOLAND_CONFIG 1036
 #define PG_FW_AUTOLAND_APPROACH_CONFIG 1037
 #define PG_OSD_CUSTOM_ELEMENTS_CONFIG 1038
-#define PG_INAV_END PG_OSD_CUSTOM_ELEMENTS_CONFIG
+#define PG_OSD_REFRESH_CONFIG 1039
+#define PG_INAV_END PG_OSD_REFRESH_CONFIG
 
 // OSD configuration (subject to change)
 //#define PG_OSD_FONT_CONFIG 2047
@@ -27,29 +27,18 @@
 #include "drivers/io.h"
 #include "drivers/bus.h"
 #include "drivers/barometer/barometer.h"
+#include "drivers/barometer/barometer_compensation.h"
 #include "drivers/barometer/barometer_bmp280.h"
 
 #if defined(USE_BARO_BMP280)
 
 // BMP280, address 0x76
 
-typedef struct bmp280_calib_param_s {
-    uint16_t dig_T1; /* calibration T1 data */
-    int16_t dig_T2; /* calibration T2 data */
-    int16_t dig_T3; /* calibration T3 data */
-    uint16_t dig_P1; /* calibration P1 data */
-    int16_t dig_P2; /* calibration P2 data */
-    int16_t dig_P3; /* calibration P3 data */
-    int16_t dig_P4; /* calibration P4 data */
-    int16_t dig_P5; /* calibration P5 data */
-    int16_t dig_P6; /* calibration P6 data */
-    int16_t dig_P7; /* calibration P7 data */
-    int16_t dig_P8; /* calibration P8 data */
-    int16_t dig_P9; /* calibration P9 data */
-    int32_t t_fine; /* calibration t_fine data */
-} bmp280_calib_param_t;
-
-STATIC_UNIT_TESTED bmp280_calib_param_t bmp280_cal;
+STATIC_ASSERT(sizeof(baroBmp280Calibration_t) == BMP280_PRESSURE_TEMPERATURE_CALIB_DATA_LENGTH, bmp280_calibration_layout_mismatch);
+
+STATIC_UNIT_TESTED baroBmp280Calibration_t bmp280_cal;
+static baroBmp280Compensation_t bmp280_comp;
+static int32_t bmp280_comp_ut = -1;     // raw temperature the compensation was computed for
 // uncompensated pressure and temperature
 int32_t bmp280_up = 0;
 int32_t bmp280_ut = 0;
@@ -101,56 +90,22 @@ static bool bmp280_get_up(baroDev_t * baro)
     return ack;
 }
 
-// Returns temperature in DegC, resolution is 0.01 DegC. Output value of "5123" equals 51.23 DegC
-// t_fine carries fine temperature as global value
-static int32_t bmp280_compensate_T(int32_t adc_T)
-{
-    int32_t var1, var2, T;
-
-    var1 = ((((adc_T >> 3) - ((int32_t)bmp280_cal.dig_T1 << 1))) * ((int32_t)bmp280_cal.dig_T2)) >> 11;
-    var2  = (((((adc_T >> 4) - ((int32_t)bmp280_cal.dig_T1)) * ((adc_T >> 4) - ((int32_t)bmp280_cal.dig_T1))) >> 12) * ((int32_t)bmp280_cal.dig_T3)) >> 14;
-    bmp280_cal.t_fine = var1 + var2;
-    T = (bmp280_cal.t_fine * 5 + 128) >> 8;
-
-    return T;
-}
-
-// Returns pressure in Pa as unsigned 32 bit integer in Q24.8 format (24 integer bits and 8 fractional bits).
-// Output value of "24674867" represents 24674867/256 = 96386.2 Pa = 963.862 hPa
-static uint32_t bmp280_compensate_P(int32_t adc_P)
-{
-    int64_t var1, var2, p;
-    var1 = ((int64_t)bmp280_cal.t_fine) - 128000;
-    var2 = var1 * var1 * (int64_t)bmp280_cal.dig_P6;
-    var2 = var2 + ((var1*(int64_t)bmp280_cal.dig_P5) << 17);
-    var2 = var2 + (((int64_t)bmp280_cal.dig_P4) << 35);
-    var1 = ((var1 * var1 * (int64_t)bmp280_cal.dig_P3) >> 8) + ((var1 * (int64_t)bmp280_cal.dig_P2) << 12);
-    var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)bmp280_cal.dig_P1) >> 33;
-    if (var1 == 0) {
-        return 0;
-    }
-
-    p = 1048576 - adc_P;
-    p = (((p << 31) - var2) * 3125) / var1;
-    var1 = (((int64_t)bmp280_cal.dig_P9) * (p >> 13) * (p >> 13)) >> 25;
-    var2 = (((int64_t)bmp280_cal.dig_P8) * p) >> 19;
-    p = ((p + var1 + var2) >> 8) + (((int64_t)bmp280_cal.dig_P7) << 4);
-    return (uint32_t)p;
-}
-
 STATIC_UNIT_TESTED bool bmp280_calculate(baroDev_t * baro, int32_t * pressure, int32_t * temperature)
 {
     UNUSED(baro);
 
-    int32_t t = bmp280_compensate_T(bmp280_ut);
-    uint32_t p = bmp280_compensate_P(bmp280_up);
+    // Temperature comes with every pressure readout, redo its part of the compensation only if it changed
+    if (bmp280_ut != bmp280_comp_ut) {
+        baroBmp280CompensateTemperature(&bmp280_comp, &bmp280_cal, bmp280_ut);
+        bmp280_comp_ut = bmp280_ut;
+    }
 
     if (pressure) {
-        *pressure = (int32_t)(p / 256);
+        *pressure = baroBmp280CompensatePressure(&bmp280_comp, bmp280_up);
     }
 
     if (temperature) {
-        *temperature = t;
+        *temperature = bmp280_comp.temperature;
     }
 
     return true;
@@ -189,7 +144,8 @@ bool bmp280Detect(baroDev_t *baro)
     }
 
     // read calibration
-    busReadBuf(baro->busDev, BMP280_TEMPERATURE_CALIB_DIG_T1_LSB_REG, (uint8_t *)&bmp280_cal, 24);
+    busReadBuf(baro->busDev, BMP280_TEMPERATURE_CALIB_DIG_T1_LSB_REG, (uint8_t *)&bmp280_cal, BMP280_PRESSURE_TEMPERATURE_CALIB_DATA_LENGTH);
+    bmp280_comp_ut = -1;
 
     //set filter setting
     busWrite(baro->busDev, BMP280_CONFIG_REG, BMP280_FILTER);
@@ -0,0 +1,169 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "platform.h"
+
+#include "drivers/barometer/barometer_compensation.h"
+
+void baroMs56xxCompensateTemperature(baroMs56xxCompensation_t * comp, const uint16_t * prom, bool isMs5607, uint32_t rawTemperature)
+{
+    const int64_t dT = (int64_t)rawTemperature - ((int64_t)prom[5] << 8);
+    int64_t temp = 2000 + ((dT * (int64_t)prom[6]) >> 23);
+    int64_t off;
+    int64_t sens;
+    int64_t delt;
+
+    if (isMs5607) {
+        off = ((int64_t)prom[2] << 17) + (((int64_t)prom[4] * dT) >> 6);
+        sens = ((int64_t)prom[1] << 16) + (((int64_t)prom[3] * dT) >> 7);
+    }
+    else {
+        off = ((int64_t)prom[2] << 16) + (((int64_t)prom[4] * dT) >> 7);
+        sens = ((int64_t)prom[1] << 15) + (((int64_t)prom[3] * dT) >> 8);
+    }
+
+    if (temp < 2000) { // temperature lower than 20degC
+        delt = temp - 2000;
+        delt = delt * delt;
+
+        if (isMs5607) {
+            off -= (61 * delt) >> 4;
+            sens -= 2 * delt;
+        }
+        else {
+            off -= (5 * delt) >> 1;
+            sens -= (5 * delt) >> 2;
+        }
+
+        if (temp < -1500) { // temperature lower than -15degC
+            delt = temp + 1500;
+            delt = delt * delt;
+
+            if (isMs5607) {
+                off -= 15 * delt;
+                sens -= 8 * delt;
+            }
+            else {
+                off -= 7 * delt;
+                sens -= (11 * delt) >> 1;
+            }
+        }
+
+        temp -= ((dT * dT) >> 31);
+    }
+
+    comp->off = off;
+    comp->sens = sens;
+    comp->temperature = temp;
+}
+
+int32_t baroMs56xxCompensatePressure(const baroMs56xxCompensation_t * comp, uint32_t rawPressure)
+{
+    return (int32_t)(((((int64_t)rawPressure * comp->sens) >> 21) - comp->off) >> 15);
+}
+
+void baroBmp280CompensateTemperature(baroBmp280Compensation_t * comp, const baroBmp280Calibration_t * cal, int32_t rawTemperature)
+{
+    const int32_t var1 = ((((rawTemperature >> 3) - ((int32_t)cal->dig_T1 << 1))) * ((int32_t)cal->dig_T2)) >> 11;
+    const int32_t var2 = (((((rawTemperature >> 4) - ((int32_t)cal->dig_T1)) * ((rawTemperature >> 4) - ((int32_t)cal->dig_T1))) >> 12) * ((int32_t)cal->dig_T3)) >> 14;
+    const int32_t tFine = var1 + var2;
+
+    comp->cal = cal;
+    comp->temperature = (tFine * 5 + 128) >> 8;
+
+    // Everything up to the division only depends on t_fine
+    int64_t pVar1 = ((int64_t)tFine) - 128000;
+    int64_t pVar2 = pVar1 * pVar1 * (int64_t)cal->dig_P6;
+    pVar2 = pVar2 + ((pVar1 * (int64_t)cal->dig_P5) << 17);
+    pVar2 = pVar2 + (((int64_t)cal->dig_P4) << 35);
+    pVar1 = ((pVar1 * pVar1 * (int64_t)cal->dig_P3) >> 8) + ((pVar1 * (int64_t)cal->dig_P2) << 12);
+    pVar1 = (((((int64_t)1) << 47) + pVar1)) * ((int64_t)cal->dig_P1) >> 33;
+
+    comp->var1 = pVar1;
+    comp->var2 = pVar2;
+}
+
+int32_t baroBmp280CompensatePressure(const baroBmp280Compensation_t * comp, int32_t rawPressure)
+{
+    // Avoid division by zero, reports 0 Pa just like the reference implementation
+    if (comp->var1 == 0) {
+        return 0;
+    }
+
+    int64_t p = 1048576 - rawPressure;
+    p = (((p << 31) - comp->var2) * 3125) / comp->var1;
+
+    const int64_t var1 = (((int64_t)comp->cal->dig_P9) * (p >> 13) * (p >> 13)) >> 25;
+    const int64_t var2 = (((int64_t)comp->cal->dig_P8) * p) >> 19;
+    p = ((p + var1 + var2) >> 8) + (((int64_t)comp->cal->dig_P7) << 4);
+
+    // Q24.8 to Pa
+    return (int32_t)((uint32_t)p / 256);
+}
+
+/*
+ * Raw values are divided by a scale factor kP/kT that depends on the oversampling rate.
+ * All of them are (2^n - 1) << s, which lets us get the scaled value in Q20 with a 32-bit division.
+ */
+static int32_t baroDpsScaleRaw(int32_t raw, uint8_t oversampling)
+{
+    int n = 0;
+    while ((1 << n) < oversampling && n < 7) {
+        n++;
+    }
+
+    const int32_t divisor = (1 << (n + 1)) - 1;
+    if (n < 4) {
+        // scale factor is divisor << 19
+        return (raw * 2) / divisor;
+    }
+
+    // scale factor is divisor << 13
+    return (raw * 128) / divisor;
+}
+
+#define DPS_Q       20      // Scaled raw values
+#define DPS_P_Q     8       // Polynomial coefficients and result
+
+void baroDpsCompensateTemperature(baroDpsCompensation_t * comp, const baroDpsCalibration_t * cal, int32_t rawTemperature, uint8_t oversampling)
+{
+    const int64_t tsc = baroDpsScaleRaw(rawTemperature, oversampling);
+
+    // T = c0 / 2 + c1 * Tsc
+    comp->temperature = (int32_t)(cal->c0 * 50 + ((cal->c1 * tsc * 100) >> DPS_Q));
+
+    // P = c00 + Tsc * c01 + Psc * ((c10 + Tsc * c11) + Psc * ((c20 + Tsc * c21) + Psc * c30))
+    comp->a[0] = ((int64_t)cal->c00 << DPS_P_Q) + ((cal->c01 * tsc) >> (DPS_Q - DPS_P_Q));
+    comp->a[1] = ((int64_t)cal->c10 << DPS_P_Q) + ((cal->c11 * tsc) >> (DPS_Q - DPS_P_Q));
+    comp->a[2] = ((int64_t)cal->c20 << DPS_P_Q) + ((cal->c21 * tsc) >> (DPS_Q - DPS_P_Q));
+    comp->a[3] = ((int64_t)cal->c30 << DPS_P_Q);
+}
+
+int32_t baroDpsCompensatePressure(const baroDpsCompensation_t * comp, int32_t rawPressure, uint8_t oversampling)
+{
+    const int64_t psc = baroDpsScaleRaw(rawPressure, oversampling);
+
+    int64_t p = comp->a[3];
+    p = comp->a[2] + ((p * psc) >> DPS_Q);
+    p = comp->a[1] + ((p * psc) >> DPS_Q);
+    p = comp->a[0] + ((p * psc) >> DPS_Q);
+
+    return (int32_t)((p + (1 << (DPS_P_Q - 1))) >> DPS_P_Q);
+}
@@ -0,0 +1,87 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Integer compensation shared by the barometer drivers. Every sensor family is split into a
+ * temperature stage, which only has to run when a new raw temperature is read, and a cheap
+ * pressure stage that runs for every pressure sample. Pressure is returned in Pa, temperature
+ * in centidegrees C.
+ */
+
+// MS5611 / MS5607, first and second order compensation from the datasheets
+#define BARO_MS56XX_PROM_SIZE   8
+
+typedef struct baroMs56xxCompensation_s {
+    int64_t off;
+    int64_t sens;
+    int32_t temperature;
+} baroMs56xxCompensation_t;
+
+void baroMs56xxCompensateTemperature(baroMs56xxCompensation_t * comp, const uint16_t * prom, bool isMs5607, uint32_t rawTemperature);
+int32_t baroMs56xxCompensatePressure(const baroMs56xxCompensation_t * comp, uint32_t rawPressure);
+
+// BMP280 / BME280, 64-bit integer formulas from the datasheet. Layout matches the calibration registers.
+typedef struct baroBmp280Calibration_s {
+    uint16_t dig_T1;
+    int16_t dig_T2;
+    int16_t dig_T3;
+    uint16_t dig_P1;
+    int16_t dig_P2;
+    int16_t dig_P3;
+    int16_t dig_P4;
+    int16_t dig_P5;
+    int16_t dig_P6;
+    int16_t dig_P7;
+    int16_t dig_P8;
+    int16_t dig_P9;
+} baroBmp280Calibration_t;
+
+typedef struct baroBmp280Compensation_s {
+    const baroBmp280Calibration_t * cal;
+    int64_t var1;           // Pressure terms depending on t_fine only
+    int64_t var2;
+    int32_t temperature;
+} baroBmp280Compensation_t;
+
+void baroBmp280CompensateTemperature(baroBmp280Compensation_t * comp, const baroBmp280Calibration_t * cal, int32_t rawTemperature);
+int32_t baroBmp280CompensatePressure(const baroBmp280Compensation_t * comp, int32_t rawPressure);
+
+// DPS310 / SPL06, the two share the same calibration polynomial and raw value scaling
+typedef struct baroDpsCalibration_s {
+    int16_t c0;     // 12bit
+    int16_t c1;     // 12bit
+    int32_t c00;    // 20bit
+    int32_t c10;    // 20bit
+    int16_t c01;    // 16bit
+    int16_t c11;    // 16bit
+    int16_t c20;    // 16bit
+    int16_t c21;    // 16bit
+    int16_t c30;    // 16bit
+} baroDpsCalibration_t;
+
+typedef struct baroDpsCompensation_s {
+    int64_t a[4];           // Pressure polynomial with the temperature terms folded in, Q8 Pa
+    int32_t temperature;
+} baroDpsCompensation_t;
+
+void baroDpsCompensateTemperature(baroDpsCompensation_t * comp, const baroDpsCalibration_t * cal, int32_t rawTemperature, uint8_t oversampling);
+int32_t baroDpsCompensatePressure(const baroDpsCompensation_t * comp, int32_t rawPressure, uint8_t oversampling);
@@ -36,6 +36,7 @@
 #include "drivers/bus.h"
 #include "drivers/time.h"
 #include "drivers/barometer/barometer.h"
+#include "drivers/barometer/barometer_compensation.h"
 #include "drivers/barometer/barometer_dps310.h"
 
 // See datasheet at https://www.infineon.com/dgdl/Infineon-DPS310-DataSheet-v01_02-EN.pdf?fileId=5546d462576f34750157750826c42242
@@ -86,22 +87,14 @@
 
 #define DPS310_COEF_SRCE_BIT_TMP_COEF_SRCE  (0x80)
 
-typedef struct {
-    int16_t c0;     // 12bit
-    int16_t c1;     // 12bit
-    int32_t c00;    // 20bit
-    int32_t c10;    // 20bit
-    int16_t c01;    // 16bit
-    int16_t c11;    // 16bit
-    int16_t c20;    // 16bit
-    int16_t c21;    // 16bit
-    int16_t c30;    // 16bit
-} calibrationCoefficients_t;
+#define DPS310_OVERSAMPLING                 16      // Pressure and temperature, matches *_PRC_16 above
 
 typedef struct {
-    calibrationCoefficients_t   calib;
-    float                       pressure;       // Pa
-    float                       temperature;    // DegC
+    baroDpsCalibration_t        calib;
+    baroDpsCompensation_t       comp;
+    int32_t                     compTraw;       // Raw temperature the compensation was computed for
+    int32_t                     pressure;       // Pa
+    int32_t                     temperature;    // centidegrees
 } baroState_t;
 
 static baroState_t  baroState;
@@ -199,6 +192,8 @@ static bool deviceConfigure(busDevice_t * busDev)
     // 0x20 c30 [15:8] + 0x21 c30 [7:0]
     baroState.calib.c30 = getTwosComplement(((uint32_t)coef[16] << 8) | (uint32_t)coef[17], 16);
 
+    baroState.compTraw = INT32_MIN;
+
     // MEAS_CFG: Make sure the device is in IDLE mode
     registerWriteBits(busDev, DPS310_REG_MEAS_CFG, DPS310_MEAS_CFG_MEAS_CTRL_MASK, DPS310_MEAS_CFG_MEAS_IDLE);
 
@@ -238,12 +233,7 @@ static bool deviceReadMeasurement(baroDev_t *baro)
         return false;
     }
 
-    // 2. Choose scaling factors kT (for temperature) and kP (for pressure) based on the chosen precision rate.
-    // The scaling factors are listed in Table 9.
-    static float kT = 253952; // 16 times (Standard)
-    static float kP = 253952; // 16 times (Standard)
-
-    // 3. Read the pressure and temperature result from the registers
+    // 2. Read the pressure and temperature result from the registers
     // Read PSR_B2, PSR_B1, PSR_B0, TMP_B2, TMP_B1, TMP_B0
     uint8_t buf[6];
     if (!busReadBuf(baro->busDev, DPS310_REG_PSR_B2, buf, 6)) {
@@ -253,27 +243,15 @@ static bool deviceReadMeasurement(baroDev_t *baro)
     const int32_t Praw = getTwosComplement((buf[0] << 16) + (buf[1] << 8) + buf[2], 24);
     const int32_t Traw = getTwosComplement((buf[3] << 16) + (buf[4] << 8) + buf[5], 24);
 
-    // 4. Calculate scaled measurement results.
-    const float Praw_sc = Praw / kP;
-    const float Traw_sc = Traw / kT;
-
-    // 5. Calculate compensated measurement results.
-    const float c00 = baroState.calib.c00;
-    const float c01 = baroState.calib.c01;
-    const float c10 = baroState.calib.c10;
-    const float c11 = baroState.calib.c11;
-    const float c20 = baroState.calib.c20;
-    const float c21 = baroState.calib.c21;
-    const float c30 = baroState.calib.c30;
-
-    // See section 4.9.1, How to Calculate Compensated Pressure Values, of datasheet
-    baroState.pressure = c00 + Praw_sc * (c10 + Praw_sc * (c20 + Praw_sc * c30)) + Traw_sc * c01 + Traw_sc * Praw_sc * (c11 + Praw_sc * c21);
+    // 3. Calculate compensated measurement results, see section 4.9 of datasheet.
+    // Temperature dependent terms are only recalculated when temperature changes.
+    if (Traw != baroState.compTraw) {
+        baroDpsCompensateTemperature(&baroState.comp, &baroState.calib, Traw, DPS310_OVERSAMPLING);
+        baroState.compTraw = Traw;
+    }
 
-    const float c0 = baroState.calib.c0;
-    const float c1 = baroState.calib.c1;
-    
-    // See section 4.9.2, How to Calculate Compensated Temperature Values, of datasheet
-    baroState.temperature = c0 * 0.5f + c1 * Traw_sc;
+    baroState.pressure = baroDpsCompensatePressure(&baroState.comp, Praw, DPS310_OVERSAMPLING);
+    baroState.temperature = baroState.comp.temperature;
 
     return true;
 }
@@ -287,7 +265,7 @@ static bool deviceCalculate(baroDev_t *baro, int32_t *pressure, int32_t *tempera
     }
 
     if (temperature) {
-        *temperature = (baroState.temperature * 100);   // to centidegrees
+        *temperature = baroState.temperature;
     }
 
     return true;
@@ -27,6 +27,7 @@
 #include "drivers/bus.h"
 #include "drivers/time.h"
 #include "drivers/barometer/barometer.h"
+#include "drivers/barometer/barometer_compensation.h"
 #include "drivers/barometer/barometer_ms56xx.h"
 
 #if defined(USE_BARO_MS5607) || defined(USE_BARO_MS5611)
@@ -45,12 +46,14 @@
 #define CMD_ADC_2048            0x06 // ADC OSR=2048
 #define CMD_ADC_4096            0x08 // ADC OSR=4096
 #define CMD_PROM_RD             0xA0 // Prom read command
-#define PROM_NB                 8
+#define PROM_NB                 BARO_MS56XX_PROM_SIZE
 
 STATIC_UNIT_TESTED uint32_t ms56xx_ut;  // static result of temperature measurement
 STATIC_UNIT_TESTED uint32_t ms56xx_up;  // static result of pressure measurement
 STATIC_UNIT_TESTED uint16_t ms56xx_c[PROM_NB];  // on-chip ROM
 static uint8_t ms56xx_osr = CMD_ADC_4096;
+static bool ms56xx_is_ms5607;
+static baroMs56xxCompensation_t ms56xx_comp;
 
 STATIC_UNIT_TESTED int8_t ms56xx_crc(uint16_t *prom)
 {
@@ -97,6 +100,9 @@ static bool ms56xx_start_ut(baroDev_t *baro)
 static bool ms56xx_get_ut(baroDev_t *baro)
 {
     ms56xx_ut = ms56xx_read_adc(baro);
+
+    // Temperature dependent part of the compensation is only redone when temperature is read
+    baroMs56xxCompensateTemperature(&ms56xx_comp, ms56xx_c, ms56xx_is_ms5607, ms56xx_ut);
     return true;
 }
 
@@ -111,77 +117,17 @@ static bool ms56xx_get_up(baroDev_t *baro)
     return true;
 }
 
-#ifdef USE_BARO_MS5611
-STATIC_UNIT_TESTED bool ms5611_calculate(baroDev_t *baro, int32_t *pressure, int32_t *temperature)
-{
-    UNUSED(baro);
-    uint32_t press;
-    int64_t temp;
-    int64_t delt;
-    int64_t dT = (int64_t)ms56xx_ut - ((uint64_t)ms56xx_c[5] * 256);
-    int64_t off = ((int64_t)ms56xx_c[2] << 16) + (((int64_t)ms56xx_c[4] * dT) >> 7);
-    int64_t sens = ((int64_t)ms56xx_c[1] << 15) + (((int64_t)ms56xx_c[3] * dT) >> 8);
-    temp = 2000 + ((dT * (int64_t)ms56xx_c[6]) >> 23);
-
-    if (temp < 2000) { // temperature lower than 20degC
-        delt = temp - 2000;
-        delt = 5 * delt * delt;
-        off -= delt >> 1;
-        sens -= delt >> 2;
-        if (temp < -1500) { // temperature lower than -15degC
-            delt = temp + 1500;
-            delt = delt * delt;
-            off -= 7 * delt;
-            sens -= (11 * delt) >> 1;
-        }
-    temp -= ((dT * dT) >> 31);
-    }
-    press = ((((int64_t)ms56xx_up * sens) >> 21) - off) >> 15;
-
-    if (pressure)
-        *pressure = press;
-    if (temperature)
-        *temperature = temp;
-
-    return true;
-}
-#endif
-
-#ifdef USE_BARO_MS5607
-STATIC_UNIT_TESTED bool ms5607_calculate(baroDev_t *baro, int32_t *pressure, int32_t *temperature)
+static bool ms56xx_calculate(baroDev_t *baro, int32_t *pressure, int32_t *temperature)
 {
     UNUSED(baro);
-    uint32_t press;
-    int64_t temp;
-    int64_t delt;
-    int64_t dT = (int64_t)ms56xx_ut - ((uint64_t)ms56xx_c[5] << 8);
-    int64_t off = ((int64_t)ms56xx_c[2] << 17) + (((int64_t)ms56xx_c[4] * dT) >> 6);
-    int64_t sens = ((int64_t)ms56xx_c[1] << 16) + (((int64_t)ms56xx_c[3] * dT) >> 7);
-    temp = 2000 + ((dT * (int64_t)ms56xx_c[6]) >> 23);
-
-    if (temp < 2000) { // temperature lower than 20degC
-        delt = temp - 2000;
-        delt = delt * delt;
-        off -= (61 * delt) >> 4;
-        sens -= 2 * delt;
-        if (temp < -1500) { // temperature lower than -15degC
-            delt = temp + 1500;
-            delt = delt * delt;
-            off -= 15 * delt;
-            sens -= 8 * delt;
-        }
-        temp -= ((dT * dT) >> 31);
-    }
-    press = ((((int64_t)ms56xx_up * sens) >> 21) - off) >> 15;
 
     if (pressure)
-        *pressure = press;
+        *pressure = baroMs56xxCompensatePressure(&ms56xx_comp, ms56xx_up);
     if (temperature)
-        *temperature = temp;
+        *temperature = ms56xx_comp.temperature;
 
     return true;
 }
-#endif
 
 #define DETECTION_MAX_RETRY_COUNT   5
 static bool deviceDetect(busDevice_t * dev)
@@ -247,7 +193,8 @@ bool ms5607Detect(baroDev_t *baro)
         return false;
     }
 
-    baro->calculate = ms5607_calculate;
+    ms56xx_is_ms5607 = true;
+    baro->calculate = ms56xx_calculate;
 
     return true;
 }
@@ -271,7 +218,8 @@ bool ms5611Detect(baroDev_t *baro)
         return false;
     }
 
-    baro->calculate = ms5611_calculate;
+    ms56xx_is_ms5607 = false;
+    baro->calculate = ms56xx_calculate;
 
     return true;
 }
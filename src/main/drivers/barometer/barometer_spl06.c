@@ -27,26 +27,15 @@
 #include "drivers/io.h"
 #include "drivers/bus.h"
 #include "drivers/barometer/barometer.h"
+#include "drivers/barometer/barometer_compensation.h"
 #include "drivers/barometer/barometer_spl06.h"
 
 #if defined(USE_BARO_SPL06)
 
 // SPL06, address 0x76
 
-typedef struct {
-    int16_t c0;
-    int16_t c1;
-    int32_t c00;
-    int32_t c10;
-    int16_t c01;
-    int16_t c11;
-    int16_t c20;
-    int16_t c21;
-    int16_t c30;
-} spl06_coeffs_t;
-
-
-spl06_coeffs_t spl06_cal;
+baroDpsCalibration_t spl06_cal;
+static baroDpsCompensation_t spl06_comp;
 // uncompensated pressure and temperature
 static int32_t spl06_pressure_raw = 0;
 static int32_t spl06_temperature_raw = 0;
@@ -67,22 +56,6 @@ static int8_t spl06_samples_to_cfg_reg_value(uint8_t sample_rate)
     }
 }
 
-static int32_t spl06_raw_value_scale_factor(uint8_t oversampling_rate)
-{
-    switch(oversampling_rate)
-    {
-        case 1: return 524288;
-        case 2: return 1572864;
-        case 4: return 3670016;
-        case 8: return 7864320;
-        case 16: return 253952;
-        case 32: return 516096;
-        case 64: return 1040384;
-        case 128: return 2088960;
-        default: return -1; // invalid
-    }
-}
-
 static bool spl06_start_temperature_measurement(baroDev_t * baro)
 {
     return busWrite(baro->busDev, SPL06_MODE_AND_STATUS_REG, SPL06_MEAS_TEMPERATURE);
@@ -98,6 +71,9 @@ static bool spl06_read_temperature(baroDev_t * baro)
     if (ack) {
         spl06_temperature = (int32_t)((data[0] & 0x80 ? 0xFF000000 : 0) | (((uint32_t)(data[0])) << 16) | (((uint32_t)(data[1])) << 8) | ((uint32_t)data[2]));
         spl06_temperature_raw = spl06_temperature;
+
+        // Temperature dependent part of the compensation is only redone when temperature is read
+        baroDpsCompensateTemperature(&spl06_comp, &spl06_cal, spl06_temperature_raw, SPL06_TEMPERATURE_OVERSAMPLING);
     }
 
     return ack;
@@ -123,36 +99,16 @@ static bool spl06_read_pressure(baroDev_t * baro)
     return ack;
 }
 
-// Returns temperature in degrees centigrade
-static float spl06_compensate_temperature(int32_t temperature_raw)
-{
-    const float t_raw_sc = (float)temperature_raw / spl06_raw_value_scale_factor(SPL06_TEMPERATURE_OVERSAMPLING);
-    const float temp_comp = (float)spl06_cal.c0 / 2 + t_raw_sc * spl06_cal.c1;
-    return temp_comp;
-}
-
-// Returns pressure in Pascal
-static float spl06_compensate_pressure(int32_t pressure_raw, int32_t temperature_raw)
-{
-    const float p_raw_sc = (float)pressure_raw / spl06_raw_value_scale_factor(SPL06_PRESSURE_OVERSAMPLING);
-    const float t_raw_sc = (float)temperature_raw / spl06_raw_value_scale_factor(SPL06_TEMPERATURE_OVERSAMPLING);
-
-    const float pressure_cal = (float)spl06_cal.c00 + p_raw_sc * ((float)spl06_cal.c10 + p_raw_sc * ((float)spl06_cal.c20 + p_raw_sc * spl06_cal.c30));
-    const float p_temp_comp = t_raw_sc * ((float)spl06_cal.c01 + p_raw_sc * ((float)spl06_cal.c11 + p_raw_sc * spl06_cal.c21));
-
-    return pressure_cal + p_temp_comp;
-}
-
 bool spl06_calculate(baroDev_t * baro, int32_t * pressure, int32_t * temperature)
 {
     UNUSED(baro);
 
     if (pressure) {
-        *pressure = lrintf(spl06_compensate_pressure(spl06_pressure_raw, spl06_temperature_raw));
+        *pressure = baroDpsCompensatePressure(&spl06_comp, spl06_pressure_raw, SPL06_PRESSURE_OVERSAMPLING);
     }
 
     if (temperature) {
-        *temperature = lrintf(spl06_compensate_temperature(spl06_temperature_raw) * 100);
+        *temperature = spl06_comp.temperature;
     }
 
     return true;
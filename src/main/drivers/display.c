@@ -91,6 +91,7 @@ void displayClearScreen(displayPort_t *instance)
 {
     instance->vTable->clearScreen(instance);
     instance->cleared = true;
+    instance->clearCount++;
     instance->cursorRow = -1;
 }
 
@@ -298,6 +299,9 @@ void displayCommitTransaction(displayPort_t *instance)
 bool displayGetCanvas(displayCanvas_t *canvas, const displayPort_t *instance)
 {
 #if defined(USE_CANVAS)
+    if (canvas) {
+        canvas->regions = NULL;
+    }
     if (canvas && instance->vTable->getCanvas && instance->vTable->getCanvas(canvas, instance)) {
         canvas->gridElementWidth = canvas->width / instance->cols;
         canvas->gridElementHeight = canvas->height / instance->rows;
@@ -316,6 +320,7 @@ void displayInit(displayPort_t *instance, const displayPortVTable_t *vTable)
     instance->vTable->clearScreen(instance);
     instance->useFullscreen = false;
     instance->cleared = true;
+    instance->clearCount = 0;
     instance->grabCount = 0;
     instance->cursorRow = -1;
     instance->cachedSupportedTextAttributes = TEXT_ATTRIBUTES_NONE;
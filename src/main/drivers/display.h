@@ -84,6 +84,7 @@ typedef struct displayPort_s {
     // CMS state
     bool useFullscreen;
     bool cleared;
+    uint8_t clearCount;         // Incremented on every clear, lets clients tell their content is gone
     int8_t cursorRow;
     int8_t grabCount;
     textAttributes_t cachedSupportedTextAttributes;
@@ -24,7 +24,10 @@
  * @author Alberto Garcia Hierro <alberto@garciahierro.com>
  */
 
+#include <string.h>
+
 #include "drivers/display_canvas.h"
+#include "drivers/time.h"
 
 void displayCanvasSetStrokeColor(displayCanvas_t *displayCanvas, displayCanvasColor_e color)
 {
@@ -278,3 +281,324 @@ bool displayCanvasGetWidgets(displayWidgets_t *widgets, const displayCanvas_t *d
 {
     return displayCanvas && displayCanvas->vTable->getWidgets ? displayCanvas->vTable->getWidgets(widgets, displayCanvas) : false;
 }
+
+// Region hashing: a vtable which folds every command into the hash
+// pointed by the device field instead of drawing it.
+
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+typedef enum {
+    HASH_OP_SET_STROKE_COLOR = 1,
+    HASH_OP_SET_FILL_COLOR,
+    HASH_OP_SET_STROKE_AND_FILL_COLOR,
+    HASH_OP_SET_COLOR_INVERSION,
+    HASH_OP_SET_PIXEL,
+    HASH_OP_SET_PIXEL_TO_STROKE_COLOR,
+    HASH_OP_SET_PIXEL_TO_FILL_COLOR,
+    HASH_OP_SET_STROKE_WIDTH,
+    HASH_OP_SET_LINE_OUTLINE_TYPE,
+    HASH_OP_SET_LINE_OUTLINE_COLOR,
+    HASH_OP_CLIP_TO_RECT,
+    HASH_OP_CLEAR_RECT,
+    HASH_OP_RESET_DRAWING_STATE,
+    HASH_OP_DRAW_CHARACTER,
+    HASH_OP_DRAW_CHARACTER_MASK,
+    HASH_OP_DRAW_STRING,
+    HASH_OP_DRAW_STRING_MASK,
+    HASH_OP_MOVE_TO_POINT,
+    HASH_OP_STROKE_LINE_TO_POINT,
+    HASH_OP_STROKE_TRIANGLE,
+    HASH_OP_FILL_TRIANGLE,
+    HASH_OP_FILL_STROKE_TRIANGLE,
+    HASH_OP_STROKE_RECT,
+    HASH_OP_FILL_RECT,
+    HASH_OP_FILL_STROKE_RECT,
+    HASH_OP_STROKE_ELLIPSE_IN_RECT,
+    HASH_OP_FILL_ELLIPSE_IN_RECT,
+    HASH_OP_FILL_STROKE_ELLIPSE_IN_RECT,
+    HASH_OP_CTM_RESET,
+    HASH_OP_CTM_SET,
+    HASH_OP_CTM_TRANSLATE,
+    HASH_OP_CTM_SCALE,
+    HASH_OP_CTM_ROTATE,
+    HASH_OP_CONTEXT_PUSH,
+    HASH_OP_CONTEXT_POP,
+} displayCanvasHashOp_e;
+
+static void hashBytes(displayCanvas_t *displayCanvas, const void *data, size_t size)
+{
+    uint32_t *hash = displayCanvas->device;
+    const uint8_t *ptr = data;
+
+    for (size_t ii = 0; ii < size; ii++) {
+        *hash = (*hash ^ ptr[ii]) * FNV_PRIME;
+    }
+}
+
+static void hashInts(displayCanvas_t *displayCanvas, displayCanvasHashOp_e op, int a, int b, int c, int d, int e, int f)
+{
+    const int32_t values[] = { op, a, b, c, d, e, f };
+    hashBytes(displayCanvas, values, sizeof(values));
+}
+
+static void hashFloats(displayCanvas_t *displayCanvas, displayCanvasHashOp_e op, float a, float b, float c, float d, float e, float f)
+{
+    const float values[] = { a, b, c, d, e, f };
+    hashInts(displayCanvas, op, 0, 0, 0, 0, 0, 0);
+    hashBytes(displayCanvas, values, sizeof(values));
+}
+
+static void hashString(displayCanvas_t *displayCanvas, displayCanvasHashOp_e op, int x, int y, const char *s, int color, int opts)
+{
+    hashInts(displayCanvas, op, x, y, color, opts, 0, 0);
+    hashBytes(displayCanvas, s, strlen(s));
+}
+
+static void hashSetStrokeColor(displayCanvas_t *displayCanvas, displayCanvasColor_e color)
+{
+    hashInts(displayCanvas, HASH_OP_SET_STROKE_COLOR, color, 0, 0, 0, 0, 0);
+}
+
+static void hashSetFillColor(displayCanvas_t *displayCanvas, displayCanvasColor_e color)
+{
+    hashInts(displayCanvas, HASH_OP_SET_FILL_COLOR, color, 0, 0, 0, 0, 0);
+}
+
+static void hashSetStrokeAndFillColor(displayCanvas_t *displayCanvas, displayCanvasColor_e color)
+{
+    hashInts(displayCanvas, HASH_OP_SET_STROKE_AND_FILL_COLOR, color, 0, 0, 0, 0, 0);
+}
+
+static void hashSetColorInversion(displayCanvas_t *displayCanvas, bool inverted)
+{
+    hashInts(displayCanvas, HASH_OP_SET_COLOR_INVERSION, inverted, 0, 0, 0, 0, 0);
+}
+
+static void hashSetPixel(displayCanvas_t *displayCanvas, int x, int y, displayCanvasColor_e color)
+{
+    hashInts(displayCanvas, HASH_OP_SET_PIXEL, x, y, color, 0, 0, 0);
+}
+
+static void hashSetPixelToStrokeColor(displayCanvas_t *displayCanvas, int x, int y)
+{
+    hashInts(displayCanvas, HASH_OP_SET_PIXEL_TO_STROKE_COLOR, x, y, 0, 0, 0, 0);
+}
+
+static void hashSetPixelToFillColor(displayCanvas_t *displayCanvas, int x, int y)
+{
+    hashInts(displayCanvas, HASH_OP_SET_PIXEL_TO_FILL_COLOR, x, y, 0, 0, 0, 0);
+}
+
+static void hashSetStrokeWidth(displayCanvas_t *displayCanvas, unsigned w)
+{
+    hashInts(displayCanvas, HASH_OP_SET_STROKE_WIDTH, w, 0, 0, 0, 0, 0);
+}
+
+static void hashSetLineOutlineType(displayCanvas_t *displayCanvas, displayCanvasOutlineType_e outlineType)
+{
+    hashInts(displayCanvas, HASH_OP_SET_LINE_OUTLINE_TYPE, outlineType, 0, 0, 0, 0, 0);
+}
+
+static void hashSetLineOutlineColor(displayCanvas_t *displayCanvas, displayCanvasColor_e outlineColor)
+{
+    hashInts(displayCanvas, HASH_OP_SET_LINE_OUTLINE_COLOR, outlineColor, 0, 0, 0, 0, 0);
+}
+
+static void hashClipToRect(displayCanvas_t *displayCanvas, int x, int y, int w, int h)
+{
+    hashInts(displayCanvas, HASH_OP_CLIP_TO_RECT, x, y, w, h, 0, 0);
+}
+
+static void hashClearRect(displayCanvas_t *displayCanvas, int x, int y, int w, int h)
+{
+    hashInts(displayCanvas, HASH_OP_CLEAR_RECT, x, y, w, h, 0, 0);
+}
+
+static void hashResetDrawingState(displayCanvas_t *displayCanvas)
+{
+    hashInts(displayCanvas, HASH_OP_RESET_DRAWING_STATE, 0, 0, 0, 0, 0, 0);
+}
+
+static void hashDrawCharacter(displayCanvas_t *displayCanvas, int x, int y, uint16_t chr, displayCanvasBitmapOption_t opts)
+{
+    hashInts(displayCanvas, HASH_OP_DRAW_CHARACTER, x, y, chr, opts, 0, 0);
+}
+
+static void hashDrawCharacterMask(displayCanvas_t *displayCanvas, int x, int y, uint16_t chr, displayCanvasColor_e color, displayCanvasBitmapOption_t opts)
+{
+    hashInts(displayCanvas, HASH_OP_DRAW_CHARACTER_MASK, x, y, chr, color, opts, 0);
+}
+
+static void hashDrawString(displayCanvas_t *displayCanvas, int x, int y, const char *s, displayCanvasBitmapOption_t opts)
+{
+    hashString(displayCanvas, HASH_OP_DRAW_STRING, x, y, s, 0, opts);
+}
+
+static void hashDrawStringMask(displayCanvas_t *displayCanvas, int x, int y, const char *s, displayCanvasColor_e color, displayCanvasBitmapOption_t opts)
+{
+    hashString(displayCanvas, HASH_OP_DRAW_STRING_MASK, x, y, s, color, opts);
+}
+
+static void hashMoveToPoint(displayCanvas_t *displayCanvas, int x, int y)
+{
+    hashInts(displayCanvas, HASH_OP_MOVE_TO_POINT, x, y, 0, 0, 0, 0);
+}
+
+static void hashStrokeLineToPoint(displayCanvas_t *displayCanvas, int x, int y)
+{
+    hashInts(displayCanvas, HASH_OP_STROKE_LINE_TO_POINT, x, y, 0, 0, 0, 0);
+}
+
+static void hashStrokeTriangle(displayCanvas_t *displayCanvas, int x1, int y1, int x2, int y2, int x3, int y3)
+{
+    hashInts(displayCanvas, HASH_OP_STROKE_TRIANGLE, x1, y1, x2, y2, x3, y3);
+}
+
+static void hashFillTriangle(displayCanvas_t *displayCanvas, int x1, int y1, int x2, int y2, int x3, int y3)
+{
+    hashInts(displayCanvas, HASH_OP_FILL_TRIANGLE, x1, y1, x2, y2, x3, y3);
+}
+
+static void hashFillStrokeTriangle(displayCanvas_t *displayCanvas, int x1, int y1, int x2, int y2, int x3, int y3)
+{
+    hashInts(displayCanvas, HASH_OP_FILL_STROKE_TRIANGLE, x1, y1, x2, y2, x3, y3);
+}
+
+static void hashStrokeRect(displayCanvas_t *displayCanvas, int x, int y, int w, int h)
+{
+    hashInts(displayCanvas, HASH_OP_STROKE_RECT, x, y, w, h, 0, 0);
+}
+
+static void hashFillRect(displayCanvas_t *displayCanvas, int x, int y, int w, int h)
+{
+    hashInts(displayCanvas, HASH_OP_FILL_RECT, x, y, w, h, 0, 0);
+}
+
+static void hashFillStrokeRect(displayCanvas_t *displayCanvas, int x, int y, int w, int h)
+{
+    hashInts(displayCanvas, HASH_OP_FILL_STROKE_RECT, x, y, w, h, 0, 0);
+}
+
+static void hashStrokeEllipseInRect(displayCanvas_t *displayCanvas, int x, int y, int w, int h)
+{
+    hashInts(displayCanvas, HASH_OP_STROKE_ELLIPSE_IN_RECT, x, y, w, h, 0, 0);
+}
+
+static void hashFillEllipseInRect(displayCanvas_t *displayCanvas, int x, int y, int w, int h)
+{
+    hashInts(displayCanvas, HASH_OP_FILL_ELLIPSE_IN_RECT, x, y, w, h, 0, 0);
+}
+
+static void hashFillStrokeEllipseInRect(displayCanvas_t *displayCanvas, int x, int y, int w, int h)
+{
+    hashInts(displayCanvas, HASH_OP_FILL_STROKE_ELLIPSE_IN_RECT, x, y, w, h, 0, 0);
+}
+
+static void hashCtmReset(displayCanvas_t *displayCanvas)
+{
+    hashInts(displayCanvas, HASH_OP_CTM_RESET, 0, 0, 0, 0, 0, 0);
+}
+
+static void hashCtmSet(displayCanvas_t *displayCanvas, float m11, float m12, float m21, float m22, float m31, float m32)
+{
+    hashFloats(displayCanvas, HASH_OP_CTM_SET, m11, m12, m21, m22, m31, m32);
+}
+
+static void hashCtmTranslate(displayCanvas_t *displayCanvas, float tx, float ty)
+{
+    hashFloats(displayCanvas, HASH_OP_CTM_TRANSLATE, tx, ty, 0, 0, 0, 0);
+}
+
+static void hashCtmScale(displayCanvas_t *displayCanvas, float sx, float sy)
+{
+    hashFloats(displayCanvas, HASH_OP_CTM_SCALE, sx, sy, 0, 0, 0, 0);
+}
+
+static void hashCtmRotate(displayCanvas_t *displayCanvas, float r)
+{
+    hashFloats(displayCanvas, HASH_OP_CTM_ROTATE, r, 0, 0, 0, 0, 0);
+}
+
+static void hashContextPush(displayCanvas_t *displayCanvas)
+{
+    hashInts(displayCanvas, HASH_OP_CONTEXT_PUSH, 0, 0, 0, 0, 0, 0);
+}
+
+static void hashContextPop(displayCanvas_t *displayCanvas)
+{
+    hashInts(displayCanvas, HASH_OP_CONTEXT_POP, 0, 0, 0, 0, 0, 0);
+}
+
+static const displayCanvasVTable_t hashVTable = {
+    .setStrokeColor = hashSetStrokeColor,
+    .setFillColor = hashSetFillColor,
+    .setStrokeAndFillColor = hashSetStrokeAndFillColor,
+    .setColorInversion = hashSetColorInversion,
+    .setPixel = hashSetPixel,
+    .setPixelToStrokeColor = hashSetPixelToStrokeColor,
+    .setPixelToFillColor = hashSetPixelToFillColor,
+    .setStrokeWidth = hashSetStrokeWidth,
+    .setLineOutlineType = hashSetLineOutlineType,
+    .setLineOutlineColor = hashSetLineOutlineColor,
+
+    .clipToRect = hashClipToRect,
+    .clearRect = hashClearRect,
+    .resetDrawingState = hashResetDrawingState,
+    .drawCharacter = hashDrawCharacter,
+    .drawCharacterMask = hashDrawCharacterMask,
+    .drawString = hashDrawString,
+    .drawStringMask = hashDrawStringMask,
+    .moveToPoint = hashMoveToPoint,
+    .strokeLineToPoint = hashStrokeLineToPoint,
+    .strokeTriangle = hashStrokeTriangle,
+    .fillTriangle = hashFillTriangle,
+    .fillStrokeTriangle = hashFillStrokeTriangle,
+    .strokeRect = hashStrokeRect,
+    .fillRect = hashFillRect,
+    .fillStrokeRect = hashFillStrokeRect,
+    .strokeEllipseInRect = hashStrokeEllipseInRect,
+    .fillEllipseInRect = hashFillEllipseInRect,
+    .fillStrokeEllipseInRect = hashFillStrokeEllipseInRect,
+
+    .ctmReset = hashCtmReset,
+    .ctmSet = hashCtmSet,
+    .ctmTranslate = hashCtmTranslate,
+    .ctmScale = hashCtmScale,
+    .ctmRotate = hashCtmRotate,
+
+    .contextPush = hashContextPush,
+    .contextPop = hashContextPop,
+
+    .getWidgets = NULL,
+};
+
+void displayCanvasDrawRegion(displayCanvas_t *displayCanvas, unsigned region, uint32_t seed, displayCanvasRegionDrawFn draw, const void *ctx)
+{
+    displayCanvasRegionCache_t *regions = displayCanvas->regions;
+
+    if (!regions || region >= DISPLAY_CANVAS_REGION_COUNT) {
+        draw(displayCanvas, ctx);
+        return;
+    }
+
+    // Run the drawing code once without sending anything, just to fingerprint it
+    uint32_t hash = FNV_OFFSET_BASIS;
+    displayCanvas_t hashCanvas = *displayCanvas;
+    hashCanvas.vTable = &hashVTable;
+    hashCanvas.device = &hash;
+    hashCanvas.regions = NULL;
+    hashBytes(&hashCanvas, &seed, sizeof(seed));
+    draw(&hashCanvas, ctx);
+
+    const timeMs_t now = millis();
+    if (hash == regions->hashes[region] && now - regions->sentAt[region] < DISPLAY_CANVAS_REGION_MAX_AGE_MS) {
+        regions->skipped++;
+        return;
+    }
+
+    draw(displayCanvas, ctx);
+    displayCanvasResetDrawingState(displayCanvas);
+    regions->hashes[region] = hash;
+    regions->sentAt[region] = now;
+}
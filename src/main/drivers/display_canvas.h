@@ -29,6 +29,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "common/time.h"
+
 typedef struct displayWidgets_s displayWidgets_t;
 
 typedef enum {
@@ -54,9 +56,21 @@ typedef enum {
 
 typedef struct displayCanvasVTable_s displayCanvasVTable_t;
 
+#define DISPLAY_CANVAS_REGION_COUNT 4
+#define DISPLAY_CANVAS_REGION_MAX_AGE_MS 1000   // Unchanged regions are still sent at this interval, in case a frame was lost
+
+// Drivers that pay for every command sent to the device can provide this to skip
+// regions whose drawing commands are the same as the last time they were sent.
+typedef struct displayCanvasRegionCache_s {
+    uint32_t hashes[DISPLAY_CANVAS_REGION_COUNT];
+    timeMs_t sentAt[DISPLAY_CANVAS_REGION_COUNT];
+    uint32_t skipped;
+} displayCanvasRegionCache_t;
+
 typedef struct displayCanvas_s {
     const displayCanvasVTable_t *vTable;
     void *device;
+    displayCanvasRegionCache_t *regions;
     uint16_t width;
     uint16_t height;
     uint8_t gridElementWidth;
@@ -146,3 +160,10 @@ void displayCanvasContextPush(displayCanvas_t *displayCanvas);
 void displayCanvasContextPop(displayCanvas_t *displayCanvas);
 
 bool displayCanvasGetWidgets(displayWidgets_t *widgets, const displayCanvas_t *displayCanvas);
+
+typedef void (*displayCanvasRegionDrawFn)(displayCanvas_t *displayCanvas, const void *ctx);
+
+// Draws a region with the given function, which must issue the same commands for the same ctx.
+// If the canvas has a region cache and the commands (and seed) didn't change since the last time
+// the region was sent, nothing is sent. Otherwise the drawing state is reset after the region.
+void displayCanvasDrawRegion(displayCanvas_t *displayCanvas, unsigned region, uint32_t seed, displayCanvasRegionDrawFn draw, const void *ctx);
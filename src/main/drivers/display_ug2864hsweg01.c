@@ -24,6 +24,8 @@
 
 #ifdef USE_OLED_UG2864
 
+#include "common/maths.h"
+
 #include "drivers/bus.h"
 #include "drivers/bus_i2c.h"
 #include "drivers/time.h"
@@ -176,6 +178,14 @@ static const uint8_t multiWiiFont[][5] = { // Refer to "Times New Roman" Font Da
 
 static busDevice_t *busDev = NULL;
 
+static struct {
+    uint8_t data[SCREEN_PAGE_COUNT][SCREEN_WIDTH];
+    uint8_t dirtyMin[SCREEN_PAGE_COUNT];   // Changed columns of each page since the last flush
+    uint8_t dirtyMax[SCREEN_PAGE_COUNT];
+    uint8_t page;
+    uint8_t col;
+} fb;
+
 static bool i2c_OLED_send_cmd(uint8_t command)
 {
     if (!busDev) {
@@ -185,13 +195,67 @@ static bool i2c_OLED_send_cmd(uint8_t command)
     return busWrite(busDev, 0x80, command);
 }
 
+/*
+ * Everything is drawn into a local copy of the display RAM. i2c_OLED_flush()
+ * then sends the changed span of each page as a single bus transfer, instead
+ * of one transfer per byte.
+ */
+static void i2c_OLED_fb_write(uint8_t val)
+{
+    uint8_t *cell = &fb.data[fb.page][fb.col];
+
+    if (*cell != val) {
+        *cell = val;
+        fb.dirtyMin[fb.page] = MIN(fb.dirtyMin[fb.page], fb.col);
+        fb.dirtyMax[fb.page] = MAX(fb.dirtyMax[fb.page], fb.col);
+    }
+
+    // Horizontal addressing mode, wrap to the next page
+    if (++fb.col == SCREEN_WIDTH) {
+        fb.col = 0;
+        fb.page = (fb.page + 1) % SCREEN_PAGE_COUNT;
+    }
+}
+
+static void i2c_OLED_fb_reset(void)
+{
+    memset(fb.data, 0, sizeof(fb.data));
+    for (int page = 0; page < SCREEN_PAGE_COUNT; page++) {
+        fb.dirtyMin[page] = SCREEN_WIDTH;
+        fb.dirtyMax[page] = 0;
+    }
+    fb.page = 0;
+    fb.col = 0;
+}
+
 bool i2c_OLED_send_byte(uint8_t val)
 {
     if (!busDev) {
         return false;
     }
 
-    return busWrite(busDev, 0x40, val);
+    i2c_OLED_fb_write(val);
+    return true;
+}
+
+void i2c_OLED_flush(void)
+{
+    if (!busDev) {
+        return;
+    }
+
+    for (int page = 0; page < SCREEN_PAGE_COUNT; page++) {
+        if (fb.dirtyMin[page] > fb.dirtyMax[page]) {
+            continue;
+        }
+        const uint8_t col = fb.dirtyMin[page];
+        i2c_OLED_send_cmd(0xb0 + page);                     // set page address
+        i2c_OLED_send_cmd(0x00 + (col & 0x0f));             // set low col address
+        i2c_OLED_send_cmd(0x10 + ((col >> 4) & 0x0f));      // set high col address
+        busWriteBuf(busDev, 0x40, &fb.data[page][col], fb.dirtyMax[page] - col + 1);
+        fb.dirtyMin[page] = SCREEN_WIDTH;
+        fb.dirtyMax[page] = 0;
+    }
 }
 
 void i2c_OLED_clear_display(void)
@@ -204,8 +268,11 @@ void i2c_OLED_clear_display(void)
     i2c_OLED_send_cmd(0x40);              // Display start line register to 0
     i2c_OLED_send_cmd(0);                 // Set low col address to 0
     i2c_OLED_send_cmd(0x10);              // Set high col address to 0
-    for (uint16_t i = 0; i < 1024; i++) {  // fill the display's RAM with graphic... 128*64 pixel picture
-        i2c_OLED_send_byte(0x00);  // clear
+    i2c_OLED_fb_reset();
+    for (int page = 0; page < SCREEN_PAGE_COUNT; page++) {  // fill the display's RAM with graphic... 128*64 pixel picture
+        if (busDev) {
+            busWriteBuf(busDev, 0x40, fb.data[page], SCREEN_WIDTH);  // clear
+        }
     }
     i2c_OLED_send_cmd(0x81);              // Setup CONTRAST CONTROL, following byte is the contrast Value... always a 2 byte instruction
     i2c_OLED_send_cmd(200);               // Here you can set the brightness 1 = dull, 255 is very bright
@@ -214,27 +281,23 @@ void i2c_OLED_clear_display(void)
 
 void i2c_OLED_clear_display_quick(void)
 {
-    i2c_OLED_send_cmd(0xb0);              // set page address to 0
-    i2c_OLED_send_cmd(0x40);              // Display start line register to 0
-    i2c_OLED_send_cmd(0);                 // Set low col address to 0
-    i2c_OLED_send_cmd(0x10);              // Set high col address to 0
-    for (uint16_t i = 0; i < 1024; i++) {      // fill the display's RAM with graphic... 128*64 pixel picture
-        i2c_OLED_send_byte(0x00);  // clear
+    fb.page = 0;
+    fb.col = 0;
+    for (uint16_t i = 0; i < SCREEN_WIDTH * SCREEN_PAGE_COUNT; i++) {
+        i2c_OLED_fb_write(0x00);  // clear
     }
 }
 
 void i2c_OLED_set_xy(uint8_t col, uint8_t row)
 {
-    i2c_OLED_send_cmd(0xb0 + row);                      //set page address
-    i2c_OLED_send_cmd(0x00 + ((CHARACTER_WIDTH_TOTAL * col) & 0x0f));         //set low col address
-    i2c_OLED_send_cmd(0x10 + (((CHARACTER_WIDTH_TOTAL * col) >> 4) & 0x0f));  //set high col address
+    fb.page = row % SCREEN_PAGE_COUNT;
+    fb.col = (CHARACTER_WIDTH_TOTAL * col) % SCREEN_WIDTH;
 }
 
 void i2c_OLED_set_line(uint8_t row)
 {
-    i2c_OLED_send_cmd(0xb0 + row); //set page address
-    i2c_OLED_send_cmd(0);          //set low col address
-    i2c_OLED_send_cmd(0x10);       //set high col address
+    fb.page = row % SCREEN_PAGE_COUNT;
+    fb.col = 0;
 }
 
 void i2c_OLED_send_char(unsigned char ascii)
@@ -244,9 +307,9 @@ void i2c_OLED_send_char(unsigned char ascii)
     for (i = 0; i < 5; i++) {
         buffer = multiWiiFont[ascii - 32][i];
         buffer ^= CHAR_FORMAT;  // apply
-        i2c_OLED_send_byte(buffer);
+        i2c_OLED_fb_write(buffer);
     }
-    i2c_OLED_send_byte(CHAR_FORMAT);    // the gap
+    i2c_OLED_fb_write(CHAR_FORMAT);    // the gap
 }
 
 void i2c_OLED_send_string(const char *string)
@@ -19,6 +19,7 @@
 
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 64
+#define SCREEN_PAGE_COUNT (SCREEN_HEIGHT / 8)
 
 #define FONT_WIDTH 5
 #define FONT_HEIGHT 7
@@ -43,4 +44,5 @@ void i2c_OLED_send_string(const char *string);
 bool i2c_OLED_send_byte(uint8_t val);
 void i2c_OLED_clear_display(void);
 void i2c_OLED_clear_display_quick(void);
+void i2c_OLED_flush(void);
 
@@ -34,6 +34,7 @@
 #include "build/debug.h"
 
 #include "common/bitarray.h"
+#include "common/maths.h"
 #include "common/printf.h"
 #include "common/utils.h"
 
@@ -193,6 +194,16 @@ static BITARRAY_DECLARE(screenIsDirty, MAX7456_BUFFER_CHARS_PAL);
 //max chars to update in one idle
 #define MAX_CHARS2UPDATE        10
 #define BYTES_PER_CHAR2UPDATE   (7 * 2) // SPI regs + values for them
+// Bytes sent per update. Runs of characters are sent in auto-increment
+// mode with one byte per character, so the same transfer time carries
+// more characters than MAX_CHARS2UPDATE.
+#define MAX_BYTES2UPDATE        (MAX_CHARS2UPDATE * BYTES_PER_CHAR2UPDATE)
+// DMM, DMAH and DMAL before the characters, END_STRING and DMM after them
+#define BYTES_PER_RUN           (3 * 2 + 1 + 2)
+// Shorter runs are cheaper as individual writes
+#define MIN_CHARS_PER_RUN       3
+// Clean characters included in a run to avoid starting a new one
+#define MAX_RUN_GAP             4
 
 typedef struct max7456Registers_s {
     uint8_t vm0;
@@ -205,6 +216,7 @@ typedef struct max7456State_s {
     bool isInitialized;
     bool mutex;
     max7456Registers_t registers;
+    max7456Stats_t stats;
 } max7456State_t;
 
 static max7456State_t state;
@@ -483,18 +495,116 @@ void max7456Write(uint8_t x, uint8_t y, const char *buff, uint8_t mode)
     }
 }
 
+static int max7456PrepareChar(uint8_t *spiBuff, size_t bufsize, int bufPtr, unsigned pos)
+{
+    uint8_t ph = pos >> 8;
+    uint8_t pl = pos & 0xff;
+
+    uint8_t charMode = MODE_BYTE(osdCharacterGridBuffer[pos]);
+    uint8_t chr = CHAR_BYTE(osdCharacterGridBuffer[pos]);
+    if (CHAR_MODE_IS_EXT(charMode)) {
+        if (!DMM_IS_8BIT_MODE(state.registers.dmm)) {
+            state.registers.dmm |= DMM_8BIT_MODE;
+            bufPtr = max7456PrepareBuffer(spiBuff, bufsize, bufPtr, MAX7456ADD_DMM, state.registers.dmm);
+        }
+
+        bufPtr = max7456PrepareBuffer(spiBuff, bufsize, bufPtr, MAX7456ADD_DMAH, ph | DMAH_8_BIT_DMDI_IS_CHAR_ATTR);
+        bufPtr = max7456PrepareBuffer(spiBuff, bufsize, bufPtr, MAX7456ADD_DMAL, pl);
+        // Attribute bit positions on DMDI are 2 bits up relative to DMM.
+        // DMM uses [5:3] while DMDI uses [7:4] - one bit more for referencing
+        // characters in the [256, 511] range (which is not possible via DMM).
+        // Since we write mostly to DMM, the internal representation uses
+        // the format of the former and we shift it up here.
+        bufPtr = max7456PrepareBuffer(spiBuff, bufsize, bufPtr, MAX7456ADD_DMDI, charMode << 2);
+
+        bufPtr = max7456PrepareBuffer(spiBuff, bufsize, bufPtr, MAX7456ADD_DMAH, ph);
+        bufPtr = max7456PrepareBuffer(spiBuff, bufsize, bufPtr, MAX7456ADD_DMAL, pl);
+        bufPtr = max7456PrepareBuffer(spiBuff, bufsize, bufPtr, MAX7456ADD_DMDI, chr);
+
+    } else {
+        if (DMM_IS_8BIT_MODE(state.registers.dmm) || (DMM_CHAR_MODE_MASK & state.registers.dmm) != charMode) {
+            state.registers.dmm &= ~DMM_8BIT_MODE;
+            state.registers.dmm = (state.registers.dmm & ~DMM_CHAR_MODE_MASK) | charMode;
+            // Send the attributes for the character run. They
+            // will be applied to all characters until we change
+            // the DMM register.
+            bufPtr = max7456PrepareBuffer(spiBuff, bufsize, bufPtr, MAX7456ADD_DMM, state.registers.dmm);
+        }
+
+        bufPtr = max7456PrepareBuffer(spiBuff, bufsize, bufPtr, MAX7456ADD_DMAH, ph);
+        bufPtr = max7456PrepareBuffer(spiBuff, bufsize, bufPtr, MAX7456ADD_DMAL, pl);
+        bufPtr = max7456PrepareBuffer(spiBuff, bufsize, bufPtr, MAX7456ADD_DMDI, chr);
+    }
+    return bufPtr;
+}
+
+static bool max7456CanContinueRun(unsigned pos, uint8_t charMode)
+{
+    // END_STRING terminates auto-increment mode, so it can't be part of a run.
+    // Characters above 255 need the 8 bit mode, which is only possible
+    // with individual writes.
+    return MODE_BYTE(osdCharacterGridBuffer[pos]) == charMode &&
+        CHAR_BYTE(osdCharacterGridBuffer[pos]) != END_STRING;
+}
+
+// Returns the number of characters starting at the dirty pos that should be
+// sent as an auto-increment run, or 0 if they're cheaper as individual writes.
+static unsigned max7456FindRun(unsigned pos, size_t bytesLeft)
+{
+    const uint8_t charMode = MODE_BYTE(osdCharacterGridBuffer[pos]);
+
+    if (bytesLeft < BYTES_PER_RUN + MIN_CHARS_PER_RUN || CHAR_MODE_IS_EXT(charMode) ||
+        CHAR_BYTE(osdCharacterGridBuffer[pos]) == END_STRING) {
+        return 0;
+    }
+
+    const unsigned maxEnd = MIN(ARRAYLEN(osdCharacterGridBuffer), pos + bytesLeft - BYTES_PER_RUN);
+    unsigned end = pos + 1;
+    unsigned gap = 0;
+    for (unsigned ii = pos + 1; ii < maxEnd && max7456CanContinueRun(ii, charMode); ii++) {
+        if (bitArrayGet(screenIsDirty, ii)) {
+            end = ii + 1;
+            gap = 0;
+        } else if (++gap > MAX_RUN_GAP) {
+            break;
+        }
+    }
+    return end - pos >= MIN_CHARS_PER_RUN ? end - pos : 0;
+}
+
+static int max7456PrepareRun(uint8_t *spiBuff, size_t bufsize, int bufPtr, unsigned pos, unsigned count)
+{
+    // Attributes for all the characters in the run are taken from DMM
+    state.registers.dmm = (state.registers.dmm & ~(DMM_8BIT_MODE | DMM_CHAR_MODE_MASK)) | MODE_BYTE(osdCharacterGridBuffer[pos]);
+
+    bufPtr = max7456PrepareBuffer(spiBuff, bufsize, bufPtr, MAX7456ADD_DMAH, pos >> 8);
+    bufPtr = max7456PrepareBuffer(spiBuff, bufsize, bufPtr, MAX7456ADD_DMAL, pos & 0xff);
+    bufPtr = max7456PrepareBuffer(spiBuff, bufsize, bufPtr, MAX7456ADD_DMM, state.registers.dmm | DMM_AUTOINCREMENT);
+
+    if ((size_t)bufPtr + count + 1 > bufsize) {
+        BOUNDS_CHECK_FAILED();
+        return INT_MAX;
+    }
+    // In auto-increment mode every byte is the next character
+    for (unsigned ii = 0; ii < count; ii++) {
+        spiBuff[bufPtr++] = CHAR_BYTE(osdCharacterGridBuffer[pos + ii]);
+    }
+    spiBuff[bufPtr++] = END_STRING;
+
+    return max7456PrepareBuffer(spiBuff, bufsize, bufPtr, MAX7456ADD_DMM, state.registers.dmm);
+}
+
 // Must be called with the lock held. Returns whether any new characters
 // were drawn.
 static bool max7456DrawScreenPartial(void)
 {
-    uint8_t spiBuff[MAX_CHARS2UPDATE * BYTES_PER_CHAR2UPDATE];
+    uint8_t spiBuff[MAX_BYTES2UPDATE];
     int bufPtr = 0;
-    size_t pos;
-    uint_fast16_t updatedCharCount;
-    uint8_t charMode;
+    unsigned pos;
+    unsigned charCount = 0;
     int next;
 
-    for (pos = 0, updatedCharCount = 0; pos < ARRAYLEN(osdCharacterGridBuffer);) {
+    for (pos = 0; pos < ARRAYLEN(osdCharacterGridBuffer);) {
         next = BITARRAY_FIND_FIRST_SET(screenIsDirty, pos);
         if (next < 0) {
             // No more dirty chars.
@@ -505,61 +615,45 @@ static bool max7456DrawScreenPartial(void)
             BOUNDS_CHECK_FAILED();
         }
 
-        // Found one dirty character to send
-        uint8_t ph = pos >> 8;
-        uint8_t pl = pos & 0xff;
-
-        charMode = MODE_BYTE(osdCharacterGridBuffer[pos]);
-        uint8_t chr = CHAR_BYTE(osdCharacterGridBuffer[pos]);
-        if (CHAR_MODE_IS_EXT(charMode)) {
-            if (!DMM_IS_8BIT_MODE(state.registers.dmm)) {
-                state.registers.dmm |= DMM_8BIT_MODE;
-                bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMM, state.registers.dmm);
+        const size_t bytesLeft = sizeof(spiBuff) - bufPtr;
+        const unsigned runLength = max7456FindRun(pos, bytesLeft);
+        if (runLength > 0) {
+            bufPtr = max7456PrepareRun(spiBuff, sizeof(spiBuff), bufPtr, pos, runLength);
+            for (unsigned ii = pos; ii < pos + runLength; ii++) {
+                bitArrayClr(screenIsDirty, ii);
             }
-
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAH, ph | DMAH_8_BIT_DMDI_IS_CHAR_ATTR);
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAL, pl);
-            // Attribute bit positions on DMDI are 2 bits up relative to DMM.
-            // DMM uses [5:3] while DMDI uses [7:4] - one bit more for referencing
-            // characters in the [256, 511] range (which is not possible via DMM).
-            // Since we write mostly to DMM, the internal representation uses
-            // the format of the former and we shift it up here.
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMDI, charMode << 2);
-
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAH, ph);
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAL, pl);
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMDI, chr);
-
+            state.stats.runs++;
+            charCount += runLength;
+            pos += runLength;
         } else {
-            if (DMM_IS_8BIT_MODE(state.registers.dmm) || (DMM_CHAR_MODE_MASK & state.registers.dmm) != charMode) {
-                state.registers.dmm &= ~DMM_8BIT_MODE;
-                state.registers.dmm = (state.registers.dmm & ~DMM_CHAR_MODE_MASK) | charMode;
-                // Send the attributes for the character run. They
-                // will be applied to all characters until we change
-                // the DMM register.
-                bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMM, state.registers.dmm);
+            if (bytesLeft < BYTES_PER_CHAR2UPDATE) {
+                break;
             }
-
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAH, ph);
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAL, pl);
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMDI, chr);
+            // Found one dirty character to send
+            bufPtr = max7456PrepareChar(spiBuff, sizeof(spiBuff), bufPtr, pos);
+            bitArrayClr(screenIsDirty, pos);
+            charCount++;
+            // Start next search at next bit
+            pos++;
         }
-
-        bitArrayClr(screenIsDirty, pos);
-        if (++updatedCharCount == MAX_CHARS2UPDATE) {
-            break;
-        }
-        // Start next search at next bit
-        pos++;
     }
 
+    state.stats.lastUpdateChars = charCount;
     if (bufPtr) {
         busTransfer(state.dev, NULL, spiBuff, bufPtr);
+        state.stats.transfers++;
+        state.stats.bytes += bufPtr;
+        state.stats.chars += charCount;
         return true;
     }
     return false;
 }
 
+const max7456Stats_t *max7456GetStats(void)
+{
+    return &state.stats;
+}
+
 // Must be called with the lock held
 static void max7456StallCheck(void)
 {
@@ -44,6 +44,14 @@ enum VIDEO_TYPES { AUTO = 0, PAL, NTSC };
 #define MAX7456_MODE_BLINK    (1 << 4)
 #define MAX7456_MODE_SOLID_BG (1 << 5)
 
+typedef struct max7456Stats_s {
+    uint32_t transfers;         // SPI transfers with screen updates
+    uint32_t bytes;             // Bytes sent in those transfers
+    uint32_t chars;             // Characters written
+    uint32_t runs;              // Character runs sent in auto-increment mode
+    uint16_t lastUpdateChars;   // Characters written by the last update
+} max7456Stats_t;
+
 void max7456Init(const videoSystem_e videoSystem);
 void max7456Update(void);
 void max7456ReadNvm(uint16_t char_address, osdCharacter_t *chr);
@@ -56,3 +64,4 @@ bool max7456ReadChar(uint8_t x, uint8_t y, uint16_t *c, uint8_t *mode);
 void max7456ClearScreen(void);
 void max7456RefreshAll(void);
 uint8_t* max7456GetScreenBuffer(void);
+const max7456Stats_t *max7456GetStats(void);
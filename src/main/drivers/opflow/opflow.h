@@ -30,6 +30,7 @@
 struct opflowDev_s;
 
 typedef struct opflowData_s {
+    timeUs_t    timestamp;      // End of the integration timeframe, 0 if the driver doesn't know
     timeDelta_t deltaTime;      // Integration timeframe of motionX/Y
     float     flowRateRaw[3]; // Flow rotation in raw sensor uints (per deltaTime interval). Use dummy 3-rd axis (always zero) for compatibility with alignment functions
     int16_t     quality;
@@ -38,5 +39,6 @@ typedef struct opflowData_s {
 typedef struct opflowDev_s {
     sensorOpflowInitFuncPtr initFn;
     sensorOpflowUpdateFuncPtr updateFn;
+    sensorOpflowHasNewDataFuncPtr hasNewDataFn;     // Optional, lets the task run as soon as a frame arrived
     opflowData_t rawData;
 } opflowDev_t;
@@ -63,6 +63,7 @@ bool fakeOpflowDetect(opflowDev_t * dev)
 {
     dev->initFn = &fakeOpflowInit;
     dev->updateFn = &fakeOpflowUpdate;
+    dev->hasNewDataFn = NULL;
 
     memset(&dev->rawData, 0, sizeof(opflowData_t));
 
@@ -52,12 +52,19 @@ static bool virtualOpflowUpdate(opflowDev_t * dev)
     return highLevelDeviceVTable->update(&dev->rawData);
 }
 
+static bool virtualOpflowHasNewData(opflowDev_t * dev)
+{
+    UNUSED(dev);
+    return highLevelDeviceVTable->hasNewData();
+}
+
 bool virtualOpflowDetect(opflowDev_t * dev, const virtualOpflowVTable_t * vtable)
 {
     if (vtable && vtable->detect()) {
         highLevelDeviceVTable = vtable;
         dev->initFn = &virtualOpflowInit;
         dev->updateFn = &virtualOpflowUpdate;
+        dev->hasNewDataFn = vtable->hasNewData ? &virtualOpflowHasNewData : NULL;
         memset(&dev->rawData, 0, sizeof(opflowData_t));
         return true;
     }
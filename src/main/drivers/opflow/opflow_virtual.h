@@ -30,6 +30,7 @@ typedef struct virtualOpflowVTable_s {
     bool (*detect)(void);
     bool (*init)(void);
     bool (*update)(opflowData_t * data);
+    bool (*hasNewData)(void);       // Optional
 } virtualOpflowVTable_t;
 
 bool virtualOpflowDetect(opflowDev_t * dev, const virtualOpflowVTable_t * vtable);
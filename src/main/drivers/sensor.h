@@ -55,3 +55,4 @@ typedef bool (*sensorTempReadFuncPtr)(struct temperatureDev_s *tempDev, int16_t
 struct opflowDev_s;
 typedef bool (*sensorOpflowInitFuncPtr)(struct opflowDev_s *mag);
 typedef bool (*sensorOpflowUpdateFuncPtr)(struct opflowDev_s *mag);
+typedef bool (*sensorOpflowHasNewDataFuncPtr)(struct opflowDev_s *mag);
@@ -39,6 +39,7 @@ bool cliMode = false;
 #include "common/printf.h"
 #include "common/string_light.h"
 #include "common/memory.h"
+#include "common/number_format.h"
 #include "common/time.h"
 #include "common/typeconversion.h"
 #include "common/fp_pid.h"
@@ -182,6 +183,7 @@ static const char * const blackboxIncludeFlagNames[] = {
     "PEAKS_R",
     "PEAKS_P",
     "PEAKS_Y",
+    "RC_LATENCY",
     NULL
 };
 #endif
@@ -242,6 +244,7 @@ static void cliPrintLinefeed(void)
 {
     cliPrint("\r\n");
     if (cliDelayMs) {
+        bufWriterFlush(cliWriter);
         delay(cliDelayMs);
     }
 }
@@ -302,16 +305,16 @@ typedef enum {
     HIDE_UNUSED = (1 << 7)
 } dumpFlags_e;
 
+// Output is flushed when cliWriter fills up and before the prompt, so
+// long outputs like dump and diff go out in full buffers
 static void cliPrintfva(const char *format, va_list va)
 {
     tfp_format(cliWriter, cliPutp, format, va);
-    bufWriterFlush(cliWriter);
 }
 
 static void cliPrintLinefva(const char *format, va_list va)
 {
     tfp_format(cliWriter, cliPutp, format, va);
-    bufWriterFlush(cliWriter);
     cliPrintLinefeed();
 }
 
@@ -431,9 +434,10 @@ static void printValuePointer(const setting_t *var, const void *valuePointer, ui
     switch (SETTING_MODE(var)) {
     case MODE_DIRECT:
         if (SETTING_TYPE(var) == VAR_UINT32)
-            cliPrintf("%u", value);
+            formatUnsigned(buf, value, 0, false);
         else
-            cliPrintf("%d", value);
+            formatSigned(buf, value, 0, false);
+        cliPrint(buf);
         if (full) {
             if (SETTING_MODE(var) == MODE_DIRECT) {
                 cliPrintf(" %d %u", settingGetMin(var), settingGetMax(var));
@@ -489,7 +493,7 @@ static bool valuePtrEqualsDefault(const setting_t *value, const void *ptr, const
     return result;
 }
 
-static void dumpPgValue(const setting_t *value, uint8_t dumpMask)
+static void dumpPgValue(const setting_t *value, uint8_t dumpMask, bool pgEqualsDefault)
 {
     char name[SETTING_MAX_NAME_LENGTH];
     const char *format = "set %s = ";
@@ -501,7 +505,7 @@ static void dumpPgValue(const setting_t *value, uint8_t dumpMask)
     // will return the actual value.
     const void *valuePointer = settingGetCopyValuePointer(value);
     const void *defaultValuePointer = settingGetValuePointer(value);
-    const bool equalsDefault = valuePtrEqualsDefault(value, valuePointer, defaultValuePointer);
+    const bool equalsDefault = pgEqualsDefault || valuePtrEqualsDefault(value, valuePointer, defaultValuePointer);
     if (((dumpMask & DO_DIFF) == 0) || !equalsDefault) {
         settingGetName(value, name);
         if (dumpMask & SHOW_DEFAULTS && !equalsDefault) {
@@ -520,13 +524,41 @@ static void dumpPgValue(const setting_t *value, uint8_t dumpMask)
     }
 }
 
-static void dumpAllValues(uint16_t valueSection, uint8_t dumpMask)
+// Returns true when none of the bytes backing the settings in [start, end]
+// differ from their defaults, which lets a whole PG be skipped without
+// comparing each value or decoding any name.
+static bool pgValuesEqualDefaults(uint16_t start, uint16_t end)
 {
-    for (unsigned i = 0; i < SETTINGS_TABLE_COUNT; i++) {
+    const setting_t *first = settingGet(start);
+    // See dumpPgValue() for where the actual and default values are
+    const uint8_t *valueBase = (const uint8_t *)settingGetCopyValuePointer(first) - first->offset;
+    const uint8_t *defaultBase = (const uint8_t *)settingGetValuePointer(first) - first->offset;
+    size_t size = 0;
+    for (unsigned i = start; i <= end; i++) {
         const setting_t *value = settingGet(i);
-        bufWriterFlush(cliWriter);
-        if (SETTING_SECTION(value) == valueSection) {
-            dumpPgValue(value, dumpMask);
+        const size_t valueEnd = value->offset + settingGetValueSize(value);
+        if (valueEnd > size) {
+            size = valueEnd;
+        }
+    }
+    return memcmp(valueBase, defaultBase, size) == 0;
+}
+
+static void dumpAllValues(uint16_t valueSection, uint8_t dumpMask)
+{
+    // All the settings in a PG are contiguous and belong to the same section
+    for (unsigned pgIndex = 0; pgIndex < SETTINGS_PGN_COUNT; pgIndex++) {
+        uint16_t start, end;
+        settingsGetParameterGroupByIndex(pgIndex, &start, &end);
+        if (SETTING_SECTION(settingGet(start)) != valueSection) {
+            continue;
+        }
+        const bool pgEqualsDefault = pgValuesEqualDefaults(start, end);
+        if ((dumpMask & DO_DIFF) && pgEqualsDefault) {
+            continue;
+        }
+        for (unsigned i = start; i <= end; i++) {
+            dumpPgValue(settingGet(i), dumpMask, pgEqualsDefault);
         }
     }
 }
@@ -746,6 +778,9 @@ static void cliAux(char *cmdline)
             if (validArgumentCount != 4) {
                 memset(mac, 0, sizeof(modeActivationCondition_t));
             }
+
+            // Mode evaluation uses ranges compiled from the conditions
+            updateUsedModeActivationConditionFlags();
         } else {
             cliShowArgumentRangeError("index", 0, MAX_MODE_ACTIVATION_CONDITION_COUNT - 1);
         }
@@ -2462,6 +2497,7 @@ static void osdCustom(char *cmdline){
             osdCustomElementsMutable(i)->visibility.type = args[VISIBILITY_TYPE];
             osdCustomElementsMutable(i)->visibility.value = args[VISIBILITY_VALUE];
             memcpy(osdCustomElementsMutable(i)->osdCustomElementText, text, OSD_CUSTOM_ELEMENT_TEXT_SIZE);
+            customElementsCompile();
 
             osdCustom("");
         } else {
@@ -2776,6 +2812,87 @@ static void cliOsdLayout(char *cmdline)
     }
 }
 
+static const char * const osdRefreshClassNames[] = { "AUTO", "CRITICAL", "NORMAL", "SLOW" };
+
+STATIC_ASSERT(ARRAYLEN(osdRefreshClassNames) == OSD_REFRESH_CLASS_COUNT, osd_refresh_class_names_mismatch);
+
+static void printOsdRefresh(uint8_t dumpMask, const osdRefreshConfig_t *config, const osdRefreshConfig_t *configDefault, int layout, int item)
+{
+    // "<layout> <item> <class>"
+    const char *format = "osd_refresh %d %d %s";
+    for (int ii = 0; ii < OSD_LAYOUT_COUNT; ii++) {
+        if (layout >= 0 && layout != ii) {
+            continue;
+        }
+        for (int jj = 0; jj < OSD_ITEM_COUNT; jj++) {
+            if (item >= 0 && item != jj) {
+                continue;
+            }
+            const osdRefreshClass_e refreshClass = osdGetItemRefreshClass(config, ii, jj);
+            const osdRefreshClass_e defaultRefreshClass = osdGetItemRefreshClass(configDefault, ii, jj);
+            // Elements left at AUTO everywhere would only add noise when listing all of them
+            if (item < 0 && refreshClass == OSD_REFRESH_CLASS_AUTO && defaultRefreshClass == OSD_REFRESH_CLASS_AUTO) {
+                continue;
+            }
+            bool equalsDefault = refreshClass == defaultRefreshClass;
+            cliDefaultPrintLinef(dumpMask, equalsDefault, format, ii, jj, osdRefreshClassNames[defaultRefreshClass]);
+            cliDumpPrintLinef(dumpMask, equalsDefault, format, ii, jj, osdRefreshClassNames[refreshClass]);
+        }
+    }
+}
+
+static void cliOsdRefresh(char *cmdline)
+{
+    char * saveptr;
+
+    int layout = -1;
+    int item = -1;
+    int refreshClass = -1;
+    char *tok = strtok_r(cmdline, " ", &saveptr);
+
+    int ii;
+
+    for (ii = 0; tok != NULL; ii++, tok = strtok_r(NULL, " ", &saveptr)) {
+        switch (ii) {
+            case 0:
+                layout = fastA2I(tok);
+                if (layout < 0 || layout >= OSD_LAYOUT_COUNT) {
+                    cliShowParseError();
+                    return;
+                }
+                break;
+            case 1:
+                item = fastA2I(tok);
+                if (item < 0 || item >= OSD_ITEM_COUNT) {
+                    cliShowParseError();
+                    return;
+                }
+                break;
+            case 2:
+                for (int jj = 0; jj < OSD_REFRESH_CLASS_COUNT; jj++) {
+                    if (sl_strcasecmp(tok, osdRefreshClassNames[jj]) == 0) {
+                        refreshClass = jj;
+                        break;
+                    }
+                }
+                if (refreshClass < 0) {
+                    cliShowParseError();
+                    return;
+                }
+                break;
+            default:
+                cliShowParseError();
+                return;
+        }
+    }
+
+    if (ii == 3) {
+        osdSetItemRefreshClass(osdRefreshConfigMutable(), layout, item, refreshClass);
+    } else {
+        printOsdRefresh(DUMP_MASTER, osdRefreshConfig(), osdRefreshConfig(), layout, item);
+    }
+}
+
 #endif
 
 static void printTimerOutputModes(dumpFlags_e dumpFlags, const timerOverride_t* to, const timerOverride_t* defaultTimerOverride, int timer)
@@ -3495,6 +3612,7 @@ static void cliDefaults(char *cmdline)
     suspendRxSignal();
     writeEEPROM();
     resumeRxSignal();
+    updateUsedModeActivationConditionFlags();
 
 #ifdef USE_CLI_BATCH
     commandBatchError = false;
@@ -3574,72 +3692,78 @@ static void cliSet(char *cmdline)
             eqptr++;
         }
 
-        for (uint32_t i = 0; i < SETTINGS_TABLE_COUNT; i++) {
-            val = settingGet(i);
-            // ensure exact match when setting to prevent setting variables with shorter names
-            if (settingNameIsExactMatch(val, name, cmdline, variableNameLength)) {
-                const setting_type_e type = SETTING_TYPE(val);
-                if (type == VAR_STRING) {
-                    // Convert strings to uppercase. Lower case is not supported by the OSD.
-                    sl_toupperptr(eqptr);
-                    // if setting the craftname, remove any quotes around the name.  This allows leading spaces in the name
-                    if ((strcmp(name, "name") == 0 || strcmp(name, "pilot_name") == 0) && (eqptr[0] == '"' && eqptr[strlen(eqptr)-1] == '"')) {
-                        settingSetString(val, eqptr + 1, strlen(eqptr)-2);
-                    } else {
-                        settingSetString(val, eqptr, strlen(eqptr));
-                    }
-                    return;
+        // Names are stored in lower case, the lookup is exact
+        val = NULL;
+        if (variableNameLength < SETTING_MAX_NAME_LENGTH) {
+            for (unsigned ii = 0; ii < variableNameLength; ii++) {
+                name[ii] = sl_tolower((unsigned char)cmdline[ii]);
+            }
+            name[variableNameLength] = '\0';
+            val = settingFind(name);
+        }
+
+        if (val) {
+            const setting_type_e type = SETTING_TYPE(val);
+            if (type == VAR_STRING) {
+                // Convert strings to uppercase. Lower case is not supported by the OSD.
+                sl_toupperptr(eqptr);
+                // if setting the craftname, remove any quotes around the name.  This allows leading spaces in the name
+                if ((strcmp(name, "name") == 0 || strcmp(name, "pilot_name") == 0) && (eqptr[0] == '"' && eqptr[strlen(eqptr)-1] == '"')) {
+                    settingSetString(val, eqptr + 1, strlen(eqptr)-2);
+                } else {
+                    settingSetString(val, eqptr, strlen(eqptr));
                 }
-                const setting_mode_e mode = SETTING_MODE(val);
-                bool changeValue = false;
-                int_float_value_t tmp = {0};
-                switch (mode) {
-                case MODE_DIRECT: {
-                        if (*eqptr != 0 && strspn(eqptr, "0123456789.+-") == strlen(eqptr)) {
-                            float valuef = fastA2F(eqptr);
-                            // note: compare float values
-                            if (valuef >= (float)settingGetMin(val) && valuef <= (float)settingGetMax(val)) {
-
-                                if (type == VAR_FLOAT)
-                                    tmp.float_value = valuef;
-                                else if (type == VAR_UINT32)
-                                    tmp.uint_value = fastA2UL(eqptr);
-                                else
-                                    tmp.int_value = fastA2I(eqptr);
-
-                                changeValue = true;
-                            }
+                return;
+            }
+            const setting_mode_e mode = SETTING_MODE(val);
+            bool changeValue = false;
+            int_float_value_t tmp = {0};
+            switch (mode) {
+            case MODE_DIRECT: {
+                    if (*eqptr != 0 && strspn(eqptr, "0123456789.+-") == strlen(eqptr)) {
+                        float valuef = fastA2F(eqptr);
+                        // note: compare float values
+                        if (valuef >= (float)settingGetMin(val) && valuef <= (float)settingGetMax(val)) {
+
+                            if (type == VAR_FLOAT)
+                                tmp.float_value = valuef;
+                            else if (type == VAR_UINT32)
+                                tmp.uint_value = fastA2UL(eqptr);
+                            else
+                                tmp.int_value = fastA2I(eqptr);
+
+                            changeValue = true;
                         }
                     }
-                    break;
-                case MODE_LOOKUP: {
-                        const lookupTableEntry_t *tableEntry = settingLookupTable(val);
-                        bool matched = false;
-                        for (uint32_t tableValueIndex = 0; tableValueIndex < tableEntry->valueCount && !matched; tableValueIndex++) {
-                            matched = sl_strcasecmp(tableEntry->values[tableValueIndex], eqptr) == 0;
-
-                            if (matched) {
-                                tmp.int_value = tableValueIndex;
-                                changeValue = true;
-                            }
+                }
+                break;
+            case MODE_LOOKUP: {
+                    const lookupTableEntry_t *tableEntry = settingLookupTable(val);
+                    bool matched = false;
+                    for (uint32_t tableValueIndex = 0; tableValueIndex < tableEntry->valueCount && !matched; tableValueIndex++) {
+                        matched = sl_strcasecmp(tableEntry->values[tableValueIndex], eqptr) == 0;
+
+                        if (matched) {
+                            tmp.int_value = tableValueIndex;
+                            changeValue = true;
                         }
                     }
-                    break;
                 }
+                break;
+            }
 
-                if (changeValue) {
-                    cliSetIntFloatVar(val, tmp);
-
-                    cliPrintf("%s set to ", name);
-                    cliPrintVar(val, 0);
-                } else {
-                    cliPrintError("Invalid value. ");
-                    cliPrintVarRange(val);
-                    cliPrintLinefeed();
-                }
+            if (changeValue) {
+                cliSetIntFloatVar(val, tmp);
 
-                return;
+                cliPrintf("%s set to ", name);
+                cliPrintVar(val, 0);
+            } else {
+                cliPrintError("Invalid value. ");
+                cliPrintVarRange(val);
+                cliPrintLinefeed();
             }
+
+            return;
         }
         cliPrintErrorLine("Invalid name");
     } else {
@@ -3952,29 +4076,6 @@ static void cliResource(char *cmdline)
     }
 }
 
-static void backupConfigs(void)
-{
-    // make copies of configs to do differencing
-    PG_FOREACH(pg) {
-        if (pgIsProfile(pg)) {
-            memcpy(pg->copy, pg->address, pgSize(pg) * MAX_PROFILE_COUNT);
-        } else {
-            memcpy(pg->copy, pg->address, pgSize(pg));
-        }
-    }
-}
-
-static void restoreConfigs(void)
-{
-    PG_FOREACH(pg) {
-        if (pgIsProfile(pg)) {
-            memcpy(pg->address, pg->copy, pgSize(pg) * MAX_PROFILE_COUNT);
-        } else {
-            memcpy(pg->address, pg->copy, pgSize(pg));
-        }
-    }
-}
-
 static void printConfig(const char *cmdline, bool doDiff)
 {
     uint8_t dumpMask = DUMP_MASTER;
@@ -4000,7 +4101,8 @@ static void printConfig(const char *cmdline, bool doDiff)
     const int currentProfileIndexSave = getConfigProfile();
     const int currentBatteryProfileIndexSave = getConfigBatteryProfile();
     const int currentMixerProfileIndexSave = getConfigMixerProfile();
-    backupConfigs();
+    // make copies of configs to do differencing
+    pgBackupAll(MAX_PROFILE_COUNT);
     // reset all configs to defaults to do differencing
     resetConfigs();
     // restore the profile indices, since they should not be reset for proper comparison
@@ -4106,6 +4208,9 @@ static void printConfig(const char *cmdline, bool doDiff)
 #ifdef USE_OSD
         cliPrintHashLine("OSD [osd_layout]");
         printOsdLayout(dumpMask, &osdLayoutsConfig_Copy, osdLayoutsConfig(), -1, -1);
+
+        cliPrintHashLine("OSD [osd_refresh]");
+        printOsdRefresh(dumpMask, &osdRefreshConfig_Copy, osdRefreshConfig(), -1, -1);
 #endif
 
 #ifdef USE_PROGRAMMING_FRAMEWORK
@@ -4183,7 +4288,7 @@ static void printConfig(const char *cmdline, bool doDiff)
 #endif
 
     // restore configs from copies
-    restoreConfigs();
+    pgRestoreAll(MAX_PROFILE_COUNT);
 }
 
 static void cliDump(char *cmdline)
@@ -4374,6 +4479,7 @@ const clicmd_t cmdTable[] = {
 #endif
 #ifdef USE_OSD
     CLI_COMMAND_DEF("osd_layout", "get or set the layout of OSD items", "[<layout> [<item> [<col> <row> [<visible>]]]]", cliOsdLayout),
+    CLI_COMMAND_DEF("osd_refresh", "get or set the refresh class of OSD items", "[<layout> [<item> [AUTO|CRITICAL|NORMAL|SLOW]]]", cliOsdRefresh),
 #endif
     CLI_COMMAND_DEF("timer_output_mode", "get or set the outputmode for a given timer.",  "[<timer> [<AUTO|MOTORS|SERVOS>]]", cliTimerOutputMode),
 };
@@ -56,6 +56,7 @@
 #include "io/ledstrip.h"
 #include "io/gps.h"
 #include "io/osd.h"
+#include "io/osd/custom_elements.h"
 
 #include "rx/rx.h"
 
@@ -327,6 +328,8 @@ static void activateConfig(void)
     pidInit();
 
     navigationUsePIDs();
+
+    customElementsCompile();
 }
 
 void readEEPROM(void)
@@ -59,6 +59,7 @@
 #include "fc/rc_smoothing.h"
 #include "fc/rc_controls.h"
 #include "fc/rc_curves.h"
+#include "fc/rc_latency.h"
 #include "fc/rc_modes.h"
 #include "fc/runtime_config.h"
 
@@ -620,10 +621,23 @@ void releaseSharedTelemetryPorts(void) {
     }
 }
 
-void processRx(timeUs_t currentTimeUs)
+/*
+ * RX processing is split in two stages. processRxChannels() runs whenever the RX task runs and only
+ * returns true if new channel data was processed - auxiliary (telemetry) processing alone does not
+ * trigger any mode logic. Mode activation from AUX channels is only re-evaluated when a channel
+ * crosses a mode range step.
+ */
+static bool processRxChannels(timeUs_t currentTimeUs)
 {
     // Calculate RPY channel data
-    calculateRxChannelsAndUpdateFailsafe(currentTimeUs);
+    return calculateRxChannelsAndUpdateFailsafe(currentTimeUs);
+}
+
+static bool processRx(timeUs_t currentTimeUs)
+{
+    if (!processRxChannels(currentTimeUs)) {
+        return false;
+    }
 
     // in 3D mode, we need to be able to disarm by switch at any time
     if (feature(FEATURE_REVERSIBLE_MOTORS)) {
@@ -658,11 +672,12 @@ void processRx(timeUs_t currentTimeUs)
 
     processRcStickPositions(throttleIsLow);
     processAirmode();
-    updateActivatedModes();
 
+    if (updateActivatedModesOnChange(false)) {
 #ifdef USE_PINIOBOX
-    pinioBoxUpdate();
+        pinioBoxUpdate();
 #endif
+    }
 
     if (!cliMode) {
         bool canUseRxData = rxIsReceivingSignal() && !FLIGHT_MODE(FAILSAFE_MODE);
@@ -833,23 +848,16 @@ void processRx(timeUs_t currentTimeUs)
 #endif
     // Sound a beeper if the flight mode state has changed
     updateFlightModeChangeBeeper();
+
+    return true;
 }
 
 // Function for loop trigger
 void FAST_CODE taskGyro(timeUs_t currentTimeUs) {
     UNUSED(currentTimeUs);
-    // getTaskDeltaTime() returns delta time frozen at the moment of entering the scheduler. currentTime is frozen at the very same point.
-    // To make busy-waiting timeout work we need to account for time spent within busy-waiting loop
-    const timeDelta_t currentDeltaTime = getTaskDeltaTime(TASK_SELF);
 
     /* Update actual hardware readings */
     gyroUpdate();
-
-#ifdef USE_OPFLOW
-    if (sensors(SENSOR_OPFLOW)) {
-        opflowGyroUpdateCallback(currentDeltaTime);
-    }
-#endif
 }
 
 static void applyThrottleTiltCompensation(void)
@@ -905,6 +913,13 @@ void taskMainPidLoop(timeUs_t currentTimeUs)
 
     gyroFilter();
 
+#ifdef USE_OPFLOW
+    // Flow derotation needs body rates integrated over the flow frame, filtered gyro at PID rate is plenty
+    if (sensors(SENSOR_OPFLOW)) {
+        opflowGyroUpdateCallback(currentTimeUs, cycleTime);
+    }
+#endif
+
     imuUpdateAccelerometer();
     imuUpdateAttitude(currentTimeUs);
 
@@ -937,6 +952,7 @@ void taskMainPidLoop(timeUs_t currentTimeUs)
 
     // Calculate stabilisation
     pidController(dT);
+    rcLatencyOnPidUpdate();
 
     mixTable();
 
@@ -955,6 +971,7 @@ void taskMainPidLoop(timeUs_t currentTimeUs)
 
         if (motorControlEnable) {
             writeMotors();
+            rcLatencyOnMotorUpdate();
         }
     }
 #else
@@ -964,6 +981,7 @@ void taskMainPidLoop(timeUs_t currentTimeUs)
 
     if (motorControlEnable) {
         writeMotors();
+        rcLatencyOnMotorUpdate();
     }
 #endif
     // Check if landed, FW and MR
@@ -1006,8 +1024,9 @@ bool taskUpdateRxCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTime)
 
 void taskUpdateRxMain(timeUs_t currentTimeUs)
 {
-    processRx(currentTimeUs);
-    isRXDataNew = true;
+    if (processRx(currentTimeUs)) {
+        isRXDataNew = true;
+    }
 }
 
 // returns seconds
@@ -68,6 +68,7 @@
 #include "fc/firmware_update.h"
 #include "fc/rc_adjustments.h"
 #include "fc/rc_controls.h"
+#include "fc/rc_latency.h"
 #include "fc/rc_modes.h"
 #include "fc/runtime_config.h"
 #include "fc/settings.h"
@@ -91,6 +92,7 @@
 #include "io/rangefinder.h"
 #include "io/ledstrip.h"
 #include "io/osd.h"
+#include "io/displayport_msp_osd.h"
 #include "io/serial.h"
 #include "io/serial_4way.h"
 #include "io/vtx.h"
@@ -1698,6 +1700,32 @@ static bool mspFcProcessOutCommand(uint16_t cmdMSP, sbuf_t *dst, mspPostProcessF
         break;
 
 #endif
+    case MSP2_INAV_RC_LATENCY:
+        for (int stage = 0; stage < RC_LATENCY_STAGE_COUNT; stage++) {
+            const rcLatencyStats_t *stats = rcLatencyGetStats(stage);
+            sbufWriteU16(dst, stats->lastUs);
+            sbufWriteU16(dst, stats->minUs);
+            sbufWriteU16(dst, stats->maxUs);
+            sbufWriteU16(dst, stats->count ? stats->sumUs / stats->count : 0);
+            sbufWriteU32(dst, stats->count);
+            for (int bin = 0; bin < RC_LATENCY_HISTOGRAM_BINS; bin++) {
+                sbufWriteU16(dst, stats->histogram[bin]);
+            }
+        }
+        break;
+
+#if defined(USE_OSD) && defined(USE_MSP_OSD)
+    case MSP2_INAV_DISPLAYPORT_STATS:
+        {
+            const displayportMspStats_t *stats = mspOsdGetStats();
+            sbufWriteU8(dst, mspOsdGetOptions());
+            sbufWriteU32(dst, stats->frames);
+            sbufWriteU32(dst, stats->bytes);
+            sbufWriteU32(dst, stats->chars);
+        }
+        break;
+#endif
+
 #ifdef USE_PROGRAMMING_FRAMEWORK
     case MSP2_INAV_CUSTOM_OSD_ELEMENTS:
         sbufWriteU8(dst, MAX_CUSTOM_ELEMENTS);
@@ -2745,6 +2773,8 @@ static mspResult_e mspFcProcessInCommand(uint16_t cmdMSP, sbuf_t *src)
             gpsSol.flags.validVelD = false;
             gpsSol.flags.validEPE = false;
             gpsSol.flags.validTime = false;
+            gpsSol.flags.validTimeOfWeek = false;
+            gpsSol.measurementTimeUs = micros();
             gpsSol.numSat = sbufReadU8(src);
             gpsSol.llh.lat = sbufReadU32(src);
             gpsSol.llh.lon = sbufReadU32(src);
@@ -3187,6 +3217,10 @@ static mspResult_e mspFcProcessInCommand(uint16_t cmdMSP, sbuf_t *src)
         }
         break;
 
+    case MSP2_INAV_RC_LATENCY_RESET:
+        rcLatencyReset();
+        break;
+
     case MSP2_INAV_SELECT_MIXER_PROFILE:
         if (!ARMING_FLAG(ARMED) && sbufReadU8Safe(&tmp_u8, src)) {
                 setConfigMixerProfileAndWriteEEPROM(tmp_u8);
@@ -3345,6 +3379,7 @@ static mspResult_e mspFcProcessInCommand(uint16_t cmdMSP, sbuf_t *src)
                 osdCustomElementsMutable(tmp_u8)->osdCustomElementText[i] = sbufReadU8(src);
             }
             osdCustomElementsMutable(tmp_u8)->osdCustomElementText[OSD_CUSTOM_ELEMENT_TEXT_SIZE - 1] = '\0';
+            customElementsCompile();
         } else{
             return MSP_RESULT_ERROR;
         }
@@ -3402,19 +3437,13 @@ static bool mspSettingCommand(sbuf_t *dst, sbuf_t *src)
     return true;
 }
 
-static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
+// Reads a value for the given setting from src and stores it at ptr if it's
+// within the setting range. Strings end at a '\0' or at the end of the payload.
+static bool mspReadSettingValue(const setting_t *setting, void *ptr, sbuf_t *src)
 {
-    UNUSED(dst);
-
-    const setting_t *setting = mspReadSetting(src);
-    if (!setting) {
-        return false;
-    }
-
     setting_min_t min = settingGetMin(setting);
     setting_max_t max = settingGetMax(setting);
 
-    void *ptr = settingGetValuePointer(setting);
     switch (SETTING_TYPE(setting)) {
         case VAR_UINT8:
             {
@@ -3482,6 +3511,7 @@ static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
                 if (!sbufReadDataSafe(src, &val, sizeof(float))) {
                     return false;
                 }
+                sbufAdvance(src, sizeof(float));
                 if (val < (float)min || val > (float)max) {
                     return false;
                 }
@@ -3490,7 +3520,16 @@ static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
             break;
         case VAR_STRING:
             {
-                settingSetString(setting, (const char*)sbufPtr(src), sbufBytesRemaining(src));
+                const char *str = (const char*)sbufPtr(src);
+                const int remaining = sbufBytesRemaining(src);
+                int len = 0;
+                while (len < remaining && str[len] != '\0') {
+                    len++;
+                }
+                const int copySize = MIN(len, (int)max);
+                memcpy(ptr, str, copySize);
+                ((char *)ptr)[copySize] = '\0';
+                sbufAdvance(src, len < remaining ? len + 1 : len);
             }
             break;
     }
@@ -3498,6 +3537,18 @@ static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
     return true;
 }
 
+static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
+{
+    UNUSED(dst);
+
+    const setting_t *setting = mspReadSetting(src);
+    if (!setting) {
+        return false;
+    }
+
+    return mspReadSettingValue(setting, settingGetValuePointer(setting), src);
+}
+
 static bool mspSettingInfoCommand(sbuf_t *dst, sbuf_t *src)
 {
     const setting_t *setting = mspReadSetting(src);
@@ -3596,6 +3647,151 @@ static bool mspParameterGroupsCommand(sbuf_t *dst, sbuf_t *src)
     return true;
 }
 
+/*
+ * Settings blob, used by MSP2_COMMON_SETTINGS_BLOB and MSP2_COMMON_SET_SETTINGS_BLOB
+ * to transfer a range of settings in a single frame. All values are little endian.
+ *
+ * Header:
+ *   uint8_t  version, MSP_SETTINGS_BLOB_VERSION
+ *   uint32_t schema hash, SETTINGS_SCHEMA_HASH. Changes when settings are added,
+ *            removed, reordered or change their type or range
+ *   uint16_t number of settings in the table
+ *   uint16_t index of the first setting in the blob
+ *   uint16_t number of settings in the blob
+ *
+ * Followed by the values in table order, each one using the size of its type.
+ * Strings end with a '\0'. Profile based settings use the current profile, like
+ * MSP2_COMMON_SETTING does.
+ */
+#define MSP_SETTINGS_BLOB_VERSION 1
+
+#define MSP_SETTINGS_BLOB_TIMEOUT_MS 1000
+
+typedef enum {
+    MSP_SETTINGS_BLOB_BEGIN     = 1 << 0,   // Start staging a new set of values from the current settings
+    MSP_SETTINGS_BLOB_COMMIT    = 1 << 1,   // Validate and apply the staged values
+} mspSettingsBlobFlags_e;
+
+static bool mspSettingsBlobActive;
+static uint8_t mspSettingsBlobCopyGeneration;
+static timeMs_t mspSettingsBlobLastFrameMs;
+
+static bool mspWriteSettingValue(sbuf_t *dst, const setting_t *setting)
+{
+    const void *ptr = settingGetValuePointer(setting);
+    size_t size = settingGetValueSize(setting);
+    if (SETTING_TYPE(setting) == VAR_STRING) {
+        size = strlen(ptr) + 1;
+    }
+    if ((size_t)sbufBytesRemaining(dst) < size) {
+        return false;
+    }
+    sbufWriteData(dst, ptr, size);
+    return true;
+}
+
+// Request: [first index (uint16_t)] [max number of settings (uint16_t)].
+// Replies with as many settings as fit, starting at the first one.
+static bool mspSettingsBlobCommand(sbuf_t *dst, sbuf_t *src)
+{
+    uint16_t first = 0;
+    uint16_t count = SETTINGS_TABLE_COUNT;
+
+    if (sbufReadU16Safe(&first, src)) {
+        sbufReadU16Safe(&count, src);
+    }
+    if (first > SETTINGS_TABLE_COUNT) {
+        return false;
+    }
+    count = MIN(count, SETTINGS_TABLE_COUNT - first);
+
+    sbufWriteU8(dst, MSP_SETTINGS_BLOB_VERSION);
+    sbufWriteU32(dst, SETTINGS_SCHEMA_HASH);
+    sbufWriteU16(dst, SETTINGS_TABLE_COUNT);
+    sbufWriteU16(dst, first);
+    uint8_t *countPtr = sbufPtr(dst);
+    sbufWriteU16(dst, 0);
+
+    uint16_t written = 0;
+    while (written < count && mspWriteSettingValue(dst, settingGet(first + written))) {
+        written++;
+    }
+    countPtr[0] = written & 0xFF;
+    countPtr[1] = written >> 8;
+    return true;
+}
+
+// The staged values are simply dropped, the settings in use were never touched
+static bool mspSettingsBlobAbort(void)
+{
+    mspSettingsBlobActive = false;
+    return false;
+}
+
+// Request: flags (mspSettingsBlobFlags_e), then a settings blob. A config
+// spanning several frames is applied as one transaction, which starts
+// with MSP_SETTINGS_BLOB_BEGIN and ends with MSP_SETTINGS_BLOB_COMMIT.
+// Values are staged in the PG copies and only swapped in on commit, if
+// they pass settingsValidate(). A rejected frame, a gap of more than
+// MSP_SETTINGS_BLOB_TIMEOUT_MS between frames or a CLI dump reusing the
+// copies drops the transaction.
+static bool mspSetSettingsBlobCommand(sbuf_t *dst, sbuf_t *src)
+{
+    UNUSED(dst);
+
+    uint8_t flags;
+    uint8_t version;
+    uint32_t schemaHash;
+    uint16_t total;
+    uint16_t first;
+    uint16_t count;
+
+    if (!sbufReadU8Safe(&flags, src) || !sbufReadU8Safe(&version, src) ||
+        !sbufReadU32Safe(&schemaHash, src) || !sbufReadU16Safe(&total, src) ||
+        !sbufReadU16Safe(&first, src) || !sbufReadU16Safe(&count, src)) {
+        return mspSettingsBlobAbort();
+    }
+    if (version != MSP_SETTINGS_BLOB_VERSION || schemaHash != SETTINGS_SCHEMA_HASH ||
+        total != SETTINGS_TABLE_COUNT || first + count > SETTINGS_TABLE_COUNT) {
+        return mspSettingsBlobAbort();
+    }
+
+    const timeMs_t now = millis();
+    if (flags & MSP_SETTINGS_BLOB_BEGIN) {
+        pgBackupAll(MAX_PROFILE_COUNT);
+        mspSettingsBlobCopyGeneration = pgGetCopyGeneration();
+        mspSettingsBlobActive = true;
+    } else if (now - mspSettingsBlobLastFrameMs > MSP_SETTINGS_BLOB_TIMEOUT_MS || mspSettingsBlobCopyGeneration != pgGetCopyGeneration()) {
+        return mspSettingsBlobAbort();
+    }
+    if (!mspSettingsBlobActive) {
+        return false;
+    }
+    mspSettingsBlobLastFrameMs = now;
+
+    for (unsigned ii = first; ii < first + count; ii++) {
+        const setting_t *setting = settingGet(ii);
+        if (!mspReadSettingValue(setting, settingGetCopyValuePointer(setting), src)) {
+            return mspSettingsBlobAbort();
+        }
+    }
+    if (sbufBytesRemaining(src) != 0) {
+        return mspSettingsBlobAbort();
+    }
+
+    if (flags & MSP_SETTINGS_BLOB_COMMIT) {
+        mspSettingsBlobActive = false;
+        pgSwapAll(MAX_PROFILE_COUNT);
+        if (!settingsValidate(NULL)) {
+            pgSwapAll(MAX_PROFILE_COUNT);
+            return false;
+        }
+        // Every PG was replaced, including the mode ranges
+        updateUsedModeActivationConditionFlags();
+    }
+    return true;
+}
+
 #ifdef USE_SIMULATOR
 bool isOSDTypeSupportedBySimulator(void)
 {
@@ -3779,6 +3975,14 @@ bool mspFCProcessInOutCommand(uint16_t cmdMSP, sbuf_t *dst, sbuf_t *src, mspResu
         *ret = mspParameterGroupsCommand(dst, src) ? MSP_RESULT_ACK : MSP_RESULT_ERROR;
         break;
 
+    case MSP2_COMMON_SETTINGS_BLOB:
+        *ret = mspSettingsBlobCommand(dst, src) ? MSP_RESULT_ACK : MSP_RESULT_ERROR;
+        break;
+
+    case MSP2_COMMON_SET_SETTINGS_BLOB:
+        *ret = mspSetSettingsBlobCommand(dst, src) ? MSP_RESULT_ACK : MSP_RESULT_ERROR;
+        break;
+
 #if defined(USE_OSD)
     case MSP2_INAV_OSD_LAYOUTS:
         if (sbufBytesRemaining(src) >= 1) {
@@ -3940,6 +4144,7 @@ bool mspFCProcessInOutCommand(uint16_t cmdMSP, sbuf_t *dst, sbuf_t *src, mspResu
                 if (sensors(SENSOR_BARO)) {
                     baro.baroPressure = (int32_t)sbufReadU32(src);
                     baro.baroTemperature = DEGREES_TO_CENTIDEGREES(SIMULATOR_BARO_TEMP);
+                    baroPublishSample(micros());
                 } else {
                     sbufAdvance(src, sizeof(uint32_t));
                 }
@@ -3948,6 +4153,7 @@ bool mspFCProcessInOutCommand(uint16_t cmdMSP, sbuf_t *dst, sbuf_t *src, mspResu
                     mag.magADC[X] = ((int16_t)sbufReadU16(src)) / 20;  // 16000 / 20 = 800uT
                     mag.magADC[Y] = ((int16_t)sbufReadU16(src)) / 20;   //note that mag failure is simulated by setting all readings to zero
                     mag.magADC[Z] = ((int16_t)sbufReadU16(src)) / 20;
+                    compassPublishSample(micros());
                 } else {
                     sbufAdvance(src, sizeof(uint16_t) * XYZ_AXIS_COUNT);
                 }
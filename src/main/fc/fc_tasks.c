@@ -158,6 +158,20 @@ void taskUpdateTemperature(timeUs_t currentTimeUs)
 }
 
 #ifdef USE_GPS
+// Run as soon as the receiver has sent data, but no faster than GPS_TASK_MIN_PERIOD_US
+#define GPS_TASK_MIN_PERIOD_US  TASK_PERIOD_HZ(500)
+
+bool taskProcessGPSCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTime)
+{
+    UNUSED(currentTimeUs);
+
+    if (currentDeltaTime >= TASK_PERIOD_HZ(50)) {
+        return true;
+    }
+
+    return currentDeltaTime >= GPS_TASK_MIN_PERIOD_US && feature(FEATURE_GPS) && gpsHasPendingData();
+}
+
 void taskProcessGPS(timeUs_t currentTimeUs)
 {
     // if GPS feature is enabled, gpsThread() will be called at some intervals to check for stuck
@@ -201,12 +215,20 @@ void taskUpdateBaro(timeUs_t currentTimeUs)
         return;
     }
 
+    static uint32_t baroSamplesSeen = 0;
+    sensorSample_t sample;
+
+    UNUSED(currentTimeUs);
+
     const uint32_t newDeadline = baroUpdate();
     if (newDeadline != 0) {
         rescheduleTask(TASK_SELF, newDeadline);
     }
 
-    updatePositionEstimator_BaroTopic(currentTimeUs);
+    // Every other run only kicks off a conversion, estimator has nothing to do then
+    if (sensorSampleRingHasNewSample(&baro.samples, &baroSamplesSeen) && sensorSampleRingGetLatest(&baro.samples, &sample)) {
+        updatePositionEstimator_BaroTopic(sample.timeUs);
+    }
 }
 #endif
 
@@ -217,10 +239,15 @@ void taskUpdatePitot(timeUs_t currentTimeUs)
         return;
     }
 
+    static uint32_t pitotSamplesSeen = 0;
+    sensorSample_t sample;
+
+    UNUSED(currentTimeUs);
+
     pitotUpdate();
 
-    if ( pitotIsHealthy()) {
-        updatePositionEstimator_PitotTopic(currentTimeUs);
+    if (sensorSampleRingHasNewSample(&pitot.samples, &pitotSamplesSeen) && pitotIsHealthy() && sensorSampleRingGetLatest(&pitot.samples, &sample)) {
+        updatePositionEstimator_PitotTopic(sample.timeUs);
     }
 }
 #endif
@@ -242,8 +269,9 @@ void taskUpdateRangefinder(timeUs_t currentTimeUs)
     /*
      * Process raw rangefinder readout
      */
-    if (rangefinderProcess(calculateCosTiltAngle())) {
-        updatePositionEstimator_SurfaceTopic(currentTimeUs, rangefinderGetLatestAltitude());
+    sensorSample_t sample;
+    if (rangefinderProcess(calculateCosTiltAngle()) && sensorSampleRingGetLatest(&rangefinder.samples, &sample)) {
+        updatePositionEstimator_SurfaceTopic(sample.timeUs, sample.value[RANGEFINDER_SAMPLE_CALCULATED_ALTITUDE]);
     }
 }
 #endif
@@ -257,13 +285,33 @@ void taskUpdateIrlock(timeUs_t currentTimeUs)
 #endif
 
 #ifdef USE_OPFLOW
+// Run as soon as a flow frame arrived so it is fused at the sensor rate, not faster than OPFLOW_TASK_MIN_PERIOD_US
+#define OPFLOW_TASK_MIN_PERIOD_US   TASK_PERIOD_HZ(500)
+
+bool taskUpdateOpticalFlowCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTime)
+{
+    UNUSED(currentTimeUs);
+
+    if (currentDeltaTime >= TASK_PERIOD_HZ(100)) {
+        return true;
+    }
+
+    return currentDeltaTime >= OPFLOW_TASK_MIN_PERIOD_US && sensors(SENSOR_OPFLOW) && opflowHasPendingData();
+}
+
 void taskUpdateOpticalFlow(timeUs_t currentTimeUs)
 {
     if (!sensors(SENSOR_OPFLOW))
         return;
 
+    static uint32_t opflowSamplesSeen = 0;
+    sensorSample_t sample;
+
     opflowUpdate(currentTimeUs);
-    updatePositionEstimator_OpticalFlowTopic(currentTimeUs);
+
+    if (sensorSampleRingHasNewSample(&opflow.samples, &opflowSamplesSeen) && sensorSampleRingGetLatest(&opflow.samples, &sample)) {
+        updatePositionEstimator_OpticalFlowTopic(sample.timeUs);
+    }
 }
 #endif
 
@@ -500,8 +548,9 @@ cfTask_t cfTasks[TASK_COUNT] = {
 #ifdef USE_GPS
     [TASK_GPS] = {
         .taskName = "GPS",
+        .checkFunc = taskProcessGPSCheck,
         .taskFunc = taskProcessGPS,
-        .desiredPeriod = TASK_PERIOD_HZ(50),      // GPS usually don't go raster than 10Hz
+        .desiredPeriod = TASK_PERIOD_HZ(50),      // Event driven on received data, falls back to 50Hz polling
         .staticPriority = TASK_PRIORITY_MEDIUM,
     },
 #endif
@@ -635,8 +684,9 @@ cfTask_t cfTasks[TASK_COUNT] = {
 #ifdef USE_OPFLOW
     [TASK_OPFLOW] = {
         .taskName = "OPFLOW",
+        .checkFunc = taskUpdateOpticalFlowCheck,
         .taskFunc = taskUpdateOpticalFlow,
-        .desiredPeriod = TASK_PERIOD_HZ(100),   // I2C/SPI sensor will work at higher rate and accumulate, UART sensor will work at lower rate w/o accumulation
+        .desiredPeriod = TASK_PERIOD_HZ(100),   // Event driven for UART/MSP sensors, I2C/SPI sensors are polled and accumulate
         .staticPriority = TASK_PRIORITY_MEDIUM,
     },
 #endif
@@ -0,0 +1,114 @@
+/*
+ * This file is part of INAV.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU General Public License Version 3, as described below:
+ *
+ * This file is free software: you may copy, redistribute and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+
+#include "common/maths.h"
+#include "common/utils.h"
+
+#include "drivers/time.h"
+
+#include "fc/rc_latency.h"
+
+static rcLatencyStats_t rcLatencyStats[RC_LATENCY_STAGE_COUNT];
+
+// Timestamp of the previous stage for the RC sample currently travelling through the pipeline
+static timeUs_t rxProcessedAtUs;
+static timeUs_t pidUpdatedAtUs;
+static bool pidUpdatePending;
+static bool motorUpdatePending;
+
+static void rcLatencyAddSample(rcLatencyStage_e stage, timeDelta_t latencyUs)
+{
+    rcLatencyStats_t *stats = &rcLatencyStats[stage];
+    const uint16_t sample = constrain(latencyUs, 0, UINT16_MAX);
+
+    stats->lastUs = sample;
+    stats->minUs = stats->count ? MIN(stats->minUs, sample) : sample;
+    stats->maxUs = MAX(stats->maxUs, sample);
+    stats->sumUs += sample;
+    stats->count++;
+
+    unsigned bin = 0;
+    while (bin < RC_LATENCY_HISTOGRAM_BINS - 1 && sample >= (RC_LATENCY_HISTOGRAM_BASE_US << bin)) {
+        bin++;
+    }
+
+    if (stats->histogram[bin] < UINT16_MAX) {
+        stats->histogram[bin]++;
+    }
+}
+
+void rcLatencyReset(void)
+{
+    memset(rcLatencyStats, 0, sizeof(rcLatencyStats));
+    pidUpdatePending = false;
+    motorUpdatePending = false;
+}
+
+void rcLatencyOnRxFrameProcessed(timeUs_t frameTimeUs, timeUs_t currentTimeUs)
+{
+    rcLatencyAddSample(RC_LATENCY_FRAME_TO_RX, cmpTimeUs(currentTimeUs, frameTimeUs));
+
+    rxProcessedAtUs = currentTimeUs;
+    pidUpdatePending = true;
+}
+
+void rcLatencyOnPidUpdate(void)
+{
+    if (!pidUpdatePending) {
+        return;
+    }
+
+    pidUpdatedAtUs = micros();
+    rcLatencyAddSample(RC_LATENCY_RX_TO_PID, cmpTimeUs(pidUpdatedAtUs, rxProcessedAtUs));
+
+    pidUpdatePending = false;
+    motorUpdatePending = true;
+}
+
+void rcLatencyOnMotorUpdate(void)
+{
+    if (!motorUpdatePending) {
+        return;
+    }
+
+    rcLatencyAddSample(RC_LATENCY_PID_TO_MOTOR, cmpTimeUs(micros(), pidUpdatedAtUs));
+    motorUpdatePending = false;
+}
+
+const rcLatencyStats_t *rcLatencyGetStats(rcLatencyStage_e stage)
+{
+    return &rcLatencyStats[stage];
+}
+
+uint16_t rcLatencyGetLastUs(rcLatencyStage_e stage)
+{
+    return rcLatencyStats[stage].lastUs;
+}
@@ -0,0 +1,67 @@
+/*
+ * This file is part of INAV.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU General Public License Version 3, as described below:
+ *
+ * This file is free software: you may copy, redistribute and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/time.h"
+
+/*
+ * Stick-to-motor latency is split into three stages, each measured once per
+ * RC frame:
+ *  - FRAME_TO_RX:    last byte of the RC frame received -> RX task decoded channels
+ *  - RX_TO_PID:      RX task decoded channels -> first PID loop using the new sample
+ *  - PID_TO_MOTOR:   PID loop computed the output -> motor output written
+ */
+typedef enum {
+    RC_LATENCY_FRAME_TO_RX = 0,
+    RC_LATENCY_RX_TO_PID,
+    RC_LATENCY_PID_TO_MOTOR,
+    RC_LATENCY_STAGE_COUNT
+} rcLatencyStage_e;
+
+// Histogram bin N counts samples below (RC_LATENCY_HISTOGRAM_BASE_US << N), last bin counts everything above
+#define RC_LATENCY_HISTOGRAM_BINS       8
+#define RC_LATENCY_HISTOGRAM_BASE_US    250
+
+typedef struct rcLatencyStats_s {
+    uint16_t lastUs;
+    uint16_t minUs;
+    uint16_t maxUs;
+    uint32_t sumUs;
+    uint32_t count;
+    uint16_t histogram[RC_LATENCY_HISTOGRAM_BINS];
+} rcLatencyStats_t;
+
+void rcLatencyReset(void);
+
+void rcLatencyOnRxFrameProcessed(timeUs_t frameTimeUs, timeUs_t currentTimeUs);
+void rcLatencyOnPidUpdate(void);
+void rcLatencyOnMotorUpdate(void);
+
+const rcLatencyStats_t *rcLatencyGetStats(rcLatencyStage_e stage);
+uint16_t rcLatencyGetLastUs(rcLatencyStage_e stage);
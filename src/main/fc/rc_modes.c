@@ -41,6 +41,24 @@
 static uint8_t specifiedConditionCountPerMode[CHECKBOX_ITEM_COUNT];
 static bool isUsingNAVModes = false;
 
+typedef struct modeActivationRange_s {
+    uint8_t startStep;
+    uint8_t endStep;
+    uint8_t modeId;
+} modeActivationRange_t;
+
+// Usable mode activation ranges compiled at config load, grouped by AUX channel and sorted by startStep
+static modeActivationRange_t modeActivationRanges[MAX_MODE_ACTIVATION_CONDITION_COUNT];
+static uint8_t auxChannelRangesStart[MAX_AUX_CHANNEL_COUNT + 1];
+static uint8_t usedAuxChannels[MAX_AUX_CHANNEL_COUNT];
+static uint8_t usedAuxChannelCount;
+
+// Incremental evaluation state: last evaluated step of each used AUX channel and active range count per mode
+static int16_t auxChannelSteps[MAX_AUX_CHANNEL_COUNT];
+static uint8_t activeRangeCountPerMode[CHECKBOX_ITEM_COUNT];
+static uint8_t activeModeActivationOperator;
+static bool modeActivationUpdateRequired = true;
+
 boxBitmask_t rcModeActivationMask; // one bit per mode defined in boxId_e
 
 // TODO(alberto): It looks like we can now safely remove this assert, since everything
@@ -194,8 +212,163 @@ void updateActivatedModes(void)
     rcModeUpdate(&newMask);
 }
 
+// Step of a channel value, -1 below CHANNEL_RANGE_MIN. Matches the range test done by isRangeActive()
+static int16_t channelValueToRangeStep(uint16_t channelValue)
+{
+    if (channelValue < CHANNEL_RANGE_MIN) {
+        return -1;
+    }
+
+    return MIN((channelValue - CHANNEL_RANGE_MIN) / CHANNEL_RANGE_STEP_WIDTH, UINT8_MAX);
+}
+
+static bool isStepInRange(int16_t step, const modeActivationRange_t *range)
+{
+    return step >= range->startStep && step < range->endStep;
+}
+
+static void applyModeActivationState(uint8_t modeId)
+{
+    bool active;
+
+    if (modeActivationOperatorConfig()->modeActivationOperator == MODE_OPERATOR_AND) {
+        active = activeRangeCountPerMode[modeId] == specifiedConditionCountPerMode[modeId];
+    } else {
+        active = activeRangeCountPerMode[modeId] > 0;
+    }
+
+    if (active && specifiedConditionCountPerMode[modeId] > 0) {
+        bitArraySet(rcModeActivationMask.bits, modeId);
+    } else {
+        bitArrayClr(rcModeActivationMask.bits, modeId);
+    }
+}
+
+static void rebuildActivatedModes(void)
+{
+    memset(activeRangeCountPerMode, 0, sizeof(activeRangeCountPerMode));
+
+    for (int i = 0; i < usedAuxChannelCount; i++) {
+        const uint8_t auxChannelIndex = usedAuxChannels[i];
+        const int16_t step = channelValueToRangeStep(rxGetChannelValue(auxChannelIndex + NON_AUX_CHANNEL_COUNT));
+
+        auxChannelSteps[auxChannelIndex] = step;
+        for (int r = auxChannelRangesStart[auxChannelIndex]; r < auxChannelRangesStart[auxChannelIndex + 1]; r++) {
+            if (isStepInRange(step, &modeActivationRanges[r])) {
+                activeRangeCountPerMode[modeActivationRanges[r].modeId]++;
+            }
+        }
+    }
+
+    for (int modeIndex = 0; modeIndex < CHECKBOX_ITEM_COUNT; modeIndex++) {
+        applyModeActivationState(modeIndex);
+    }
+}
+
+/*
+ * Incremental version of updateActivatedModes(). Only ranges of AUX channels that moved to another
+ * step since the previous call are tested, and only modes owning those ranges are updated.
+ * Returns true if any mode activation could have changed.
+ */
+bool updateActivatedModesOnChange(bool forceUpdate)
+{
+    if (activeModeActivationOperator != modeActivationOperatorConfig()->modeActivationOperator) {
+        activeModeActivationOperator = modeActivationOperatorConfig()->modeActivationOperator;
+        forceUpdate = true;
+    }
+
+    if (forceUpdate || modeActivationUpdateRequired) {
+        modeActivationUpdateRequired = false;
+        rebuildActivatedModes();
+        return true;
+    }
+
+    bool changed = false;
+
+    for (int i = 0; i < usedAuxChannelCount; i++) {
+        const uint8_t auxChannelIndex = usedAuxChannels[i];
+        const int16_t oldStep = auxChannelSteps[auxChannelIndex];
+        const int16_t newStep = channelValueToRangeStep(rxGetChannelValue(auxChannelIndex + NON_AUX_CHANNEL_COUNT));
+
+        if (newStep == oldStep) {
+            continue;
+        }
+
+        auxChannelSteps[auxChannelIndex] = newStep;
+
+        const int16_t highestStep = MAX(oldStep, newStep);
+        for (int r = auxChannelRangesStart[auxChannelIndex]; r < auxChannelRangesStart[auxChannelIndex + 1]; r++) {
+            const modeActivationRange_t *range = &modeActivationRanges[r];
+
+            // Ranges are sorted by startStep, the remaining ones contain neither step
+            if (range->startStep > highestStep) {
+                break;
+            }
+
+            const bool wasActive = isStepInRange(oldStep, range);
+            const bool isActive = isStepInRange(newStep, range);
+
+            if (wasActive != isActive) {
+                if (isActive) {
+                    activeRangeCountPerMode[range->modeId]++;
+                } else {
+                    activeRangeCountPerMode[range->modeId]--;
+                }
+                applyModeActivationState(range->modeId);
+                changed = true;
+            }
+        }
+    }
+
+    return changed;
+}
+
+static void compileModeActivationRanges(void)
+{
+    uint8_t rangeCountPerChannel[MAX_AUX_CHANNEL_COUNT];
+    memset(rangeCountPerChannel, 0, sizeof(rangeCountPerChannel));
+
+    for (int index = 0; index < MAX_MODE_ACTIVATION_CONDITION_COUNT; index++) {
+        const modeActivationCondition_t *condition = modeActivationConditions(index);
+        if (IS_RANGE_USABLE(&condition->range) && condition->auxChannelIndex < MAX_AUX_CHANNEL_COUNT && condition->modeId < CHECKBOX_ITEM_COUNT) {
+            rangeCountPerChannel[condition->auxChannelIndex]++;
+        }
+    }
+
+    usedAuxChannelCount = 0;
+    auxChannelRangesStart[0] = 0;
+    for (int auxChannelIndex = 0; auxChannelIndex < MAX_AUX_CHANNEL_COUNT; auxChannelIndex++) {
+        auxChannelRangesStart[auxChannelIndex + 1] = auxChannelRangesStart[auxChannelIndex] + rangeCountPerChannel[auxChannelIndex];
+        if (rangeCountPerChannel[auxChannelIndex]) {
+            usedAuxChannels[usedAuxChannelCount++] = auxChannelIndex;
+        }
+        rangeCountPerChannel[auxChannelIndex] = 0;
+    }
+
+    // Insertion sort into each channel's slice, conditions are few and this only runs on config change
+    for (int index = 0; index < MAX_MODE_ACTIVATION_CONDITION_COUNT; index++) {
+        const modeActivationCondition_t *condition = modeActivationConditions(index);
+        if (!IS_RANGE_USABLE(&condition->range) || condition->auxChannelIndex >= MAX_AUX_CHANNEL_COUNT || condition->modeId >= CHECKBOX_ITEM_COUNT) {
+            continue;
+        }
+
+        modeActivationRange_t *slice = &modeActivationRanges[auxChannelRangesStart[condition->auxChannelIndex]];
+        int pos = rangeCountPerChannel[condition->auxChannelIndex]++;
+        while (pos > 0 && slice[pos - 1].startStep > condition->range.startStep) {
+            slice[pos] = slice[pos - 1];
+            pos--;
+        }
+        slice[pos].startStep = condition->range.startStep;
+        slice[pos].endStep = condition->range.endStep;
+        slice[pos].modeId = condition->modeId;
+    }
+}
+
 void updateUsedModeActivationConditionFlags(void)
 {
+    compileModeActivationRanges();
+    modeActivationUpdateRequired = true;
+
     memset(specifiedConditionCountPerMode, 0, CHECKBOX_ITEM_COUNT);
     for (int index = 0; index < MAX_MODE_ACTIVATION_CONDITION_COUNT; index++) {
         if (IS_RANGE_USABLE(&modeActivationConditions(index)->range)) {
@@ -139,4 +139,5 @@ bool isUsingNavigationModes(void);
 bool isRangeActive(uint8_t auxChannelIndex, const channelRange_t *range);
 
 void updateActivatedModes(void);
+bool updateActivatedModesOnChange(bool forceUpdate);
 void updateUsedModeActivationConditionFlags(void);
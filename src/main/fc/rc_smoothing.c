@@ -22,6 +22,7 @@
  * along with this program. If not, see http://www.gnu.org/licenses/.
  */
 
+#include <math.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -34,6 +35,7 @@
 
 #include "common/maths.h"
 #include "common/filter.h"
+#include "common/utils.h"
 
 #include "drivers/time.h"
 
@@ -50,10 +52,28 @@
 // RC Interpolation is not allowed to go below this value.
 #define RC_INTERPOLATION_MIN_FREQUENCY 15
 
+// Predictive interpolation does not extrapolate across gaps longer than this many frame periods
+#define RC_PREDICTOR_MAX_FRAME_GAP 4
+
+typedef struct rcPredictorState_s {
+    float value;            // Last received stick value
+    float slope;            // Stick units per second between the last two frames
+    float curvature;        // Stick units per second^2, only used in QUADRATIC mode
+    float stepLimit;        // Largest allowed distance of the extrapolation from the last received value
+    float stepError;        // Output discontinuity at frame arrival, bled out over one frame period
+    float output;
+    float derivative;       // Rate of change of the output in stick units per second
+} rcPredictorState_t;
+
 static pt3Filter_t rcSmoothFilter[4];
 static float rcStickUnfiltered[4];
 static uint16_t rcUpdateFrequency;
 
+static rcPredictorState_t rcPredictor[4];
+static timeUs_t rcPredictorFrameTimeUs;
+static float rcFrameJitter;
+static bool rcPredictorActive;
+
 uint16_t getRcUpdateFrequency(void) {
     return rcUpdateFrequency;
 }
@@ -75,6 +95,97 @@ static int32_t applyRcUpdateFrequencyMedianFilter(int32_t newReading)
     return medianFilterReady ? quickMedianFilter9(filterSamples) : newReading;
 }
 
+bool rcInterpolationIsPredictive(void)
+{
+    return rcPredictorActive;
+}
+
+float rcInterpolationGetStickDerivative(int stick)
+{
+    return rcPredictorActive ? rcPredictor[stick].derivative : 0.0f;
+}
+
+static void rcPredictorOnNewFrame(rcPredictorState_t *predictor, float newValue, float frameDelta, bool continuous, bool quadratic)
+{
+    const float step = newValue - predictor->value;
+
+    if (continuous) {
+        const float newSlope = step / frameDelta;
+        predictor->curvature = quadratic ? (newSlope - predictor->slope) / frameDelta : 0.0f;
+        predictor->slope = newSlope;
+        predictor->stepLimit = fabsf(step);
+    } else {
+        // Gap in the frame stream, restart the trajectory from the new sample
+        predictor->slope = 0.0f;
+        predictor->curvature = 0.0f;
+        predictor->stepLimit = 0.0f;
+    }
+
+    // Keep the output continuous: carry the prediction error and bleed it out over the next frame
+    predictor->stepError = predictor->output - newValue;
+    predictor->value = newValue;
+}
+
+static void rcPredictorApply(rcPredictorState_t *predictor, float sinceFrame, float framePeriod, float horizon, float minValue, float maxValue)
+{
+    const float t = MIN(sinceFrame, horizon);
+
+    float extrapolation = predictor->slope * t + 0.5f * predictor->curvature * t * t;
+    extrapolation = constrainf(extrapolation, -predictor->stepLimit, predictor->stepLimit);
+
+    float derivative = (sinceFrame < horizon) ? predictor->slope + predictor->curvature * t : 0.0f;
+
+    float bleed = 0.0f;
+    if (sinceFrame < framePeriod) {
+        bleed = predictor->stepError * (1.0f - sinceFrame / framePeriod);
+        derivative -= predictor->stepError / framePeriod;
+    }
+
+    predictor->output = constrainf(predictor->value + extrapolation + bleed, minValue, maxValue);
+    predictor->derivative = derivative;
+}
+
+/*
+ * Extrapolate stick positions between RC frames along the trajectory described by the last frames.
+ * Extrapolation never runs further than one frame period (shortened by the measured frame jitter)
+ * and never further from the last sample than the recent frame-to-frame step.
+ */
+static void rcPredictiveInterpolationApply(bool isRXDataNew, timeDelta_t frameDeltaUs, timeUs_t currentTimeUs)
+{
+    const float framePeriod = rcUpdateFrequency ? 1.0f / rcUpdateFrequency : 0.0f;
+
+    if (isRXDataNew) {
+        const float frameDelta = US2S(frameDeltaUs);
+        const bool continuous = framePeriod > 0.0f && frameDelta > 0.0f && frameDelta < framePeriod * RC_PREDICTOR_MAX_FRAME_GAP;
+        const bool quadratic = rxConfig()->rcFilterMode == RC_FILTER_MODE_QUADRATIC;
+
+        if (continuous) {
+            rcFrameJitter += 0.1f * (fabsf(frameDelta - framePeriod) - rcFrameJitter);
+        }
+
+        for (int stick = 0; stick < 4; stick++) {
+            rcPredictorOnNewFrame(&rcPredictor[stick], rcStickUnfiltered[stick], frameDelta, continuous, quadratic);
+        }
+
+        rcPredictorFrameTimeUs = rxGetFrameTimeUs();
+    }
+
+    if (framePeriod <= 0.0f) {
+        return;
+    }
+
+    const float sinceFrame = MAX(0, cmpTimeUs(currentTimeUs, rcPredictorFrameTimeUs)) * 0.000001f;
+    const float horizon = MAX(0.0f, framePeriod - rcFrameJitter);
+
+    for (int stick = 0; stick < 4; stick++) {
+        const float minValue = (stick == THROTTLE) ? PWM_RANGE_MIN : -500.0f;
+        const float maxValue = (stick == THROTTLE) ? PWM_RANGE_MAX : 500.0f;
+
+        rcPredictorApply(&rcPredictor[stick], sinceFrame, framePeriod, horizon, minValue, maxValue);
+        rcCommand[stick] = rcPredictor[stick].output;
+    }
+}
+
 void rcInterpolationApply(bool isRXDataNew, timeUs_t currentTimeUs)
 {
     // Compute the RC update frequency
@@ -92,8 +203,11 @@ void rcInterpolationApply(bool isRXDataNew, timeUs_t currentTimeUs)
             // Initialize the RC smooth filter
             for (int stick = 0; stick < 4; stick++) {
                 pt3FilterInit(&rcSmoothFilter[stick], pt3FilterGain(filterFrequency, dT));
+                rcPredictor[stick].value = rcCommand[stick];
+                rcPredictor[stick].output = rcCommand[stick];
             }
 
+            rcPredictorActive = rxConfig()->rcFilterMode != RC_FILTER_MODE_LPF;
             initDone = true;
         }
 
@@ -107,10 +221,16 @@ void rcInterpolationApply(bool isRXDataNew, timeUs_t currentTimeUs)
         return;
     }
 
+    timeDelta_t delta = 0;
+
     if (isRXDataNew) {
-        const timeDelta_t delta = cmpTimeUs(currentTimeUs, previousRcData);
-        rcUpdateFrequency = applyRcUpdateFrequencyMedianFilter(1.0f / (delta * 0.000001f));
-        previousRcData = currentTimeUs;
+        // Use the time the RC frame was received to avoid measuring scheduler jitter as RC rate jitter
+        const timeUs_t rcFrameTimeUs = rxGetFrameTimeUs();
+        delta = cmpTimeUs(rcFrameTimeUs, previousRcData);
+        if (delta > 0) {
+            rcUpdateFrequency = applyRcUpdateFrequencyMedianFilter(1.0f / (delta * 0.000001f));
+        }
+        previousRcData = rcFrameTimeUs;
 
         /*
          * If auto smoothing is enabled, update the filters
@@ -140,6 +260,11 @@ void rcInterpolationApply(bool isRXDataNew, timeUs_t currentTimeUs)
 
     }
 
+    if (rcPredictorActive) {
+        rcPredictiveInterpolationApply(isRXDataNew, delta, currentTimeUs);
+        return;
+    }
+
     for (int stick = 0; stick < 4; stick++) {
         rcCommand[stick] = pt3FilterApply(&rcSmoothFilter[stick], rcStickUnfiltered[stick]);
     }
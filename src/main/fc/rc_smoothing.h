@@ -29,4 +29,6 @@
 #include <stdint.h>
 
 uint16_t getRcUpdateFrequency(void);
-void rcInterpolationApply(bool isRXDataNew, timeUs_t currentTimeUs);
\ No newline at end of file
+void rcInterpolationApply(bool isRXDataNew, timeUs_t currentTimeUs);
+bool rcInterpolationIsPredictive(void);
+float rcInterpolationGetStickDerivative(int stick);
\ No newline at end of file
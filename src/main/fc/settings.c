@@ -19,10 +19,13 @@ static bool settingGetWord(char *buf, int idx)
 	if (idx == 0) {
 		return false;
 	}
-	const uint8_t *ptr = settingNamesWords;
+	// Start from the closest indexed word rather than from the first one
+	const unsigned indexed = (idx - 1) / SETTING_NAMES_WORDS_INDEX_STEP;
+	const unsigned bit = settingNamesWordsIndex[indexed];
+	const uint8_t *ptr = settingNamesWords + bit / 8;
 	char *bufPtr = buf;
-	int used_bits = 0;
-	int word = 1;
+	int used_bits = bit % 8;
+	int word = 1 + indexed * SETTING_NAMES_WORDS_INDEX_STEP;
 	for(;;) {
 		int shift = 8 - SETTINGS_WORDS_BITS_PER_CHAR - used_bits;
 		char chr;
@@ -111,17 +114,33 @@ bool settingNameIsExactMatch(const setting_t *val, char *buf, const char *cmdlin
 	return sl_strncasecmp(cmdline, buf, strlen(buf)) == 0 && var_name_length == strlen(buf);
 }
 
+// FNV-1a, keep in sync with NameHash.name_hash in utils/settings.rb
+static uint32_t settingNameHash(const char *name, uint32_t seed)
+{
+	uint32_t hash = 2166136261U ^ (seed * 0x9E3779B1U);
+	for (; *name; name++) {
+		hash = (hash ^ (uint8_t)*name) * 16777619U;
+	}
+	return hash;
+}
+
 const setting_t *settingFind(const char *name)
 {
-	char buf[SETTING_MAX_NAME_LENGTH];
-	for (int ii = 0; ii < SETTINGS_TABLE_COUNT; ii++) {
-		const setting_t *setting = &settingsTable[ii];
-		settingGetName(setting, buf);
-		if (strcmp(buf, name) == 0) {
-			return setting;
-		}
+	// settingNameHashBuckets and settingNameHashSlots form a minimal
+	// perfect hash of all the names, generated by utils/settings.rb.
+	// Any name maps to a single candidate, which is then decoded to
+	// verify it's the one we're looking for.
+	const uint16_t bucket = settingNameHashBuckets[settingNameHash(name, 0) % SETTING_NAME_HASH_BUCKETS];
+	unsigned slot;
+	if (bucket & SETTING_NAME_HASH_DIRECT_SLOT) {
+		slot = bucket & ~SETTING_NAME_HASH_DIRECT_SLOT;
+	} else {
+		slot = settingNameHash(name, bucket) % SETTINGS_TABLE_COUNT;
 	}
-	return NULL;
+	const setting_t *setting = &settingsTable[settingNameHashSlots[slot]];
+	char buf[SETTING_MAX_NAME_LENGTH];
+	settingGetName(setting, buf);
+	return strcmp(buf, name) == 0 ? setting : NULL;
 }
 
 const setting_t *settingGet(unsigned index)
@@ -253,7 +272,7 @@ void *settingGetValuePointer(const setting_t *val)
     return pg->address + getValueOffset(val);
 }
 
-const void * settingGetCopyValuePointer(const setting_t *val)
+void * settingGetCopyValuePointer(const setting_t *val)
 {
     const pgRegistry_t *pg = pgFind(settingGetPgn(val));
     return pg->copy + getValueOffset(val);
@@ -348,3 +367,18 @@ bool settingsGetParameterGroupIndexes(pgn_t pg, uint16_t *start, uint16_t *end)
 	}
 	return false;
 }
+
+pgn_t settingsGetParameterGroupByIndex(unsigned index, uint16_t *start, uint16_t *end)
+{
+	unsigned acc = 0;
+	for (unsigned ii = 0; ii < index; ii++) {
+		acc += settingsPgnCounts[ii];
+	}
+	if (start) {
+		*start = acc;
+	}
+	if (end) {
+		*end = acc + settingsPgnCounts[index] - 1;
+	}
+	return settingsPgn[index];
+}
@@ -97,9 +97,9 @@ pgn_t settingGetPgn(const setting_t *val);
 void * settingGetValuePointer(const setting_t *val);
 // Returns a pointer to the backed up copy of the value. Note that
 // this will contain random garbage unless a copy of the parameter
-// group for the value has been manually performed. Currently, this
-// is only used by cli.c during config dumps.
-const void * settingGetCopyValuePointer(const setting_t *val);
+// group for the value has been manually performed. Used by cli.c
+// during config dumps and to stage MSP settings blobs.
+void * settingGetCopyValuePointer(const setting_t *val);
 // Returns the minimum valid value for the given setting_t. setting_min_t
 // depends on the target and build options, but will always be a signed
 // integer (e.g. intxx_t,)
@@ -132,3 +132,8 @@ setting_max_t settingGetStringMaxLength(const setting_t *val);
 // Retrieve the setting indexes for the given PG. If the PG is not
 // found, these function returns false.
 bool settingsGetParameterGroupIndexes(pgn_t pg, uint16_t *start, uint16_t *end);
+
+// Retrieve the PG and its setting indexes for the given PG index in
+// the settings table, from 0 to SETTINGS_PGN_COUNT - 1. Settings for
+// each PG are contiguous and PGs are stored in table order.
+pgn_t settingsGetParameterGroupByIndex(unsigned index, uint16_t *start, uint16_t *end);
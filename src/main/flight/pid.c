@@ -37,6 +37,7 @@
 #include "fc/controlrate_profile.h"
 #include "fc/rc_controls.h"
 #include "fc/rc_modes.h"
+#include "fc/rc_smoothing.h"
 #include "fc/runtime_config.h"
 #include "fc/settings.h"
 
@@ -102,6 +103,11 @@ typedef struct {
     float previousRateTarget;
     float previousRateGyro;
 
+    // Setpoint change over one loop predicted by RC interpolation. Used by Control Derivative only while
+    // the final rate target is still the stick-derived one, cleared by anything that replaces or alters it
+    float predictedRateTargetDelta;
+    bool predictedRateTargetDeltaValid;
+
 #ifdef USE_D_BOOST
     pt1Filter_t dBoostLpf;
     biquadFilter_t dBoostGyroLpf;
@@ -669,6 +675,7 @@ static void pidLevel(const float angleTarget, pidState_t *pidState, flight_dynam
     } else {
         pidState->rateTarget = angleRateTarget;
     }
+    pidState->predictedRateTargetDeltaValid = false;
 }
 
 /* Apply angular acceleration limit to rate target to limit extreme stick inputs to respect physical capabilities of the machine */
@@ -678,6 +685,7 @@ static void pidApplySetpointRateLimiting(pidState_t *pidState, flight_dynamics_i
 
     if (axisAccelLimit > AXIS_ACCEL_MIN_LIMIT) {
         pidState->rateTarget = rateLimitFilterApply4(&pidState->axisAccelFilter, pidState->rateTarget, (float)axisAccelLimit, dT);
+        pidState->predictedRateTargetDeltaValid = false;
     }
 }
 
@@ -866,7 +874,8 @@ static void FAST_CODE NOINLINE pidApplyMulticopterRateController(pidState_t *pid
     const float newPTerm = pTermProcess(pidState, rateError, dT);
     const float newDTerm = dTermProcess(pidState, rateTarget, dT, dT_inv);
 
-    const float rateTargetDelta = rateTarget - pidState->previousRateTarget;
+    const bool usePredictedDelta = pidState->predictedRateTargetDeltaValid && !isFlightAxisRateOverrideActive(pidState->axis);
+    const float rateTargetDelta = usePredictedDelta ? pidState->predictedRateTargetDelta : rateTarget - pidState->previousRateTarget;
     const float rateTargetDeltaFiltered = pt3FilterApply(&pidState->rateTargetFilter, rateTargetDelta);
 
     /*
@@ -1051,6 +1060,10 @@ static void NOINLINE pidTurnAssistant(pidState_t *pidState, float bankAngleTarge
     // Transform calculated rate offsets into body frame and apply
     imuTransformVectorEarthToBody(&targetRates);
 
+    for (int axis = 0; axis < 3; axis++) {
+        pidState[axis].predictedRateTargetDeltaValid = false;
+    }
+
     // Add in roll and pitch
     pidState[ROLL].rateTarget = constrainf(pidState[ROLL].rateTarget + targetRates.x, -currentControlRateProfile->stabilized.rates[ROLL] * 10.0f, currentControlRateProfile->stabilized.rates[ROLL] * 10.0f);
     pidState[PITCH].rateTarget = constrainf(pidState[PITCH].rateTarget + targetRates.y * pidProfile()->fixedWingCoordinatedPitchGain, -currentControlRateProfile->stabilized.rates[PITCH] * 10.0f, currentControlRateProfile->stabilized.rates[PITCH] * 10.0f);
@@ -1081,6 +1094,8 @@ static void pidApplyFpvCameraAngleMix(pidState_t *pidState, uint8_t fpvCameraAng
     const float yawRate = pidState[YAW].rateTarget;
     pidState[ROLL].rateTarget = constrainf(rollRate * cosCameraAngle -  yawRate * sinCameraAngle, -GYRO_SATURATION_LIMIT, GYRO_SATURATION_LIMIT);
     pidState[YAW].rateTarget = constrainf(yawRate * cosCameraAngle + rollRate * sinCameraAngle, -GYRO_SATURATION_LIMIT, GYRO_SATURATION_LIMIT);
+    pidState[ROLL].predictedRateTargetDeltaValid = false;
+    pidState[YAW].predictedRateTargetDeltaValid = false;
 }
 
 void checkItermLimitingActive(pidState_t *pidState)
@@ -1193,18 +1208,31 @@ void FAST_CODE pidController(float dT)
         // Step 2: Read target
         float rateTarget;
 
+        pidState[axis].predictedRateTargetDeltaValid = false;
+
         if (axis == FD_YAW && headingHoldState == HEADING_HOLD_ENABLED) {
             rateTarget = pidHeadingHold(dT);
         } else {
 #ifdef USE_PROGRAMMING_FRAMEWORK
-            rateTarget = pidRcCommandToRate(getRcCommandOverride(rcCommand, axis), currentControlRateProfile->stabilized.rates[axis]);
+            const int16_t stick = getRcCommandOverride(rcCommand, axis);
 #else
-            rateTarget = pidRcCommandToRate(rcCommand[axis], currentControlRateProfile->stabilized.rates[axis]);
+            const int16_t stick = rcCommand[axis];
 #endif
+            rateTarget = pidRcCommandToRate(stick, currentControlRateProfile->stabilized.rates[axis]);
+
+            if (rcInterpolationIsPredictive() && stick == rcCommand[axis]) {
+                // Stick derivative is in rcCommand units per second, scale it the same way as the stick itself
+                const float maxRateDPS = currentControlRateProfile->stabilized.rates[axis] * 10.0f;
+                pidState[axis].predictedRateTargetDelta = rcInterpolationGetStickDerivative(axis) * (maxRateDPS / 500.0f) * dT;
+                pidState[axis].predictedRateTargetDeltaValid = true;
+            }
         }
 
         // Limit desired rate to something gyro can measure reliably
         pidState[axis].rateTarget = constrainf(rateTarget, -GYRO_SATURATION_LIMIT, +GYRO_SATURATION_LIMIT);
+        if (fabsf(rateTarget) > GYRO_SATURATION_LIMIT) {
+            pidState[axis].predictedRateTargetDeltaValid = false;
+        }
 
 #ifdef USE_GYRO_KALMAN
         gyroKalmanUpdateSetpoint(axis, pidState[axis].rateTarget);
@@ -510,6 +510,8 @@ void dashboardUpdate(timeUs_t currentTimeUs)
         updateRxStatus();
         updateTicker();
     }
+
+    i2c_OLED_flush();
 }
 
 void dashboardSetPage(pageId_e newPageId)
@@ -597,8 +597,12 @@ static const displayCanvasVTable_t frskyOSDCanvasVTable = {
 
 static bool getCanvas(displayCanvas_t *canvas, const displayPort_t *instance)
 {
+    // Every command goes through the serial port, skip regions that didn't change
+    static displayCanvasRegionCache_t regions;
+
     canvas->device = instance->device;
     canvas->vTable = &frskyOSDCanvasVTable;
+    canvas->regions = &regions;
     canvas->width = frskyOSDGetPixelWidth();
     canvas->height = frskyOSDGetPixelHeight();
     return true;
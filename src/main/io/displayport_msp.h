@@ -29,6 +29,7 @@ typedef enum {
     MSP_DP_DRAW_SCREEN = 4,     // Trigger a screen draw
     MSP_DP_OPTIONS = 5,         // Not used by Betaflight. Reserved by Ardupilot and INAV
     MSP_DP_SYS = 6,             // Display system element displayportSystemElement_e at given coordinates
+    MSP_DP_WRITE_BATCH = 7,     // INAV extension, several (optionally run-length encoded) strings in one frame
     MSP_DP_COUNT,
 } displayportMspCommand_e;
 
@@ -67,12 +67,23 @@ typedef enum {          // defines are from hdzero code
 #define TX_BUFFER_SIZE 1024
 #define VTX_TIMEOUT 1000 // 1 second timer
 
+// Batched frames are sent as MSP V2, they can be a lot bigger than V1 allows
+#define BATCH_MAX_PAYLOAD       480
+#define BATCH_RECORD_HEADER     4
+// Shorter repeats are cheaper as part of a literal record
+#define BATCH_RLE_MIN_LENGTH    (BATCH_RECORD_HEADER + 2)
+// Unchanged characters between two dirty ones are resent if that is cheaper than a new record
+#define BATCH_MAX_GAP           BATCH_RECORD_HEADER
+#define BATCH_MAX_COUNT         0x7F
+
 static mspProcessCommandFnPtr mspProcessCommand;
 static mspPort_t mspPort;
 static displayPort_t mspOsdDisplayPort;
 static bool vtxSeen, vtxActive, vtxReset;
 static timeMs_t vtxHeartbeat;
 static timeMs_t sendSubFrameMs = 0;
+static uint8_t vtxOptions;                  // DISPLAYPORT_MSP_OPTION_*, negotiated with the device
+static displayportMspStats_t stats;
 
 // PAL screen size
 #define PAL_COLS 30
@@ -106,6 +117,9 @@ static bool screenCleared;
 static uint8_t screenRows, screenCols;
 static videoSystem_e osdVideoSystem;
 
+static uint8_t batch[BATCH_MAX_PAYLOAD];
+static int batchLength;
+
 extern uint8_t cliMode;
 
 static void checkVtxPresent(void)
@@ -119,7 +133,7 @@ static void checkVtxPresent(void)
     }
 }
 
-static int output(displayPort_t *displayPort, uint8_t cmd, uint8_t *subcmd, int len)
+static int outputVersion(displayPort_t *displayPort, uint8_t cmd, uint8_t *subcmd, int len, mspVersion_e version)
 {
     UNUSED(displayPort);
 
@@ -127,12 +141,19 @@ static int output(displayPort_t *displayPort, uint8_t cmd, uint8_t *subcmd, int
 
     int sent = 0;
     if (!cliMode && vtxActive) {
-        sent = mspSerialPushPort(cmd, subcmd, len, &mspPort, MSP_V1);
+        sent = mspSerialPushPort(cmd, subcmd, len, &mspPort, version);
+        stats.frames++;
+        stats.bytes += sent;
     }
 
     return sent;
 }
 
+static int output(displayPort_t *displayPort, uint8_t cmd, uint8_t *subcmd, int len)
+{
+    return outputVersion(displayPort, cmd, subcmd, len, MSP_V1);
+}
+
 static uint8_t determineHDZeroOsdMode(void)
 {
     if (cmsInMenu) {
@@ -262,33 +283,9 @@ static int writeString(displayPort_t *displayPort, uint8_t col, uint8_t row, con
     return 0;
 }
 
-/**
- * Write only changed characters to the VTX
- */
-static int drawScreen(displayPort_t *displayPort) // 250Hz
+// One MSP_DP_WRITE_STRING frame per run of dirty characters
+static void drawDirty(displayPort_t *displayPort)
 {
-    static uint8_t counter = 0;
-
-    if ((!cmsInMenu && IS_RC_MODE_ACTIVE(BOXOSD)) || (counter++ % DRAW_FREQ_DENOM)) { // 62.5Hz
-        return 0;
-    }
-
-    if (osdConfig()->msp_displayport_fullframe_interval >= 0 && (millis() > sendSubFrameMs)) {
-        // For full frame update, first clear the OSD completely
-        uint8_t refreshSubcmd[1];
-        refreshSubcmd[0] = MSP_DP_CLEAR_SCREEN;
-        output(displayPort, MSP_DISPLAYPORT, refreshSubcmd, sizeof(refreshSubcmd));
-        
-        // Then dirty the characters that are not blank, to send all data on this draw.
-        for (unsigned int pos = 0; pos < sizeof(screen); pos++) {
-            if (screen[pos] != SYM_BLANK) {
-                bitArraySet(dirty, pos);
-            }
-        }
-            
-        sendSubFrameMs = (osdConfig()->msp_displayport_fullframe_interval > 0) ? (millis() + DS2MS(osdConfig()->msp_displayport_fullframe_interval)) : 0;
-    }
-
     uint8_t subcmd[COLS + 4];
     uint8_t updateCount = 0;
     subcmd[0] = MSP_DP_WRITE_STRING;
@@ -327,6 +324,7 @@ static int drawScreen(displayPort_t *displayPort) // 250Hz
         subcmd[2] = col;
         subcmd[3] = attributes;
         output(displayPort, MSP_DISPLAYPORT, subcmd, len);
+        stats.chars += len - 4;
         updateCount++;
         next = BITARRAY_FIND_FIRST_SET(dirty, pos);
     }
@@ -339,9 +337,160 @@ static int drawScreen(displayPort_t *displayPort) // 250Hz
         subcmd[0] = MSP_DP_DRAW_SCREEN;
         output(displayPort, MSP_DISPLAYPORT, subcmd, 1);
     }
+}
+
+static uint8_t getCharAttributes(uint16_t pos)
+{
+    uint8_t attributes = 0;
+
+    if (!isDJICompatibleVideoSystem(osdConfig())) {
+        attributes |= (getAttrPage(attrs[pos]) << DISPLAYPORT_MSP_ATTR_FONTPAGE);
+    }
+
+    if (getAttrBlink(attrs[pos])) {
+        attributes |= (1 << DISPLAYPORT_MSP_ATTR_BLINK);
+    }
+
+    return attributes;
+}
+
+static void batchReset(void)
+{
+    batch[0] = MSP_DP_WRITE_BATCH;
+    batch[1] = 0;
+    batchLength = 2;
+}
+
+static void batchFlush(displayPort_t *displayPort, bool draw)
+{
+    if (draw) {
+        batch[1] |= DISPLAYPORT_MSP_BATCH_FLAG_DRAW;
+    }
+    outputVersion(displayPort, MSP_DISPLAYPORT, batch, batchLength, MSP_V2_NATIVE);
+    batchReset();
+}
+
+static void batchAppend(displayPort_t *displayPort, uint8_t row, uint8_t col, uint8_t attributes, const uint8_t *data, uint8_t count, bool rle)
+{
+    const int size = BATCH_RECORD_HEADER + (rle ? 1 : count);
+
+    if (batchLength + size > BATCH_MAX_PAYLOAD) {
+        batchFlush(displayPort, false);
+    }
+
+    batch[batchLength++] = row;
+    batch[batchLength++] = col;
+    batch[batchLength++] = attributes;
+    batch[batchLength++] = rle ? (DISPLAYPORT_MSP_BATCH_RLE | count) : count;
+    memcpy(&batch[batchLength], data, rle ? 1 : count);
+    batchLength += rle ? 1 : count;
+    stats.chars += count;
+}
+
+// Literal records for the characters, except for long repeats (mostly blanks) which are run-length encoded
+static void batchAppendRun(displayPort_t *displayPort, uint8_t row, uint8_t col, uint8_t attributes, const uint8_t *chars, uint8_t count)
+{
+    uint8_t literalStart = 0;
+    uint8_t ii = 0;
+
+    while (ii < count) {
+        uint8_t repeat = 1;
+        while (ii + repeat < count && chars[ii + repeat] == chars[ii]) {
+            repeat++;
+        }
+
+        if (repeat >= BATCH_RLE_MIN_LENGTH) {
+            if (ii > literalStart) {
+                batchAppend(displayPort, row, col + literalStart, attributes, &chars[literalStart], ii - literalStart, false);
+            }
+            batchAppend(displayPort, row, col + ii, attributes, &chars[ii], repeat, true);
+            literalStart = ii + repeat;
+        }
+        ii += repeat;
+    }
+
+    if (count > literalStart) {
+        batchAppend(displayPort, row, col + literalStart, attributes, &chars[literalStart], count - literalStart, false);
+    }
+}
+
+// All dirty characters packed into as few MSP_DP_WRITE_BATCH frames as possible, normally just one
+static void drawDirtyBatched(displayPort_t *displayPort)
+{
+    uint8_t chars[COLS];
+
+    batchReset();
+
+    int next = BITARRAY_FIND_FIRST_SET(dirty, 0);
+    while (next >= 0) {
+        const int start = next;
+        const uint8_t row = start / COLS;
+        const uint8_t col = start % COLS;
+        const int endOfLine = row * COLS + screenCols;
+        const uint8_t attributes = getCharAttributes(start);
+
+        // Extend the run over dirty characters with the same attributes, bridging short clean gaps
+        int end = start + 1;
+        for (int pos = end; pos < endOfLine && pos - end < BATCH_MAX_GAP && pos - start < BATCH_MAX_COUNT; pos++) {
+            if (getCharAttributes(pos) != attributes) {
+                break;
+            }
+            if (bitArrayGet(dirty, pos)) {
+                end = pos + 1;
+            }
+        }
+
+        for (int pos = start; pos < end; pos++) {
+            bitArrayClr(dirty, pos);
+            chars[pos - start] = isDJICompatibleVideoSystem(osdConfig()) ? getDJICharacter(screen[pos], getAttrPage(attrs[pos])) : screen[pos];
+        }
+
+        batchAppendRun(displayPort, row, col, attributes, chars, end - start);
+        next = BITARRAY_FIND_FIRST_SET(dirty, end);
+    }
+
+    if (batchLength > 2 || screenCleared) {
+        screenCleared = false;
+        batchFlush(displayPort, true);
+    }
+}
+
+/**
+ * Write only changed characters to the VTX
+ */
+static int drawScreen(displayPort_t *displayPort) // 250Hz
+{
+    static uint8_t counter = 0;
+
+    if ((!cmsInMenu && IS_RC_MODE_ACTIVE(BOXOSD)) || (counter++ % DRAW_FREQ_DENOM)) { // 62.5Hz
+        return 0;
+    }
+
+    if (osdConfig()->msp_displayport_fullframe_interval >= 0 && (millis() > sendSubFrameMs)) {
+        // For full frame update, first clear the OSD completely
+        uint8_t refreshSubcmd[1];
+        refreshSubcmd[0] = MSP_DP_CLEAR_SCREEN;
+        output(displayPort, MSP_DISPLAYPORT, refreshSubcmd, sizeof(refreshSubcmd));
+        
+        // Then dirty the characters that are not blank, to send all data on this draw.
+        for (unsigned int pos = 0; pos < sizeof(screen); pos++) {
+            if (screen[pos] != SYM_BLANK) {
+                bitArraySet(dirty, pos);
+            }
+        }
+            
+        sendSubFrameMs = (osdConfig()->msp_displayport_fullframe_interval > 0) ? (millis() + DS2MS(osdConfig()->msp_displayport_fullframe_interval)) : 0;
+    }
+
+    if (vtxOptions & DISPLAYPORT_MSP_OPTION_BATCH) {
+        drawDirtyBatched(displayPort);
+    } else {
+        drawDirty(displayPort);
+    }
 
     if (vtxReset) {
-        clearScreen(displayPort);
+        // Through the display layer, so the OSD knows it has to draw everything again
+        displayClearScreen(displayPort);
         vtxReset = false;
     }
 
@@ -524,9 +673,25 @@ static mspResult_e processMspCommand(mspPacket_t *cmd, mspPacket_t *reply, mspPo
         vtxReset = true;
     }
 
+    // Device might have been swapped while it was gone, it has to ask for the extensions again
+    if (vtxSeen && !vtxActive) {
+        vtxOptions = 0;
+    }
+
     vtxSeen = vtxActive = true;
     vtxHeartbeat = millis();
 
+    // Device lists the extensions it understands, the reply holds the ones that will be used
+    if (cmd->cmd == MSP2_INAV_DISPLAYPORT_OPTIONS) {
+        uint8_t requested;
+        vtxOptions = sbufReadU8Safe(&requested, &cmd->buf) ? (requested & DISPLAYPORT_MSP_OPTION_BATCH) : 0;
+        reply->cmd = cmd->cmd;
+        sbufWriteU8(&reply->buf, vtxOptions);
+        // Resend everything in the negotiated format
+        vtxReset = true;
+        return MSP_RESULT_ACK;
+    }
+
     // Process MSP command
     return mspProcessCommand(cmd, reply, mspPostProcessFn);
 }
@@ -539,6 +704,16 @@ void mspOsdSerialProcess(mspProcessCommandFnPtr mspProcessCommandFn)
     }
 }
 
+uint8_t mspOsdGetOptions(void)
+{
+    return vtxOptions;
+}
+
+const displayportMspStats_t *mspOsdGetStats(void)
+{
+    return &stats;
+}
+
 mspPort_t *getMspOsdPort(void)
 {
     if (mspPort.port) {
@@ -36,11 +36,30 @@
 #define DISPLAYPORT_MSP_ATTR_BLINK_MASK      (1 << DISPLAYPORT_MSP_ATTR_BLINK)
 #define DISPLAYPORT_MSP_ATTR_VERSION_MASK    (1 << DISPLAYPORT_MSP_ATTR_VERSION)
 
+/*
+ * MSP_DP_WRITE_BATCH payload: flags byte followed by records of row, col, attributes and count.
+ * Count is the number of characters following, or if DISPLAYPORT_MSP_BATCH_RLE is set, the
+ * number of times the single following character is repeated.
+ */
+#define DISPLAYPORT_MSP_BATCH_FLAG_DRAW     (1 << 0)    // Draw the screen once the frame is processed
+#define DISPLAYPORT_MSP_BATCH_RLE           0x80
+
+// Extensions a device can request with MSP2_INAV_DISPLAYPORT_OPTIONS
+#define DISPLAYPORT_MSP_OPTION_BATCH        (1 << 0)
+
+typedef struct displayportMspStats_s {
+    uint32_t frames;            // MSP frames sent
+    uint32_t bytes;             // Bytes sent, including MSP framing
+    uint32_t chars;             // Characters updated on the device
+} displayportMspStats_t;
+
 typedef struct displayPort_s displayPort_t;
 
 displayPort_t *mspOsdDisplayPortInit(const videoSystem_e videoSystem);
 void mspOsdSerialProcess(mspProcessCommandFnPtr mspProcessCommandFn);
 mspPort_t *getMspOsdPort(void);
+uint8_t mspOsdGetOptions(void);
+const displayportMspStats_t *mspOsdGetStats(void);
 
 #define getAttrPage(attr) (attr & DISPLAYPORT_MSP_ATTR_FONTPAGE_MASK)
 #define getAttrBlink(attr) ((attr & DISPLAYPORT_MSP_ATTR_BLINK_MASK) >> DISPLAYPORT_MSP_ATTR_BLINK)
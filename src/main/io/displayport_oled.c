@@ -49,6 +49,7 @@ static int oledClearScreen(displayPort_t *displayPort)
 static int oledDrawScreen(displayPort_t *displayPort)
 {
     UNUSED(displayPort);
+    i2c_OLED_flush();
     return 0;
 }
 
@@ -84,6 +85,7 @@ static bool oledIsTransferInProgress(const displayPort_t *displayPort)
 static int oledHeartbeat(displayPort_t *displayPort)
 {
     UNUSED(displayPort);
+    i2c_OLED_flush();
     return 0;
 }
 
@@ -98,6 +100,12 @@ static uint32_t oledTxBytesFree(const displayPort_t *displayPort)
     return UINT32_MAX;
 }
 
+static void oledCommitTransaction(displayPort_t *displayPort)
+{
+    UNUSED(displayPort);
+    i2c_OLED_flush();
+}
+
 static const displayPortVTable_t oledVTable = {
     .grab = oledGrab,
     .release = oledRelease,
@@ -112,6 +120,7 @@ static const displayPortVTable_t oledVTable = {
     .resync = oledResync,
     .txBytesFree = oledTxBytesFree,
     .supportedTextAttributes = NULL,
+    .commitTransaction = oledCommitTransaction,
 };
 
 displayPort_t *displayPortOledInit(void)
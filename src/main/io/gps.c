@@ -78,6 +78,7 @@ typedef struct {
     portMode_t          portMode;           // Port mode RX/TX (only for serial based)
     void                (*restart)(void);   // Restart protocol driver thread
     void                (*protocol)(void);  // Process protocol driver thread
+    bool                (*hasPendingData)(void);    // Received data not parsed yet (optional)
 } gpsProviderDescriptor_t;
 
 // GPS public data
@@ -97,34 +98,34 @@ baudRate_e gpsToSerialBaudRate[GPS_BAUDRATE_COUNT] = { BAUD_115200, BAUD_57600,
 static gpsProviderDescriptor_t gpsProviders[GPS_PROVIDER_COUNT] = {
     /* UBLOX binary */
 #ifdef USE_GPS_PROTO_UBLOX
-    { false, MODE_RXTX, &gpsRestartUBLOX, &gpsHandleUBLOX },
+    { false, MODE_RXTX, &gpsRestartUBLOX, &gpsHandleUBLOX, &gpsHasPendingDataUBLOX },
 #else
-    { false, 0, NULL, NULL },
+    { false, 0, NULL, NULL, NULL },
 #endif
 
     /* UBLOX7PLUS binary */
 #ifdef USE_GPS_PROTO_UBLOX
-    { false, MODE_RXTX, &gpsRestartUBLOX, &gpsHandleUBLOX },
+    { false, MODE_RXTX, &gpsRestartUBLOX, &gpsHandleUBLOX, &gpsHasPendingDataUBLOX },
 #else
-    { false, 0,  NULL, NULL },
+    { false, 0,  NULL, NULL, NULL },
 #endif
 
     /* MSP GPS */
 #ifdef USE_GPS_PROTO_MSP
-    { true, 0, &gpsRestartMSP, &gpsHandleMSP },
+    { true, 0, &gpsRestartMSP, &gpsHandleMSP, NULL },
 #else
-    { false, 0, NULL, NULL },
+    { false, 0, NULL, NULL, NULL },
 #endif
 
 #ifdef USE_GPS_FAKE
-    {true, 0, &gpsFakeRestart, &gpsFakeHandle},
+    {true, 0, &gpsFakeRestart, &gpsFakeHandle, NULL},
 #else
-    { false, 0, NULL, NULL },
+    { false, 0, NULL, NULL, NULL },
 #endif
 
 };
 
-PG_REGISTER_WITH_RESET_TEMPLATE(gpsConfig_t, gpsConfig, PG_GPS_CONFIG, 5);
+PG_REGISTER_WITH_RESET_TEMPLATE(gpsConfig_t, gpsConfig, PG_GPS_CONFIG, 6);
 
 PG_RESET_TEMPLATE(gpsConfig_t, gpsConfig,
     .provider = SETTING_GPS_PROVIDER_DEFAULT,
@@ -137,7 +138,8 @@ PG_RESET_TEMPLATE(gpsConfig_t, gpsConfig,
     .ubloxUseBeidou = SETTING_GPS_UBLOX_USE_BEIDOU_DEFAULT,
     .ubloxUseGlonass = SETTING_GPS_UBLOX_USE_GLONASS_DEFAULT,
     .ubloxNavHz = SETTING_GPS_UBLOX_NAV_HZ_DEFAULT,
-    .autoBaudMax = SETTING_GPS_AUTO_BAUD_MAX_SUPPORTED_DEFAULT
+    .autoBaudMax = SETTING_GPS_AUTO_BAUD_MAX_SUPPORTED_DEFAULT,
+    .fixedLatencyMs = SETTING_GPS_FIXED_LATENCY_MS_DEFAULT
 );
 
 int gpsBaudRateToInt(gpsBaudRate_e baudrate)
@@ -301,6 +303,7 @@ void updateEstimatedGPSFix(void)
     gpsSol.flags.validVelD = false;  //do not provide velocity.z
     gpsSol.flags.validEPE = true;
     gpsSol.flags.validTime = false;
+    gpsSol.flags.validTimeOfWeek = false;   // Estimated from the current state, no receiver latency
 
     float speed = pidProfile()->fixedWingReferenceAirspeed;
 
@@ -358,6 +361,53 @@ void gpsProcessNewDriverData(void)
 #endif
 }
 
+/*
+ * Receiver latency estimation. The offset between the local read time and the GPS time of week
+ * is the clock offset plus the latency of that solution. Its running minimum (allowed to creep up to
+ * follow clock drift) gives the clock offset plus the smallest latency seen, anything above it is
+ * extra delay caused by receiver load or serial queuing. The minimum latency itself is not observable
+ * without a PPS reference and is taken from gps_fixed_latency_ms.
+ *
+ * Solutions are stamped when the driver reads them, not when their first byte arrives. The time spent
+ * in the serial RX buffer varies with the GPS task timing and is compensated like any other extra
+ * delay. Only its minimum is not, and it adds to the error of gps_fixed_latency_ms.
+ */
+#define GPS_LATENCY_DRIFT_US        20          // Minimum offset creep per solution, covers 200ppm clock drift at 10Hz
+#define GPS_LATENCY_MAX_EXCESS_US   200000      // Larger jumps mean the receiver or its clock was reset
+
+static bool gpsLatencyValid;
+static uint32_t gpsLatencyLastTimeOfWeekMs;
+static int64_t gpsLatencyMinOffsetUs;
+
+static void gpsUpdateMeasurementTime(void)
+{
+    const timeUs_t readTimeUs = gpsSol.readTimeUs ? gpsSol.readTimeUs : micros();
+    uint32_t latencyUs = 0;
+
+    // Without a time of week the source is not a real receiver (simulator, MSP injection), take it as current
+    if (gpsSol.flags.validTimeOfWeek) {
+        latencyUs = MS2US(gpsConfig()->fixedLatencyMs);
+
+        const int64_t offsetUs = (int64_t)readTimeUs - (int64_t)gpsSol.timeOfWeekMs * 1000;
+
+        if (!gpsLatencyValid || gpsSol.timeOfWeekMs < gpsLatencyLastTimeOfWeekMs || offsetUs - gpsLatencyMinOffsetUs > GPS_LATENCY_MAX_EXCESS_US) {
+            gpsLatencyMinOffsetUs = offsetUs;
+            gpsLatencyValid = true;
+        }
+        else {
+            gpsLatencyMinOffsetUs = MIN(gpsLatencyMinOffsetUs + GPS_LATENCY_DRIFT_US, offsetUs);
+            latencyUs += offsetUs - gpsLatencyMinOffsetUs;
+        }
+
+        gpsLatencyLastTimeOfWeekMs = gpsSol.timeOfWeekMs;
+    }
+    else {
+        gpsLatencyValid = false;
+    }
+
+    gpsSol.measurementTimeUs = readTimeUs - latencyUs;
+}
+
 //called after: 
 //1)driver copies gpsSolDRV to gpsSol
 //2)gpsSol is processed by "Disable GPS logical switch"
@@ -391,6 +441,10 @@ void gpsProcessNewSolutionData(bool timeout)
     if (!timeout) {
         // Data came from GPS sensor - set sensor as ready and available (it may still not have GPS fix)
         sensorsSet(SENSOR_GPS);
+        gpsUpdateMeasurementTime();
+    }
+    else {
+        gpsSol.measurementTimeUs = micros();
     }
 
     // Pass on GPS update to NAV and IMU
@@ -423,6 +477,7 @@ static void gpsResetSolution(gpsSolutionData_t* gpsSol)
     gpsSol->flags.validVelD = false;
     gpsSol->flags.validEPE = false;
     gpsSol->flags.validTime = false;
+    gpsSol->flags.validTimeOfWeek = false;
 }
 
 void gpsTryEstimateOnTimeout(void)
@@ -597,6 +652,21 @@ bool gpsUpdate(void)
     return res;
 }
 
+bool gpsHasPendingData(void)
+{
+    if (!gpsState.gpsPort) {
+        return false;
+    }
+
+    // A frame may be complete in the driver buffers already
+    const gpsProviderDescriptor_t *provider = &gpsProviders[gpsState.gpsConfig->provider];
+    if (provider->hasPendingData && provider->hasPendingData()) {
+        return true;
+    }
+
+    return serialRxBytesWaiting(gpsState.gpsPort);
+}
+
 void gpsEnablePassthrough(serialPort_t *gpsPassthroughPort)
 {
     waitForSerialPortToFinishTransmitting(gpsState.gpsPort);
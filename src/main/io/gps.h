@@ -102,6 +102,7 @@ typedef struct gpsConfig_s {
     uint8_t gpsMinSats;
     uint8_t ubloxNavHz;
     gpsBaudRate_e autoBaudMax;
+    uint8_t fixedLatencyMs;
 } gpsConfig_t;
 
 PG_DECLARE(gpsConfig_t, gpsConfig);
@@ -128,6 +129,7 @@ typedef struct gpsSolutionData_s {
         bool validVelD;
         bool validEPE;      // EPH/EPV values are valid - actual accuracy
         bool validTime;
+        bool validTimeOfWeek;   // Measurement epoch time of week is known
     } flags;
 
     gpsFixType_e fixType;
@@ -146,6 +148,11 @@ typedef struct gpsSolutionData_s {
 
     dateTime_t time; // GPS time in UTC
 
+    uint32_t timeOfWeekMs;      // GPS time of week of the measurement epoch (ms)
+    timeUs_t readTimeUs;        // Local time the driver read the start of the solution from the serial port, 0 if unknown.
+                                // Later than the arrival of its first byte by the time spent in the serial RX buffer.
+    timeUs_t measurementTimeUs; // Local time the solution is valid at, read time corrected for receiver latency
+
 } gpsSolutionData_t;
 
 typedef struct {
@@ -164,6 +171,7 @@ void gpsInit(void);
 // Called periodically from GPS task. Returns true iff the GPS
 // information was updated.
 bool gpsUpdate(void);
+bool gpsHasPendingData(void);
 void updateGpsIndicator(timeUs_t currentTimeUs);
 bool isGPSHealthy(void);
 bool isGPSHeadingValid(void);
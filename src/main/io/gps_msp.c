@@ -108,6 +108,10 @@ void mspGPSReceiveNewData(const uint8_t * bufferPtr)
 
     gpsSolDRV.flags.validTime = (pkt->fixType >= 3);
 
+    gpsSolDRV.timeOfWeekMs = pkt->msTOW;
+    gpsSolDRV.flags.validTimeOfWeek = true;
+    gpsSolDRV.readTimeUs = micros();
+
     gpsProcessNewDriverData();
     newDataReady = true;
 }
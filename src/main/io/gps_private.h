@@ -77,6 +77,7 @@ void gpsSetProtocolTimeout(timeMs_t timeoutMs);
 
 extern void gpsRestartUBLOX(void);
 extern void gpsHandleUBLOX(void);
+extern bool gpsHasPendingDataUBLOX(void);
 
 extern void gpsRestartMSP(void);
 extern void gpsHandleMSP(void);
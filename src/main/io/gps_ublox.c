@@ -53,6 +53,11 @@
 #include "gps_ublox.h"
 #include "gps_ublox_utils.h"
 
+#if defined(GPS_UBLOX_UNIT_TEST)
+// Defined by the unit test, the host libc has no strnstr()
+char *strnstr(const char *s, const char *find, size_t slen);
+#endif
+
 
 // SBAS_AUTO, SBAS_EGNOS, SBAS_WAAS, SBAS_MSAS, SBAS_GAGAN, SBAS_NONE
 // note PRNs last upadted 2023-08-10
@@ -84,19 +89,19 @@ static const char * baudInitDataNMEA[GPS_BAUDRATE_COUNT] = {
     "$PUBX,41,1,0003,0001,921600,0*15\r\n"      // GPS_BAUDRATE_921600
 };
 
-// Packet checksum accumulators
-static uint8_t _ck_a;
-static uint8_t _ck_b;
+// Frame assembly buffer, only used for frames split across serial reads
+static uint8_t ubxFramerBuffer[UBX_FRAME_OVERHEAD + MAX_UBLOX_PAYLOAD_SIZE];
+static ubxFramer_t ubxFramer;
 
-// State machine state
-static bool _skip_packet;
-static uint8_t _step;
-static uint8_t _msg_id;
-static uint16_t _payload_length;
-static uint16_t _payload_counter;
+// Serial data pending parsing
+#define UBX_RX_CHUNK_SIZE   128
+static uint8_t ubxRxChunk[UBX_RX_CHUNK_SIZE];
+static uint8_t ubxRxChunkPos;
+static uint8_t ubxRxChunkLen;
+static timeUs_t ubxRxChunkTimeUs;     // Time the chunk was read from the serial port
+static timeUs_t ubxFrameStartTimeUs;  // Time the chunk holding the first byte of the frame being parsed was read
 
 static uint8_t next_fix_type;
-static uint8_t _class;
 static uint8_t _ack_state;
 static uint8_t _ack_waiting_msg;
 
@@ -535,9 +540,18 @@ static uint32_t gpsDecodeHardwareVersion(const char * szBuf, unsigned nBufSize)
     return UBX_HW_VERSION_UNKNOWN;
 }
 
-static bool gpsParseFrameUBLOX(void)
+static bool gpsParseFrameUBLOX(const ubxFrame_t *frame)
 {
-    switch (_msg_id) {
+    const ubx_nav_pvt *pvt = &_buffer.pvt;
+
+    if (frame->msgId == MSG_PVT && frame->length >= sizeof(ubx_nav_pvt)) {
+        // High rate message, decode directly from the received frame
+        pvt = (const ubx_nav_pvt *)frame->payload;
+    } else {
+        memcpy(_buffer.bytes, frame->payload, MIN(frame->length, sizeof(_buffer.bytes)));
+    }
+
+    switch (frame->msgId) {
     case MSG_POSLLH:
         gpsSolDRV.llh.lon = _buffer.posllh.longitude;
         gpsSolDRV.llh.lat = _buffer.posllh.latitude;
@@ -545,6 +559,9 @@ static bool gpsParseFrameUBLOX(void)
         gpsSolDRV.eph = gpsConstrainEPE(_buffer.posllh.horizontal_accuracy / 10);
         gpsSolDRV.epv = gpsConstrainEPE(_buffer.posllh.vertical_accuracy / 10);
         gpsSolDRV.flags.validEPE = true;
+        gpsSolDRV.timeOfWeekMs = _buffer.posllh.time;
+        gpsSolDRV.flags.validTimeOfWeek = true;
+        gpsSolDRV.readTimeUs = ubxFrameStartTimeUs;
         if (next_fix_type != GPS_NO_FIX)
             gpsSolDRV.fixType = next_fix_type;
         _new_position = true;
@@ -587,32 +604,35 @@ static bool gpsParseFrameUBLOX(void)
         }
         break;
     case MSG_PVT:
-        next_fix_type = gpsMapFixType(_buffer.pvt.fix_status & NAV_STATUS_FIX_VALID, _buffer.pvt.fix_type);
+        next_fix_type = gpsMapFixType(pvt->fix_status & NAV_STATUS_FIX_VALID, pvt->fix_type);
         gpsSolDRV.fixType = next_fix_type;
-        gpsSolDRV.llh.lon = _buffer.pvt.longitude;
-        gpsSolDRV.llh.lat = _buffer.pvt.latitude;
-        gpsSolDRV.llh.alt = _buffer.pvt.altitude_msl / 10;  //alt in cm
-        gpsSolDRV.velNED[X]=_buffer.pvt.ned_north / 10;  // to cm/s
-        gpsSolDRV.velNED[Y]=_buffer.pvt.ned_east / 10;   // to cm/s
-        gpsSolDRV.velNED[Z]=_buffer.pvt.ned_down / 10;   // to cm/s
-        gpsSolDRV.groundSpeed = _buffer.pvt.speed_2d / 10;    // to cm/s
-        gpsSolDRV.groundCourse = (uint16_t) (_buffer.pvt.heading_2d / 10000);     // Heading 2D deg * 100000 rescaled to deg * 10
-        gpsSolDRV.numSat = _buffer.pvt.satellites;
-        gpsSolDRV.eph = gpsConstrainEPE(_buffer.pvt.horizontal_accuracy / 10);
-        gpsSolDRV.epv = gpsConstrainEPE(_buffer.pvt.vertical_accuracy / 10);
-        gpsSolDRV.hdop = gpsConstrainHDOP(_buffer.pvt.position_DOP);
+        gpsSolDRV.llh.lon = pvt->longitude;
+        gpsSolDRV.llh.lat = pvt->latitude;
+        gpsSolDRV.llh.alt = pvt->altitude_msl / 10;  //alt in cm
+        gpsSolDRV.timeOfWeekMs = pvt->time;
+        gpsSolDRV.flags.validTimeOfWeek = true;
+        gpsSolDRV.readTimeUs = ubxFrameStartTimeUs;
+        gpsSolDRV.velNED[X]=pvt->ned_north / 10;  // to cm/s
+        gpsSolDRV.velNED[Y]=pvt->ned_east / 10;   // to cm/s
+        gpsSolDRV.velNED[Z]=pvt->ned_down / 10;   // to cm/s
+        gpsSolDRV.groundSpeed = pvt->speed_2d / 10;    // to cm/s
+        gpsSolDRV.groundCourse = (uint16_t) (pvt->heading_2d / 10000);     // Heading 2D deg * 100000 rescaled to deg * 10
+        gpsSolDRV.numSat = pvt->satellites;
+        gpsSolDRV.eph = gpsConstrainEPE(pvt->horizontal_accuracy / 10);
+        gpsSolDRV.epv = gpsConstrainEPE(pvt->vertical_accuracy / 10);
+        gpsSolDRV.hdop = gpsConstrainHDOP(pvt->position_DOP);
         gpsSolDRV.flags.validVelNE = true;
         gpsSolDRV.flags.validVelD = true;
         gpsSolDRV.flags.validEPE = true;
 
-        if (UBX_VALID_GPS_DATE_TIME(_buffer.pvt.valid)) {
-            gpsSolDRV.time.year = _buffer.pvt.year;
-            gpsSolDRV.time.month = _buffer.pvt.month;
-            gpsSolDRV.time.day = _buffer.pvt.day;
-            gpsSolDRV.time.hours = _buffer.pvt.hour;
-            gpsSolDRV.time.minutes = _buffer.pvt.min;
-            gpsSolDRV.time.seconds = _buffer.pvt.sec;
-            gpsSolDRV.time.millis = _buffer.pvt.nano / (1000*1000);
+        if (UBX_VALID_GPS_DATE_TIME(pvt->valid)) {
+            gpsSolDRV.time.year = pvt->year;
+            gpsSolDRV.time.month = pvt->month;
+            gpsSolDRV.time.day = pvt->day;
+            gpsSolDRV.time.hours = pvt->hour;
+            gpsSolDRV.time.minutes = pvt->min;
+            gpsSolDRV.time.seconds = pvt->sec;
+            gpsSolDRV.time.millis = pvt->nano / (1000*1000);
 
             gpsSolDRV.flags.validTime = true;
         } else {
@@ -623,14 +643,14 @@ static bool gpsParseFrameUBLOX(void)
         _new_speed = true;
         break;
     case MSG_VER:
-        if (_class == CLASS_MON) {
+        if (frame->msgClass == CLASS_MON) {
             gpsState.hwVersion = gpsDecodeHardwareVersion(_buffer.ver.hwVersion, sizeof(_buffer.ver.hwVersion));
             if (gpsState.hwVersion >= UBX_HW_VERSION_UBLOX8) {
                 if (_buffer.ver.swVersion[9] > '2' || true) {
                     // check extensions;
                     // after hw + sw vers; each is 30 bytes
                     bool found = false;
-                    for (int j = 40; j < _payload_length && !found; j += 30)
+                    for (int j = 40; j < frame->length && !found; j += 30)
                     {
                         // Example content: GPS;GAL;BDS;GLO
                         if (strnstr((const char *)(_buffer.bytes + j), "GAL", 30))
@@ -650,7 +670,7 @@ static bool gpsParseFrameUBLOX(void)
                         }
                     }
                 }
-                for(int j = 40; j < _payload_length; j += 30) {
+                for(int j = 40; j < frame->length; j += 30) {
                     if (strnstr((const char *)(_buffer.bytes + j), "PROTVER", 30)) {
                         gpsDecodeProtocolVersion((const char *)(_buffer.bytes + j), 30);
                         break;
@@ -660,7 +680,7 @@ static bool gpsParseFrameUBLOX(void)
         }
         break;
     case MSG_MON_GNSS:
-        if(_class == CLASS_MON) {
+        if(frame->msgClass == CLASS_MON) {
             if (_buffer.gnss.version == 0) {
                 ubx_capabilities.supported = _buffer.gnss.supported;
                 ubx_capabilities.defaultGnss = _buffer.gnss.defaultGnss;
@@ -694,96 +714,6 @@ static bool gpsParseFrameUBLOX(void)
     return false;
 }
 
-static bool gpsNewFrameUBLOX(uint8_t data)
-{
-    bool parsed = false;
-
-    switch (_step) {
-        case 0: // Sync char 1 (0xB5)
-            if (PREAMBLE1 == data) {
-                _skip_packet = false;
-                _step++;
-            }
-            break;
-        case 1: // Sync char 2 (0x62)
-            if (PREAMBLE2 != data) {
-                _step = 0;
-                break;
-            }
-            _step++;
-            break;
-        case 2: // Class
-            _step++;
-            _class = data;
-            _ck_b = _ck_a = data;   // reset the checksum accumulators
-            break;
-        case 3: // Id
-            _step++;
-            _ck_b += (_ck_a += data);       // checksum byte
-            _msg_id = data;
-            break;
-        case 4: // Payload length (part 1)
-            _step++;
-            _ck_b += (_ck_a += data);       // checksum byte
-            _payload_length = data; // payload length low byte
-            break;
-        case 5: // Payload length (part 2)
-            _step++;
-            _ck_b += (_ck_a += data);       // checksum byte
-            _payload_length |= (uint16_t)(data << 8);
-            if (_payload_length > MAX_UBLOX_PAYLOAD_SIZE ) {
-                // we can't receive the whole packet, just log the error and start searching for the next packet.
-                gpsStats.errors++;
-                _step = 0;
-                break;
-            }
-            // prepare to receive payload
-            _payload_counter = 0;
-            if (_payload_length == 0) {
-                _step = 7;
-            }
-            break;
-        case 6:
-            _ck_b += (_ck_a += data);       // checksum byte
-            if (_payload_counter < MAX_UBLOX_PAYLOAD_SIZE) {
-                _buffer.bytes[_payload_counter] = data;
-            }
-            // NOTE: check counter BEFORE increasing so that a payload_size of 65535 is correctly handled.  This can happen if garbage data is received.
-            if (_payload_counter ==  _payload_length - 1) {
-                _step++;
-            }
-            _payload_counter++;
-            break;
-        case 7:
-            _step++;
-            if (_ck_a != data) {
-                _skip_packet = true;          // bad checksum
-                gpsStats.errors++;
-                _step = 0;
-            }
-            break;
-        case 8:
-            _step = 0;
-
-            if (_ck_b != data) {
-                gpsStats.errors++;
-                break;              // bad checksum
-            }
-
-            gpsStats.packetCount++;
-
-            if (_skip_packet) {
-                break;
-            }
-
-            if (gpsParseFrameUBLOX()) {
-                parsed = true;
-            }
-    }
-
-    return parsed;
-}
-
 static uint16_t hz2rate(uint8_t hz)
 {
     return 1000 / hz;
@@ -981,21 +911,59 @@ STATIC_PROTOTHREAD(gpsConfigure)
 
 static ptSemaphore_t semNewDataReady;
 
+// Returns true if there is unparsed data, reading a new chunk from the serial port if needed
+static bool gpsFillRxChunkUBLOX(void)
+{
+    if (ubxRxChunkPos < ubxRxChunkLen) {
+        return true;
+    }
+
+    const uint32_t available = MIN(serialRxBytesWaiting(gpsState.gpsPort), (uint32_t)UBX_RX_CHUNK_SIZE);
+    for (ubxRxChunkLen = 0; ubxRxChunkLen < available; ubxRxChunkLen++) {
+        ubxRxChunk[ubxRxChunkLen] = serialRead(gpsState.gpsPort);
+    }
+    ubxRxChunkPos = 0;
+    ubxRxChunkTimeUs = micros();
+
+    return ubxRxChunkLen > 0;
+}
+
+bool gpsHasPendingDataUBLOX(void)
+{
+    return ubxRxChunkPos < ubxRxChunkLen;
+}
+
 STATIC_PROTOTHREAD(gpsProtocolReceiverThread)
 {
     ptBegin(gpsProtocolReceiverThread);
 
     while (1) {
         // Wait until there are bytes to consume
-        ptWait(serialRxBytesWaiting(gpsState.gpsPort));
+        ptWait(ubxRxChunkPos < ubxRxChunkLen || serialRxBytesWaiting(gpsState.gpsPort));
 
         // Consume bytes until buffer empty of until we have full message received
-        while (serialRxBytesWaiting(gpsState.gpsPort)) {
-            uint8_t newChar = serialRead(gpsState.gpsPort);
-            if (gpsNewFrameUBLOX(newChar)) {
-                gpsProcessNewDriverData();
-                ptSemaphoreSignal(semNewDataReady);
-                break;
+        while (gpsFillRxChunkUBLOX()) {
+            if (ubxFramer.received == 0) {
+                // Next frame starts in this chunk
+                ubxFrameStartTimeUs = ubxRxChunkTimeUs;
+            }
+
+            ubxFrame_t frame;
+            size_t consumed;
+            const ubxFramerResult_e result = ubxFramerFeed(&ubxFramer, &ubxRxChunk[ubxRxChunkPos], ubxRxChunkLen - ubxRxChunkPos, &consumed, &frame);
+            ubxRxChunkPos += consumed;
+
+            if (result == UBX_FRAMER_ERROR) {
+                gpsStats.errors++;
+            }
+            else if (result == UBX_FRAMER_FRAME) {
+                gpsStats.packetCount++;
+
+                if (gpsParseFrameUBLOX(&frame)) {
+                    gpsProcessNewDriverData();
+                    ptSemaphoreSignal(semNewDataReady);
+                    break;
+                }
             }
         }
     }
@@ -1101,6 +1069,8 @@ STATIC_PROTOTHREAD(gpsProtocolStateThread)
 
 void gpsRestartUBLOX(void)
 {
+    ubxFramerInit(&ubxFramer, ubxFramerBuffer, sizeof(ubxFramerBuffer));
+    ubxRxChunkPos = ubxRxChunkLen = 0;
     ptSemaphoreInit(semNewDataReady);
     ptRestart(ptGetHandle(gpsProtocolReceiverThread));
     ptRestart(ptGetHandle(gpsProtocolStateThread));
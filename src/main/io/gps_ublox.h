@@ -332,7 +332,7 @@ typedef struct {
     uint16_t position_DOP;
     uint16_t reserved2;
     uint16_t reserved3;
-} ubx_nav_pvt;
+} __attribute__((packed)) ubx_nav_pvt;   // Decoded in place from the receive stream at any alignment
 
 #define UBX_MON_GNSS_GPS_MASK       (1 << 0)
 #define UBX_MON_GNSS_GLONASS_MASK   (1 << 1)
@@ -17,17 +17,165 @@
 
 
 #include <stdint.h>
+#include <string.h>
+
+#include "common/maths.h"
 
 #include "gps_ublox_utils.h"
 
 void ublox_update_checksum(uint8_t *data, uint8_t len, uint8_t *ck_a, uint8_t *ck_b)
 {
     *ck_a = *ck_b = 0;
+    ubloxChecksumAccumulate(data, len, ck_a, ck_b);
+}
+
+/*
+ * Continue the UBX Fletcher checksum over a contiguous span. Sums are kept in 32 bits and truncated
+ * once at the end; unsigned wrap-around is modulo 2^32 which keeps the result exact modulo 256.
+ */
+void ubloxChecksumAccumulate(const uint8_t *data, size_t len, uint8_t *ck_a, uint8_t *ck_b)
+{
+    uint32_t a = *ck_a;
+    uint32_t b = *ck_b;
+
+    while (len >= 4) {
+        a += data[0]; b += a;
+        a += data[1]; b += a;
+        a += data[2]; b += a;
+        a += data[3]; b += a;
+        data += 4;
+        len -= 4;
+    }
+
     while (len--) {
-        *ck_a += *data;
-        *ck_b += *ck_a;
-        data++;
+        a += *data++;
+        b += a;
+    }
+
+    *ck_a = a;
+    *ck_b = b;
+}
+
+void ubxFramerInit(ubxFramer_t *framer, uint8_t *buffer, uint16_t bufferSize)
+{
+    framer->buffer = buffer;
+    framer->maxPayloadLength = bufferSize - UBX_FRAME_OVERHEAD;
+    framer->received = 0;
+}
+
+static uint16_t ubxFramePayloadLength(const uint8_t *header)
+{
+    return header[4] | (header[5] << 8);
+}
+
+static ubxFramerResult_e ubxFramerCheckFrame(const uint8_t *start, uint16_t payloadLength, ubxFrame_t *frame)
+{
+    uint8_t ck_a = 0;
+    uint8_t ck_b = 0;
+    ubloxChecksumAccumulate(start + 2, payloadLength + 4, &ck_a, &ck_b);
+
+    const uint8_t *checksum = start + UBX_FRAME_HEADER_SIZE + payloadLength;
+    if (checksum[0] != ck_a || checksum[1] != ck_b) {
+        return UBX_FRAMER_ERROR;
+    }
+
+    frame->msgClass = start[2];
+    frame->msgId = start[3];
+    frame->length = payloadLength;
+    frame->payload = start + UBX_FRAME_HEADER_SIZE;
+    return UBX_FRAMER_FRAME;
+}
+
+/*
+ * Consume UBX data from a contiguous span and stop after the first complete frame.
+ * Frames fully contained in the span are validated and returned in place; only frames split
+ * across spans are assembled in the framer buffer. *consumed is always set.
+ */
+ubxFramerResult_e ubxFramerFeed(ubxFramer_t *framer, const uint8_t *data, size_t length, size_t *consumed, ubxFrame_t *frame)
+{
+    const uint8_t *p = data;
+    const uint8_t *end = data + length;
+    ubxFramerResult_e result = UBX_FRAMER_NEED_MORE;
+
+    while (p < end) {
+        if (framer->received == 0) {
+            const uint8_t *sync = memchr(p, PREAMBLE1, end - p);
+            if (!sync) {
+                p = end;
+                break;
+            }
+            p = sync;
+
+            const size_t available = end - p;
+            if (available >= UBX_FRAME_HEADER_SIZE) {
+                if (p[1] != PREAMBLE2) {
+                    p++;
+                    continue;
+                }
+
+                const uint16_t payloadLength = ubxFramePayloadLength(p);
+                if (payloadLength > framer->maxPayloadLength) {
+                    p += UBX_FRAME_HEADER_SIZE;
+                    result = UBX_FRAMER_ERROR;
+                    break;
+                }
+
+                const size_t frameSize = UBX_FRAME_OVERHEAD + payloadLength;
+                if (available >= frameSize) {
+                    result = ubxFramerCheckFrame(p, payloadLength, frame);
+                    p += frameSize;
+                    break;
+                }
+            }
+            // Frame continues in a later span, assemble it below
+        }
+
+        if (framer->received < 2) {
+            framer->buffer[framer->received++] = *p++;
+            if (framer->received < 2) {
+                continue;
+            }
+
+            if (framer->buffer[1] != PREAMBLE2) {
+                // Second byte may itself start a frame
+                framer->received = (framer->buffer[1] == PREAMBLE1) ? 1 : 0;
+                continue;
+            }
+        }
+
+        if (framer->received < UBX_FRAME_HEADER_SIZE) {
+            const size_t count = MIN((size_t)(UBX_FRAME_HEADER_SIZE - framer->received), (size_t)(end - p));
+            memcpy(&framer->buffer[framer->received], p, count);
+            framer->received += count;
+            p += count;
+
+            if (framer->received < UBX_FRAME_HEADER_SIZE) {
+                break;
+            }
+
+            if (ubxFramePayloadLength(framer->buffer) > framer->maxPayloadLength) {
+                framer->received = 0;
+                result = UBX_FRAMER_ERROR;
+                break;
+            }
+        }
+
+        const uint16_t payloadLength = ubxFramePayloadLength(framer->buffer);
+        const size_t frameSize = UBX_FRAME_OVERHEAD + payloadLength;
+        const size_t count = MIN(frameSize - framer->received, (size_t)(end - p));
+        memcpy(&framer->buffer[framer->received], p, count);
+        framer->received += count;
+        p += count;
+
+        if (framer->received == frameSize) {
+            framer->received = 0;
+            result = ubxFramerCheckFrame(framer->buffer, payloadLength, frame);
+            break;
+        }
     }
+
+    *consumed = p - data;
+    return result;
 }
 
 int ubloxCfgFillBytes(ubx_config_data8_t *cfg, ubx_config_data8_payload_t *kvPairs, uint8_t count)
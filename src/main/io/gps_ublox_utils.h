@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "gps_ublox.h"
@@ -28,6 +29,33 @@ extern "C" {
 int ubloxCfgFillBytes(ubx_config_data8_t *cfg, ubx_config_data8_payload_t *kvPairs, uint8_t count);
 
 void ublox_update_checksum(uint8_t *data, uint8_t len, uint8_t *ck_a, uint8_t *ck_b);
+void ubloxChecksumAccumulate(const uint8_t *data, size_t len, uint8_t *ck_a, uint8_t *ck_b);
+
+#define UBX_FRAME_HEADER_SIZE       6   // preamble (2), class, id, length (2)
+#define UBX_FRAME_CHECKSUM_SIZE     2
+#define UBX_FRAME_OVERHEAD          (UBX_FRAME_HEADER_SIZE + UBX_FRAME_CHECKSUM_SIZE)
+
+typedef enum {
+    UBX_FRAMER_NEED_MORE = 0,   // All input consumed, no complete frame
+    UBX_FRAMER_FRAME,           // Valid frame returned
+    UBX_FRAMER_ERROR,           // Oversized or corrupted frame dropped
+} ubxFramerResult_e;
+
+typedef struct ubxFrame_s {
+    uint8_t msgClass;
+    uint8_t msgId;
+    uint16_t length;
+    const uint8_t *payload;     // Points into the input span or the framer buffer, valid until the next ubxFramerFeed() call
+} ubxFrame_t;
+
+typedef struct ubxFramer_s {
+    uint8_t *buffer;            // Assembles frames split across input spans
+    uint16_t maxPayloadLength;
+    uint16_t received;          // Bytes of the pending frame held in buffer
+} ubxFramer_t;
+
+void ubxFramerInit(ubxFramer_t *framer, uint8_t *buffer, uint16_t bufferSize);
+ubxFramerResult_e ubxFramerFeed(ubxFramer_t *framer, const uint8_t *data, size_t length, size_t *consumed, ubxFrame_t *frame);
 
 #ifdef __cplusplus
 }
@@ -110,6 +110,7 @@ static bool cxofOpflowUpdate(opflowData_t * data)
 
                 if (pkt->header == 0xFE && pkt->footer == 0xAA) {
                     // Valid packet
+                    tmpData.timestamp = currentTimeUs;
                     tmpData.deltaTime += (currentTimeUs - previousTimeUs);
                     tmpData.flowRateRaw[0] += pkt->motionX;
                     tmpData.flowRateRaw[1] += pkt->motionY;
@@ -137,10 +138,16 @@ static bool cxofOpflowUpdate(opflowData_t * data)
     return newPacket;
 }
 
+static bool cxofOpflowHasNewData(void)
+{
+    return flowPort && serialRxBytesWaiting(flowPort) >= (uint32_t)(CXOF_PACKET_SIZE - bufferPtr);
+}
+
 virtualOpflowVTable_t opflowCxofVtable = {
     .detect = cxofOpflowDetect,
     .init = cxofOpflowInit,
-    .update = cxofOpflowUpdate
+    .update = cxofOpflowUpdate,
+    .hasNewData = cxofOpflowHasNewData
 };
 
 #endif
@@ -71,11 +71,17 @@ static bool mspOpflowUpdate(opflowData_t * data)
     return false;
 }
 
+static bool mspOpflowHasNewData(void)
+{
+    return hasNewData;
+}
+
 void mspOpflowReceiveNewData(uint8_t * bufferPtr)
 {
     const timeUs_t currentTimeUs = micros();
     const mspSensorOpflowDataMessage_t * pkt = (const mspSensorOpflowDataMessage_t *)bufferPtr;
 
+    sensorData.timestamp = currentTimeUs;
     sensorData.deltaTime = currentTimeUs - updatedTimeUs;
     sensorData.flowRateRaw[0] = pkt->motionX;
     sensorData.flowRateRaw[1] = pkt->motionY;
@@ -89,7 +95,8 @@ void mspOpflowReceiveNewData(uint8_t * bufferPtr)
 virtualOpflowVTable_t opflowMSPVtable = {
     .detect = mspOpflowDetect,
     .init = mspOpflowInit,
-    .update = mspOpflowUpdate
+    .update = mspOpflowUpdate,
+    .hasNewData = mspOpflowHasNewData
 };
 
 #endif
\ No newline at end of file
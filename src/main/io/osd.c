@@ -45,6 +45,7 @@
 #include "common/constants.h"
 #include "common/filter.h"
 #include "common/log.h"
+#include "common/number_format.h"
 #include "common/olc.h"
 #include "common/printf.h"
 #include "common/string_light.h"
@@ -200,6 +201,22 @@ static bool refreshWaitForResumeCmdRelease;
 
 static bool fullRedraw = false;
 
+// Elements whose output did not change are only rewritten after this long, bounds the time a glitch can stay on screen
+#define OSD_ELEMENT_REFRESH_MAX_MS  1000
+
+// Refresh intervals of the non critical classes, critical elements are refreshed on every call
+#define OSD_REFRESH_NORMAL_INTERVAL_MS  100
+#define OSD_REFRESH_SLOW_INTERVAL_MS    500
+
+typedef struct osdElementState_s {
+    uint32_t fingerprint;       // Hash of what was last drawn, 0 if unknown
+    uint16_t drawnAt;           // Low bits of millis(), every interval is far below the wrap around
+    uint16_t refreshedAt;
+} osdElementState_t;
+
+static osdElementState_t osdElementState[OSD_ITEM_COUNT];
+static uint8_t osdElementStateClearCount;
+
 static uint8_t armState;
 
 static textAttributes_t osdGetMultiFunctionMessage(char *buff);
@@ -225,6 +242,11 @@ static bool osdDisplayHasCanvas;
 
 PG_REGISTER_WITH_RESET_TEMPLATE(osdConfig_t, osdConfig, PG_OSD_CONFIG, 11);
 PG_REGISTER_WITH_RESET_FN(osdLayoutsConfig_t, osdLayoutsConfig, PG_OSD_LAYOUTS_CONFIG, 1);
+PG_REGISTER_WITH_RESET_TEMPLATE(osdRefreshConfig_t, osdRefreshConfig, PG_OSD_REFRESH_CONFIG, 0);
+
+PG_RESET_TEMPLATE(osdRefreshConfig_t, osdRefreshConfig,
+    .time_budget = SETTING_OSD_REFRESH_TIME_BUDGET_DEFAULT,
+);
 
 void osdStartedSaveProcess(void) {
     savingSettings = true;
@@ -328,11 +350,10 @@ static void osdFormatDistanceStr(char *buff, int32_t dist)
         centifeet = CENTIMETERS_TO_CENTIFEET(dist);
         if (abs(centifeet) < FEET_PER_MILE * 100 / 2) {
             // Show feet when dist < 0.5mi
-            tfp_sprintf(buff, "%d%c", (int)(centifeet / 100), SYM_FT);
+            formatChar(formatSigned(buff, (int)(centifeet / 100), 0, false), SYM_FT);
         } else {
             // Show miles when dist >= 0.5mi
-            tfp_sprintf(buff, "%d.%02d%c", (int)(centifeet / (100*FEET_PER_MILE)),
-                (abs(centifeet) % (100 * FEET_PER_MILE)) / FEET_PER_MILE, SYM_MI);
+            formatChar(formatFixedPoint(buff, centifeet / FEET_PER_MILE, 2, 0), SYM_MI);
         }
         break;
     case OSD_UNIT_METRIC_MPH:
@@ -340,22 +361,20 @@ static void osdFormatDistanceStr(char *buff, int32_t dist)
     case OSD_UNIT_METRIC:
         if (abs(dist) < METERS_PER_KILOMETER * 100) {
             // Show meters when dist < 1km
-            tfp_sprintf(buff, "%d%c", (int)(dist / 100), SYM_M);
+            formatChar(formatSigned(buff, (int)(dist / 100), 0, false), SYM_M);
         } else {
             // Show kilometers when dist >= 1km
-            tfp_sprintf(buff, "%d.%02d%c", (int)(dist / (100*METERS_PER_KILOMETER)),
-                (abs(dist) % (100 * METERS_PER_KILOMETER)) / METERS_PER_KILOMETER, SYM_KM);
+            formatChar(formatFixedPoint(buff, dist / METERS_PER_KILOMETER, 2, 0), SYM_KM);
         }
         break;
     case OSD_UNIT_GA:
          centifeet = CENTIMETERS_TO_CENTIFEET(dist);
         if (abs(centifeet) < 100000) {
             // Show feet when dist < 1000ft
-            tfp_sprintf(buff, "%d%c", (int)(centifeet / 100), SYM_FT);
+            formatChar(formatSigned(buff, (int)(centifeet / 100), 0, false), SYM_FT);
         } else {
             // Show nautical miles when dist >= 1000ft
-            tfp_sprintf(buff, "%d.%02d%c", (int)(centifeet / (100 * FEET_PER_NAUTICALMILE)),
-                (int)((abs(centifeet) % (int)(100 * FEET_PER_NAUTICALMILE)) / FEET_PER_NAUTICALMILE), SYM_NM);
+            formatChar(formatFixedPoint(buff, (int32_t)(centifeet / FEET_PER_NAUTICALMILE), 2, 0), SYM_NM);
         }
         break;
     }
@@ -398,23 +417,23 @@ void osdFormatVelocityStr(char* buff, int32_t vel, bool _3D, bool _max)
         FALLTHROUGH;
     case OSD_UNIT_IMPERIAL:
         if (_max) {
-            tfp_sprintf(buff, "%c%3d%c", SYM_MAX, (int)osdConvertVelocityToUnit(vel), (_3D ? SYM_3D_MPH : SYM_MPH));
+            formatChar(formatSigned(formatChar(buff, SYM_MAX), (int)osdConvertVelocityToUnit(vel), 3, false), (_3D ? SYM_3D_MPH : SYM_MPH));
         } else {
-            tfp_sprintf(buff, "%3d%c", (int)osdConvertVelocityToUnit(vel), (_3D ? SYM_3D_MPH : SYM_MPH));
+            formatChar(formatSigned(buff, (int)osdConvertVelocityToUnit(vel), 3, false), (_3D ? SYM_3D_MPH : SYM_MPH));
         }
         break;
     case OSD_UNIT_METRIC:
         if (_max) {
-            tfp_sprintf(buff, "%c%3d%c", SYM_MAX, (int)osdConvertVelocityToUnit(vel), (_3D ? SYM_3D_KMH : SYM_KMH));
+            formatChar(formatSigned(formatChar(buff, SYM_MAX), (int)osdConvertVelocityToUnit(vel), 3, false), (_3D ? SYM_3D_KMH : SYM_KMH));
         } else {
-            tfp_sprintf(buff, "%3d%c", (int)osdConvertVelocityToUnit(vel), (_3D ? SYM_3D_KMH : SYM_KMH));
+            formatChar(formatSigned(buff, (int)osdConvertVelocityToUnit(vel), 3, false), (_3D ? SYM_3D_KMH : SYM_KMH));
         }
         break;
     case OSD_UNIT_GA:
         if (_max) {
-            tfp_sprintf(buff, "%c%3d%c", SYM_MAX, (int)osdConvertVelocityToUnit(vel), (_3D ? SYM_3D_KT : SYM_KT));
+            formatChar(formatSigned(formatChar(buff, SYM_MAX), (int)osdConvertVelocityToUnit(vel), 3, false), (_3D ? SYM_3D_KT : SYM_KT));
         } else {
-            tfp_sprintf(buff, "%3d%c", (int)osdConvertVelocityToUnit(vel), (_3D ? SYM_3D_KT : SYM_KT));
+            formatChar(formatSigned(buff, (int)osdConvertVelocityToUnit(vel), 3, false), (_3D ? SYM_3D_KT : SYM_KT));
         }
         break;
     }
@@ -579,13 +598,13 @@ static void osdFormatAltitudeStr(char *buff, int32_t alt)
             FALLTHROUGH;
         case OSD_UNIT_IMPERIAL:
             value = CENTIMETERS_TO_FEET(alt);
-            tfp_sprintf(buff, "%d%c", (int)value, SYM_FT);
+            formatChar(formatSigned(buff, (int)value, 0, false), SYM_FT);
             break;
         case OSD_UNIT_METRIC_MPH:
             FALLTHROUGH;
         case OSD_UNIT_METRIC:
             value = CENTIMETERS_TO_METERS(alt);
-            tfp_sprintf(buff, "%d%c", (int)value, SYM_M);
+            formatChar(formatSigned(buff, (int)value, 0, false), SYM_M);
             break;
     }
 }
@@ -600,7 +619,8 @@ static void osdFormatTime(char *buff, uint32_t seconds, char sym_m, char sym_h)
         value = seconds / 60;
     }
     buff[0] = sym;
-    tfp_sprintf(buff + 1, "%02d:%02d", (int)(value / 60), (int)(value % 60));
+    char *ptr = formatChar(formatUnsigned(buff + 1, value / 60, 2, true), ':');
+    formatUnsigned(ptr, value % 60, 2, true);
 }
 
 static inline void osdFormatOnTime(char *buff)
@@ -711,7 +731,7 @@ static void osdDisplayTemperature(uint8_t elemPosX, uint8_t elemPosY, uint16_t s
 
         if ((temperature <= alarm_min) || (temperature >= alarm_max)) TEXT_ATTRIBUTES_ADD_BLINK(elemAttr);
         if (osdConfig()->units == OSD_UNIT_IMPERIAL) temperature = temperature * 9 / 5.0f + 320;
-        tfp_sprintf(buff, "%3d", temperature / 10);
+        formatSigned(buff, temperature / 10, 3, false);
 
     } else
         strcpy(buff, "---");
@@ -976,9 +996,9 @@ static const char * divertingToSafehomeMessage(void)
 #endif
 	    return OSD_MESSAGE_STR(OSD_MSG_DIVERT_SAFEHOME);
 	}
-#endif
 	return NULL;
 }
+#endif
 
 
 static const char * navigationStateMessage(void)
@@ -1137,7 +1157,7 @@ static void osdFormatThrottlePosition(char *buff, bool useScaled, textAttributes
         strcpy(buff + 1, message);
         return;
     }
-    tfp_sprintf(buff + 2, "%3d", throttlePercent);
+    formatSigned(buff + 2, throttlePercent, 3, false);
 }
 
 /**
@@ -1165,23 +1185,7 @@ static void osdFormatRpm(char *buff, uint32_t rpm)
             buff[osdConfig()->esc_rpm_precision+1] = '\0';
         }
         else {
-            switch(osdConfig()->esc_rpm_precision) {
-                case 6:
-                    tfp_sprintf(buff + 1, "%6lu", rpm);
-                    break;
-                case 5:
-                    tfp_sprintf(buff + 1, "%5lu", rpm);
-                    break;
-                case 4:
-                    tfp_sprintf(buff + 1, "%4lu", rpm);
-                    break;
-                case 3:
-                default:
-                    tfp_sprintf(buff + 1, "%3lu", rpm);
-                    break;
-            }
-
-
+            formatUnsigned(buff + 1, rpm, osdConfig()->esc_rpm_precision, false);
         }
     }
     else {
@@ -1251,19 +1255,164 @@ int osdGetHeadingAngle(int angle)
     return angle;
 }
 
+static int8_t getGeoWaypointNumber(int8_t waypointIndex)
+{
+    static int8_t lastWaypointIndex = 1;
+    static int8_t geoWaypointIndex;
+
+    if (waypointIndex != lastWaypointIndex) {
+        lastWaypointIndex = geoWaypointIndex = waypointIndex;
+        for (uint8_t i = posControl.startWpIndex; i <= waypointIndex; i++) {
+            if (posControl.waypointList[i].action == NAV_WP_ACTION_SET_POI ||
+                posControl.waypointList[i].action == NAV_WP_ACTION_SET_HEAD ||
+                posControl.waypointList[i].action == NAV_WP_ACTION_JUMP) {
+                    geoWaypointIndex -= 1;
+            }
+        }
+    }
+
+    return geoWaypointIndex - posControl.startWpIndex + 1;
+}
+
 #if defined(USE_GPS)
 
+#define OSD_MAP_RADAR_SLOTS     RADAR_MAX_POIS
+#ifdef USE_ADSB
+#define OSD_MAP_ADSB_SLOTS      MAX_ADSB_VEHICLES
+#else
+#define OSD_MAP_ADSB_SLOTS      0
+#endif
+#define OSD_MAP_WP_SLOTS        3
+#define OSD_MAP_EXTRA_SLOTS     (OSD_MAP_RADAR_SLOTS + OSD_MAP_ADSB_SLOTS + OSD_MAP_WP_SLOTS)
+#define OSD_MAP_EXTRA_BUDGET    4   // Extra POIs projected per refresh, all of them are when the scale changes
+
+typedef struct osdMapPoint_s {
+    uint16_t drawn;         // OSD_POS() | OSD_VISIBLE_FLAG of the cell, 0 when not on screen
+    uint16_t symbol;
+} osdMapPoint_t;
+
+typedef struct osdMapState_s {
+    uint32_t scale;
+    // Inputs of the last scale search, it's only repeated when they change
+    uint32_t poiDistance;
+    int16_t poiDirection;
+    int16_t referenceHeading;
+    osdMapPoint_t poi;
+    osdMapPoint_t extras[OSD_MAP_EXTRA_SLOTS];
+    uint8_t nextExtra;
+} osdMapState_t;
+
+static bool osdMapCellIsOurs(const osdMapState_t *state, uint16_t cell)
+{
+    if (state->poi.drawn == cell) {
+        return true;
+    }
+    for (int i = 0; i < OSD_MAP_EXTRA_SLOTS; i++) {
+        if (state->extras[i].drawn == cell) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Erases a point drawn by the map, unless something else was written over it
+static void osdMapErasePoint(osdMapPoint_t *point)
+{
+    if (OSD_VISIBLE(point->drawn)) {
+        uint16_t c;
+        if (!displayReadCharWithAttr(osdDisplayPort, OSD_X(point->drawn), OSD_Y(point->drawn), &c, NULL) || c == point->symbol) {
+            displayWriteChar(osdDisplayPort, OSD_X(point->drawn), OSD_Y(point->drawn), SYM_BLANK);
+        }
+        point->drawn = 0;
+    }
+}
+
+// Moves a point to the given cell, the display is only written when the cell or the symbol changed
+static void osdMapMovePoint(osdMapPoint_t *point, int x, int y, uint16_t symbol)
+{
+    const uint16_t cell = OSD_POS(x, y) | OSD_VISIBLE_FLAG;
+    uint16_t c;
+
+    if (point->drawn != cell) {
+        osdMapErasePoint(point);
+    } else if (point->symbol == symbol && displayReadCharWithAttr(osdDisplayPort, x, y, &c, NULL) && c == symbol) {
+        return;
+    }
+
+    displayWriteChar(osdDisplayPort, x, y, symbol);
+    point->drawn = cell;
+    point->symbol = symbol;
+}
+
+/* Returns the distance (m) and bearing (°) from the aircraft to the given extra POI slot.
+ * Slots are the ESP32 radar peers, the ADS-B vehicles and the next waypoints, in this order.
+ */
+static bool osdMapGetExtraPoi(uint8_t slot, uint32_t *distance, int16_t *bearing, uint16_t *symbol)
+{
+    fpVector3_t poi;
+
+    if (slot < OSD_MAP_RADAR_SLOTS) {
+        if (radar_pois[slot].gps.lat == 0 || radar_pois[slot].gps.lon == 0 || radar_pois[slot].state >= 2) { // state 2 means POI has been lost
+            return false;
+        }
+        geoConvertGeodeticToLocal(&poi, &posControl.gpsOrigin, &radar_pois[slot].gps, GEO_ALT_RELATIVE);
+        *distance = calculateDistanceToDestination(&poi) / 100;
+        *bearing = calculateBearingToDestination(&poi) / 100;
+        *symbol = 'A' + slot;
+        return true;
+    }
+    slot -= OSD_MAP_RADAR_SLOTS;
+
+#ifdef USE_ADSB
+    if (slot < OSD_MAP_ADSB_SLOTS) {
+        adsbVehicle_t *vehicle = findVehicle(slot);
+        if (vehicle == NULL || vehicle->ttl == 0) {
+            return false;
+        }
+        recalculateVehicle(vehicle);
+        if (vehicle->ttl == 0 || !vehicle->calculatedVehicleValues.valid) {
+            return false;
+        }
+        *distance = CENTIMETERS_TO_METERS(vehicle->calculatedVehicleValues.dist);
+        *bearing = CENTIDEGREES_TO_DEGREES(vehicle->calculatedVehicleValues.dir);
+        *symbol = SYM_ADSB;
+        return true;
+    }
+    slot -= OSD_MAP_ADSB_SLOTS;
+#endif
+
+    if (!posControl.waypointListValid || posControl.waypointCount == 0) {
+        return false;
+    }
+    const int index = posControl.activeWaypointIndex + slot;
+    if (index > posControl.startWpIndex + posControl.waypointCount - 1) { // limit to max WP index for mission
+        return false;
+    }
+    const navWaypoint_t *waypoint = &posControl.waypointList[index];
+    if (waypoint->lat == 0 || waypoint->lon == 0) {
+        return false;
+    }
+    const gpsLocation_t location = { .lat = waypoint->lat, .lon = waypoint->lon, .alt = waypoint->alt };
+    geoConvertGeodeticToLocal(&poi, &posControl.gpsOrigin, &location, GEO_ALT_RELATIVE);
+    *distance = calculateDistanceToDestination(&poi) / 100;
+    *bearing = calculateBearingToDestination(&poi) / 100;
+    *symbol = '0' + getGeoWaypointNumber(index) % 10; // Only the last digit, as in the HUD
+    return true;
+}
+
 /* Draws a map with the given symbol in the center and given point of interest
  * defined by its distance in meters and direction in degrees.
  * referenceHeading indicates the up direction in the map, in degrees, while
  * referenceSym (if non-zero) is drawn at the upper right corner below a small
- * arrow to indicate the map reference to the user. The drawn argument is an
- * in-out used to store the last position where the craft was drawn to avoid
- * erasing all screen on each redraw.
+ * arrow to indicate the map reference to the user. craftNorth and craftEast
+ * are the position of the aircraft relative to the map center, in meters,
+ * and are used to place the extra POIs enabled by osd_map_pois.
+ * The state keeps the cells drawn on the previous call, so only the symbols
+ * that moved are written again, and the inputs of the last scale search.
  */
-static void osdDrawMap(int referenceHeading, uint16_t referenceSym, uint16_t centerSym,
+static void osdDrawMap(osdMapState_t *state, int referenceHeading, uint16_t referenceSym, uint16_t centerSym,
                        uint32_t poiDistance, int16_t poiDirection, uint16_t poiSymbol,
-                       uint16_t *drawn, uint32_t *usedScale)
+                       float craftNorth, float craftEast)
 {
     // TODO: These need to be tested with several setups. We might
     // need to make them configurable.
@@ -1280,14 +1429,15 @@ static void osdDrawMap(int referenceHeading, uint16_t referenceSym, uint16_t cen
     uint8_t maxY = osdDisplayPort->rows - 1 - vMargin;
     uint8_t midX = osdDisplayPort->cols / 2;
     uint8_t midY = osdDisplayPort->rows / 2;
+    const uint16_t centerCell = OSD_POS(midX, midY) | OSD_VISIBLE_FLAG;
 
     // Fixed marks
     displayWriteChar(osdDisplayPort, midX, midY, centerSym);
 
-    // First, erase the previous drawing.
-    if (OSD_VISIBLE(*drawn)) {
-        displayWriteChar(osdDisplayPort, OSD_X(*drawn), OSD_Y(*drawn), SYM_BLANK);
-        *drawn = 0;
+    if (poiSymbol == SYM_ARROW_UP) {
+        // Drawing aircraft, rotate
+        int mapHeading = osdGetHeadingAngle(DECIDEGREES_TO_DEGREES(osdGetHeading()) - referenceHeading);
+        poiSymbol += mapHeading * 2 / 45;
     }
 
     uint32_t initialScale;
@@ -1313,29 +1463,40 @@ static void osdDrawMap(int referenceHeading, uint16_t referenceSym, uint16_t cen
             break;
     }
 
-    // Try to keep the same scale when getting closer until we draw over the center point
-    uint32_t scale = initialScale;
-    if (*usedScale) {
-        scale = *usedScale;
-        if (scale > initialScale && poiDistance < *usedScale * scaleReductionMultiplier) {
-            scale /= scaleMultiplier;
-        }
-    }
-
-    if (STATE(GPS_FIX) 
+    const bool hasFix = STATE(GPS_FIX)
 #ifdef USE_GPS_FIX_ESTIMATION
             || STATE(GPS_ESTIMATED_FIX)
 #endif
-        ) {
+        ;
+
+    uint32_t scale = initialScale;
+    uint16_t c;
+
+    if (hasFix && state->scale && OSD_VISIBLE(state->poi.drawn) && state->poi.drawn != centerCell &&
+        poiDistance == state->poiDistance && poiDirection == state->poiDirection && referenceHeading == state->referenceHeading &&
+        (!displayReadCharWithAttr(osdDisplayPort, OSD_X(state->poi.drawn), OSD_Y(state->poi.drawn), &c, NULL) || c == state->poi.symbol)) {
+
+        // Nothing moved since the last search, the result would be the same
+        scale = state->scale;
+        osdMapMovePoint(&state->poi, OSD_X(state->poi.drawn), OSD_Y(state->poi.drawn), poiSymbol);
+
+    } else if (hasFix) {
+
+        // Try to keep the same scale when getting closer until we draw over the center point
+        if (state->scale) {
+            scale = state->scale;
+            if (scale > initialScale && poiDistance < state->scale * scaleReductionMultiplier) {
+                scale /= scaleMultiplier;
+            }
+        }
 
         int directionToPoi = osdGetHeadingAngle(poiDirection - referenceHeading);
-        float poiAngle = DEGREES_TO_RADIANS(directionToPoi);
-        float poiSin = sin_approx(poiAngle);
-        float poiCos = cos_approx(poiAngle);
+        float poiSin = osdSinDecidegrees(directionToPoi * 10);
+        float poiCos = osdCosDecidegrees(directionToPoi * 10);
+        bool drawn = false;
 
         // Now start looking for a valid scale that lets us draw everything
-        int ii;
-        for (ii = 0; ii < 50; ii++) {
+        for (int ii = 0; ii < 50; ii++) {
             // Calculate location of the aircraft in map
             int points = poiDistance / ((float)scale / charHeight);
 
@@ -1362,8 +1523,9 @@ static void osdDrawMap(int referenceHeading, uint16_t referenceSym, uint16_t cen
                 }
             } else {
 
-                uint16_t c;
-                if (displayReadCharWithAttr(osdDisplayPort, poiX, poiY, &c, NULL) && c != SYM_BLANK) {
+                // Cells showing our own points are free, they will be moved
+                if (displayReadCharWithAttr(osdDisplayPort, poiX, poiY, &c, NULL) && c != SYM_BLANK &&
+                    !osdMapCellIsOurs(state, OSD_POS(poiX, poiY) | OSD_VISIBLE_FLAG)) {
                     // Something else written here, increase scale. If the display doesn't support reading
                     // back characters, we assume there's nothing.
                     //
@@ -1383,21 +1545,67 @@ static void osdDrawMap(int referenceHeading, uint16_t referenceSym, uint16_t cen
             }
 
             // Draw the point on the map
-            if (poiSymbol == SYM_ARROW_UP) {
-                // Drawing aircraft, rotate
-                int mapHeading = osdGetHeadingAngle(DECIDEGREES_TO_DEGREES(osdGetHeading()) - referenceHeading);
-                poiSymbol += mapHeading * 2 / 45;
+            osdMapMovePoint(&state->poi, poiX, poiY, poiSymbol);
+            drawn = true;
+            break;
+        }
+
+        if (!drawn) {
+            osdMapErasePoint(&state->poi);
+        }
+
+        state->poiDistance = poiDistance;
+        state->poiDirection = poiDirection;
+        state->referenceHeading = referenceHeading;
+
+    } else {
+        osdMapErasePoint(&state->poi);
+        if (state->scale) {
+            scale = state->scale;
+        }
+    }
+
+    const bool rescaled = scale != state->scale;
+    state->scale = scale;
+
+    if (osdConfig()->map_pois && hasFix) {
+        // Extra POIs keep the scale chosen for the main one and are skipped when they don't fit
+        const float referenceSin = osdSinDecidegrees(referenceHeading * 10);
+        const float referenceCos = osdCosDecidegrees(referenceHeading * 10);
+        const float pointsPerMeter = (float)charHeight / scale;
+        const int count = rescaled ? OSD_MAP_EXTRA_SLOTS : MIN(OSD_MAP_EXTRA_BUDGET, OSD_MAP_EXTRA_SLOTS);
+
+        for (int i = 0; i < count; i++) {
+            osdMapPoint_t *point = &state->extras[state->nextExtra];
+            uint32_t distance;
+            int16_t bearing;
+            uint16_t symbol;
+
+            if (osdMapGetExtraPoi(state->nextExtra, &distance, &bearing, &symbol)) {
+                const float north = craftNorth + distance * osdCosDecidegrees(bearing * 10);
+                const float east = craftEast + distance * osdSinDecidegrees(bearing * 10);
+                const int x = midX + roundf((east * referenceCos - north * referenceSin) * pointsPerMeter / charWidth);
+                const int y = midY - roundf((north * referenceCos + east * referenceSin) * pointsPerMeter / charHeight);
+                const uint16_t cell = OSD_POS(x, y) | OSD_VISIBLE_FLAG;
+
+                if (x >= minX && x <= maxX && y >= minY && y <= maxY && cell != centerCell && cell != state->poi.drawn &&
+                    (cell == point->drawn || !displayReadCharWithAttr(osdDisplayPort, x, y, &c, NULL) || c == SYM_BLANK)) {
+                    osdMapMovePoint(point, x, y, symbol);
+                } else {
+                    osdMapErasePoint(point);
+                }
+            } else {
+                osdMapErasePoint(point);
             }
-            displayWriteChar(osdDisplayPort, poiX, poiY, poiSymbol);
 
-            // Update saved location
-            *drawn = OSD_POS(poiX, poiY) | OSD_VISIBLE_FLAG;
-            break;
+            state->nextExtra = (state->nextExtra + 1) % OSD_MAP_EXTRA_SLOTS;
+        }
+    } else {
+        for (int i = 0; i < OSD_MAP_EXTRA_SLOTS; i++) {
+            osdMapErasePoint(&state->extras[i]);
         }
     }
 
-    *usedScale = scale;
-
     // Update global map data for scale and reference
     osdMapData.scale = scale;
     osdMapData.referenceSymbol = referenceSym;
@@ -1406,19 +1614,21 @@ static void osdDrawMap(int referenceHeading, uint16_t referenceSym, uint16_t cen
 /* Draws a map with the home in the center and the craft moving around.
  * See osdDrawMap() for reference.
  */
-static void osdDrawHomeMap(int referenceHeading, uint8_t referenceSym, uint16_t *drawn, uint32_t *usedScale)
+static void osdDrawHomeMap(osdMapState_t *state, int referenceHeading, uint8_t referenceSym)
 {
-    osdDrawMap(referenceHeading, referenceSym, SYM_HOME, GPS_distanceToHome, GPS_directionToHome, SYM_ARROW_UP, drawn, usedScale);
+    const float craftNorth = -(float)GPS_distanceToHome * osdCosDecidegrees(GPS_directionToHome * 10);
+    const float craftEast = -(float)GPS_distanceToHome * osdSinDecidegrees(GPS_directionToHome * 10);
+    osdDrawMap(state, referenceHeading, referenceSym, SYM_HOME, GPS_distanceToHome, GPS_directionToHome, SYM_ARROW_UP, craftNorth, craftEast);
 }
 
 /* Draws a map with the aircraft in the center and the home moving around.
  * See osdDrawMap() for reference.
  */
-static void osdDrawRadar(uint16_t *drawn, uint32_t *usedScale)
+static void osdDrawRadar(osdMapState_t *state)
 {
     int16_t reference = DECIDEGREES_TO_DEGREES(osdGetHeading());
     int16_t poiDirection = osdGetHeadingAngle(GPS_directionToHome + 180);
-    osdDrawMap(reference, 0, SYM_ARROW_UP, GPS_distanceToHome, poiDirection, SYM_HOME, drawn, usedScale);
+    osdDrawMap(state, reference, 0, SYM_ARROW_UP, GPS_distanceToHome, poiDirection, SYM_HOME, 0, 0);
 }
 
 static uint16_t crc_accumulate(uint8_t data, uint16_t crcAccum)
@@ -1542,25 +1752,25 @@ static void osdDisplayFlightPIDValues(uint8_t elemPosX, uint8_t elemPosY, const
     }
 
     elemAttr = TEXT_ATTRIBUTES_NONE;
-    tfp_sprintf(buff, "%3d", pid->P);
+    formatSigned(buff, pid->P, 3, false);
     if ((isAdjustmentFunctionSelected(adjFuncP)) || (((adjFuncP == ADJUSTMENT_ROLL_P) || (adjFuncP == ADJUSTMENT_PITCH_P)) && (isAdjustmentFunctionSelected(ADJUSTMENT_PITCH_ROLL_P))))
         TEXT_ATTRIBUTES_ADD_BLINK(elemAttr);
     displayWriteWithAttr(osdDisplayPort, elemPosX + 4, elemPosY, buff, elemAttr);
 
     elemAttr = TEXT_ATTRIBUTES_NONE;
-    tfp_sprintf(buff, "%3d", pid->I);
+    formatSigned(buff, pid->I, 3, false);
     if ((isAdjustmentFunctionSelected(adjFuncI)) || (((adjFuncI == ADJUSTMENT_ROLL_I) || (adjFuncI == ADJUSTMENT_PITCH_I)) && (isAdjustmentFunctionSelected(ADJUSTMENT_PITCH_ROLL_I))))
         TEXT_ATTRIBUTES_ADD_BLINK(elemAttr);
     displayWriteWithAttr(osdDisplayPort, elemPosX + 8, elemPosY, buff, elemAttr);
 
     elemAttr = TEXT_ATTRIBUTES_NONE;
-    tfp_sprintf(buff, "%3d", pid->D);
+    formatSigned(buff, pid->D, 3, false);
     if ((isAdjustmentFunctionSelected(adjFuncD)) || (((adjFuncD == ADJUSTMENT_ROLL_D) || (adjFuncD == ADJUSTMENT_PITCH_D)) && (isAdjustmentFunctionSelected(ADJUSTMENT_PITCH_ROLL_D))))
         TEXT_ATTRIBUTES_ADD_BLINK(elemAttr);
     displayWriteWithAttr(osdDisplayPort, elemPosX + 12, elemPosY, buff, elemAttr);
 
     elemAttr = TEXT_ATTRIBUTES_NONE;
-    tfp_sprintf(buff, "%3d", pid->FF);
+    formatSigned(buff, pid->FF, 3, false);
     if ((isAdjustmentFunctionSelected(adjFuncFF)) || (((adjFuncFF == ADJUSTMENT_ROLL_FF) || (adjFuncFF == ADJUSTMENT_PITCH_FF)) && (isAdjustmentFunctionSelected(ADJUSTMENT_PITCH_ROLL_FF))))
         TEXT_ATTRIBUTES_ADD_BLINK(elemAttr);
     displayWriteWithAttr(osdDisplayPort, elemPosX + 16, elemPosY, buff, elemAttr);
@@ -1584,19 +1794,19 @@ static void osdDisplayNavPIDValues(uint8_t elemPosX, uint8_t elemPosY, const cha
     }
 
     elemAttr = TEXT_ATTRIBUTES_NONE;
-    tfp_sprintf(buff, "%3d", pid->P);
+    formatSigned(buff, pid->P, 3, false);
     if ((isAdjustmentFunctionSelected(adjFuncP)) || (((adjFuncP == ADJUSTMENT_ROLL_P) || (adjFuncP == ADJUSTMENT_PITCH_P)) && (isAdjustmentFunctionSelected(ADJUSTMENT_PITCH_ROLL_P))))
         TEXT_ATTRIBUTES_ADD_BLINK(elemAttr);
     displayWriteWithAttr(osdDisplayPort, elemPosX + 4, elemPosY, buff, elemAttr);
 
     elemAttr = TEXT_ATTRIBUTES_NONE;
-    tfp_sprintf(buff, "%3d", pid->I);
+    formatSigned(buff, pid->I, 3, false);
     if ((isAdjustmentFunctionSelected(adjFuncI)) || (((adjFuncI == ADJUSTMENT_ROLL_I) || (adjFuncI == ADJUSTMENT_PITCH_I)) && (isAdjustmentFunctionSelected(ADJUSTMENT_PITCH_ROLL_I))))
         TEXT_ATTRIBUTES_ADD_BLINK(elemAttr);
     displayWriteWithAttr(osdDisplayPort, elemPosX + 8, elemPosY, buff, elemAttr);
 
     elemAttr = TEXT_ATTRIBUTES_NONE;
-    tfp_sprintf(buff, "%3d", pidType == PID_TYPE_PIFF ? pid->FF : pid->D);
+    formatSigned(buff, pidType == PID_TYPE_PIFF ? pid->FF : pid->D, 3, false);
     if ((isAdjustmentFunctionSelected(adjFuncD)) || (((adjFuncD == ADJUSTMENT_ROLL_D) || (adjFuncD == ADJUSTMENT_PITCH_D)) && (isAdjustmentFunctionSelected(ADJUSTMENT_PITCH_ROLL_D))))
         TEXT_ATTRIBUTES_ADD_BLINK(elemAttr);
     displayWriteWithAttr(osdDisplayPort, elemPosX + 12, elemPosY, buff, elemAttr);
@@ -1614,25 +1824,6 @@ static void osdDisplayAdjustableDecimalValue(uint8_t elemPosX, uint8_t elemPosY,
     displayWriteWithAttr(osdDisplayPort, elemPosX + strlen(str) + 1 + valueOffset, elemPosY, buff, elemAttr);
 }
 
-int8_t getGeoWaypointNumber(int8_t waypointIndex)
-{
-    static int8_t lastWaypointIndex = 1;
-    static int8_t geoWaypointIndex;
-
-    if (waypointIndex != lastWaypointIndex) {
-        lastWaypointIndex = geoWaypointIndex = waypointIndex;
-        for (uint8_t i = posControl.startWpIndex; i <= waypointIndex; i++) {
-            if (posControl.waypointList[i].action == NAV_WP_ACTION_SET_POI ||
-                posControl.waypointList[i].action == NAV_WP_ACTION_SET_HEAD ||
-                posControl.waypointList[i].action == NAV_WP_ACTION_JUMP) {
-                    geoWaypointIndex -= 1;
-            }
-        }
-    }
-
-    return geoWaypointIndex - posControl.startWpIndex + 1;
-}
-
 void osdDisplaySwitchIndicator(const char *swName, int rcValue, char *buff) {
     int8_t ptr = 0;
 
@@ -1667,6 +1858,59 @@ void osdDisplaySwitchIndicator(const char *swName, int rcValue, char *buff) {
     buff[ptr] = '\0';
 }
 
+#define OSD_FINGERPRINT_INIT    2166136261U
+
+// FNV-1a, cheap enough to run over every element on every pass
+static uint32_t osdFingerprintUpdate(uint32_t hash, const void *data, size_t length)
+{
+    const uint8_t *p = data;
+    while (length--) {
+        hash = (hash ^ *p++) * 16777619U;
+    }
+    return hash;
+}
+
+static void osdElementInvalidate(uint8_t item)
+{
+    osdElementState[item].fingerprint = 0;
+}
+
+// Nothing on screen can be trusted after it was cleared, every element has to be drawn again
+static void osdElementStateCheckCleared(uint16_t now)
+{
+    if (osdDisplayPort->clearCount == osdElementStateClearCount) {
+        return;
+    }
+
+    for (int ii = 0; ii < OSD_ITEM_COUNT; ii++) {
+        osdElementState[ii].fingerprint = 0;
+        osdElementState[ii].refreshedAt = now - OSD_REFRESH_SLOW_INTERVAL_MS;
+    }
+    osdElementStateClearCount = osdDisplayPort->clearCount;
+}
+
+/*
+ * Returns true if an element with the given fingerprint has to be drawn, i.e. it changed since it
+ * was last drawn, the screen was cleared in the meantime or OSD_ELEMENT_REFRESH_MAX_MS elapsed.
+ */
+static bool osdElementNeedsDraw(uint8_t item, uint32_t fingerprint)
+{
+    osdElementState_t *state = &osdElementState[item];
+    const uint16_t now = millis();
+
+    if (fingerprint == 0) {
+        fingerprint = 1;
+    }
+
+    if (state->fingerprint == fingerprint && (uint16_t)(now - state->drawnAt) < OSD_ELEMENT_REFRESH_MAX_MS) {
+        return false;
+    }
+
+    state->fingerprint = fingerprint;
+    state->drawnAt = now;
+    return true;
+}
+
 static bool osdDrawSingleElement(uint8_t item)
 {
     uint16_t pos = osdLayoutsConfig()->item_pos[currentLayout][item];
@@ -1698,7 +1942,7 @@ static bool osdDrawSingleElement(uint8_t item)
         {
             uint16_t osdRssi = osdConvertRSSI();
             buff[0] = SYM_RSSI;
-            tfp_sprintf(buff + 1, "%2d", osdRssi);
+            formatSigned(buff + 1, osdRssi, 2, false);
             if (osdRssi < osdConfig()->rssi_alarm) {
                 TEXT_ATTRIBUTES_ADD_BLINK(elemAttr);
             }
@@ -1745,7 +1989,7 @@ static bool osdDrawSingleElement(uint8_t item)
 #ifndef DISABLE_MSP_DJI_COMPAT // IF DJICOMPAT is not supported, there's no need to check for it
         if (isDJICompatibleVideoSystem(osdConfig())) {
             //DJIcompat is unable to work with scaled values and it only has mAh symbol to work with
-            tfp_sprintf(buff, "%5d", (int)getMAhDrawn());   // Use 5 digits to allow packs below 100Ah
+            formatSigned(buff, (int)getMAhDrawn(), 5, false);   // Use 5 digits to allow packs below 100Ah
             buff[5] = SYM_MAH;
             buff[6] = '\0';
         } else
@@ -1786,7 +2030,7 @@ static bool osdDrawSingleElement(uint8_t item)
 #ifndef DISABLE_MSP_DJI_COMPAT // IF DJICOMPAT is not supported, there's no need to check for it
             if (isDJICompatibleVideoSystem(osdConfig())) {
                 //DJIcompat is unable to work with scaled values and it only has mAh symbol to work with
-                tfp_sprintf(buff, "%5d", (int)getBatteryRemainingCapacity());   // Use 5 digits to allow packs below 100Ah
+                formatSigned(buff, (int)getBatteryRemainingCapacity(), 5, false);   // Use 5 digits to allow packs below 100Ah
                 buff[5] = SYM_MAH;
                 buff[6] = '\0';
                 unitsDrawn = true;
@@ -1825,7 +2069,7 @@ static bool osdDrawSingleElement(uint8_t item)
 
     case OSD_POWER_SUPPLY_IMPEDANCE:
         if (isPowerSupplyImpedanceValid())
-            tfp_sprintf(buff, "%3d", getPowerSupplyImpedance());
+            formatSigned(buff, getPowerSupplyImpedance(), 3, false);
         else
             strcpy(buff, "---");
         buff[3] = SYM_MILLIOHM;
@@ -1836,7 +2080,7 @@ static bool osdDrawSingleElement(uint8_t item)
     case OSD_GPS_SATS:
         buff[0] = SYM_SAT_L;
         buff[1] = SYM_SAT_R;
-        tfp_sprintf(buff + 2, "%2d", gpsSol.numSat);
+        formatSigned(buff + 2, gpsSol.numSat, 2, false);
 #ifdef USE_GPS_FIX_ESTIMATION
         if (STATE(GPS_ESTIMATED_FIX)) {
             strcpy(buff + 2, "ES");
@@ -1936,7 +2180,7 @@ static bool osdDrawSingleElement(uint8_t item)
 
             if (isImuHeadingValid() && navigationPositionEstimateIsHealthy()) {
                 int16_t h = lrintf(CENTIDEGREES_TO_DEGREES((float)wrap_18000(DEGREES_TO_CENTIDEGREES((int32_t)GPS_directionToHome) - (STATE(AIRPLANE) ? posControl.actualState.cog : DECIDEGREES_TO_CENTIDEGREES((int32_t)osdGetHeading())))));
-                tfp_sprintf(buff + 2, "%4d", h);
+                formatSigned(buff + 2, h, 4, false);
             } else {
                 strcpy(buff + 2, "----");
             }
@@ -2021,7 +2265,7 @@ static bool osdDrawSingleElement(uint8_t item)
         {
             buff[0] = SYM_GROUND_COURSE;
             if (osdIsHeadingValid()) {
-                tfp_sprintf(&buff[1], "%3d", (int16_t)CENTIDEGREES_TO_DEGREES(posControl.actualState.cog));
+                formatSigned(&buff[1], (int16_t)CENTIDEGREES_TO_DEGREES(posControl.actualState.cog), 3, false);
             } else {
                 buff[1] = buff[2] = buff[3] = '-';
             }
@@ -2046,7 +2290,7 @@ static bool osdDrawSingleElement(uint8_t item)
                 if (ABS(herr) > 99)
                     strcpy(buff + 1, ">99");
                 else
-                    tfp_sprintf(buff + 1, "%3d", herr);
+                    formatSigned(buff + 1, herr, 3, false);
             }
 
             buff[4] = SYM_DEGREES;
@@ -2068,7 +2312,7 @@ static bool osdDrawSingleElement(uint8_t item)
             if (!ARMING_FLAG(ARMED)) {
                 buff[1] = buff[2] = buff[3] = buff[4] = '-';
             } else if (FLIGHT_MODE(NAV_COURSE_HOLD_MODE)) {
-                tfp_sprintf(buff + 1, "%4d", heading_adjust);
+                formatSigned(buff + 1, heading_adjust, 4, false);
             }
 
             buff[5] = SYM_DEGREES;
@@ -2160,7 +2404,7 @@ static bool osdDrawSingleElement(uint8_t item)
         {
             buff[0] = SYM_ADSB;
             if(getAdsbStatus()->vehiclesMessagesTotal > 0){
-                tfp_sprintf(buff + 1, "%2d", getActiveVehiclesCount());
+                formatSigned(buff + 1, getActiveVehiclesCount(), 2, false);
             }else{
                 buff[1] = '-';
             }
@@ -2171,23 +2415,20 @@ static bool osdDrawSingleElement(uint8_t item)
 #endif
     case OSD_MAP_NORTH:
         {
-            static uint16_t drawn = 0;
-            static uint32_t scale = 0;
-            osdDrawHomeMap(0, 'N', &drawn, &scale);
+            static osdMapState_t state;
+            osdDrawHomeMap(&state, 0, 'N');
             return true;
         }
     case OSD_MAP_TAKEOFF:
         {
-            static uint16_t drawn = 0;
-            static uint32_t scale = 0;
-            osdDrawHomeMap(CENTIDEGREES_TO_DEGREES(navigationGetHomeHeading()), 'T', &drawn, &scale);
+            static osdMapState_t state;
+            osdDrawHomeMap(&state, CENTIDEGREES_TO_DEGREES(navigationGetHomeHeading()), 'T');
             return true;
         }
     case OSD_RADAR:
         {
-            static uint16_t drawn = 0;
-            static uint32_t scale = 0;
-            osdDrawRadar(&drawn, &scale);
+            static osdMapState_t state;
+            osdDrawRadar(&state);
             return true;
         }
 #endif // GPS
@@ -2450,7 +2691,7 @@ static bool osdDrawSingleElement(uint8_t item)
             int16_t rssi = rxLinkStatistics.uplinkRSSI;
             buff[0] = (rxLinkStatistics.activeAntenna == 0) ? SYM_RSSI : SYM_2RSS; // Separate symbols for each antenna
             if (rssi <= -100) {
-                tfp_sprintf(buff + 1, "%4d%c", rssi, SYM_DBM);
+                formatChar(formatSigned(buff + 1, rssi, 4, false), SYM_DBM);
             } else {
                 tfp_sprintf(buff + 1, "%3d%c%c", rssi, SYM_DBM, ' ');
             }
@@ -2469,9 +2710,9 @@ static bool osdDrawSingleElement(uint8_t item)
             switch (osdConfig()->crsf_lq_format) {
                 case OSD_CRSF_LQ_TYPE1:
                     if (!failsafeIsReceivingRxData()) {
-                        tfp_sprintf(buff+1, "%3d", 0);
+                        formatSigned(buff+1, 0, 3, false);
                     } else {
-                        tfp_sprintf(buff+1, "%3d", rxLinkStatistics.uplinkLQ);
+                        formatSigned(buff+1, rxLinkStatistics.uplinkLQ, 3, false);
                     }
                     break;
                 case OSD_CRSF_LQ_TYPE2:
@@ -2483,9 +2724,9 @@ static bool osdDrawSingleElement(uint8_t item)
                     break;
                 case OSD_CRSF_LQ_TYPE3:
                     if (!failsafeIsReceivingRxData()) {
-                        tfp_sprintf(buff+1, "%3d", 0);
+                        formatSigned(buff+1, 0, 3, false);
                     } else {
-                        tfp_sprintf(buff+1, "%3d", rxLinkStatistics.rfMode >= 2 ? scaledLQ : rxLinkStatistics.uplinkLQ);
+                        formatSigned(buff+1, rxLinkStatistics.rfMode >= 2 ? scaledLQ : rxLinkStatistics.uplinkLQ, 3, false);
                     }
                     break;
             }
@@ -2517,7 +2758,7 @@ static bool osdDrawSingleElement(uint8_t item)
             } else if (snrFiltered <= osdConfig()->snr_alarm) {
                 buff[0] = SYM_SNR;
                 if (snrFiltered <= -10) {
-                    tfp_sprintf(buff + 1, "%3d%c", snrFiltered, SYM_DB);
+                    formatChar(formatSigned(buff + 1, snrFiltered, 3, false), SYM_DB);
                 } else {
                     tfp_sprintf(buff + 1, "%2d%c%c", snrFiltered, SYM_DB, ' ');
                 }
@@ -2530,7 +2771,7 @@ static bool osdDrawSingleElement(uint8_t item)
             if (!failsafeIsReceivingRxData())
                 tfp_sprintf(buff, "%s%c", "    ", SYM_BLANK);
             else
-                tfp_sprintf(buff, "%4d%c", rxLinkStatistics.uplinkTXPower, SYM_MW);
+                formatChar(formatSigned(buff, rxLinkStatistics.uplinkTXPower, 4, false), SYM_MW);
             break;
         }
 #endif
@@ -2554,14 +2795,13 @@ static bool osdDrawSingleElement(uint8_t item)
 #endif            
             ) && isImuHeadingValid()) {
 
-            if (osdConfig()->hud_homepoint || osdConfig()->hud_radar_disp > 0 || osdConfig()->hud_wp_disp > 0) {
-                    osdHudClear();
-            }
+            osdHudPoi_t pois[OSD_HUD_MAX_POIS];
+            uint8_t poiCount = 0;
 
             // -------- POI : Home point
 
             if (osdConfig()->hud_homepoint) { // Display the home point (H)
-                osdHudDrawPoi(GPS_distanceToHome, GPS_directionToHome, -osdGetAltitude() / 100, 0, SYM_HOME, 0 , 0);
+                pois[poiCount++] = (osdHudPoi_t){ GPS_distanceToHome, GPS_directionToHome, -osdGetAltitude() / 100, 0, SYM_HOME, 0, 0 };
             }
 
             // -------- POI : Nearby aircrafts from ESP32 radar
@@ -2576,7 +2816,7 @@ static bool osdDrawSingleElement(uint8_t item)
                         if (radar_pois[i].distance >= osdConfig()->hud_radar_range_min && radar_pois[i].distance <= osdConfig()->hud_radar_range_max) {
                             radar_pois[i].direction = calculateBearingToDestination(&poi) / 100; // In °
                             radar_pois[i].altitude = (radar_pois[i].gps.alt - osdGetAltitudeMsl()) / 100;
-                            osdHudDrawPoi(radar_pois[i].distance, osdGetHeadingAngle(radar_pois[i].direction), radar_pois[i].altitude, 1, 65 + i, radar_pois[i].heading, radar_pois[i].lq);
+                            pois[poiCount++] = (osdHudPoi_t){ radar_pois[i].distance, osdGetHeadingAngle(radar_pois[i].direction), radar_pois[i].altitude, 1, 65 + i, radar_pois[i].heading, radar_pois[i].lq };
                         }
                     }
                 }
@@ -2602,10 +2842,14 @@ static bool osdDrawSingleElement(uint8_t item)
                         int32_t altConvModeAltitude = waypointMissionAltConvMode(posControl.waypointList[j].p3) == GEO_ALT_ABSOLUTE ? osdGetAltitudeMsl() : osdGetAltitude();
                         j = getGeoWaypointNumber(j);
                         while (j > 9) j -= 10; // Only the last digit displayed if WP>=10, no room for more (48 = ascii 0)
-                        osdHudDrawPoi(calculateDistanceToDestination(&poi) / 100, osdGetHeadingAngle(calculateBearingToDestination(&poi) / 100), (posControl.waypointList[j].alt - altConvModeAltitude)/ 100, 2, SYM_WAYPOINT, 48 + j, i);
+                        pois[poiCount++] = (osdHudPoi_t){ calculateDistanceToDestination(&poi) / 100, osdGetHeadingAngle(calculateBearingToDestination(&poi) / 100), (posControl.waypointList[j].alt - altConvModeAltitude)/ 100, 2, SYM_WAYPOINT, 48 + j, i };
                     }
                 }
             }
+
+            if (osdConfig()->hud_homepoint || osdConfig()->hud_radar_disp > 0 || osdConfig()->hud_wp_disp > 0) {
+                osdHudDrawPois(pois, poiCount);
+            }
         }
 
         return true;
@@ -2630,16 +2874,17 @@ static bool osdDrawSingleElement(uint8_t item)
 
     case OSD_ARTIFICIAL_HORIZON:
         {
-            float rollAngle = DECIDEGREES_TO_RADIANS(attitude.values.roll);
-            float pitchAngle = DECIDEGREES_TO_RADIANS(attitude.values.pitch);
-
-            pitchAngle -= osdConfig()->ahi_camera_uptilt_comp ? DEGREES_TO_RADIANS(osdConfig()->camera_uptilt) : 0;
-            pitchAngle += DEGREES_TO_RADIANS(getFixedWingLevelTrim());
-            if (osdConfig()->ahi_reverse_roll) {
-                rollAngle = -rollAngle;
+            const float rollAngle = osdGetViewTransform()->rollAngle;
+            const float pitchAngle = osdGetViewTransform()->pitchAngle;
+
+            // Attitude is only known to 0.1deg, most calls would redraw the exact same horizon
+            uint32_t fingerprint = osdFingerprintUpdate(OSD_FINGERPRINT_INIT, &pos, sizeof(pos));
+            fingerprint = osdFingerprintUpdate(fingerprint, &rollAngle, sizeof(rollAngle));
+            fingerprint = osdFingerprintUpdate(fingerprint, &pitchAngle, sizeof(pitchAngle));
+            if (osdElementNeedsDraw(item, fingerprint)) {
+                osdDrawArtificialHorizon(osdDisplayPort, osdGetDisplayPortCanvas(),
+                     OSD_DRAW_POINT_GRID(elemPosX, elemPosY), rollAngle, pitchAngle);
             }
-            osdDrawArtificialHorizon(osdDisplayPort, osdGetDisplayPortCanvas(),
-                 OSD_DRAW_POINT_GRID(elemPosX, elemPosY), rollAngle, pitchAngle);
             osdDrawSingleElement(OSD_HORIZON_SIDEBARS);
             osdDrawSingleElement(OSD_CROSSHAIRS);
 
@@ -2814,7 +3059,7 @@ static bool osdDrawSingleElement(uint8_t item)
                 }
 
                 if (osdConfig()->pan_servo_indicator_show_degrees) {
-                    tfp_sprintf(buff, "%3d%c", -panOffset, SYM_DEGREES);
+                    formatChar(formatSigned(buff, -panOffset, 3, false), SYM_DEGREES);
                     displayWriteWithAttr(osdDisplayPort, elemPosX+1, elemPosY, buff, elemAttr);
                 }
                 displayWriteCharWithAttr(osdDisplayPort, elemPosX, elemPosY, SYM_SERVO_PAN_IS_OFFSET_R, elemAttr);
@@ -2830,7 +3075,7 @@ static bool osdDrawSingleElement(uint8_t item)
                 }
 
                 if (osdConfig()->pan_servo_indicator_show_degrees) {
-                    tfp_sprintf(buff, "%3d%c", panOffset, SYM_DEGREES);
+                    formatChar(formatSigned(buff, panOffset, 3, false), SYM_DEGREES);
                     displayWriteWithAttr(osdDisplayPort, elemPosX+1, elemPosY, buff, elemAttr);
                 }
                 displayWriteCharWithAttr(osdDisplayPort, elemPosX, elemPosY, SYM_SERVO_PAN_IS_OFFSET_L, elemAttr);
@@ -2838,7 +3083,7 @@ static bool osdDrawSingleElement(uint8_t item)
                 panServoTimeOffCentre = 0;
 
                 if (osdConfig()->pan_servo_indicator_show_degrees) {
-                    tfp_sprintf(buff, "%3d%c", panOffset, SYM_DEGREES);
+                    formatChar(formatSigned(buff, panOffset, 3, false), SYM_DEGREES);
                     displayWriteWithAttr(osdDisplayPort, elemPosX+1, elemPosY, buff, elemAttr);
                 }
                 displayWriteChar(osdDisplayPort, elemPosX, elemPosY, SYM_SERVO_PAN_IS_CENTRED);
@@ -2913,7 +3158,7 @@ static bool osdDrawSingleElement(uint8_t item)
         displayWrite(osdDisplayPort, elemPosX, elemPosY, "SPR");
 
         elemAttr = TEXT_ATTRIBUTES_NONE;
-        tfp_sprintf(buff, "%3d", currentControlRateProfile->stabilized.rates[FD_PITCH]);
+        formatSigned(buff, currentControlRateProfile->stabilized.rates[FD_PITCH], 3, false);
         if (isAdjustmentFunctionSelected(ADJUSTMENT_PITCH_RATE) || isAdjustmentFunctionSelected(ADJUSTMENT_PITCH_ROLL_RATE))
             TEXT_ATTRIBUTES_ADD_BLINK(elemAttr);
         displayWriteWithAttr(osdDisplayPort, elemPosX + 4, elemPosY, buff, elemAttr);
@@ -2923,7 +3168,7 @@ static bool osdDrawSingleElement(uint8_t item)
         displayWrite(osdDisplayPort, elemPosX, elemPosY, "SRR");
 
         elemAttr = TEXT_ATTRIBUTES_NONE;
-        tfp_sprintf(buff, "%3d", currentControlRateProfile->stabilized.rates[FD_ROLL]);
+        formatSigned(buff, currentControlRateProfile->stabilized.rates[FD_ROLL], 3, false);
         if (isAdjustmentFunctionSelected(ADJUSTMENT_ROLL_RATE) || isAdjustmentFunctionSelected(ADJUSTMENT_PITCH_ROLL_RATE))
             TEXT_ATTRIBUTES_ADD_BLINK(elemAttr);
         displayWriteWithAttr(osdDisplayPort, elemPosX + 4, elemPosY, buff, elemAttr);
@@ -2945,7 +3190,7 @@ static bool osdDrawSingleElement(uint8_t item)
         displayWrite(osdDisplayPort, elemPosX, elemPosY, "MPR");
 
         elemAttr = TEXT_ATTRIBUTES_NONE;
-        tfp_sprintf(buff, "%3d", currentControlRateProfile->manual.rates[FD_PITCH]);
+        formatSigned(buff, currentControlRateProfile->manual.rates[FD_PITCH], 3, false);
         if (isAdjustmentFunctionSelected(ADJUSTMENT_MANUAL_PITCH_RATE) || isAdjustmentFunctionSelected(ADJUSTMENT_MANUAL_PITCH_ROLL_RATE))
             TEXT_ATTRIBUTES_ADD_BLINK(elemAttr);
         displayWriteWithAttr(osdDisplayPort, elemPosX + 4, elemPosY, buff, elemAttr);
@@ -2955,7 +3200,7 @@ static bool osdDrawSingleElement(uint8_t item)
         displayWrite(osdDisplayPort, elemPosX, elemPosY, "MRR");
 
         elemAttr = TEXT_ATTRIBUTES_NONE;
-        tfp_sprintf(buff, "%3d", currentControlRateProfile->manual.rates[FD_ROLL]);
+        formatSigned(buff, currentControlRateProfile->manual.rates[FD_ROLL], 3, false);
         if (isAdjustmentFunctionSelected(ADJUSTMENT_MANUAL_ROLL_RATE) || isAdjustmentFunctionSelected(ADJUSTMENT_MANUAL_PITCH_ROLL_RATE))
             TEXT_ATTRIBUTES_ADD_BLINK(elemAttr);
         displayWriteWithAttr(osdDisplayPort, elemPosX + 4, elemPosY, buff, elemAttr);
@@ -3017,11 +3262,11 @@ static bool osdDrawSingleElement(uint8_t item)
             const navigationPIDControllers_t *nav_pids = getNavigationPIDControllers();
             strcpy(buff, "POSO ");
             // display requested velocity cm/s
-            tfp_sprintf(buff + 5, "%4d", (int)lrintf(nav_pids->pos[X].output_constrained * 100));
+            formatSigned(buff + 5, (int)lrintf(nav_pids->pos[X].output_constrained * 100), 4, false);
             buff[9] = ' ';
-            tfp_sprintf(buff + 10, "%4d", (int)lrintf(nav_pids->pos[Y].output_constrained * 100));
+            formatSigned(buff + 10, (int)lrintf(nav_pids->pos[Y].output_constrained * 100), 4, false);
             buff[14] = ' ';
-            tfp_sprintf(buff + 15, "%4d", (int)lrintf(nav_pids->pos[Z].output_constrained * 100));
+            formatSigned(buff + 15, (int)lrintf(nav_pids->pos[Z].output_constrained * 100), 4, false);
             buff[19] = '\0';
             break;
         }
@@ -3137,7 +3382,7 @@ static bool osdDrawSingleElement(uint8_t item)
                 if (h < 0) {
                     h += 360;
                 }
-                tfp_sprintf(&buff[1], "%3d", h);
+                formatSigned(&buff[1], h, 3, false);
             } else {
                 buff[1] = buff[2] = buff[3] = '-';
             }
@@ -3440,7 +3685,7 @@ static bool osdDrawSingleElement(uint8_t item)
                 else
                     h = h + 180;
 
-                tfp_sprintf(&buff[1], "%3d", h);
+                formatSigned(&buff[1], h, 3, false);
             } else {
                 buff[1] = buff[2] = buff[3] = '-';
             }
@@ -3570,7 +3815,7 @@ static bool osdDrawSingleElement(uint8_t item)
 
             displayWrite(osdDisplayPort, elemPosX, elemPosY, "TPA");
             attr = TEXT_ATTRIBUTES_NONE;
-            tfp_sprintf(buff, "%3d", currentControlRateProfile->throttle.dynPID);
+            formatSigned(buff, currentControlRateProfile->throttle.dynPID, 3, false);
             if (isAdjustmentFunctionSelected(ADJUSTMENT_TPA)) {
                 TEXT_ATTRIBUTES_ADD_BLINK(attr);
             }
@@ -3578,7 +3823,7 @@ static bool osdDrawSingleElement(uint8_t item)
 
             displayWrite(osdDisplayPort, elemPosX, elemPosY + 1, "BP");
             attr = TEXT_ATTRIBUTES_NONE;
-            tfp_sprintf(buff, "%4d", currentControlRateProfile->throttle.pa_breakpoint);
+            formatSigned(buff, currentControlRateProfile->throttle.pa_breakpoint, 4, false);
             if (isAdjustmentFunctionSelected(ADJUSTMENT_TPA_BREAKPOINT)) {
                 TEXT_ATTRIBUTES_ADD_BLINK(attr);
             }
@@ -3709,6 +3954,19 @@ static bool osdDrawSingleElement(uint8_t item)
         return false;
     }
 
+    // Blink might be emulated by alternating the text, always write those
+    if (TEXT_ATTRIBUTES_HAVE_BLINK(elemAttr)) {
+        osdElementInvalidate(item);
+    } else {
+        uint32_t fingerprint = osdFingerprintUpdate(OSD_FINGERPRINT_INIT, &elemPosX, sizeof(elemPosX));
+        fingerprint = osdFingerprintUpdate(fingerprint, &elemPosY, sizeof(elemPosY));
+        fingerprint = osdFingerprintUpdate(fingerprint, &elemAttr, sizeof(elemAttr));
+        fingerprint = osdFingerprintUpdate(fingerprint, buff, strlen(buff));
+        if (!osdElementNeedsDraw(item, fingerprint)) {
+            return true;
+        }
+    }
+
     displayWriteWithAttr(osdDisplayPort, elemPosX, elemPosY, buff, elemAttr);
     return true;
 }
@@ -3717,10 +3975,6 @@ uint8_t osdIncElementIndex(uint8_t elementIndex)
 {
     ++elementIndex;
 
-    if (elementIndex == OSD_ARTIFICIAL_HORIZON) {   // always drawn last so skip
-        elementIndex++;
-    }
-
 #ifndef USE_TEMPERATURE_SENSOR
     if (elementIndex == OSD_TEMP_SENSOR_0_TEMPERATURE) {
         elementIndex = OSD_ALTITUDE_MSL;
@@ -3820,17 +4074,118 @@ uint8_t osdIncElementIndex(uint8_t elementIndex)
     return elementIndex;
 }
 
+osdRefreshClass_e osdGetItemRefreshClass(const osdRefreshConfig_t *config, int layout, osd_items_e item)
+{
+    const unsigned shift = (item % OSD_REFRESH_CLASSES_PER_BYTE) * OSD_REFRESH_CLASS_BITS;
+    return (config->item_class[layout][item / OSD_REFRESH_CLASSES_PER_BYTE] >> shift) & ((1 << OSD_REFRESH_CLASS_BITS) - 1);
+}
+
+void osdSetItemRefreshClass(osdRefreshConfig_t *config, int layout, osd_items_e item, osdRefreshClass_e refreshClass)
+{
+    const unsigned shift = (item % OSD_REFRESH_CLASSES_PER_BYTE) * OSD_REFRESH_CLASS_BITS;
+    uint8_t *classes = &config->item_class[layout][item / OSD_REFRESH_CLASSES_PER_BYTE];
+
+    *classes = (*classes & ~(((1 << OSD_REFRESH_CLASS_BITS) - 1) << shift)) | (refreshClass << shift);
+}
+
+// Class used for elements left at OSD_REFRESH_CLASS_AUTO
+static osdRefreshClass_e osdDefaultRefreshClass(uint8_t item)
+{
+    switch (item) {
+    case OSD_ARTIFICIAL_HORIZON:
+    case OSD_HORIZON_SIDEBARS:
+    case OSD_CROSSHAIRS:
+    case OSD_ATTITUDE_ROLL:
+    case OSD_ATTITUDE_PITCH:
+    case OSD_MESSAGES:
+    case OSD_MULTI_FUNCTION:
+    case OSD_ADSB_WARNING:
+        return OSD_REFRESH_CLASS_CRITICAL;
+
+    case OSD_CRAFT_NAME:
+    case OSD_PILOT_NAME:
+    case OSD_PILOT_LOGO:
+    case OSD_VERSION:
+    case OSD_VTX_CHANNEL:
+    case OSD_VTX_POWER:
+    case OSD_ACTIVE_PROFILE:
+    case OSD_IMU_TEMPERATURE:
+    case OSD_BARO_TEMPERATURE:
+    case OSD_TEMP_SENSOR_0_TEMPERATURE:
+    case OSD_TEMP_SENSOR_1_TEMPERATURE:
+    case OSD_TEMP_SENSOR_2_TEMPERATURE:
+    case OSD_TEMP_SENSOR_3_TEMPERATURE:
+    case OSD_TEMP_SENSOR_4_TEMPERATURE:
+    case OSD_TEMP_SENSOR_5_TEMPERATURE:
+    case OSD_TEMP_SENSOR_6_TEMPERATURE:
+    case OSD_TEMP_SENSOR_7_TEMPERATURE:
+    case OSD_ESC_TEMPERATURE:
+    case OSD_GPS_MAX_SPEED:
+    case OSD_3D_MAX_SPEED:
+    case OSD_AIR_MAX_SPEED:
+    case OSD_ODOMETER:
+    case OSD_EFFICIENCY_MAH_PER_KM:
+    case OSD_EFFICIENCY_WH_PER_KM:
+    case OSD_CLIMB_EFFICIENCY:
+    case OSD_POWER_SUPPLY_IMPEDANCE:
+        return OSD_REFRESH_CLASS_SLOW;
+
+    default:
+        return OSD_REFRESH_CLASS_NORMAL;
+    }
+}
+
+static osdRefreshClass_e osdItemRefreshClass(uint8_t item)
+{
+    const osdRefreshClass_e refreshClass = osdGetItemRefreshClass(osdRefreshConfig(), currentLayout, item);
+    return refreshClass == OSD_REFRESH_CLASS_AUTO ? osdDefaultRefreshClass(item) : refreshClass;
+}
+
+/*
+ * Critical elements are drawn on every call. The remaining ones are drawn round robin as soon as their
+ * refresh interval elapsed, until osd_refresh_time_budget is used up. At least one is drawn per call.
+ */
 void osdDrawNextElement(void)
 {
     static uint8_t elementIndex = 0;
+    const timeUs_t startUs = micros();
+    const uint16_t now = millis();
+
+    osdElementStateCheckCleared(now);
+
+    uint8_t item = 0;
+    do {
+        if (osdItemRefreshClass(item) == OSD_REFRESH_CLASS_CRITICAL) {
+            osdDrawSingleElement(item);
+        }
+        item = osdIncElementIndex(item);
+    } while (item != 0);
+
     // Flag for end of loop, also prevents infinite loop when no elements are enabled
-    uint8_t index = elementIndex;
+    const uint8_t index = elementIndex;
     do {
         elementIndex = osdIncElementIndex(elementIndex);
-    } while (!osdDrawSingleElement(elementIndex) && index != elementIndex);
 
-    // Draw artificial horizon + tracking telemetry last
-    osdDrawSingleElement(OSD_ARTIFICIAL_HORIZON);
+        const osdRefreshClass_e refreshClass = osdItemRefreshClass(elementIndex);
+        if (refreshClass == OSD_REFRESH_CLASS_CRITICAL) {
+            continue;
+        }
+
+        osdElementState_t *state = &osdElementState[elementIndex];
+        const uint16_t interval = refreshClass == OSD_REFRESH_CLASS_SLOW ? OSD_REFRESH_SLOW_INTERVAL_MS : OSD_REFRESH_NORMAL_INTERVAL_MS;
+        if ((uint16_t)(now - state->refreshedAt) < interval) {
+            continue;
+        }
+
+        if (osdDrawSingleElement(elementIndex)) {
+            state->refreshedAt = now;
+            if (cmpTimeUs(micros(), startUs) >= osdRefreshConfig()->time_budget) {
+                break;
+            }
+        }
+    } while (index != elementIndex);
+
+    // Draw tracking telemetry last
     if (osdConfig()->telemetry>0){
         osdDisplayTelemetry();
     }
@@ -3900,6 +4255,7 @@ PG_RESET_TEMPLATE(osdConfig_t, osdConfig,
     .hud_radar_alt_difference_display_time = SETTING_OSD_HUD_RADAR_ALT_DIFFERENCE_DISPLAY_TIME_DEFAULT,
     .hud_radar_distance_display_time = SETTING_OSD_HUD_RADAR_DISTANCE_DISPLAY_TIME_DEFAULT,
     .hud_wp_disp = SETTING_OSD_HUD_WP_DISP_DEFAULT,
+    .map_pois = SETTING_OSD_MAP_POIS_DEFAULT,
     .left_sidebar_scroll = SETTING_OSD_LEFT_SIDEBAR_SCROLL_DEFAULT,
     .right_sidebar_scroll = SETTING_OSD_RIGHT_SIDEBAR_SCROLL_DEFAULT,
     .sidebar_scroll_arrows = SETTING_OSD_SIDEBAR_SCROLL_ARROWS_DEFAULT,
@@ -4213,7 +4569,7 @@ uint8_t drawStat_Stats(uint8_t statNameX, uint8_t row, uint8_t statValueX, bool
                 FALLTHROUGH;
             case OSD_UNIT_IMPERIAL:
                 if (isBootStats) {
-                    tfp_sprintf(string_buffer, "%5d", (uint16_t)(statsConfig()->stats_total_dist / METERS_PER_MILE));
+                    formatSigned(string_buffer, (uint16_t)(statsConfig()->stats_total_dist / METERS_PER_MILE), 5, false);
                     buffLen = 5;
                 } else {
                     uint16_t statTotalDist = (uint16_t)(statsConfig()->stats_total_dist / METERS_PER_MILE);
@@ -4226,7 +4582,7 @@ uint8_t drawStat_Stats(uint8_t statNameX, uint8_t row, uint8_t statValueX, bool
             default:
             case OSD_UNIT_GA:
                 if (isBootStats) {
-                    tfp_sprintf(string_buffer, "%5d", (uint16_t)(statsConfig()->stats_total_dist / METERS_PER_NAUTICALMILE));
+                    formatSigned(string_buffer, (uint16_t)(statsConfig()->stats_total_dist / METERS_PER_NAUTICALMILE), 5, false);
                     buffLen = 5;
                 } else {
                     uint16_t statTotalDist = (uint16_t)(statsConfig()->stats_total_dist / METERS_PER_NAUTICALMILE);
@@ -4240,7 +4596,7 @@ uint8_t drawStat_Stats(uint8_t statNameX, uint8_t row, uint8_t statValueX, bool
                 FALLTHROUGH;
             case OSD_UNIT_METRIC:
                 if (isBootStats) {
-                    tfp_sprintf(string_buffer, "%5d", (uint16_t)(statsConfig()->stats_total_dist / METERS_PER_KILOMETER));
+                    formatSigned(string_buffer, (uint16_t)(statsConfig()->stats_total_dist / METERS_PER_KILOMETER), 5, false);
                     buffLen = 5;
                 } else {
                     uint16_t statTotalDist = (uint16_t)(statsConfig()->stats_total_dist / METERS_PER_KILOMETER);
@@ -5476,6 +5832,7 @@ static void osdRefresh(timeUs_t currentTimeUs)
             displayClearScreen(osdDisplayPort);
             fullRedraw = false;
         }
+        osdUpdateViewTransform();
         osdDrawNextElement();
         displayHeartbeat(osdDisplayPort);
         displayCommitTransaction(osdDisplayPort);
@@ -5616,6 +5973,55 @@ displayCanvas_t *osdGetDisplayPortCanvas(void)
     return NULL;
 }
 
+#define OSD_SYSTEM_MESSAGES_MAX 5
+#define OSD_SYSTEM_MESSAGES_BUF_SIZE (SETTING_MAX_NAME_LENGTH > OSD_MESSAGE_LENGTH + 1 ? SETTING_MAX_NAME_LENGTH : OSD_MESSAGE_LENGTH + 1)
+// Inputs not in the key (sensor health, angle hold axis...) are re-read at least this often
+#define OSD_SYSTEM_MESSAGES_MAX_AGE_MS 500
+
+typedef enum {
+    OSD_SYSTEM_MESSAGES_KEY_SAVING_SETTINGS         = 1 << 0,
+    OSD_SYSTEM_MESSAGES_KEY_SETTINGS_SAVED          = 1 << 1,
+    OSD_SYSTEM_MESSAGES_KEY_WP_LIST_VALID           = 1 << 2,
+    OSD_SYSTEM_MESSAGES_KEY_WP_MISSION_RTH          = 1 << 3,
+    OSD_SYSTEM_MESSAGES_KEY_RX_DATA                 = 1 << 4,
+    OSD_SYSTEM_MESSAGES_KEY_MISSION_PLANNER         = 1 << 5,
+    OSD_SYSTEM_MESSAGES_KEY_RTH_TRACKBACK           = 1 << 6,
+    OSD_SYSTEM_MESSAGES_KEY_LINEAR_DESCENT          = 1 << 7,
+    OSD_SYSTEM_MESSAGES_KEY_LINEAR_DESCENT_SHOWN    = 1 << 8,
+    OSD_SYSTEM_MESSAGES_KEY_LEVEL_TRIM              = 1 << 9,
+    OSD_SYSTEM_MESSAGES_KEY_BOX_ARM                 = 1 << 10,
+    OSD_SYSTEM_MESSAGES_KEY_BOX_AUTOTRIM            = 1 << 11,
+    OSD_SYSTEM_MESSAGES_KEY_BOX_AUTOTUNE            = 1 << 12,
+    OSD_SYSTEM_MESSAGES_KEY_BOX_ANGLEHOLD           = 1 << 13,
+    OSD_SYSTEM_MESSAGES_KEY_SAFEHOME                = 1 << 14,
+    OSD_SYSTEM_MESSAGES_KEY_LAND_WP                 = 1 << 15,
+} osdSystemMessagesKeyFlags_e;
+
+// State selecting which system messages are shown
+typedef struct osdSystemMessagesKey_s {
+    uint32_t armingFlags;
+    uint32_t flightModeFlags;
+    uint32_t stateFlags;
+    uint32_t navStateFlags;
+    uint32_t flags;         // osdSystemMessagesKeyFlags_e
+    uint8_t navState;
+    uint8_t failsafePhase;
+    uint8_t fwLaunchState;
+} osdSystemMessagesKey_t;
+
+typedef struct osdSystemMessages_s {
+    osdSystemMessagesKey_t key;
+    timeMs_t builtAt;
+    bool valid;
+    bool dynamic;           // Some message shows a live value, rebuild on every call
+    const char *messages[OSD_SYSTEM_MESSAGES_MAX];
+    unsigned count;
+    timeMs_t cycleTime;
+    const char *failsafeInfoMessage;
+    const char *invertedInfoMessage;
+    char buf[OSD_SYSTEM_MESSAGES_BUF_SIZE]; //warning: shared buffer. Make sure it is used by single message!
+} osdSystemMessages_t;
+
 timeMs_t systemMessageCycleTime(unsigned messageCount, const char **messages){
     uint8_t i = 0;
     float factor = 1.0f;
@@ -5628,213 +6034,278 @@ timeMs_t systemMessageCycleTime(unsigned messageCount, const char **messages){
     return osdConfig()->system_msg_display_time * factor;
 }
 
-textAttributes_t osdGetSystemMessage(char *buff, size_t buff_size, bool isCenteredText)
+// Collects the system messages for the current state, see osdGetSystemMessage()
+static void osdBuildSystemMessages(osdSystemMessages_t *sm)
 {
-    textAttributes_t elemAttr = TEXT_ATTRIBUTES_NONE;
+    sm->count = 0;
+    sm->dynamic = false;
+    sm->failsafeInfoMessage = NULL;
+    sm->invertedInfoMessage = NULL;
 
-    if (buff != NULL) {
-        const char *message = NULL;
-        char messageBuf[MAX(SETTING_MAX_NAME_LENGTH, OSD_MESSAGE_LENGTH+1)]; //warning: shared buffer. Make sure it is used by single message in code below!
-        // We might have up to 5 messages to show.
-        const char *messages[5];
-        unsigned messageCount = 0;
-        const char *failsafeInfoMessage = NULL;
-        const char *invertedInfoMessage = NULL;
-
-        if (ARMING_FLAG(ARMED)) {
+    if (ARMING_FLAG(ARMED)) {
 #ifdef USE_FW_AUTOLAND
-            if (FLIGHT_MODE(FAILSAFE_MODE) || FLIGHT_MODE(NAV_RTH_MODE) || FLIGHT_MODE(NAV_WP_MODE) || navigationIsExecutingAnEmergencyLanding() || FLIGHT_MODE(NAV_FW_AUTOLAND)) {
-                if (isWaypointMissionRTHActive() && !posControl.fwLandState.landWp) {
+        if (FLIGHT_MODE(FAILSAFE_MODE) || FLIGHT_MODE(NAV_RTH_MODE) || FLIGHT_MODE(NAV_WP_MODE) || navigationIsExecutingAnEmergencyLanding() || FLIGHT_MODE(NAV_FW_AUTOLAND)) {
+            if (isWaypointMissionRTHActive() && !posControl.fwLandState.landWp) {
 #else
-            if (FLIGHT_MODE(FAILSAFE_MODE) || FLIGHT_MODE(NAV_RTH_MODE) || FLIGHT_MODE(NAV_WP_MODE) || navigationIsExecutingAnEmergencyLanding()) {
-                if (isWaypointMissionRTHActive()) {
+        if (FLIGHT_MODE(FAILSAFE_MODE) || FLIGHT_MODE(NAV_RTH_MODE) || FLIGHT_MODE(NAV_WP_MODE) || navigationIsExecutingAnEmergencyLanding()) {
+            if (isWaypointMissionRTHActive()) {
 #endif
-                    // if RTH activated whilst WP mode selected, remind pilot to cancel WP mode to exit RTH
-                    messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_WP_RTH_CANCEL);
-                }
-                if (navGetCurrentStateFlags() & NAV_AUTO_WP_DONE) {
-                    messages[messageCount++] = STATE(LANDING_DETECTED) ? OSD_MESSAGE_STR(OSD_MSG_WP_LANDED) : OSD_MESSAGE_STR(OSD_MSG_WP_FINISHED);
-                } else if (NAV_Status.state == MW_NAV_STATE_WP_ENROUTE) {
-                    // Countdown display for remaining Waypoints
-                    char buf[6];
-                    osdFormatDistanceSymbol(buf, posControl.wpDistance, 0);
-                    tfp_sprintf(messageBuf, "TO WP %u/%u (%s)", getGeoWaypointNumber(posControl.activeWaypointIndex), posControl.geoWaypointCount, buf);
-                    messages[messageCount++] = messageBuf;
-                } else if (NAV_Status.state == MW_NAV_STATE_HOLD_TIMED) {
-                    if (navConfig()->general.waypoint_enforce_altitude && !posControl.wpAltitudeReached) {
-                        messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_ADJUSTING_WP_ALT);
-                    } else {
-                        // WP hold time countdown in seconds
-                        timeMs_t currentTime = millis();
-                        int holdTimeRemaining = posControl.waypointList[posControl.activeWaypointIndex].p1 - (int)(MS2S(currentTime - posControl.wpReachedTime));
-                        holdTimeRemaining = holdTimeRemaining >= 0 ? holdTimeRemaining : 0;
-
-                        tfp_sprintf(messageBuf, "HOLDING WP FOR %2u S", holdTimeRemaining);
+                // if RTH activated whilst WP mode selected, remind pilot to cancel WP mode to exit RTH
+                sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_WP_RTH_CANCEL);
+            }
+            if (navGetCurrentStateFlags() & NAV_AUTO_WP_DONE) {
+                sm->messages[sm->count++] = STATE(LANDING_DETECTED) ? OSD_MESSAGE_STR(OSD_MSG_WP_LANDED) : OSD_MESSAGE_STR(OSD_MSG_WP_FINISHED);
+            } else if (NAV_Status.state == MW_NAV_STATE_WP_ENROUTE) {
+                // Countdown display for remaining Waypoints
+                char buf[6];
+                osdFormatDistanceSymbol(buf, posControl.wpDistance, 0);
+                sm->dynamic = true;
+                tfp_sprintf(sm->buf, "TO WP %u/%u (%s)", getGeoWaypointNumber(posControl.activeWaypointIndex), posControl.geoWaypointCount, buf);
+                sm->messages[sm->count++] = sm->buf;
+            } else if (NAV_Status.state == MW_NAV_STATE_HOLD_TIMED) {
+                if (navConfig()->general.waypoint_enforce_altitude && !posControl.wpAltitudeReached) {
+                    sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_ADJUSTING_WP_ALT);
+                } else {
+                    // WP hold time countdown in seconds
+                    timeMs_t currentTime = millis();
+                    int holdTimeRemaining = posControl.waypointList[posControl.activeWaypointIndex].p1 - (int)(MS2S(currentTime - posControl.wpReachedTime));
+                    holdTimeRemaining = holdTimeRemaining >= 0 ? holdTimeRemaining : 0;
 
-                        messages[messageCount++] = messageBuf;
-                    }
-                } else if (NAV_Status.state == MW_NAV_STATE_LAND_SETTLE && posControl.landingDelay > 0) {
-                    uint16_t remainingHoldSec = MS2S(posControl.landingDelay - millis());
-                    tfp_sprintf(messageBuf, "LANDING DELAY: %3u SECONDS", remainingHoldSec);
+                    sm->dynamic = true;
+                    tfp_sprintf(sm->buf, "HOLDING WP FOR %2u S", holdTimeRemaining);
 
-                    messages[messageCount++] = messageBuf;
+                    sm->messages[sm->count++] = sm->buf;
                 }
+            } else if (NAV_Status.state == MW_NAV_STATE_LAND_SETTLE && posControl.landingDelay > 0) {
+                uint16_t remainingHoldSec = MS2S(posControl.landingDelay - millis());
+                sm->dynamic = true;
+                tfp_sprintf(sm->buf, "LANDING DELAY: %3u SECONDS", remainingHoldSec);
 
-                else {
+                sm->messages[sm->count++] = sm->buf;
+            }
+
+            else {
 #ifdef USE_FW_AUTOLAND
-                    if (canFwLandingBeCancelled()) {
-                         messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_MOVE_STICKS);
-                    } else if (!FLIGHT_MODE(NAV_FW_AUTOLAND)) {
+                if (canFwLandingBeCancelled()) {
+                     sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_MOVE_STICKS);
+                } else if (!FLIGHT_MODE(NAV_FW_AUTOLAND)) {
 #endif
-                        const char *navStateMessage = navigationStateMessage();
-                        if (navStateMessage) {
-                            messages[messageCount++] = navStateMessage;
-                        }
-#ifdef USE_FW_AUTOLAND
+                    const char *navStateMessage = navigationStateMessage();
+                    if (navStateMessage) {
+                        sm->messages[sm->count++] = navStateMessage;
                     }
-#endif
+#ifdef USE_FW_AUTOLAND
                 }
+#endif
+            }
 
 #if defined(USE_SAFE_HOME)
-                const char *safehomeMessage = divertingToSafehomeMessage();
-                if (safehomeMessage) {
-                    messages[messageCount++] = safehomeMessage;
-                }
+            const char *safehomeMessage = divertingToSafehomeMessage();
+            if (safehomeMessage) {
+                sm->messages[sm->count++] = safehomeMessage;
+            }
 #endif
-                if (FLIGHT_MODE(FAILSAFE_MODE)) {
-                    // In FS mode while being armed too
-                    const char *failsafePhaseMessage = osdFailsafePhaseMessage();
-                    failsafeInfoMessage = osdFailsafeInfoMessage();
+            if (FLIGHT_MODE(FAILSAFE_MODE)) {
+                // In FS mode while being armed too
+                const char *failsafePhaseMessage = osdFailsafePhaseMessage();
+                sm->failsafeInfoMessage = osdFailsafeInfoMessage();
 
-                    if (failsafePhaseMessage) {
-                        messages[messageCount++] = failsafePhaseMessage;
-                    }
-                    if (failsafeInfoMessage) {
-                        messages[messageCount++] = failsafeInfoMessage;
-                    }
+                if (failsafePhaseMessage) {
+                    sm->messages[sm->count++] = failsafePhaseMessage;
                 }
-            } else {    /* messages shown only when Failsafe, WP, RTH or Emergency Landing not active */
-                if (STATE(FIXED_WING_LEGACY) && (navGetCurrentStateFlags() & NAV_CTL_LAUNCH)) {
-                    messages[messageCount++] = navConfig()->fw.launch_manual_throttle ? OSD_MESSAGE_STR(OSD_MSG_AUTOLAUNCH_MANUAL) :
-                                                                                        OSD_MESSAGE_STR(OSD_MSG_AUTOLAUNCH);
-                    const char *launchStateMessage = fixedWingLaunchStateMessage();
-                    if (launchStateMessage) {
-                        messages[messageCount++] = launchStateMessage;
-                    }
-                } else {
-                    if (FLIGHT_MODE(NAV_ALTHOLD_MODE) && !navigationRequiresAngleMode()) {
-                        // ALTHOLD might be enabled alongside ANGLE/HORIZON/ANGLEHOLD/ACRO
-                        // when it doesn't require ANGLE mode (required only in FW
-                        // right now). If it requires ANGLE, its display is handled by OSD_FLYMODE.
-                        messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_ALTITUDE_HOLD);
-                    }
-                    if (STATE(MULTIROTOR) && FLIGHT_MODE(NAV_COURSE_HOLD_MODE)) {
-                        if (posControl.cruise.multicopterSpeed >= 50.0f) {
-                            char buf[6];
-                            osdFormatVelocityStr(buf, posControl.cruise.multicopterSpeed, false, false);
-                            tfp_sprintf(messageBuf, "(SPD %s)", buf);
-                        } else {
-                            strcpy(messageBuf, "(HOLD)");
-                        }
-                        messages[messageCount++] = messageBuf;
-                    }
-                    if (IS_RC_MODE_ACTIVE(BOXAUTOTRIM) && !feature(FEATURE_FW_AUTOTRIM)) {
-                        messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_AUTOTRIM);
-                    }
-                    if (IS_RC_MODE_ACTIVE(BOXAUTOTUNE)) {
-                        messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_AUTOTUNE);
-                        if (FLIGHT_MODE(MANUAL_MODE)) {
-                            messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_AUTOTUNE_ACRO);
-                        }
-                    }
-                    if (isFixedWingLevelTrimActive()) {
-                            messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_AUTOLEVEL);
-                    }
-                    if (FLIGHT_MODE(HEADFREE_MODE)) {
-                        messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_HEADFREE);
-                    }
-                    if (FLIGHT_MODE(SOARING_MODE)) {
-                        messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_NAV_SOARING);
-                    }
-                    if (posControl.flags.wpMissionPlannerActive) {
-                        messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_MISSION_PLANNER);
+                if (sm->failsafeInfoMessage) {
+                    sm->messages[sm->count++] = sm->failsafeInfoMessage;
+                }
+            }
+        } else {    /* messages shown only when Failsafe, WP, RTH or Emergency Landing not active */
+            if (STATE(FIXED_WING_LEGACY) && (navGetCurrentStateFlags() & NAV_CTL_LAUNCH)) {
+                sm->messages[sm->count++] = navConfig()->fw.launch_manual_throttle ? OSD_MESSAGE_STR(OSD_MSG_AUTOLAUNCH_MANUAL) :
+                                                                                    OSD_MESSAGE_STR(OSD_MSG_AUTOLAUNCH);
+                const char *launchStateMessage = fixedWingLaunchStateMessage();
+                if (launchStateMessage) {
+                    sm->messages[sm->count++] = launchStateMessage;
+                }
+            } else {
+                if (FLIGHT_MODE(NAV_ALTHOLD_MODE) && !navigationRequiresAngleMode()) {
+                    // ALTHOLD might be enabled alongside ANGLE/HORIZON/ANGLEHOLD/ACRO
+                    // when it doesn't require ANGLE mode (required only in FW
+                    // right now). If it requires ANGLE, its display is handled by OSD_FLYMODE.
+                    sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_ALTITUDE_HOLD);
+                }
+                if (STATE(MULTIROTOR) && FLIGHT_MODE(NAV_COURSE_HOLD_MODE)) {
+                    if (posControl.cruise.multicopterSpeed >= 50.0f) {
+                        char buf[6];
+                        osdFormatVelocityStr(buf, posControl.cruise.multicopterSpeed, false, false);
+                        sm->dynamic = true;
+                        tfp_sprintf(sm->buf, "(SPD %s)", buf);
+                    } else {
+                        strcpy(sm->buf, "(HOLD)");
                     }
-                    if (STATE(LANDING_DETECTED)) {
-                        messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_LANDED);
+                    sm->messages[sm->count++] = sm->buf;
+                }
+                if (IS_RC_MODE_ACTIVE(BOXAUTOTRIM) && !feature(FEATURE_FW_AUTOTRIM)) {
+                    sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_AUTOTRIM);
+                }
+                if (IS_RC_MODE_ACTIVE(BOXAUTOTUNE)) {
+                    sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_AUTOTUNE);
+                    if (FLIGHT_MODE(MANUAL_MODE)) {
+                        sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_AUTOTUNE_ACRO);
                     }
-                    if (IS_RC_MODE_ACTIVE(BOXANGLEHOLD)) {
-                        int8_t navAngleHoldAxis = navCheckActiveAngleHoldAxis();
-                        if (isAngleHoldLevel()) {
-                            messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_ANGLEHOLD_LEVEL);
-                        } else if (navAngleHoldAxis == FD_ROLL) {
-                            messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_ANGLEHOLD_ROLL);
-                        } else if (navAngleHoldAxis == FD_PITCH) {
-                            messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_ANGLEHOLD_PITCH);
-                        }
+                }
+                if (isFixedWingLevelTrimActive()) {
+                        sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_AUTOLEVEL);
+                }
+                if (FLIGHT_MODE(HEADFREE_MODE)) {
+                    sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_HEADFREE);
+                }
+                if (FLIGHT_MODE(SOARING_MODE)) {
+                    sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_NAV_SOARING);
+                }
+                if (posControl.flags.wpMissionPlannerActive) {
+                    sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_MISSION_PLANNER);
+                }
+                if (STATE(LANDING_DETECTED)) {
+                    sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_LANDED);
+                }
+                if (IS_RC_MODE_ACTIVE(BOXANGLEHOLD)) {
+                    int8_t navAngleHoldAxis = navCheckActiveAngleHoldAxis();
+                    if (isAngleHoldLevel()) {
+                        sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_ANGLEHOLD_LEVEL);
+                    } else if (navAngleHoldAxis == FD_ROLL) {
+                        sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_ANGLEHOLD_ROLL);
+                    } else if (navAngleHoldAxis == FD_PITCH) {
+                        sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_ANGLEHOLD_PITCH);
                     }
                 }
             }
-        } else if (ARMING_FLAG(ARMING_DISABLED_ALL_FLAGS)) {
-            unsigned invalidIndex;
+        }
+    } else if (ARMING_FLAG(ARMING_DISABLED_ALL_FLAGS)) {
+        unsigned invalidIndex;
 
-            // Check if we're unable to arm for some reason
-            if (ARMING_FLAG(ARMING_DISABLED_INVALID_SETTING) && !settingsValidate(&invalidIndex)) {
+        // Check if we're unable to arm for some reason
+        if (ARMING_FLAG(ARMING_DISABLED_INVALID_SETTING) && !settingsValidate(&invalidIndex)) {
 
-                    const setting_t *setting = settingGet(invalidIndex);
-                    settingGetName(setting, messageBuf);
-                    for (int ii = 0; messageBuf[ii]; ii++) {
-                        messageBuf[ii] = sl_toupper(messageBuf[ii]);
-                    }
-                    invertedInfoMessage = messageBuf;
-                    messages[messageCount++] = invertedInfoMessage;
+                const setting_t *setting = settingGet(invalidIndex);
+                settingGetName(setting, sm->buf);
+                for (int ii = 0; sm->buf[ii]; ii++) {
+                    sm->buf[ii] = sl_toupper(sm->buf[ii]);
+                }
+                sm->invertedInfoMessage = sm->buf;
+                sm->messages[sm->count++] = sm->invertedInfoMessage;
 
-                    invertedInfoMessage = OSD_MESSAGE_STR(OSD_MSG_INVALID_SETTING);
-                    messages[messageCount++] = invertedInfoMessage;
+                sm->invertedInfoMessage = OSD_MESSAGE_STR(OSD_MSG_INVALID_SETTING);
+                sm->messages[sm->count++] = sm->invertedInfoMessage;
 
-            } else {
+        } else {
 
-                    invertedInfoMessage = OSD_MESSAGE_STR(OSD_MSG_UNABLE_ARM);
-                    messages[messageCount++] = invertedInfoMessage;
+                sm->invertedInfoMessage = OSD_MESSAGE_STR(OSD_MSG_UNABLE_ARM);
+                sm->messages[sm->count++] = sm->invertedInfoMessage;
 
-                    // Show the reason for not arming
-                    messages[messageCount++] = osdArmingDisabledReasonMessage();
+                // Show the reason for not arming
+                const char *armingDisabledReasonMessage = osdArmingDisabledReasonMessage();
+                if (armingDisabledReasonMessage) {
+                    sm->messages[sm->count++] = armingDisabledReasonMessage;
+                }
 
-            }
-        } else if (!ARMING_FLAG(ARMED)) {
-            if (isWaypointListValid()) {
-                messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_WP_MISSION_LOADED);
-            }
         }
+    } else if (!ARMING_FLAG(ARMED)) {
+        if (isWaypointListValid()) {
+            sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_WP_MISSION_LOADED);
+        }
+    }
 
-        /* Messages that are shown regardless of Arming state */
+    /* Messages that are shown regardless of Arming state */
 
-        // The following has been commented out as it will be added in #9688
-        // uint16_t rearmMs = (emergInflightRearmEnabled()) ? emergencyInFlightRearmTimeMS() : 0;
+    // The following has been commented out as it will be added in #9688
+    // uint16_t rearmMs = (emergInflightRearmEnabled()) ? emergencyInFlightRearmTimeMS() : 0;
 
-        if (savingSettings == true) {
-           messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_SAVING_SETTNGS);
-        /*} else if (rearmMs > 0) { // Show rearming time if settings not actively being saved. Ignore the settings saved message if rearm available.
-            char emReArmMsg[23];
-            tfp_sprintf(emReArmMsg, "** REARM PERIOD: ");
-            tfp_sprintf(emReArmMsg + strlen(emReArmMsg), "%02d", (uint8_t)MS2S(rearmMs));
-            strcat(emReArmMsg, " **\0");
-            messages[messageCount++] = OSD_MESSAGE_STR(emReArmMsg);*/
-        } else if (notify_settings_saved > 0) {
-            if (millis() > notify_settings_saved) {
-                notify_settings_saved = 0;
-            } else {
-                messages[messageCount++] = OSD_MESSAGE_STR(OSD_MSG_SETTINGS_SAVED);
-            }
+    if (savingSettings == true) {
+       sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_SAVING_SETTNGS);
+    /*} else if (rearmMs > 0) { // Show rearming time if settings not actively being saved. Ignore the settings saved message if rearm available.
+        char emReArmMsg[23];
+        tfp_sprintf(emReArmMsg, "** REARM PERIOD: ");
+        tfp_sprintf(emReArmMsg + strlen(emReArmMsg), "%02d", (uint8_t)MS2S(rearmMs));
+        strcat(emReArmMsg, " **\0");
+        sm->messages[sm->count++] = OSD_MESSAGE_STR(emReArmMsg);*/
+    } else if (notify_settings_saved > 0) {
+        sm->messages[sm->count++] = OSD_MESSAGE_STR(OSD_MSG_SETTINGS_SAVED);
+    }
+
+    sm->cycleTime = systemMessageCycleTime(sm->count, sm->messages);
+}
+
+static void osdGetSystemMessagesKey(osdSystemMessagesKey_t *key)
+{
+    const timeMs_t currentTimeMs = millis();
+
+    if (notify_settings_saved > 0 && currentTimeMs > notify_settings_saved) {
+        notify_settings_saved = 0;
+    }
+
+    memset(key, 0, sizeof(*key));
+    key->armingFlags = armingFlags;
+    key->flightModeFlags = flightModeFlags;
+    key->stateFlags = stateFlags;
+    key->navStateFlags = navGetCurrentStateFlags();
+    key->navState = NAV_Status.state;
+    key->failsafePhase = failsafePhase();
+    key->fwLaunchState = fixedWingLaunchStatus();
+
+    uint32_t flags = 0;
+    flags |= savingSettings ? OSD_SYSTEM_MESSAGES_KEY_SAVING_SETTINGS : 0;
+    flags |= notify_settings_saved > 0 ? OSD_SYSTEM_MESSAGES_KEY_SETTINGS_SAVED : 0;
+    flags |= isWaypointListValid() ? OSD_SYSTEM_MESSAGES_KEY_WP_LIST_VALID : 0;
+    flags |= isWaypointMissionRTHActive() ? OSD_SYSTEM_MESSAGES_KEY_WP_MISSION_RTH : 0;
+    flags |= failsafeIsReceivingRxData() ? OSD_SYSTEM_MESSAGES_KEY_RX_DATA : 0;
+    flags |= posControl.flags.wpMissionPlannerActive ? OSD_SYSTEM_MESSAGES_KEY_MISSION_PLANNER : 0;
+    flags |= posControl.flags.rthTrackbackActive ? OSD_SYSTEM_MESSAGES_KEY_RTH_TRACKBACK : 0;
+    flags |= posControl.rthState.rthLinearDescentActive ? OSD_SYSTEM_MESSAGES_KEY_LINEAR_DESCENT : 0;
+    flags |= (linearDescentMessageMs != 0 && linearDescentMessageMs <= currentTimeMs) ? OSD_SYSTEM_MESSAGES_KEY_LINEAR_DESCENT_SHOWN : 0;
+    flags |= isFixedWingLevelTrimActive() ? OSD_SYSTEM_MESSAGES_KEY_LEVEL_TRIM : 0;
+    flags |= IS_RC_MODE_ACTIVE(BOXARM) ? OSD_SYSTEM_MESSAGES_KEY_BOX_ARM : 0;
+    flags |= IS_RC_MODE_ACTIVE(BOXAUTOTRIM) ? OSD_SYSTEM_MESSAGES_KEY_BOX_AUTOTRIM : 0;
+    flags |= IS_RC_MODE_ACTIVE(BOXAUTOTUNE) ? OSD_SYSTEM_MESSAGES_KEY_BOX_AUTOTUNE : 0;
+    flags |= IS_RC_MODE_ACTIVE(BOXANGLEHOLD) ? OSD_SYSTEM_MESSAGES_KEY_BOX_ANGLEHOLD : 0;
+#if defined(USE_SAFE_HOME)
+    flags |= posControl.safehomeState.isApplied ? OSD_SYSTEM_MESSAGES_KEY_SAFEHOME : 0;
+#endif
+#ifdef USE_FW_AUTOLAND
+    flags |= posControl.fwLandState.landWp ? OSD_SYSTEM_MESSAGES_KEY_LAND_WP : 0;
+#endif
+    key->flags = flags;
+}
+
+textAttributes_t osdGetSystemMessage(char *buff, size_t buff_size, bool isCenteredText)
+{
+    textAttributes_t elemAttr = TEXT_ATTRIBUTES_NONE;
+
+    if (buff != NULL) {
+        static osdSystemMessages_t systemMessages;
+        osdSystemMessagesKey_t key;
+        const char *message = NULL;
+
+        // Rebuild the messages only when the state selecting them changed, when
+        // one of them shows a live value or when the cached set got too old
+        osdGetSystemMessagesKey(&key);
+        const timeMs_t currentTimeMs = millis();
+        if (!systemMessages.valid || systemMessages.dynamic ||
+            memcmp(&key, &systemMessages.key, sizeof(key)) != 0 ||
+            currentTimeMs - systemMessages.builtAt >= OSD_SYSTEM_MESSAGES_MAX_AGE_MS) {
+
+            osdBuildSystemMessages(&systemMessages);
+            systemMessages.key = key;
+            systemMessages.builtAt = currentTimeMs;
+            systemMessages.valid = true;
         }
 
-        if (messageCount > 0) {
-            message = messages[OSD_ALTERNATING_CHOICES(systemMessageCycleTime(messageCount, messages), messageCount)];
-            if (message == failsafeInfoMessage) {
+        if (systemMessages.count > 0) {
+            message = systemMessages.messages[OSD_ALTERNATING_CHOICES(systemMessages.cycleTime, systemMessages.count)];
+            if (message == systemMessages.failsafeInfoMessage) {
                 // failsafeInfoMessage is not useful for recovering
                 // a lost model, but might help avoiding a crash.
                 // Blink to grab user attention.
                 TEXT_ATTRIBUTES_ADD_BLINK(elemAttr);
-            } else if (message == invertedInfoMessage) {
+            } else if (message == systemMessages.invertedInfoMessage) {
                 TEXT_ATTRIBUTES_ADD_INVERTED(elemAttr);
             }
             // We're shoing either failsafePhaseMessage or
@@ -346,6 +346,24 @@ typedef struct osdLayoutsConfig_s {
 
 PG_DECLARE(osdLayoutsConfig_t, osdLayoutsConfig);
 
+typedef enum {
+    OSD_REFRESH_CLASS_AUTO = 0,         // Built-in class of the element
+    OSD_REFRESH_CLASS_CRITICAL,         // Drawn on every refresh
+    OSD_REFRESH_CLASS_NORMAL,
+    OSD_REFRESH_CLASS_SLOW,
+    OSD_REFRESH_CLASS_COUNT
+} osdRefreshClass_e;
+
+#define OSD_REFRESH_CLASS_BITS          2
+#define OSD_REFRESH_CLASSES_PER_BYTE    (8 / OSD_REFRESH_CLASS_BITS)
+
+typedef struct osdRefreshConfig_s {
+    uint16_t time_budget;               // us per refresh, critical elements are drawn even if it is exceeded
+    uint8_t item_class[OSD_LAYOUT_COUNT][(OSD_ITEM_COUNT + OSD_REFRESH_CLASSES_PER_BYTE - 1) / OSD_REFRESH_CLASSES_PER_BYTE];
+} osdRefreshConfig_t;
+
+PG_DECLARE(osdRefreshConfig_t, osdRefreshConfig);
+
 #define OSD_SWITCH_INDICATOR_NAME_LENGTH 4
 
 typedef struct osdConfig_s {
@@ -465,6 +483,7 @@ typedef struct osdConfig_s {
     uint16_t adsb_distance_alert;                       // in metres
     uint16_t adsb_ignore_plane_above_me_limit;          // in metres
 #endif
+    bool            map_pois;                           // Draw radar peers, ADS-B vehicles and the next waypoints on the map elements
 } osdConfig_t;
 
 PG_DECLARE(osdConfig_t, osdConfig);
@@ -487,6 +506,8 @@ void osdOverrideLayout(int layout, timeMs_t duration);
 int osdGetActiveLayout(bool *overridden);
 bool osdItemIsFixed(osd_items_e item);
 uint8_t osdIncElementIndex(uint8_t elementIndex);
+osdRefreshClass_e osdGetItemRefreshClass(const osdRefreshConfig_t *config, int layout, osd_items_e item);
+void osdSetItemRefreshClass(osdRefreshConfig_t *config, int layout, osd_items_e item, osdRefreshClass_e refreshClass);
 
 displayPort_t *osdGetDisplayPort(void);
 displayCanvas_t *osdGetDisplayPortCanvas(void);
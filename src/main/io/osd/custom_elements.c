@@ -16,6 +16,8 @@
  */
 
 
+#include <string.h>
+
 #include "config/config_reset.h"
 #include "config/parameter_group.h"
 #include "config/parameter_group_ids.h"
@@ -46,72 +48,154 @@ void pgResetFn_osdCustomElements(osdCustomElement_t *instance)
     }
 }
 
-bool isCustomelementVisible(const osdCustomElement_t* customElement){
-    if(customElement->visibility.type == CUSTOM_ELEMENT_VISIBILITY_ALWAYS){
-        return true;
+typedef enum {
+    CUSTOM_ELEMENT_OP_TEXT,     // Static text and icons, copied from the program text
+    CUSTOM_ELEMENT_OP_ICON_GV,  // Symbol number taken from a global variable
+    CUSTOM_ELEMENT_OP_NUMBER,   // Global variable formatted as a number
+} customElementOp_e;
+
+typedef struct {
+    uint8_t op;         // customElementOp_e
+    uint8_t length;     // Number of characters written
+    uint8_t offset;     // OP_TEXT: start in text, OP_NUMBER: entry in customElementNumberFormats
+    uint16_t value;     // Global variable index
+} customElementInstr_t;
+
+// Element parts flattened at config load. Adjacent static parts are merged
+// into a single pre-uppercased text run, so drawing only evaluates the
+// parts that depend on global variables.
+typedef struct {
+    osdCustomElementTypeVisibility_e visibilityType;
+    uint16_t visibilityValue;
+    uint8_t instrCount;
+    customElementInstr_t instr[CUSTOM_ELEMENTS_PARTS];
+    char text[CUSTOM_ELEMENTS_PARTS * OSD_CUSTOM_ELEMENT_TEXT_SIZE];
+} customElementProgram_t;
+
+typedef struct {
+    int16_t modulo;     // 0 for none
+    uint8_t multiplier;
+    uint8_t decimals;
+    uint8_t length;
+} customElementNumberFormat_t;
+
+// Indexed by osdCustomElementType_e - CUSTOM_ELEMENT_TYPE_GV
+static const customElementNumberFormat_t customElementNumberFormats[] = {
+    [CUSTOM_ELEMENT_TYPE_GV - CUSTOM_ELEMENT_TYPE_GV]               = { .modulo = 0,    .multiplier = 100,  .decimals = 0, .length = 6 },
+    [CUSTOM_ELEMENT_TYPE_GV_FLOAT - CUSTOM_ELEMENT_TYPE_GV]         = { .modulo = 0,    .multiplier = 1,    .decimals = 2, .length = 6 },
+    [CUSTOM_ELEMENT_TYPE_GV_SMALL - CUSTOM_ELEMENT_TYPE_GV]         = { .modulo = 1000, .multiplier = 100,  .decimals = 0, .length = 3 },
+    [CUSTOM_ELEMENT_TYPE_GV_SMALL_FLOAT - CUSTOM_ELEMENT_TYPE_GV]   = { .modulo = 100,  .multiplier = 10,   .decimals = 1, .length = 2 },
+};
+
+static customElementProgram_t customElementPrograms[MAX_CUSTOM_ELEMENTS];
+
+static void customElementAppendText(customElementProgram_t *program, uint8_t *textLength, char c)
+{
+    customElementInstr_t *last = program->instrCount > 0 ? &program->instr[program->instrCount - 1] : NULL;
+    if (!last || last->op != CUSTOM_ELEMENT_OP_TEXT) {
+        last = &program->instr[program->instrCount++];
+        last->op = CUSTOM_ELEMENT_OP_TEXT;
+        last->offset = *textLength;
+        last->length = 0;
+        last->value = 0;
     }
+    program->text[(*textLength)++] = c;
+    last->length++;
+}
+
+static void customElementCompile(customElementProgram_t *program, const osdCustomElement_t *customElement)
+{
+    uint8_t textLength = 0;
+
+    memset(program, 0, sizeof(*program));
+    program->visibilityType = customElement->visibility.type;
+    program->visibilityValue = customElement->visibility.value;
+
+    for (int i = 0; i < CUSTOM_ELEMENTS_PARTS; i++) {
+        const osdCustomElementItem_t *part = &customElement->part[i];
+        customElementInstr_t *instr;
 
-    if(customElement->visibility.type == CUSTOM_ELEMENT_VISIBILITY_GV && gvGet(customElement->visibility.value)){
-        return true;
+        switch (part->type) {
+            case CUSTOM_ELEMENT_TYPE_TEXT:
+                for (int j = 0; j < OSD_CUSTOM_ELEMENT_TEXT_SIZE && customElement->osdCustomElementText[j]; j++) {
+                    customElementAppendText(program, &textLength, sl_toupper((unsigned char)customElement->osdCustomElementText[j]));
+                }
+                break;
+            case CUSTOM_ELEMENT_TYPE_ICON_STATIC:
+                customElementAppendText(program, &textLength, (uint8_t)part->value);
+                break;
+            case CUSTOM_ELEMENT_TYPE_ICON_GV:
+                instr = &program->instr[program->instrCount++];
+                instr->op = CUSTOM_ELEMENT_OP_ICON_GV;
+                instr->length = 1;
+                instr->value = part->value;
+                break;
+            case CUSTOM_ELEMENT_TYPE_GV:
+                FALLTHROUGH;
+            case CUSTOM_ELEMENT_TYPE_GV_FLOAT:
+                FALLTHROUGH;
+            case CUSTOM_ELEMENT_TYPE_GV_SMALL:
+                FALLTHROUGH;
+            case CUSTOM_ELEMENT_TYPE_GV_SMALL_FLOAT:
+                instr = &program->instr[program->instrCount++];
+                instr->op = CUSTOM_ELEMENT_OP_NUMBER;
+                instr->offset = part->type - CUSTOM_ELEMENT_TYPE_GV;
+                instr->length = customElementNumberFormats[instr->offset].length;
+                instr->value = part->value;
+                break;
+            case CUSTOM_ELEMENT_TYPE_NONE:
+                break;
+        }
     }
+}
 
-    if(customElement->visibility.type == CUSTOM_ELEMENT_VISIBILITY_LOGIC_CON && logicConditionGetValue(customElement->visibility.value)){
-        return true;
+void customElementsCompile(void)
+{
+    for (int i = 0; i < MAX_CUSTOM_ELEMENTS; i++) {
+        customElementCompile(&customElementPrograms[i], osdCustomElements(i));
     }
+}
 
+static bool customElementIsVisible(const customElementProgram_t *program)
+{
+    switch (program->visibilityType) {
+        case CUSTOM_ELEMENT_VISIBILITY_ALWAYS:
+            return true;
+        case CUSTOM_ELEMENT_VISIBILITY_GV:
+            return gvGet(program->visibilityValue) != 0;
+        case CUSTOM_ELEMENT_VISIBILITY_LOGIC_CON:
+            return logicConditionGetValue(program->visibilityValue) != 0;
+    }
     return false;
 }
 
-uint8_t customElementDrawPart(char *buff, uint8_t customElementIndex, uint8_t customElementItemIndex){
-    const osdCustomElement_t* customElement = osdCustomElements(customElementIndex);
-    const int customPartType = osdCustomElements(customElementIndex)->part[customElementItemIndex].type;
-    const int customPartValue = osdCustomElements(customElementIndex)->part[customElementItemIndex].value;
-
-    switch (customPartType) {
-        case CUSTOM_ELEMENT_TYPE_GV:
-        {
-            osdFormatCentiNumber(buff, (int32_t) gvGet(customPartValue) * (int32_t) 100, 1, 0, 0, 6, false);
-            return 6;
-        }
-        case CUSTOM_ELEMENT_TYPE_GV_FLOAT:
-        {
-            osdFormatCentiNumber(buff, (int32_t) gvGet(customPartValue), 1, 2, 0, 6, false);
-            return 6;
-        }
-        case CUSTOM_ELEMENT_TYPE_GV_SMALL:
-        {
-            osdFormatCentiNumber(buff, (int32_t) ((gvGet(customPartValue) % 1000 ) * (int32_t) 100), 1, 0, 0, 3, false);
-            return 3;
-        }
-        case CUSTOM_ELEMENT_TYPE_GV_SMALL_FLOAT:
-        {
-            osdFormatCentiNumber(buff, (int32_t) ((gvGet(customPartValue) % 100)  * (int32_t) 10), 1, 1, 0, 2, false);
-            return 2;
-        }
-        case CUSTOM_ELEMENT_TYPE_ICON_GV:
-        {
-            *buff = (uint8_t)gvGet(customPartValue);
-            return 1;
-        }
-        case CUSTOM_ELEMENT_TYPE_ICON_STATIC:
-        {
-            *buff = (uint8_t)customPartValue;
-            return 1;
-        }
-        case CUSTOM_ELEMENT_TYPE_TEXT:
-        {
-            for (int i = 0; i < OSD_CUSTOM_ELEMENT_TEXT_SIZE; i++) {
-                if (customElement->osdCustomElementText[i] == 0){
-                    return i;
+static uint8_t customElementRun(char *buff, const customElementProgram_t *program)
+{
+    uint8_t length = 0;
+
+    for (int i = 0; i < program->instrCount; i++) {
+        const customElementInstr_t *instr = &program->instr[i];
+        switch (instr->op) {
+            case CUSTOM_ELEMENT_OP_TEXT:
+                memcpy(buff + length, &program->text[instr->offset], instr->length);
+                break;
+            case CUSTOM_ELEMENT_OP_ICON_GV:
+                buff[length] = (uint8_t)gvGet(instr->value);
+                break;
+            case CUSTOM_ELEMENT_OP_NUMBER:
+            {
+                const customElementNumberFormat_t *format = &customElementNumberFormats[instr->offset];
+                int32_t value = gvGet(instr->value);
+                if (format->modulo) {
+                    value %= format->modulo;
                 }
-                *buff = sl_toupper((unsigned char)customElement->osdCustomElementText[i]);
-                buff++;
+                osdFormatCentiNumber(buff + length, value * format->multiplier, 1, format->decimals, 0, format->length, false);
+                break;
             }
-            return OSD_CUSTOM_ELEMENT_TEXT_SIZE;
         }
+        length += instr->length;
     }
-
-    return 0;
+    return length;
 }
 
 void customElementDrawElement(char *buff, uint8_t customElementIndex){
@@ -123,14 +207,10 @@ void customElementDrawElement(char *buff, uint8_t customElementIndex){
     static uint8_t prevLength[MAX_CUSTOM_ELEMENTS];
 
     uint8_t buffSeek = 0;
-    const osdCustomElement_t* customElement = osdCustomElements(customElementIndex);
-    if(isCustomelementVisible(customElement))
-    {
-        for (uint8_t i = 0; i < CUSTOM_ELEMENTS_PARTS; ++i) {
-            uint8_t currentSeek = customElementDrawPart(buff, customElementIndex, i);
-            buff += currentSeek;
-            buffSeek += currentSeek;
-        }
+    const customElementProgram_t *program = &customElementPrograms[customElementIndex];
+    if (customElementIsVisible(program)) {
+        buffSeek = customElementRun(buff, program);
+        buff += buffSeek;
     }
 
     for (uint8_t i = buffSeek; i < prevLength[customElementIndex]; i++) {
@@ -138,4 +218,3 @@ void customElementDrawElement(char *buff, uint8_t customElementIndex){
     }
     prevLength[customElementIndex] = buffSeek;
 }
-
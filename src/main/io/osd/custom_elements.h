@@ -58,4 +58,6 @@ typedef struct  {
 
 PG_DECLARE_ARRAY(osdCustomElement_t, MAX_CUSTOM_ELEMENTS, osdCustomElements);
 
-void customElementDrawElement(char *buff, uint8_t customElementIndex);
\ No newline at end of file
+// Rebuilds the render lists, must be called after osdCustomElements changes
+void customElementsCompile(void);
+void customElementDrawElement(char *buff, uint8_t customElementIndex);
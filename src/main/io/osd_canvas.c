@@ -58,6 +58,23 @@
 
 #define OSD_CANVAS_VARIO_ARROWS_PER_SLOT 2.0f
 
+// Regions for displayCanvasDrawRegion()
+typedef enum {
+    OSD_CANVAS_REGION_AHI,
+    OSD_CANVAS_REGION_HEADING_GRAPH,
+} osdCanvasRegion_e;
+
+typedef struct osdCanvasAhiRegion_s {
+    float pitchAngle;
+    float rollAngle;
+} osdCanvasAhiRegion_t;
+
+typedef struct osdCanvasHeadingGraphRegion_s {
+    int px;
+    int py;
+    int heading;
+} osdCanvasHeadingGraphRegion_t;
+
 static void osdCanvasVarioRect(int *y, int *h, displayCanvas_t *canvas, int midY, float zvel)
 {
     int maxHeight = ceilf(OSD_VARIO_HEIGHT_ROWS /OSD_CANVAS_VARIO_ARROWS_PER_SLOT) * canvas->gridElementHeight;
@@ -267,8 +284,8 @@ static void osdDrawArtificialHorizonShapes(displayCanvas_t *canvas, float pitchA
     displayCanvasCtmScale(canvas, 0.5f, 0.5f);
 
     // Draw line labels
-    float sx = sin_approx(rollAngle);
-    float sy = cos_approx(-rollAngle);
+    const float sx = osdGetViewTransform()->rollSin;
+    const float sy = osdGetViewTransform()->rollCos;
     for (int ii = pitchCenter - 2; ii <= pitchCenter + 2; ii++) {
         if (ii == 0) {
             continue;
@@ -399,9 +416,18 @@ static bool osdCanvasDrawArtificialHorizonWidget(displayPort_t *display, display
     return false;
 }
 
+static void osdDrawArtificialHorizonRegion(displayCanvas_t *canvas, const void *ctx)
+{
+    const osdCanvasAhiRegion_t *region = ctx;
+    int x, y, w, h;
+
+    osdArtificialHorizonRect(canvas, &x, &y, &w, &h);
+    displayCanvasClearRect(canvas, x, y, w, h);
+    osdDrawArtificialHorizonShapes(canvas, region->pitchAngle, region->rollAngle);
+}
+
 void osdCanvasDrawArtificialHorizon(displayPort_t *display, displayCanvas_t *canvas, const osdDrawPoint_t *p, float pitchAngle, float rollAngle)
 {
-    UNUSED(display);
     UNUSED(p);
 
     static float prevPitchAngle = 9999;
@@ -418,10 +444,8 @@ void osdCanvasDrawArtificialHorizon(displayPort_t *display, displayCanvas_t *can
             switch ((osd_ahi_style_e)osdConfig()->ahi_style) {
                 case OSD_AHI_STYLE_DEFAULT:
                 {
-                    int x, y, w, h;
-                    osdArtificialHorizonRect(canvas, &x, &y, &w, &h);
-                    displayCanvasClearRect(canvas, x, y, w, h);
-                    osdDrawArtificialHorizonShapes(canvas, pitchAngle, rollAngle);
+                    const osdCanvasAhiRegion_t region = { .pitchAngle = pitchAngle, .rollAngle = rollAngle };
+                    displayCanvasDrawRegion(canvas, OSD_CANVAS_REGION_AHI, display->clearCount, osdDrawArtificialHorizonRegion, &region);
                     break;
                 }
                 case OSD_AHI_STYLE_LINE:
@@ -438,8 +462,13 @@ void osdCanvasDrawArtificialHorizon(displayPort_t *display, displayCanvas_t *can
     }
 }
 
-void osdCanvasDrawHeadingGraph(displayPort_t *display, displayCanvas_t *canvas, const osdDrawPoint_t *p, int heading)
+static void osdDrawHeadingGraphRegion(displayCanvas_t *canvas, const void *ctx)
 {
+    const osdCanvasHeadingGraphRegion_t *region = ctx;
+    const int px = region->px;
+    const int py = region->py;
+    const int heading = region->heading;
+
     static const uint8_t graph[] = {
         SYM_HEADING_W,
         SYM_HEADING_LINE,
@@ -472,10 +501,6 @@ void osdCanvasDrawHeadingGraph(displayPort_t *display, displayCanvas_t *canvas,
     STATIC_ASSERT(sizeof(graph) > (3599 / OSD_HEADING_GRAPH_DECIDEGREES_PER_CHAR) + OSD_HEADING_GRAPH_WIDTH + 1, graph_is_too_short);
 
     char buf[OSD_HEADING_GRAPH_WIDTH + 1];
-    int px;
-    int py;
-
-    osdDrawPointGetPixels(&px, &py, display, canvas, p);
     int rw = OSD_HEADING_GRAPH_WIDTH * canvas->gridElementWidth;
     int rh = canvas->gridElementHeight;
 
@@ -497,6 +522,14 @@ void osdCanvasDrawHeadingGraph(displayPort_t *display, displayCanvas_t *canvas,
     displayCanvasFillStrokeTriangle(canvas, rmx - 2, py - 1, rmx + 2, py - 1, rmx, py + 1);
 }
 
+void osdCanvasDrawHeadingGraph(displayPort_t *display, displayCanvas_t *canvas, const osdDrawPoint_t *p, int heading)
+{
+    osdCanvasHeadingGraphRegion_t region = { .heading = heading };
+
+    osdDrawPointGetPixels(&region.px, &region.py, display, canvas, p);
+    displayCanvasDrawRegion(canvas, OSD_CANVAS_REGION_HEADING_GRAPH, display->clearCount, osdDrawHeadingGraphRegion, &region);
+}
+
 static int32_t osdCanvasSidebarGetValue(osd_sidebar_scroll_e scroll)
 {
     switch (scroll) {
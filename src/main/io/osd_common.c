@@ -26,6 +26,7 @@
 
 #include "platform.h"
 
+#include "common/maths.h"
 #include "common/utils.h"
 
 #include "config/parameter_group.h"
@@ -37,6 +38,10 @@
 
 #include "fc/settings.h"
 
+#include "flight/imu.h"
+#include "flight/pid.h"
+
+#include "io/osd.h"
 #include "io/osd_canvas.h"
 #include "io/osd_common.h"
 #include "io/osd_grid.h"
@@ -77,6 +82,92 @@ int16_t osdGetSpeedFromSelectedSource(void) {
 #define CANVAS_DEFAULT_GRID_ELEMENT_WIDTH OSD_CHAR_WIDTH
 #define CANVAS_DEFAULT_GRID_ELEMENT_HEIGHT OSD_CHAR_HEIGHT
 
+// sin() for every whole degree of the first quadrant
+static const float osdSinTable[91] = {
+    0.0000000f, 0.0174524f, 0.0348995f, 0.0523360f, 0.0697565f, 0.0871557f, 0.1045285f, 0.1218693f,
+    0.1391731f, 0.1564345f, 0.1736482f, 0.1908090f, 0.2079117f, 0.2249511f, 0.2419219f, 0.2588190f,
+    0.2756374f, 0.2923717f, 0.3090170f, 0.3255682f, 0.3420201f, 0.3583679f, 0.3746066f, 0.3907311f,
+    0.4067366f, 0.4226183f, 0.4383711f, 0.4539905f, 0.4694716f, 0.4848096f, 0.5000000f, 0.5150381f,
+    0.5299193f, 0.5446390f, 0.5591929f, 0.5735764f, 0.5877853f, 0.6018150f, 0.6156615f, 0.6293204f,
+    0.6427876f, 0.6560590f, 0.6691306f, 0.6819984f, 0.6946584f, 0.7071068f, 0.7193398f, 0.7313537f,
+    0.7431448f, 0.7547096f, 0.7660444f, 0.7771460f, 0.7880108f, 0.7986355f, 0.8090170f, 0.8191520f,
+    0.8290376f, 0.8386706f, 0.8480481f, 0.8571673f, 0.8660254f, 0.8746197f, 0.8829476f, 0.8910065f,
+    0.8987940f, 0.9063078f, 0.9135455f, 0.9205049f, 0.9271839f, 0.9335804f, 0.9396926f, 0.9455186f,
+    0.9510565f, 0.9563048f, 0.9612617f, 0.9659258f, 0.9702957f, 0.9743701f, 0.9781476f, 0.9816272f,
+    0.9848078f, 0.9876883f, 0.9902681f, 0.9925462f, 0.9945219f, 0.9961947f, 0.9975641f, 0.9986295f,
+    0.9993908f, 0.9998477f, 1.0000000f,
+};
+
+static osdViewTransform_t osdView;
+
+// [0, 900] decidegrees, linear interpolation between the table entries
+static float osdSinFirstQuadrant(int32_t decidegrees)
+{
+    const int32_t degrees = decidegrees / 10;
+    const int32_t fraction = decidegrees % 10;
+
+    if (fraction == 0) {
+        return osdSinTable[degrees];
+    }
+    return osdSinTable[degrees] + (osdSinTable[degrees + 1] - osdSinTable[degrees]) * fraction * 0.1f;
+}
+
+float osdSinDecidegrees(int32_t decidegrees)
+{
+    decidegrees %= 3600;
+    if (decidegrees < 0) {
+        decidegrees += 3600;
+    }
+
+    if (decidegrees <= 900) {
+        return osdSinFirstQuadrant(decidegrees);
+    }
+    if (decidegrees <= 1800) {
+        return osdSinFirstQuadrant(1800 - decidegrees);
+    }
+    if (decidegrees <= 2700) {
+        return -osdSinFirstQuadrant(decidegrees - 1800);
+    }
+    return -osdSinFirstQuadrant(3600 - decidegrees);
+}
+
+float osdCosDecidegrees(int32_t decidegrees)
+{
+    return osdSinDecidegrees(decidegrees + 900);
+}
+
+void osdUpdateViewTransform(void)
+{
+    int32_t roll = attitude.values.roll;
+    if (osdConfig()->ahi_reverse_roll) {
+        roll = -roll;
+    }
+
+    osdView.rollAngle = DECIDEGREES_TO_RADIANS(roll);
+    osdView.rollSin = osdSinDecidegrees(roll);
+    osdView.rollCos = osdCosDecidegrees(roll);
+
+    osdView.pitchAngle = DECIDEGREES_TO_RADIANS(attitude.values.pitch);
+    osdView.pitchAngle -= osdConfig()->ahi_camera_uptilt_comp ? DEGREES_TO_RADIANS(osdConfig()->camera_uptilt) : 0;
+    osdView.pitchAngle += DEGREES_TO_RADIANS(getFixedWingLevelTrim());
+
+    osdView.pitchDegrees = attitude.values.pitch / 10;
+    osdView.headingDegrees = DECIDEGREES_TO_DEGREES(osdGetHeading());
+    osdView.panDegrees = osdConfig()->pan_servo_pwm2centideg != 0 ? osdGetPanServoOffset() : 0;
+
+    if (osdView.fovHalfH != osdConfig()->camera_fov_h / 2 || osdView.fovHalfV != osdConfig()->camera_fov_v / 2) {
+        osdView.fovHalfH = osdConfig()->camera_fov_h / 2;
+        osdView.fovHalfV = osdConfig()->camera_fov_v / 2;
+        osdView.fovScaleH = 1.0f / osdSinDecidegrees(osdView.fovHalfH * 10);
+        osdView.fovScaleV = 1.0f / osdSinDecidegrees(osdView.fovHalfV * 10);
+    }
+}
+
+const osdViewTransform_t *osdGetViewTransform(void)
+{
+    return &osdView;
+}
+
 void osdDrawPointGetGrid(uint8_t *gx, uint8_t *gy, const displayPort_t *display, const displayCanvas_t *canvas, const osdDrawPoint_t *p)
 {
     UNUSED(display);
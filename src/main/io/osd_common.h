@@ -89,6 +89,28 @@ typedef struct osdDrawPoint_s {
 #define OSD_DRAW_POINT_GRID(_x, _y) (&(osdDrawPoint_t){ .type = OSD_DRAW_POINT_TYPE_GRID, .grid = {.gx = (_x), .gy = (_y)}})
 #define OSD_DRAW_POINT_PIXEL(_x, _y) (&(osdDrawPoint_t){ .type = OSD_DRAW_POINT_TYPE_PIXEL, .pixel = {.px = (_x), .py = (_y)}})
 
+// Attitude and camera geometry shared by the AHI and the HUD, updated once per OSD refresh
+typedef struct osdViewTransform_s {
+    float pitchAngle;       // AHI pitch in radians, corrected for camera uptilt and level trim
+    float rollAngle;        // AHI roll in radians
+    float rollSin;
+    float rollCos;
+    float headingDegrees;   // Aircraft heading
+    int16_t pitchDegrees;   // Aircraft pitch, HUD projection
+    int16_t panDegrees;     // Pan servo offset, 0 without a pan servo
+    int16_t fovHalfH;       // Half the camera FOV in degrees
+    int16_t fovHalfV;
+    float fovScaleH;        // 1 / sin(fovHalfH)
+    float fovScaleV;
+} osdViewTransform_t;
+
+// Table based sine and cosine, angles in decidegrees
+float osdSinDecidegrees(int32_t decidegrees);
+float osdCosDecidegrees(int32_t decidegrees);
+
+void osdUpdateViewTransform(void);
+const osdViewTransform_t *osdGetViewTransform(void);
+
 void osdDrawPointGetGrid(uint8_t *gx, uint8_t *gy, const displayPort_t *display, const displayCanvas_t *canvas, const osdDrawPoint_t *p);
 void osdDrawPointGetPixels(int *px, int *py, const displayPort_t *display, const displayCanvas_t *canvas, const osdDrawPoint_t *p);
 
@@ -25,6 +25,7 @@
  */
 
 #include <math.h>
+#include <string.h>
 
 #include "platform.h"
 
@@ -109,37 +110,46 @@ static float osdGetAspectRatioCorrection(void)
     return osdDisplayIsPAL() ? 12.0f/15.0f : 12.0f/18.46f;
 }
 
+typedef struct osdGridAhiCell_s {
+    uint8_t x;
+    uint8_t y;
+    uint16_t symbol;
+} osdGridAhiCell_t;
+
+static bool osdGridAhiFindCell(const osdGridAhiCell_t *cells, unsigned count, uint8_t x, uint8_t y, uint16_t *symbol)
+{
+    for (unsigned i = 0; i < count; i++) {
+        if (cells[i].x == x && cells[i].y == y) {
+            *symbol = cells[i].symbol;
+            return true;
+        }
+    }
+    return false;
+}
+
 void osdGridDrawArtificialHorizon(displayPort_t *display, unsigned gx, unsigned gy, float pitchAngle, float rollAngle)
 {
     UNUSED(gx);
     UNUSED(gy);
+    UNUSED(rollAngle);
 
     uint8_t elemPosX;
     uint8_t elemPosY;
 
     osdCrosshairPosition(&elemPosX, &elemPosY);
 
-    // Store the positions we draw over to erase only these at the next iteration
-    static int8_t previous_written[OSD_AHI_PREV_SIZE];
-    static int8_t previous_orient = -1;
+    // Cells drawn by the previous call, only the ones that change are written again
+    static osdGridAhiCell_t previous[OSD_AHI_PREV_SIZE];
+    static unsigned previousCount = 0;
+    osdGridAhiCell_t line[OSD_AHI_PREV_SIZE];
+    unsigned lineCount = 0;
 
     const float pitch_rad_to_char = (float)(OSD_AHI_HEIGHT / 2 + 0.5) / DEGREES_TO_RADIANS(osdConfig()->ahi_max_pitch);
 
-    const float ky = sin_approx(rollAngle);
-    const float kx = cos_approx(rollAngle);
+    const float ky = osdGetViewTransform()->rollSin;
+    const float kx = osdGetViewTransform()->rollCos;
     const float ratio = osdGetAspectRatioCorrection();
 
-    if (previous_orient != -1) {
-        for (int i = 0; i < OSD_AHI_PREV_SIZE; ++i) {
-            if (previous_written[i] > -1) {
-                int8_t dx = (previous_orient ? previous_written[i] : i) - OSD_AHI_PREV_SIZE / 2;
-                int8_t dy = (previous_orient ? i : previous_written[i]) - OSD_AHI_PREV_SIZE / 2;
-                displayWriteChar(display, elemPosX + dx, elemPosY - dy, SYM_BLANK);
-                previous_written[i] = -1;
-            }
-        }
-    }
-
     int8_t ahiPitchAngleDatum;     // sets the pitch datum AHI is drawn relative to (degrees)
     int8_t ahiLineEndPitchOffset;  // AHI end of line offset in degrees when ahiPitchAngleDatum > 0
 
@@ -152,43 +162,76 @@ void osdGridDrawArtificialHorizon(displayPort_t *display, unsigned gx, unsigned
 
     if (fabsf(ky) < fabsf(kx)) {
 
-        previous_orient = 0;
-
         /* ahi line ends drawn with 3 deg offset when ahiPitchAngleDatum > 0
          * Line end offset increased by 1 deg with every 20 deg pitch increase */
         const int8_t ahiLineEndOffsetFactor = ahiPitchAngleDatum / 20;
+        const float slope = ky / kx;
 
         for (int8_t dx = -OSD_AHI_WIDTH / 2; dx <= OSD_AHI_WIDTH / 2; dx++) {
             ahiLineEndPitchOffset = ahiPitchAngleDatum && (dx == -OSD_AHI_WIDTH / 2 || dx == OSD_AHI_WIDTH / 2) ? -(ahiLineEndOffsetFactor + 3 * ABS(ahiPitchAngleDatum) / ahiPitchAngleDatum) : 0;
-            float fy = (ratio * dx) * (ky / kx) + (pitchAngle + DEGREES_TO_RADIANS(ahiLineEndPitchOffset)) * pitch_rad_to_char + 0.49f;
+            float fy = (ratio * dx) * slope + (pitchAngle + DEGREES_TO_RADIANS(ahiLineEndPitchOffset)) * pitch_rad_to_char + 0.49f;
             int8_t dy = floorf(fy);
-            const uint8_t chX = elemPosX + dx, chY = elemPosY - dy;
-            uint16_t c;
 
-            if ((dy >= -OSD_AHI_HEIGHT / 2) && (dy <= OSD_AHI_HEIGHT / 2) && displayReadCharWithAttr(display, chX, chY, &c, NULL) && (c == SYM_BLANK)) {
-                c = SYM_AH_H_START + ((OSD_AHI_H_SYM_COUNT - 1) - (uint8_t)((fy - dy) * OSD_AHI_H_SYM_COUNT));
-                displayWriteChar(display, elemPosX + dx, elemPosY - dy, c);
-                previous_written[dx + OSD_AHI_PREV_SIZE / 2] = dy + OSD_AHI_PREV_SIZE / 2;
+            if ((dy >= -OSD_AHI_HEIGHT / 2) && (dy <= OSD_AHI_HEIGHT / 2)) {
+                line[lineCount++] = (osdGridAhiCell_t){
+                    .x = elemPosX + dx,
+                    .y = elemPosY - dy,
+                    .symbol = SYM_AH_H_START + ((OSD_AHI_H_SYM_COUNT - 1) - (uint8_t)((fy - dy) * OSD_AHI_H_SYM_COUNT)),
+                };
             }
         }
 
     } else {
 
-        previous_orient = 1;
+        const float slope = kx / ky;
 
         for (int8_t dy = -OSD_AHI_HEIGHT / 2; dy <= OSD_AHI_HEIGHT / 2; dy++) {
-            const float fx = ((dy / ratio) - pitchAngle * pitch_rad_to_char) * (kx / ky) + 0.5f;
+            const float fx = ((dy / ratio) - pitchAngle * pitch_rad_to_char) * slope + 0.5f;
             const int8_t dx = floorf(fx);
-            const uint8_t chX = elemPosX + dx, chY = elemPosY - dy;
-            uint16_t c;
 
-            if ((dx >= -OSD_AHI_WIDTH / 2) && (dx <= OSD_AHI_WIDTH / 2) && displayReadCharWithAttr(display, chX, chY, &c, NULL) && (c == SYM_BLANK)) {
-                c = SYM_AH_V_START + (fx - dx) * OSD_AHI_V_SYM_COUNT;
-                displayWriteChar(display, chX, chY, c);
-                previous_written[dy + OSD_AHI_PREV_SIZE / 2] = dx + OSD_AHI_PREV_SIZE / 2;
+            if ((dx >= -OSD_AHI_WIDTH / 2) && (dx <= OSD_AHI_WIDTH / 2)) {
+                line[lineCount++] = (osdGridAhiCell_t){
+                    .x = elemPosX + dx,
+                    .y = elemPosY - dy,
+                    .symbol = SYM_AH_V_START + (fx - dx) * OSD_AHI_V_SYM_COUNT,
+                };
             }
         }
     }
+
+    // Erase what the line no longer covers, unless another element took the cell over
+    for (unsigned i = 0; i < previousCount; i++) {
+        uint16_t c;
+        if (osdGridAhiFindCell(line, lineCount, previous[i].x, previous[i].y, &c)) {
+            continue;
+        }
+        if (!displayReadCharWithAttr(display, previous[i].x, previous[i].y, &c, NULL) || c == previous[i].symbol) {
+            displayWriteChar(display, previous[i].x, previous[i].y, SYM_BLANK);
+        }
+    }
+
+    // Only draw on blank cells or cells still holding the previous line, other elements win
+    unsigned drawnCount = 0;
+    for (unsigned i = 0; i < lineCount; i++) {
+        uint16_t c;
+        if (!displayReadCharWithAttr(display, line[i].x, line[i].y, &c, NULL)) {
+            continue;
+        }
+
+        uint16_t previousSymbol;
+        const bool ownCell = osdGridAhiFindCell(previous, previousCount, line[i].x, line[i].y, &previousSymbol) && c == previousSymbol;
+        if (c != SYM_BLANK && !ownCell) {
+            continue;
+        }
+
+        if (c != line[i].symbol) {
+            displayWriteChar(display, line[i].x, line[i].y, line[i].symbol);
+        }
+        line[drawnCount++] = line[i];
+    }
+
+    memcpy(previous, line, drawnCount * sizeof(line[0]));
+    previousCount = drawnCount;
 }
 
 void osdGridDrawHeadingGraph(displayPort_t *display, unsigned gx, unsigned gy, int heading)
@@ -25,6 +25,7 @@
 #include "flight/imu.h"
 
 #include "io/osd.h"
+#include "io/osd_common.h"
 #include "io/osd_hud.h"
 
 #include "drivers/display.h"
@@ -37,42 +38,101 @@
 
 #ifdef USE_OSD
 
-#define HUD_DRAWN_MAXCHARS 54 // 8 POI (1 home, 4 radar, 3 WP) x 7 chars max for each, minus 2 for H
+#define HUD_DRAWN_MAXCHARS 64 // 8 POI (1 home, 4 radar, 3 WP) x 8 chars max for each
 
-static int8_t hud_drawn[HUD_DRAWN_MAXCHARS][2];
-static int8_t hud_drawn_pt;
+typedef struct osdHudCell_s {
+    int8_t x;
+    int8_t y;
+    uint16_t symbol;
+} osdHudCell_t;
+
+typedef struct osdHudProjection_s {
+    int16_t errorX;     // Horizontal angle between the heading and the POI, in degrees
+    int16_t x;
+    int16_t y;
+    bool outOfSight;
+} osdHudProjection_t;
+
+// Cells written by the current and the previous frame, stale ones are only erased at the end of a frame
+static osdHudCell_t hudCells[2][HUD_DRAWN_MAXCHARS];
+static uint8_t hudCellCount[2];
+static uint8_t hudFrame;
+
+static const osdHudCell_t *osdHudFindCell(uint8_t frame, int8_t px, int8_t py)
+{
+    for (int i = 0; i < hudCellCount[frame]; i++) {
+        if (hudCells[frame][i].x == px && hudCells[frame][i].y == py) {
+            return &hudCells[frame][i];
+        }
+    }
+    return NULL;
+}
+
+static void osdHudBeginFrame(void)
+{
+    hudFrame ^= 1;
+    hudCellCount[hudFrame] = 0;
+}
 
 /*
- * Overwrite all previously written positions on the OSD with a blank
+ * Blank the cells of the previous frame that were not drawn again, unless something else took them over
  */
-void osdHudClear(void)
+static void osdHudEndFrame(void)
 {
-    for (int i = 0; i < HUD_DRAWN_MAXCHARS; i++) {
-        if (hud_drawn[i][0] > -1) {
-            displayWriteChar(osdGetDisplayPort(), hud_drawn[i][0], hud_drawn[i][1], SYM_BLANK);
-            hud_drawn[i][0] = -1;
+    const uint8_t previous = hudFrame ^ 1;
+
+    for (int i = 0; i < hudCellCount[previous]; i++) {
+        const osdHudCell_t *cell = &hudCells[previous][i];
+        uint16_t c;
+
+        if (osdHudFindCell(hudFrame, cell->x, cell->y)) {
+            continue;
+        }
+        if (!displayReadCharWithAttr(osdGetDisplayPort(), cell->x, cell->y, &c, NULL) || c == cell->symbol) {
+            displayWriteChar(osdGetDisplayPort(), cell->x, cell->y, SYM_BLANK);
         }
     }
-    hud_drawn_pt = 0;
+    hudCellCount[previous] = 0;
 }
 
 /*
- * Write a single char on the OSD, and record the position for the next loop
+ * A cell is taken if it is not blank, markers left over from the previous frame don't count
+ */
+static bool osdHudCellIsTaken(uint8_t px, uint8_t py)
+{
+    const osdHudCell_t *cell = osdHudFindCell(hudFrame, px, py);
+    if (cell) {
+        return cell->symbol != SYM_BLANK;
+    }
+
+    uint16_t c;
+    if (!displayReadCharWithAttr(osdGetDisplayPort(), px, py, &c, NULL) || c == SYM_BLANK) {
+        return false;
+    }
+
+    cell = osdHudFindCell(hudFrame ^ 1, px, py);
+    return !cell || cell->symbol != c;
+}
+
+/*
+ * Write a single char on the OSD, and record the position for the next frame
  */
 static int osdHudWrite(uint8_t px, uint8_t py, uint16_t symb, bool crush)
 {
-    if (!crush) {
-        uint16_t c;
-        if (displayReadCharWithAttr(osdGetDisplayPort(), px, py, &c, NULL) && c != SYM_BLANK) {
-            return false;
-        }
+    if (!crush && osdHudCellIsTaken(px, py)) {
+        return false;
+    }
+
+    // Markers that did not move are still on screen
+    const osdHudCell_t *previous = osdHudFindCell(hudFrame ^ 1, px, py);
+    uint16_t c;
+    if (!previous || previous->symbol != symb || !displayReadCharWithAttr(osdGetDisplayPort(), px, py, &c, NULL) || c != symb) {
+        displayWriteChar(osdGetDisplayPort(), px, py, symb);
     }
 
-    displayWriteChar(osdGetDisplayPort(), px, py, symb);
-    hud_drawn[hud_drawn_pt][0] = px;
-    hud_drawn[hud_drawn_pt][1] = py;
-    hud_drawn_pt++;
-    if (hud_drawn_pt >= HUD_DRAWN_MAXCHARS) hud_drawn_pt = 0;
+    if (hudCellCount[hudFrame] < HUD_DRAWN_MAXCHARS) {
+        hudCells[hudFrame][hudCellCount[hudFrame]++] = (osdHudCell_t){ .x = px, .y = py, .symbol = symb };
+    }
     return true;
 }
 
@@ -113,6 +173,56 @@ int8_t radarGetNearestPOI(void)
     return poi;
 }
 
+static void osdHudGetArea(uint8_t *minX, uint8_t *maxX, uint8_t *minY, uint8_t *maxY)
+{
+    *minX = osdConfig()->hud_margin_h + 2;
+    *maxX = osdGetDisplayPort()->cols - osdConfig()->hud_margin_h - 3;
+    *minY = osdConfig()->hud_margin_v;
+    *maxY = osdGetDisplayPort()->rows - osdConfig()->hud_margin_v - 2;
+}
+
+/*
+ * Projects all the POIs of a frame onto the screen and clips them to the hud area. POIs outside
+ * of the camera view or the hud area are moved to its left or right border.
+ */
+static void osdHudProjectPois(const osdHudPoi_t *pois, uint8_t count, osdHudProjection_t *projections)
+{
+    const osdViewTransform_t *view = osdGetViewTransform();
+    uint8_t center_x;
+    uint8_t center_y;
+    uint8_t minX, maxX, minY, maxY;
+
+    osdCrosshairPosition(&center_x, &center_y);
+    osdHudGetArea(&minX, &maxX, &minY, &maxY);
+
+    for (int i = 0; i < count; i++) {
+        const osdHudPoi_t *poi = &pois[i];
+        osdHudProjection_t *projection = &projections[i];
+
+        projection->errorX = hudWrap180(poi->direction + view->panDegrees - view->headingDegrees);
+        projection->outOfSight = true;
+
+        if ((projection->errorX > -view->fovHalfH) && (projection->errorX < view->fovHalfH)) { // POI might be in sight, extra geometry needed
+            float scaled_x = osdSinDecidegrees(projection->errorX * 10) * view->fovScaleH;
+            projection->x = center_x + 15 * scaled_x;
+
+            if (projection->x >= minX && projection->x <= maxX) { // POI is on sight, compute the vertical
+                float poi_angle = atan2_approx(-poi->altitude, poi->distance);
+                poi_angle = RADIANS_TO_DEGREES(poi_angle);
+                int16_t error_y = poi_angle - view->pitchDegrees + osdConfig()->camera_uptilt;
+                float scaled_y = osdSinDecidegrees(error_y * 10) * view->fovScaleV;
+                projection->y = constrain(center_y + (osdGetDisplayPort()->rows / 2) * scaled_y, minY, maxY - 1);
+                projection->outOfSight = false;
+            }
+        }
+
+        if (projection->outOfSight) {
+            projection->x = (projection->errorX > 0) ? maxX : minX;
+            projection->y = center_y - 1;
+        }
+    }
+}
+
 /*
  * Display a POI as a 3D-marker on the hud
  * Distance (m), Direction (°), Altitude (relative, m, negative means below), Heading (°),
@@ -120,63 +230,35 @@ int8_t radarGetNearestPOI(void)
  * Type = 1 : Radar POI, P1: Relative heading, P2: Signal, P3 Cardinal direction
  * Type = 2 : Waypoint, P1: WP number, P2: 1=WP+1, 2=WP+2, 3=WP+3
  */
-void osdHudDrawPoi(uint32_t poiDistance, int16_t poiDirection, int32_t poiAltitude, uint8_t poiType, uint16_t poiSymbol, int16_t poiP1, int16_t poiP2)
+static void osdHudDrawPoi(const osdHudPoi_t *poi, const osdHudProjection_t *projection)
 {
-    int poi_x = -1;
-    int poi_y = -1;
+    const uint32_t poiDistance = poi->distance;
+    const int32_t poiAltitude = poi->altitude;
+    const uint8_t poiType = poi->type;
+    const int16_t poiP1 = poi->p1;
+    const int16_t poiP2 = poi->p2;
+    int poi_x = projection->x;
+    int poi_y = projection->y;
+    int16_t error_x = projection->errorX;
     uint8_t center_x;
     uint8_t center_y;
-    bool poi_is_oos = 0;
+    uint8_t minX, maxX, minY, maxY;
     char buff[4];
     int altc = 0;
 
-    uint8_t minX = osdConfig()->hud_margin_h + 2;
-    uint8_t maxX = osdGetDisplayPort()->cols - osdConfig()->hud_margin_h - 3;
-    uint8_t minY = osdConfig()->hud_margin_v;
-    uint8_t maxY = osdGetDisplayPort()->rows - osdConfig()->hud_margin_v - 2;
-
     osdCrosshairPosition(&center_x, &center_y);
-
-    if (!(osdConfig()->pan_servo_pwm2centideg == 0)){
-        poiDirection = poiDirection + osdGetPanServoOffset();
-    }
-
-    int16_t error_x = hudWrap180(poiDirection - DECIDEGREES_TO_DEGREES(osdGetHeading()));
-
-    if ((error_x > -(osdConfig()->camera_fov_h / 2)) && (error_x < osdConfig()->camera_fov_h / 2)) { // POI might be in sight, extra geometry needed
-        float scaled_x = sin_approx(DEGREES_TO_RADIANS(error_x)) / sin_approx(DEGREES_TO_RADIANS(osdConfig()->camera_fov_h / 2));
-        poi_x = center_x + 15 * scaled_x;
-
-        if (poi_x < minX || poi_x > maxX ) { // In camera view, but out of the hud area
-            poi_is_oos = 1;
-        } else { // POI is on sight, compute the vertical
-            float poi_angle = atan2_approx(-poiAltitude, poiDistance);
-            poi_angle = RADIANS_TO_DEGREES(poi_angle);
-            int16_t plane_angle = attitude.values.pitch / 10;
-            int camera_angle = osdConfig()->camera_uptilt;
-            int16_t error_y = poi_angle - plane_angle + camera_angle;
-            float scaled_y = sin_approx(DEGREES_TO_RADIANS(error_y)) / sin_approx(DEGREES_TO_RADIANS(osdConfig()->camera_fov_v / 2));
-            poi_y = constrain(center_y + (osdGetDisplayPort()->rows / 2) * scaled_y, minY, maxY - 1);
-        }
-    } else {
-        poi_is_oos = 1; // POI is out of camera view for sure
-    }
+    osdHudGetArea(&minX, &maxX, &minY, &maxY);
+    UNUSED(minY);
 
     // Out-of-sight arrows and stacking
     // Always show with ESP32 Radar
 
-    if (poi_is_oos || poiType == 1) {
+    if (projection->outOfSight || poiType == 1) {
         uint16_t d;
-        uint16_t c;
-
-        if (poi_is_oos) {
-            poi_x = (error_x > 0 ) ? maxX : minX;
-            poi_y = center_y - 1;
-        }
 
-        if (displayReadCharWithAttr(osdGetDisplayPort(), poi_x, poi_y, &c, NULL) && c != SYM_BLANK) {
+        if (osdHudCellIsTaken(poi_x, poi_y)) {
             poi_y = center_y - 3;
-            while (displayReadCharWithAttr(osdGetDisplayPort(), poi_x, poi_y, &c, NULL) && c != SYM_BLANK && poi_y < maxY - 3) { // Stacks the out-of-sight POI from top to bottom
+            while (osdHudCellIsTaken(poi_x, poi_y) && poi_y < maxY - 3) { // Stacks the out-of-sight POI from top to bottom
                 poi_y += 2;
             }
         }
@@ -203,10 +285,10 @@ void osdHudDrawPoi(uint32_t poiDistance, int16_t poiDirection, int32_t poiAltitu
 
     // Markers
 
-    osdHudWrite(poi_x, poi_y, poiSymbol, 1);
+    osdHudWrite(poi_x, poi_y, poi->symbol, 1);
 
     if (poiType == 1) { // POI from the ESP radar
-        error_x = hudWrap360(poiP1 - DECIDEGREES_TO_DEGREES(osdGetHeading()));
+        error_x = hudWrap360(poiP1 - osdGetViewTransform()->headingDegrees);
         osdHudWrite(poi_x - 1, poi_y, SYM_DECORATION + ((error_x + 22) / 45) % 8, 1);
         osdHudWrite(poi_x + 1, poi_y, SYM_HUD_SIGNAL_0 + poiP2, 1);
     }
@@ -295,6 +377,23 @@ void osdHudDrawPoi(uint32_t poiDistance, int16_t poiDirection, int32_t poiAltitu
     }
 }
 
+/*
+ * Draw all the POIs of a frame, only the cells that changed since the previous frame are written
+ */
+void osdHudDrawPois(const osdHudPoi_t *pois, uint8_t count)
+{
+    osdHudProjection_t projections[OSD_HUD_MAX_POIS];
+
+    count = MIN(count, OSD_HUD_MAX_POIS);
+    osdHudProjectPois(pois, count, projections);
+
+    osdHudBeginFrame();
+    for (int i = 0; i < count; i++) {
+        osdHudDrawPoi(&pois[i], &projections[i]);
+    }
+    osdHudEndFrame();
+}
+
 /*
  * Draw the crosshair
  */
@@ -344,7 +443,7 @@ void osdHudDrawHoming(uint8_t px, uint8_t py)
     int crh_u = SYM_BLANK;
     int crh_d = SYM_BLANK;
 
-    int16_t crh_diff_head = hudWrap180(GPS_directionToHome - DECIDEGREES_TO_DEGREES(osdGetHeading()));
+    int16_t crh_diff_head = hudWrap180(GPS_directionToHome - osdGetViewTransform()->headingDegrees);
 
     if (crh_diff_head <= -162 || crh_diff_head >= 162) {
         crh_l = SYM_HUD_ARROWS_L3;
@@ -382,7 +481,7 @@ void osdHudDrawHoming(uint8_t px, uint8_t py)
 
         float crh_home_angle = atan2_approx(crh_altitude, crh_distance);
         crh_home_angle = RADIANS_TO_DEGREES(crh_home_angle);
-        int crh_plane_angle = attitude.values.pitch / 10;
+        int crh_plane_angle = osdGetViewTransform()->pitchDegrees;
         int crh_camera_angle = osdConfig()->camera_uptilt;
         int crh_diff_vert = crh_home_angle - crh_plane_angle + crh_camera_angle;
 
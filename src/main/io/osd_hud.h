@@ -23,8 +23,19 @@
 typedef struct displayCanvas_s displayCanvas_t;
 
 
-void osdHudClear(void);
+#define OSD_HUD_MAX_POIS 8   // Home, 4 radar POIs and 3 waypoints
+
+typedef struct osdHudPoi_s {
+    uint32_t distance;      // m
+    int16_t direction;      // degrees
+    int32_t altitude;       // m, relative to the aircraft
+    uint8_t type;           // 0: home, 1: radar POI, 2: waypoint
+    uint16_t symbol;
+    int16_t p1;
+    int16_t p2;
+} osdHudPoi_t;
+
 void osdHudDrawCrosshair(displayCanvas_t *canvas, uint8_t px, uint8_t py);
 void osdHudDrawHoming(uint8_t px, uint8_t py);
-void osdHudDrawPoi(uint32_t poiDistance, int16_t poiDirection, int32_t poiAltitude, uint8_t poiType, uint16_t poiSymbol, int16_t poiP1, int16_t poiP2);
+void osdHudDrawPois(const osdHudPoi_t *pois, uint8_t count);
 int8_t radarGetNearestPOI(void);
@@ -33,3 +33,6 @@
 #define MSP2_COMMON_SET_RADAR_POS       0x100B //SET radar position information
 #define MSP2_COMMON_SET_RADAR_ITD       0x100C //SET radar information to display
 
+#define MSP2_COMMON_SETTINGS_BLOB       0x100D  //in/out message    Returns the values of a range of settings as a binary blob
+#define MSP2_COMMON_SET_SETTINGS_BLOB   0x100E  //in message        Sets the values of a range of settings from a binary blob
+
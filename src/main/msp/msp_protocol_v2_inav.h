@@ -96,6 +96,9 @@
 #define MSP2_INAV_FW_APPROACH                   0x204A
 #define MSP2_INAV_SET_FW_APPROACH               0x204B
 
+#define MSP2_INAV_RC_LATENCY                    0x2050
+#define MSP2_INAV_RC_LATENCY_RESET              0x2051
+
 #define MSP2_INAV_RATE_DYNAMICS                 0x2060
 #define MSP2_INAV_SET_RATE_DYNAMICS             0x2061
 
@@ -108,6 +111,8 @@
 
 #define MSP2_INAV_CUSTOM_OSD_ELEMENTS           0x2100
 #define MSP2_INAV_SET_CUSTOM_OSD_ELEMENTS       0x2101
+#define MSP2_INAV_DISPLAYPORT_OPTIONS           0x2102
+#define MSP2_INAV_DISPLAYPORT_STATS             0x2103
 
 #define MSP2_INAV_SERVO_CONFIG                  0x2200
 #define MSP2_INAV_SET_SERVO_CONFIG              0x2201
\ No newline at end of file
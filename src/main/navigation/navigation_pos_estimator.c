@@ -255,6 +255,7 @@ void onNewGPSData(void)
 
                 /* Indicate a last valid reading of Pos/Vel */
                 posEstimator.gps.lastUpdateTime = currentTimeUs;
+                posEstimator.gps.measurementTime = gpsSol.measurementTimeUs;
             }
 
             previousLat = gpsSol.llh.lat;
@@ -611,8 +612,8 @@ static bool estimationCalculateCorrection_Z(estimationContext_t * ctx)
         }
         else {
             // Altitude
-            const float gpsAltResudual = posEstimator.gps.pos.z - posEstimator.est.pos.z;
-            const float gpsVelZResudual = posEstimator.gps.vel.z - posEstimator.est.vel.z;
+            const float gpsAltResudual = posEstimator.gps.pos.z - ctx->estPosAtGps.z;
+            const float gpsVelZResudual = posEstimator.gps.vel.z - ctx->estVelAtGps.z;
 
             ctx->estPosCorr.z += gpsAltResudual * positionEstimationConfig()->w_z_gps_p * ctx->dt;
             ctx->estVelCorr.z += gpsAltResudual * sq(positionEstimationConfig()->w_z_gps_p) * ctx->dt;
@@ -641,10 +642,10 @@ static bool estimationCalculateCorrection_XY_GPS(estimationContext_t * ctx)
             ctx->newEPH = posEstimator.gps.eph;
         }
         else {
-            const float gpsPosXResidual = posEstimator.gps.pos.x - posEstimator.est.pos.x;
-            const float gpsPosYResidual = posEstimator.gps.pos.y - posEstimator.est.pos.y;
-            const float gpsVelXResidual = posEstimator.gps.vel.x - posEstimator.est.vel.x;
-            const float gpsVelYResidual = posEstimator.gps.vel.y - posEstimator.est.vel.y;
+            const float gpsPosXResidual = posEstimator.gps.pos.x - ctx->estPosAtGps.x;
+            const float gpsPosYResidual = posEstimator.gps.pos.y - ctx->estPosAtGps.y;
+            const float gpsVelXResidual = posEstimator.gps.vel.x - ctx->estVelAtGps.x;
+            const float gpsVelYResidual = posEstimator.gps.vel.y - ctx->estVelAtGps.y;
             const float gpsPosResidualMag = calc_length_pythagorean_2D(gpsPosXResidual, gpsPosYResidual);
 
             //const float gpsWeightScaler = scaleRangef(bellCurve(gpsPosResidualMag, INAV_GPS_ACCEPTANCE_EPE), 0.0f, 1.0f, 0.1f, 1.0f);
@@ -692,6 +693,75 @@ static void estimationCalculateGroundCourse(timeUs_t currentTimeUs)
     }
 }
 
+/**
+ * Estimate history for fusing delayed measurements. Corrections applied after a sample are added to it
+ * so a past state can be compared against a measurement as if it had been corrected along with the
+ * current one. They are accumulated between samples and folded into the stored ones when the next
+ * sample is taken, so the accumulated sums don't grow over a long flight.
+ */
+static void estimationResetHistory(void)
+{
+    posEstimator.history.head = 0;
+    posEstimator.history.count = 0;
+}
+
+static void estimationUpdateHistory(timeUs_t currentTimeUs, const estimationContext_t * ctx)
+{
+    navPositionEstimatorHISTORY_t * history = &posEstimator.history;
+
+    if (history->count == 0) {
+        vectorZero(&history->posCorr);
+        vectorZero(&history->velCorr);
+    }
+    else {
+        vectorAdd(&history->posCorr, &history->posCorr, &ctx->estPosCorr);
+        vectorAdd(&history->velCorr, &history->velCorr, &ctx->estVelCorr);
+
+        const navPositionEstimatorHistorySample_t * newest = &history->samples[(history->head + INAV_HISTORY_LENGTH - 1) % INAV_HISTORY_LENGTH];
+        if (cmpTimeUs(currentTimeUs, newest->timeUs) < INAV_HISTORY_SAMPLE_INTERVAL_US) {
+            return;
+        }
+    }
+
+    for (int i = 0; i < history->count; i++) {
+        vectorAdd(&history->samples[i].pos, &history->samples[i].pos, &history->posCorr);
+        vectorAdd(&history->samples[i].vel, &history->samples[i].vel, &history->velCorr);
+    }
+    vectorZero(&history->posCorr);
+    vectorZero(&history->velCorr);
+
+    navPositionEstimatorHistorySample_t * sample = &history->samples[history->head];
+    sample->timeUs = currentTimeUs;
+    sample->pos = posEstimator.est.pos;
+    sample->vel = posEstimator.est.vel;
+
+    history->head = (history->head + 1) % INAV_HISTORY_LENGTH;
+    history->count = MIN(history->count + 1, INAV_HISTORY_LENGTH);
+}
+
+/* Interpolated estimate at timeUs, current estimate if timeUs is not in the past, oldest sample if beyond the history */
+static void estimationGetHistoricalState(timeUs_t timeUs, fpVector3_t * pos, fpVector3_t * vel)
+{
+    const navPositionEstimatorHISTORY_t * history = &posEstimator.history;
+    timeUs_t newerTimeUs = posEstimator.est.lastUpdateTime;
+
+    *pos = posEstimator.est.pos;
+    *vel = posEstimator.est.vel;
+
+    for (int i = 0; i < history->count && cmpTimeUs(newerTimeUs, timeUs) > 0; i++) {
+        const navPositionEstimatorHistorySample_t * sample = &history->samples[(history->head + INAV_HISTORY_LENGTH - 1 - i) % INAV_HISTORY_LENGTH];
+        const timeDelta_t spanUs = cmpTimeUs(newerTimeUs, sample->timeUs);
+        const float newerWeight = (cmpTimeUs(sample->timeUs, timeUs) >= 0 || spanUs <= 0) ? 0.0f : (float)cmpTimeUs(timeUs, sample->timeUs) / spanUs;
+
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            pos->v[axis] = pos->v[axis] * newerWeight + (sample->pos.v[axis] + history->posCorr.v[axis]) * (1.0f - newerWeight);
+            vel->v[axis] = vel->v[axis] * newerWeight + (sample->vel.v[axis] + history->velCorr.v[axis]) * (1.0f - newerWeight);
+        }
+
+        newerTimeUs = sample->timeUs;
+    }
+}
+
 /**
  * Calculate next estimate using IMU and apply corrections from reference sensors (GPS, BARO etc)
  *  Function is called at main loop rate
@@ -709,6 +779,7 @@ static void updateEstimatedTopic(timeUs_t currentTimeUs)
         posEstimator.est.eph = positionEstimationConfig()->max_eph_epv + 0.001f;
         posEstimator.est.epv = positionEstimationConfig()->max_eph_epv + 0.001f;
         posEstimator.flags = 0;
+        estimationResetHistory();
         return;
     }
 
@@ -726,6 +797,9 @@ static void updateEstimatedTopic(timeUs_t currentTimeUs)
     /* Prediction stage: X,Y,Z */
     estimationPredict(&ctx);
 
+    /* GPS measurements are compared against the estimate from the time they were taken */
+    estimationGetHistoricalState(posEstimator.gps.measurementTime, &ctx.estPosAtGps, &ctx.estVelAtGps);
+
     /* Correction stage: Z */
     const bool estZCorrectOk =
         estimationCalculateCorrection_Z(&ctx);
@@ -752,6 +826,7 @@ static void updateEstimatedTopic(timeUs_t currentTimeUs)
     // Apply corrections
     vectorAdd(&posEstimator.est.pos, &posEstimator.est.pos, &ctx.estPosCorr);
     vectorAdd(&posEstimator.est.vel, &posEstimator.est.vel, &ctx.estVelCorr);
+    estimationUpdateHistory(currentTimeUs, &ctx);
 
     /* Correct accelerometer bias */
     if (positionEstimationConfig()->w_acc_bias > 0.0f) {
@@ -47,6 +47,9 @@
 
 #define CALIBRATING_GRAVITY_TIME_MS         2000
 
+#define INAV_HISTORY_SAMPLE_INTERVAL_US     10000   // Resolution of the estimate history
+#define INAV_HISTORY_LENGTH                 32      // 320ms of estimate history to fuse delayed GPS measurements
+
 // Time constants for calculating Baro/Sonar averages. Should be the same value to impose same amount of group delay
 #define INAV_BARO_AVERAGE_HZ                1.0f
 #define INAV_SURFACE_AVERAGE_HZ             1.0f
@@ -65,6 +68,7 @@ typedef struct {
 
 typedef struct {
     timeUs_t    lastUpdateTime; // Last update time (us)
+    timeUs_t    measurementTime;    // Time the measurement was taken, lastUpdateTime minus receiver latency (us)
     fpVector3_t pos;            // GPS position in NEU coordinate system (cm)
     fpVector3_t vel;            // GPS velocity (cms)
     float       eph;
@@ -136,6 +140,20 @@ typedef struct {
     zeroCalibrationScalar_t gravityCalibration;
 } navPosisitonEstimatorIMU_t;
 
+typedef struct {
+    timeUs_t    timeUs;
+    fpVector3_t pos;
+    fpVector3_t vel;
+} navPositionEstimatorHistorySample_t;
+
+typedef struct {
+    navPositionEstimatorHistorySample_t samples[INAV_HISTORY_LENGTH];
+    uint8_t     head;           // Next slot to write
+    uint8_t     count;
+    fpVector3_t posCorr;        // Corrections applied since the newest sample, not yet added to the stored samples
+    fpVector3_t velCorr;
+} navPositionEstimatorHISTORY_t;
+
 typedef enum {
     EST_GPS_XY_VALID            = (1 << 0),
     EST_GPS_Z_VALID             = (1 << 1),
@@ -168,6 +186,7 @@ typedef struct {
 
     // Estimate
     navPositionEstimatorESTIMATE_t  est;
+    navPositionEstimatorHISTORY_t   history;
 
     // Extra state variables
     navPositionEstimatorSTATE_t state;
@@ -181,6 +200,8 @@ typedef struct {
     fpVector3_t estPosCorr;
     fpVector3_t estVelCorr;
     fpVector3_t accBiasCorr;
+    fpVector3_t estPosAtGps;    // Estimate at the time the GPS measurement was taken
+    fpVector3_t estVelAtGps;
 } estimationContext_t;
 
 extern navigationPosEstimator_t posEstimator;
@@ -158,6 +158,7 @@ typedef struct {
 typedef struct fportBuffer_s {
     uint8_t data[sizeof(fportFrame_t)+1]; // +1 for CRC
     uint8_t length;
+    timeUs_t frameEndTimeUs;
 } fportBuffer_t;
 
 typedef struct {
@@ -195,6 +196,7 @@ static timeUs_t readyToUpdateFirmwareTimestamp = 0;
 #endif
 
 static volatile uint16_t frameErrors = 0;
+static timeUs_t rcFrameEndTimeUs = 0;
 
 static void reportFrameError(uint8_t errorReason) {
     UNUSED(errorReason);
@@ -212,6 +214,7 @@ static bool nextWriteBuffer(void)
     if (nextWriteIndex != rxBufferReadIndex) {
         rxBufferWriteIndex = nextWriteIndex;
         clearWriteBuffer();
+        rxSignalFrameComplete();
         return true;
     } else {
         clearWriteBuffer();
@@ -271,6 +274,7 @@ static void fportDataReceive(uint16_t byte, void *callback_data)
 
         case FS_CONTROL_FRAME_DATA: {
             if (writeBuffer(byte) > controlFrameSize) {
+                rxBuffer[rxBufferWriteIndex].frameEndTimeUs = currentTimeUs;
                 nextWriteBuffer();
                 state = FS_DOWNLINK_FRAME_START;
             }
@@ -363,6 +367,7 @@ static uint8_t frameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
                             result = sbusChannelsDecode(rxRuntimeConfig, &frame->control.rc.channels);
                             lqTrackerSet(rxRuntimeConfig->lqTracker, scaleRange(frame->control.rc.rssi, 0, 100, 0, RSSI_MAX_VALUE));
                             frameReceivedTimestamp = currentTimeUs;
+                            rcFrameEndTimeUs = rxBuffer[rxBufferReadIndex].frameEndTimeUs;
 #if defined(USE_TELEMETRY_SMARTPORT)
                             otaMode = false;
 #endif
@@ -630,6 +635,12 @@ static bool processFrame(const rxRuntimeConfig_t *rxRuntimeConfig)
 }
 
 
+static timeUs_t frameTimeUs(const rxRuntimeConfig_t *rxRuntimeConfig)
+{
+    UNUSED(rxRuntimeConfig);
+    return rcFrameEndTimeUs;
+}
+
 bool fport2RxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, bool isFBUS)
 {
     static uint16_t sbusChannelData[SBUS_MAX_CHANNEL];
@@ -639,6 +650,8 @@ bool fport2RxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig
     rxRuntimeConfig->channelCount = SBUS_MAX_CHANNEL;
     rxRuntimeConfig->rcFrameStatusFn = frameStatus;
     rxRuntimeConfig->rcProcessFrameFn = processFrame;
+    rxRuntimeConfig->rcFrameTimeUsFn = frameTimeUs;
+    rxRuntimeConfig->rcFrameSignalEnabled = true;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
     if (!portConfig) {
@@ -171,6 +171,7 @@ STATIC_UNIT_TESTED void ghstDataReceive(uint16_t c, void *data)
 
             // remember what time the incoming (Rx) packet ended, so that we can ensure a quite bus before sending telemetry
             ghstRxFrameEndAtUs = microsISR();
+            rxSignalFrameComplete();
         }
     }
 }
@@ -267,6 +268,12 @@ uint8_t ghstFrameStatus(rxRuntimeConfig_t *rxRuntimeState)
     return ghstFailsafeFlag | RX_FRAME_PENDING;
 }
 
+static timeUs_t ghstFrameTimeUs(const rxRuntimeConfig_t *rxRuntimeConfig)
+{
+    UNUSED(rxRuntimeConfig);
+    return ghstRxFrameEndAtUs;
+}
+
 static bool ghstProcessFrame(const rxRuntimeConfig_t *rxRuntimeConfig)
 {
     // Assume that the only way we get here is if ghstFrameStatus returned RX_FRAME_PROCESSING_REQUIRED, which indicates that the CRC
@@ -350,6 +357,8 @@ bool ghstRxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeState)
     rxRuntimeState->rcReadRawFn = ghstReadRawRC;
     rxRuntimeState->rcFrameStatusFn = ghstFrameStatus;
     rxRuntimeState->rcProcessFrameFn = ghstProcessFrame;
+    rxRuntimeState->rcFrameTimeUsFn = ghstFrameTimeUs;
+    rxRuntimeState->rcFrameSignalEnabled = true;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
     if (!portConfig) {
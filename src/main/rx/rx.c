@@ -42,6 +42,7 @@
 
 #include "fc/config.h"
 #include "fc/rc_controls.h"
+#include "fc/rc_latency.h"
 #include "fc/rc_modes.h"
 #include "fc/settings.h"
 
@@ -74,6 +75,11 @@ static timeUs_t lastMspRssiUpdateUs = 0;
 #define RX_LQ_INTERVAL_MS       200
 #define RX_LQ_TIMEOUT_MS        1000
 
+// Receivers signalling frame completion are polled at full rate for a short window after each signal
+// (idle line detection, telemetry turnaround) and otherwise only often enough to run their timeouts
+#define RX_FRAME_SIGNAL_POLL_WINDOW_US  1000
+#define RX_FRAME_POLL_INTERVAL_US       1000
+
 static rxLinkQualityTracker_e rxLQTracker;
 static rssiSource_e activeRssiSource;
 
@@ -89,6 +95,11 @@ static bool rxFlightChannelsValid = false;
 static uint8_t rxChannelCount;
 
 static timeUs_t rxNextUpdateAtUs = 0;
+static timeUs_t rxFrameTimeUs = 0;          // Time the last complete RC frame was received
+static bool rxFrameTimeValid = false;       // Set when a new frame is waiting to be processed
+static volatile bool rxFrameSignaled = false;   // Set by the RX driver receive path when a frame is complete
+static timeUs_t rxFramePollUntilUs = 0;
+static timeUs_t rxNextFramePollAtUs = 0;
 static timeUs_t needRxSignalBefore = 0;
 static bool isRxSuspended = false;
 
@@ -98,7 +109,7 @@ rxLinkStatistics_t rxLinkStatistics;
 rxRuntimeConfig_t rxRuntimeConfig;
 static uint8_t rcSampleIndex = 0;
 
-PG_REGISTER_WITH_RESET_TEMPLATE(rxConfig_t, rxConfig, PG_RX_CONFIG, 12);
+PG_REGISTER_WITH_RESET_TEMPLATE(rxConfig_t, rxConfig, PG_RX_CONFIG, 13);
 
 #ifndef SERIALRX_PROVIDER
 #define SERIALRX_PROVIDER 0
@@ -129,6 +140,7 @@ PG_RESET_TEMPLATE(rxConfig_t, rxConfig,
     .rcFilterFrequency = SETTING_RC_FILTER_LPF_HZ_DEFAULT,
     .autoSmooth = SETTING_RC_FILTER_AUTO_DEFAULT,
     .autoSmoothFactor = SETTING_RC_FILTER_SMOOTHING_FACTOR_DEFAULT,
+    .rcFilterMode = SETTING_RC_FILTER_MODE_DEFAULT,
 #if defined(USE_RX_MSP) && defined(USE_MSP_RC_OVERRIDE)
     .mspOverrideChannels = SETTING_MSP_OVERRIDE_CHANNELS_DEFAULT,
 #endif
@@ -261,6 +273,8 @@ void rxInit(void)
     rxRuntimeConfig.lqTracker = &rxLQTracker;
     rxRuntimeConfig.rcReadRawFn = nullReadRawRC;
     rxRuntimeConfig.rcFrameStatusFn = nullFrameStatus;
+    rxRuntimeConfig.rcFrameTimeUsFn = NULL;
+    rxRuntimeConfig.rcFrameSignalEnabled = false;
     rxRuntimeConfig.rxSignalTimeout = DELAY_10_HZ;
     rcSampleIndex = 0;
 
@@ -300,6 +314,7 @@ void rxInit(void)
                 rxConfigMutable()->receiverType = RX_TYPE_NONE;
                 rxRuntimeConfig.rcReadRawFn = nullReadRawRC;
                 rxRuntimeConfig.rcFrameStatusFn = nullFrameStatus;
+                rxRuntimeConfig.rcFrameSignalEnabled = false;
             }
             break;
 #endif
@@ -365,6 +380,11 @@ void rxUpdateRSSISource(void)
     }
 }
 
+timeUs_t rxGetFrameTimeUs(void)
+{
+    return rxFrameTimeUs;
+}
+
 uint8_t calculateChannelRemapping(const uint8_t *channelMap, uint8_t channelMapEntryCount, uint8_t channelToRemap)
 {
     if (channelToRemap < channelMapEntryCount) {
@@ -395,6 +415,28 @@ void resumeRxSignal(void)
     failsafeOnRxResume();
 }
 
+void rxSignalFrameComplete(void)
+{
+    rxFrameSignaled = true;
+}
+
+static bool rxFrameStatusPollRequired(timeUs_t currentTimeUs)
+{
+    if (!rxRuntimeConfig.rcFrameSignalEnabled) {
+        return true;
+    }
+
+    if (rxFrameSignaled) {
+        rxFrameSignaled = false;
+        rxFramePollUntilUs = currentTimeUs + RX_FRAME_SIGNAL_POLL_WINDOW_US;
+    } else if (cmpTimeUs(currentTimeUs, rxFramePollUntilUs) >= 0 && cmpTimeUs(currentTimeUs, rxNextFramePollAtUs) < 0) {
+        return false;
+    }
+
+    rxNextFramePollAtUs = currentTimeUs + RX_FRAME_POLL_INTERVAL_US;
+    return true;
+}
+
 bool rxUpdateCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTime)
 {
     UNUSED(currentDeltaTime);
@@ -405,13 +447,23 @@ bool rxUpdateCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTime)
         }
     }
 
-    const uint8_t frameStatus = rxRuntimeConfig.rcFrameStatusFn(&rxRuntimeConfig);
+    const uint8_t frameStatus = rxFrameStatusPollRequired(currentTimeUs) ? rxRuntimeConfig.rcFrameStatusFn(&rxRuntimeConfig) : RX_FRAME_PENDING;
 
     if (frameStatus & RX_FRAME_COMPLETE) {
         // RX_FRAME_COMPLETE updated the failsafe status regardless
         rxSignalReceived = (frameStatus & RX_FRAME_FAILSAFE) == 0;
         needRxSignalBefore = currentTimeUs + rxRuntimeConfig.rxSignalTimeout;
         rxDataProcessingRequired = true;
+
+        rxFrameTimeUs = currentTimeUs;
+        if (rxRuntimeConfig.rcFrameTimeUsFn) {
+            const timeUs_t frameTimeUs = rxRuntimeConfig.rcFrameTimeUsFn(&rxRuntimeConfig);
+            // Driver timestamp is taken in ISR context, guard against a frame completing after we sampled the time
+            if (cmpTimeUs(currentTimeUs, frameTimeUs) >= 0) {
+                rxFrameTimeUs = frameTimeUs;
+            }
+        }
+        rxFrameTimeValid = true;
     }
     else if ((frameStatus & RX_FRAME_FAILSAFE) && rxSignalReceived) {
         // All other receiver statuses are allowed to report failsafe, but not allowed to leave it
@@ -462,6 +514,7 @@ bool calculateRxChannelsAndUpdateFailsafe(timeUs_t currentTimeUs)
 
     // If RX is suspended, do not process any data
     if (isRxSuspended) {
+        rxFrameTimeValid = false;
         return true;
     }
 
@@ -518,6 +571,11 @@ bool calculateRxChannelsAndUpdateFailsafe(timeUs_t currentTimeUs)
         failsafeOnValidDataFailed();
     }
 
+    if (rxFrameTimeValid) {
+        rcLatencyOnRxFrameProcessed(rxFrameTimeUs, micros());
+        rxFrameTimeValid = false;
+    }
+
     rcSampleIndex++;
     return true;
 }
@@ -102,6 +102,12 @@ extern const char rcChannelLetters[];
 #define RSSI_VISIBLE_VALUE_MAX 100
 #define RSSI_VISIBLE_FACTOR (RSSI_MAX_VALUE/(float)RSSI_VISIBLE_VALUE_MAX)
 
+typedef enum {
+    RC_FILTER_MODE_LPF = 0,
+    RC_FILTER_MODE_LINEAR,
+    RC_FILTER_MODE_QUADRATIC,
+} rcFilterMode_e;
+
 typedef struct rxChannelRangeConfig_s {
     uint16_t min;
     uint16_t max;
@@ -129,6 +135,7 @@ typedef struct rxConfig_s {
     uint8_t rcFilterFrequency;              // RC filter cutoff frequency (smoothness vs response sharpness)
     uint8_t autoSmooth;                     // auto smooth rx input (0 = off, 1 = on)
     uint8_t autoSmoothFactor;               // auto smooth rx input factor (1 = no smoothing, 100 = lots of smoothing)
+    uint8_t rcFilterMode;                   // RC interpolation mode (rcFilterMode_e): low pass filter or predictive extrapolation
     uint16_t mspOverrideChannels;           // Channels to override with MSP RC when BOXMSPRCOVERRIDE is active
     uint8_t rssi_source;
 #ifdef USE_SERIALRX_SRXL2
@@ -156,6 +163,7 @@ typedef uint16_t (*rcReadRawDataFnPtr)(const rxRuntimeConfig_t *rxRuntimeConfig,
 typedef uint8_t (*rcFrameStatusFnPtr)(rxRuntimeConfig_t *rxRuntimeConfig);
 typedef bool (*rcProcessFrameFnPtr)(const rxRuntimeConfig_t *rxRuntimeConfig);
 typedef uint16_t (*rcGetLinkQualityPtr)(const rxRuntimeConfig_t *rxRuntimeConfig);
+typedef timeUs_t (*rcFrameTimeUsFnPtr)(const rxRuntimeConfig_t *rxRuntimeConfig); // time when the last complete frame was received
 
 typedef struct rxRuntimeConfig_s {
     uint8_t channelCount;                  // number of rc channels as reported by current input driver
@@ -163,6 +171,8 @@ typedef struct rxRuntimeConfig_s {
     rcReadRawDataFnPtr rcReadRawFn;
     rcFrameStatusFnPtr rcFrameStatusFn;
     rcProcessFrameFnPtr rcProcessFrameFn;
+    rcFrameTimeUsFnPtr rcFrameTimeUsFn;     // Optional, if not set frame time is the time the frame was picked up by the RX task
+    bool rcFrameSignalEnabled;              // Driver calls rxSignalFrameComplete() from its receive path, rcFrameStatusFn is polled mostly on demand
     rxLinkQualityTracker_e * lqTracker;     // Pointer to a
     uint16_t *channelData;
     void *frameData;
@@ -211,6 +221,8 @@ bool rxIsReceivingSignal(void);
 bool rxAreFlightChannelsValid(void);
 bool calculateRxChannelsAndUpdateFailsafe(timeUs_t currentTimeUs);
 bool isRxPulseValid(uint16_t pulseDuration);
+timeUs_t rxGetFrameTimeUs(void);
+void rxSignalFrameComplete(void);
 
 uint8_t calculateChannelRemapping(const uint8_t *channelMap, uint8_t channelMapEntryCount, uint8_t channelToRemap);
 void parseRcChannels(const char *input);
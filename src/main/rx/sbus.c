@@ -64,6 +64,7 @@ typedef struct sbusFrameData_s {
     uint8_t buffer[SBUS_FRAME_SIZE];
     uint8_t position;
     timeUs_t lastActivityTimeUs;
+    volatile timeUs_t frameEndTimeUs;
 } sbusFrameData_t;
 
 // Receive ISR callback
@@ -115,7 +116,9 @@ static void sbusDataReceive(uint16_t c, void *data)
                 if (!sbusFrameData->frameDone && frameValid) {
 
                     memcpy((void *)&sbusFrameData->frame, (void *)&sbusFrameData->buffer[0], SBUS_FRAME_SIZE);
+                    sbusFrameData->frameEndTimeUs = currentTimeUs;
                     sbusFrameData->frameDone = true;
+                    rxSignalFrameComplete();
                 }
             }
             break;
@@ -149,6 +152,12 @@ static uint8_t sbusFrameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
     return retValue;
 }
 
+static timeUs_t sbusFrameTimeUs(const rxRuntimeConfig_t *rxRuntimeConfig)
+{
+    const sbusFrameData_t *sbusFrameData = rxRuntimeConfig->frameData;
+    return sbusFrameData->frameEndTimeUs;
+}
+
 static bool sbusInitEx(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, uint32_t sbusBaudRate)
 {
     static uint16_t sbusChannelData[SBUS_MAX_CHANNEL];
@@ -162,6 +171,8 @@ static bool sbusInitEx(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeC
     rxRuntimeConfig->channelCount = SBUS_MAX_CHANNEL;
 
     rxRuntimeConfig->rcFrameStatusFn = sbusFrameStatus;
+    rxRuntimeConfig->rcFrameTimeUsFn = sbusFrameTimeUs;
+    rxRuntimeConfig->rcFrameSignalEnabled = true;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
     if (!portConfig) {
@@ -95,6 +95,7 @@ static uint32_t fullTimeoutTimestamp = 0;
 static uint32_t lastValidPacketTimestamp = 0;
 static volatile uint32_t lastReceiveTimestamp = 0;
 static volatile uint32_t lastIdleTimestamp = 0;
+static timeUs_t lastFrameEndTimeUs = 0;
 
 struct rxBuf readBuffer[2];
 struct rxBuf* readBufferPtr = &readBuffer[0];
@@ -299,6 +300,11 @@ static void srxl2DataReceive(uint16_t character, void *data)
     else {
         readBufferPtr->packet.raw[readBufferIdx] = character;
         readBufferIdx++;
+
+        // Packet is complete once the length from the header is reached, it is picked up on line idle
+        if (readBufferIdx >= sizeof(Srxl2Header) && readBufferIdx == readBufferPtr->packet.header.length) {
+            rxSignalFrameComplete();
+        }
     }
 }
 
@@ -311,7 +317,10 @@ static void srxl2Idle(void)
         readBufferPtr->len = 0;
     }
     else {
-        lastIdleTimestamp = microsISR();
+        const timeUs_t currentTimeUs = microsISR();
+        lastIdleTimestamp = currentTimeUs;
+        // Idle is detected when polled, the frame actually ended with the last received byte
+        lastFrameEndTimeUs = lastReceiveTimestamp;
         //Swap read and process buffer pointers
         if(processBufferPtr == &readBuffer[0]) {
             processBufferPtr = &readBuffer[1];
@@ -458,6 +467,12 @@ static bool srxl2ProcessFrame(const rxRuntimeConfig_t *rxRuntimeConfig)
     return true;
 }
 
+static timeUs_t srxl2FrameTimeUs(const rxRuntimeConfig_t *rxRuntimeConfig)
+{
+    UNUSED(rxRuntimeConfig);
+    return lastFrameEndTimeUs;
+}
+
 static uint16_t srxl2ReadRawRC(const rxRuntimeConfig_t *rxRuntimeConfig, uint8_t channelIdx)
 {
     if (channelIdx >= rxRuntimeConfig->channelCount) {
@@ -493,6 +508,8 @@ bool srxl2RxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig)
     rxRuntimeConfig->rcReadRawFn = srxl2ReadRawRC;
     rxRuntimeConfig->rcFrameStatusFn = srxl2FrameStatus;
     rxRuntimeConfig->rcProcessFrameFn = srxl2ProcessFrame;
+    rxRuntimeConfig->rcFrameTimeUsFn = srxl2FrameTimeUs;
+    rxRuntimeConfig->rcFrameSignalEnabled = true;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
     if (!portConfig) {
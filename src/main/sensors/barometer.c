@@ -54,7 +54,12 @@
 #include "hardware_revision.h"
 #endif
 
+#ifdef USE_BARO
+static sensorSample_t baroSamples[SENSOR_SAMPLE_RING_DEPTH];
+baro_t baro = { .samples = SENSOR_SAMPLE_RING_INITIALIZER(baroSamples) };   // barometer access functions
+#else
 baro_t baro;                        // barometer access functions
+#endif
 
 #ifdef USE_BARO
 
@@ -246,13 +251,42 @@ bool baroInit(void)
 }
 
 typedef enum {
-    BAROMETER_NEEDS_SAMPLES = 0,
-    BAROMETER_NEEDS_CALCULATION
+    BAROMETER_NEEDS_SAMPLES = 0,        // Temperature conversion running
+    BAROMETER_NEEDS_CALCULATION         // Pressure conversion running
 } barometerState_e;
 
+#define BARO_TEMPERATURE_STABLE_CDEG    10      // Temperature is considered stable if it moved by less than 0.1 degC
+#define BARO_TEMPERATURE_MAX_SKIPS      4       // Even if stable, read temperature at least every 5th pressure sample
+
+/*
+ * Median of the last 3 pressure samples. Rejects single sample glitches (bus errors, ESD) before they
+ * reach the altitude conversion while delaying steps by one sample only.
+ */
+static int32_t baroFilterPressure(int32_t pressure)
+{
+    static int32_t history[3];
+    static uint8_t historyCount = 0;
+    static uint8_t historyIndex = 0;
+
+    history[historyIndex] = pressure;
+    historyIndex = (historyIndex + 1) % ARRAYLEN(history);
+
+    if (historyCount < ARRAYLEN(history)) {
+        historyCount++;
+        return pressure;
+    }
+
+    int32_t window[3] = { history[0], history[1], history[2] };
+    return quickMedianFilter3(window);
+}
+
 uint32_t baroUpdate(void)
 {
     static barometerState_e state = BAROMETER_NEEDS_SAMPLES;
+    static bool temperatureUpdated = false;
+    static bool temperatureStable = false;
+    static uint8_t temperatureSkips = 0;
+    static int32_t lastTemperature = 0;
 
 #ifdef USE_SIMULATOR
     if (ARMING_FLAG(SIMULATOR_MODE_HITL)) {
@@ -269,25 +303,67 @@ uint32_t baroUpdate(void)
             if (baro.dev.start_up) {
                 baro.dev.start_up(&baro.dev);
             }
+            temperatureUpdated = true;
             state = BAROMETER_NEEDS_CALCULATION;
             return baro.dev.up_delay;
         break;
 
         case BAROMETER_NEEDS_CALCULATION:
+        {
+            uint32_t nextDelay;
+            int32_t pressure;
+
             if (baro.dev.get_up) {
                 baro.dev.get_up(&baro.dev);
             }
-            if (baro.dev.start_ut) {
-                baro.dev.start_ut(&baro.dev);
+
+            /*
+             * Sensors with a separate temperature conversion spend half of their time measuring temperature.
+             * Temperature changes slowly, so while it is stable go straight to the next pressure conversion.
+             */
+            if (baro.dev.ut_delay > 0 && temperatureStable && temperatureSkips < BARO_TEMPERATURE_MAX_SKIPS) {
+                if (baro.dev.start_up) {
+                    baro.dev.start_up(&baro.dev);
+                }
+                temperatureSkips++;
+                nextDelay = baro.dev.up_delay;
+            }
+            else {
+                if (baro.dev.start_ut) {
+                    baro.dev.start_ut(&baro.dev);
+                }
+                temperatureSkips = 0;
+                state = BAROMETER_NEEDS_SAMPLES;
+                nextDelay = baro.dev.ut_delay;
             }
+
             //output: baro.baroPressure, baro.baroTemperature
-            baro.dev.calculate(&baro.dev, &baro.baroPressure, &baro.baroTemperature);
-            state = BAROMETER_NEEDS_SAMPLES;
-            return baro.dev.ut_delay;
+            baro.dev.calculate(&baro.dev, &pressure, &baro.baroTemperature);
+            baro.baroPressure = baroFilterPressure(pressure);
+            baroPublishSample(micros());
+
+            if (temperatureUpdated) {
+                temperatureStable = ABS(baro.baroTemperature - lastTemperature) < BARO_TEMPERATURE_STABLE_CDEG;
+                lastTemperature = baro.baroTemperature;
+                temperatureUpdated = false;
+            }
+
+            return nextDelay;
+        }
         break;
     }
 }
 
+void baroPublishSample(timeUs_t sampleTimeUs)
+{
+    const float values[] = {
+        [BARO_SAMPLE_PRESSURE] = baro.baroPressure,
+        [BARO_SAMPLE_TEMPERATURE] = baro.baroTemperature,
+    };
+
+    sensorSampleRingPush(&baro.samples, sampleTimeUs, values, ARRAYLEN(values));
+}
+
 static float pressureToAltitude(const float pressure)
 {
     return (1.0f - powf(pressure / 101325.0f, 0.190295f)) * 4433000.0f;
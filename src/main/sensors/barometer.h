@@ -21,6 +21,8 @@
 
 #include "drivers/barometer/barometer.h"
 
+#include "sensors/sample_ring.h"
+
 typedef enum {
     BARO_NONE = 0,
     BARO_AUTODETECT = 1,
@@ -43,8 +45,14 @@ typedef struct baro_s {
     int32_t BaroAlt;
     int32_t baroTemperature;            // Use temperature for telemetry
     int32_t baroPressure;               // Use pressure for telemetry
+    sensorSampleRing_t samples;         // Pressure [Pa] and temperature [cdeg] history
 } baro_t;
 
+typedef enum {
+    BARO_SAMPLE_PRESSURE = 0,
+    BARO_SAMPLE_TEMPERATURE,
+} baroSampleValue_e;
+
 extern baro_t baro;
 
 #ifdef USE_BARO
@@ -61,6 +69,7 @@ bool baroInit(void);
 bool baroIsCalibrationComplete(void);
 void baroStartCalibration(void);
 uint32_t baroUpdate(void);
+void baroPublishSample(timeUs_t sampleTimeUs);
 int32_t baroCalculateAltitude(void);
 int32_t baroGetLatestAltitude(void);
 int16_t baroGetTemperature(void);
@@ -60,11 +60,16 @@
 #include "sensors/gyro.h"
 #include "sensors/sensors.h"
 
+#ifdef USE_MAG
+static sensorSample_t magSamples[SENSOR_SAMPLE_RING_DEPTH];
+mag_t mag = { .samples = SENSOR_SAMPLE_RING_INITIALIZER(magSamples) };     // mag access functions
+#else
 mag_t mag;                   // mag access functions
+#endif
 
 #ifdef USE_MAG
 
-PG_REGISTER_WITH_RESET_TEMPLATE(compassConfig_t, compassConfig, PG_COMPASS_CONFIG, 6);
+PG_REGISTER_WITH_RESET_TEMPLATE(compassConfig_t, compassConfig, PG_COMPASS_CONFIG, 7);
 
 PG_RESET_TEMPLATE(compassConfig_t, compassConfig,
     .mag_align = SETTING_ALIGN_MAG_DEFAULT,
@@ -74,14 +79,37 @@ PG_RESET_TEMPLATE(compassConfig_t, compassConfig,
     .mag_to_use = SETTING_MAG_TO_USE_DEFAULT,
 #endif
     .magCalibrationTimeLimit = SETTING_MAG_CALIBRATION_TIME_DEFAULT,
+    .magInflightCalibration = SETTING_MAG_INFLIGHT_CALIBRATION_DEFAULT,
     .rollDeciDegrees = SETTING_ALIGN_MAG_ROLL_DEFAULT,
     .pitchDeciDegrees = SETTING_ALIGN_MAG_PITCH_DEFAULT,
     .yawDeciDegrees = SETTING_ALIGN_MAG_YAW_DEFAULT,
     .magGain = {SETTING_MAGGAIN_X_DEFAULT, SETTING_MAGGAIN_Y_DEFAULT, SETTING_MAGGAIN_Z_DEFAULT},
+    .magSoftIron = {SETTING_MAGSOFTIRON_XY_DEFAULT, SETTING_MAGSOFTIRON_XZ_DEFAULT, SETTING_MAGSOFTIRON_YZ_DEFAULT},
 );
 
+#define MAG_CAL_MIN_SAMPLES_PER_BIN         3       // Samples needed in every direction bin to consider the sphere covered
+#define MAG_CAL_TIMEOUT_MIN_COVERAGE        18      // Covered bins needed to use the ellipsoid fit when the time limit expires
+#define MAG_CAL_MAX_GAIN_RATIO              2.0f    // Larger gain spread between axes is a bad fit rather than soft iron
+#define MAG_CAL_SOFT_IRON_SCALE             10000
+#define MAG_BACKGROUND_CAL_INTERVAL_US      100000  // Background refinement takes at most one sample per interval
+
+static const uint8_t magSoftIronAxes[XYZ_AXIS_COUNT][2] = { { X, Y }, { X, Z }, { Y, Z } };
+
 static bool magUpdatedAtLeastOnce = false;
 
+// Shared by the ground calibration and the background refinement, they never run together
+static sensorEllipsoidCalibrationState_t magEllipsoidCalState;
+
+typedef struct magCalibration_s {
+    int16_t zero[XYZ_AXIS_COUNT];
+    int16_t gain[XYZ_AXIS_COUNT];
+    int16_t softIron[XYZ_AXIS_COUNT];
+} magCalibration_t;
+
+// Background refinement result, used instead of compassConfig() until the next ground calibration or reboot
+static magCalibration_t magBackgroundCal;
+static bool magBackgroundCalValid = false;
+
 bool compassDetect(magDev_t *dev, magSensor_e magHardwareToUse)
 {
     magSensor_e magHardware = MAG_NONE;
@@ -354,6 +382,152 @@ bool compassIsCalibrationComplete(void)
     }
 }
 
+// sqrtf(diffMag / avgMag) is a rough approximation of tangent of angle between magADC and magPrev. tan(8 deg) = 0.14
+static bool compassSampleMovedEnough(const float sample[XYZ_AXIS_COUNT], const int16_t prev[XYZ_AXIS_COUNT])
+{
+    float diffMag = 0;
+    float avgMag = 0;
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        diffMag += (sample[axis] - prev[axis]) * (sample[axis] - prev[axis]);
+        avgMag += (sample[axis] + prev[axis]) * (sample[axis] + prev[axis]) / 4.0f;
+    }
+
+    return (avgMag > 0.01f) && ((diffMag / avgMag) > (0.14f * 0.14f));
+}
+
+/*
+ * Convert the ellipsoid fit into zero, per axis gain and normalised off-diagonal soft iron terms.
+ * Gains keep their meaning (axis value giving 1024 after correction), so a fit without cross
+ * coupling is identical to the classic calibration.
+ */
+static bool compassConvertEllipsoidCalibration(const sensorEllipsoidCalibration_t *cal, magCalibration_t *result)
+{
+    int16_t zero[XYZ_AXIS_COUNT];
+    int16_t gain[XYZ_AXIS_COUNT];
+    int16_t softIron[XYZ_AXIS_COUNT];
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        const float gainf = 1.0f / cal->softIron[axis][axis];
+        if (!(gainf >= 1.0f && gainf <= INT16_MAX) || fabsf(cal->offset[axis]) > INT16_MAX) {
+            return false;
+        }
+
+        zero[axis] = lrintf(cal->offset[axis]);
+        gain[axis] = lrintf(gainf);
+    }
+
+    const int16_t minGain = MIN(gain[X], MIN(gain[Y], gain[Z]));
+    const int16_t maxGain = MAX(gain[X], MAX(gain[Y], gain[Z]));
+    if (maxGain > minGain * MAG_CAL_MAX_GAIN_RATIO) {
+        return false;
+    }
+
+    for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
+        const int a = magSoftIronAxes[i][0];
+        const int b = magSoftIronAxes[i][1];
+        const float k = cal->softIron[a][b] / sqrtf(cal->softIron[a][a] * cal->softIron[b][b]);
+        if (!(fabsf(k) < 1.0f)) {
+            return false;
+        }
+
+        softIron[i] = lrintf(k * MAG_CAL_SOFT_IRON_SCALE);
+    }
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        result->zero[axis] = zero[axis];
+        result->gain[axis] = gain[axis];
+        result->softIron[axis] = softIron[axis];
+    }
+
+    return true;
+}
+
+static bool compassSolveEllipsoidCalibration(int minCoveredBins, magCalibration_t *result)
+{
+    sensorEllipsoidCalibration_t cal;
+
+    return sensorEllipsoidCalibrationCoverage(&magEllipsoidCalState, MAG_CAL_MIN_SAMPLES_PER_BIN) >= minCoveredBins &&
+           sensorEllipsoidCalibrationSolve(&magEllipsoidCalState, &cal) &&
+           compassConvertEllipsoidCalibration(&cal, result);
+}
+
+// Ground calibration only, the result gets saved right after
+static bool compassSolveAndStoreEllipsoidCalibration(int minCoveredBins)
+{
+    magCalibration_t result;
+
+    if (!compassSolveEllipsoidCalibration(minCoveredBins, &result)) {
+        return false;
+    }
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        compassConfigMutable()->magZero.raw[axis] = result.zero[axis];
+        compassConfigMutable()->magGain[axis] = result.gain[axis];
+        compassConfigMutable()->magSoftIron[axis] = result.softIron[axis];
+    }
+
+    return true;
+}
+
+static void compassUpdateBackgroundCalibration(timeUs_t currentTimeUs)
+{
+    static timeUs_t lastSampleAt = 0;
+    static int16_t magPrev[XYZ_AXIS_COUNT];
+
+    if (!compassConfig()->magInflightCalibration || !ARMING_FLAG(ARMED)) {
+        magEllipsoidCalState.sampleCount = 0;
+        return;
+    }
+
+    if (magEllipsoidCalState.sampleCount == 0) {
+        sensorEllipsoidCalibrationReset(&magEllipsoidCalState, 1.0f);
+    }
+
+    if (cmpTimeUs(currentTimeUs, lastSampleAt) < MAG_BACKGROUND_CAL_INTERVAL_US || !compassSampleMovedEnough(mag.magADC, magPrev)) {
+        return;
+    }
+
+    lastSampleAt = currentTimeUs;
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        magPrev[axis] = mag.magADC[axis];
+    }
+
+    sensorEllipsoidCalibrationPushSample(&magEllipsoidCalState, mag.magADC);
+
+    // Once every orientation was flown, replace the running calibration and start over. The stored one is left alone.
+    if (sensorEllipsoidCalibrationCoverage(&magEllipsoidCalState, MAG_CAL_MIN_SAMPLES_PER_BIN) == SENSOR_ELLIPSOID_COVERAGE_BINS) {
+        if (compassSolveEllipsoidCalibration(SENSOR_ELLIPSOID_COVERAGE_BINS, &magBackgroundCal)) {
+            magBackgroundCalValid = true;
+        }
+        magEllipsoidCalState.sampleCount = 0;
+    }
+}
+
+static void compassApplyCalibration(void)
+{
+    const int16_t *zero = magBackgroundCalValid ? magBackgroundCal.zero : compassConfig()->magZero.raw;
+    const int16_t *gain = magBackgroundCalValid ? magBackgroundCal.gain : compassConfig()->magGain;
+    const int16_t *softIron = magBackgroundCalValid ? magBackgroundCal.softIron : compassConfig()->magSoftIron;
+    float v[XYZ_AXIS_COUNT];
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        v[axis] = mag.magADC[axis] - zero[axis];
+        mag.magADC[axis] = v[axis] * 1024 / gain[axis];
+    }
+
+    if ((softIron[0] || softIron[1] || softIron[2]) && gain[X] > 0 && gain[Y] > 0 && gain[Z] > 0) {
+        for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
+            const int a = magSoftIronAxes[i][0];
+            const int b = magSoftIronAxes[i][1];
+            const float k = softIron[i] * (1024.0f / MAG_CAL_SOFT_IRON_SCALE) / sqrtf((float)gain[a] * gain[b]);
+
+            mag.magADC[a] += k * v[b];
+            mag.magADC[b] += k * v[a];
+        }
+    }
+}
+
 void compassUpdate(timeUs_t currentTimeUs)
 {
 #ifdef USE_SIMULATOR
@@ -399,6 +573,7 @@ void compassUpdate(timeUs_t currentTimeUs)
         for (int axis = 0; axis < 3; axis++) {
             compassConfigMutable()->magZero.raw[axis] = 0;
             compassConfigMutable()->magGain[axis] = 1024;
+            compassConfigMutable()->magSoftIron[axis] = 0;
             magPrev[axis] = 0;
             magAxisDeviation[axis] = 0;  // Gain is based on the biggest absolute deviation from the mag zero point. Gain computation starts at 0
         }
@@ -406,36 +581,37 @@ void compassUpdate(timeUs_t currentTimeUs)
         beeper(BEEPER_ACTION_SUCCESS);
 
         sensorCalibrationResetState(&calState);
+        sensorEllipsoidCalibrationReset(&magEllipsoidCalState, 1.0f);
+        magBackgroundCalValid = false;
         DISABLE_STATE(CALIBRATE_MAG);
     }
 
     if (calStartedAt != 0) {
+        bool calibrationDone = false;
+
         if ((currentTimeUs - calStartedAt) < (compassConfig()->magCalibrationTimeLimit * 1000000)) {
             LED0_TOGGLE;
 
-            float diffMag = 0;
-            float avgMag = 0;
-
             for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-                diffMag += (mag.magADC[axis] - magPrev[axis]) * (mag.magADC[axis] - magPrev[axis]);
-                avgMag += (mag.magADC[axis] + magPrev[axis]) * (mag.magADC[axis] + magPrev[axis]) / 4.0f;
-
                 // Find the biggest sample deviation together with sample' sign
                 if (ABS(mag.magADC[axis]) > ABS(magAxisDeviation[axis])) {
                     magAxisDeviation[axis] = mag.magADC[axis];
                 }
-
             }
 
-            // sqrtf(diffMag / avgMag) is a rough approximation of tangent of angle between magADC and magPrev. tan(8 deg) = 0.14
-            if ((avgMag > 0.01f) && ((diffMag / avgMag) > (0.14f * 0.14f))) {
+            if (compassSampleMovedEnough(mag.magADC, magPrev)) {
                 sensorCalibrationPushSampleForOffsetCalculation(&calState, mag.magADC);
+                sensorEllipsoidCalibrationPushSample(&magEllipsoidCalState, mag.magADC);
 
                 for (int axis = 0; axis < 3; axis++) {
                     magPrev[axis] = mag.magADC[axis];
                 }
+
+                // Done as soon as all orientations were seen, no need to wait for the time limit
+                calibrationDone = compassSolveAndStoreEllipsoidCalibration(SENSOR_ELLIPSOID_COVERAGE_BINS);
             }
-        } else {
+        } else if (!compassSolveAndStoreEllipsoidCalibration(MAG_CAL_TIMEOUT_MIN_COVERAGE)) {
+            // Not enough coverage for the ellipsoid, fall back to sphere offset and per axis gain
             float magZerof[3];
             sensorCalibrationSolveForOffset(&calState, magZerof);
 
@@ -452,14 +628,19 @@ void compassUpdate(timeUs_t currentTimeUs)
                 compassConfigMutable()->magGain[axis] = ABS(magAxisDeviation[axis] - compassConfig()->magZero.raw[axis]);
             }
 
+            calibrationDone = true;
+        } else {
+            calibrationDone = true;
+        }
+
+        if (calibrationDone) {
             calStartedAt = 0;
             saveConfigAndNotify();
         }
     }
     else {
-        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
-            mag.magADC[axis] = (mag.magADC[axis] - compassConfig()->magZero.raw[axis]) * 1024 / compassConfig()->magGain[axis];
-        }
+        compassUpdateBackgroundCalibration(currentTimeUs);
+        compassApplyCalibration();
     }
 
     if (mag.dev.magAlign.useExternal) {
@@ -483,7 +664,13 @@ void compassUpdate(timeUs_t currentTimeUs)
         applyBoardAlignment(mag.magADC);
     }
 
+    compassPublishSample(currentTimeUs);
     magUpdatedAtLeastOnce = true;
 }
 
+void compassPublishSample(timeUs_t sampleTimeUs)
+{
+    sensorSampleRingPush(&mag.samples, sampleTimeUs, mag.magADC, XYZ_AXIS_COUNT);
+}
+
 #endif
@@ -24,6 +24,7 @@
 
 #include "drivers/compass/compass.h"
 
+#include "sensors/sample_ring.h"
 #include "sensors/sensors.h"
 
 // Type of magnetometer used/detected
@@ -50,6 +51,7 @@ typedef enum {
 typedef struct mag_s {
     magDev_t dev;
     float magADC[XYZ_AXIS_COUNT];
+    sensorSampleRing_t samples;         // Calibrated and aligned magADC history
 } mag_t;
 
 extern mag_t mag;
@@ -63,10 +65,12 @@ typedef struct compassConfig_s {
     uint8_t mag_hardware;                   // Which mag hardware to use on boards with more than one device
     flightDynamicsTrims_t magZero;
     int16_t magGain[XYZ_AXIS_COUNT];
+    int16_t magSoftIron[XYZ_AXIS_COUNT];    // Off-diagonal soft iron terms XY, XZ, YZ (1/10000)
 #ifdef USE_DUAL_MAG
     uint8_t mag_to_use;
 #endif
     uint8_t magCalibrationTimeLimit;        // Time for compass calibration (seconds)
+    bool magInflightCalibration;            // Refine calibration in the background
     int16_t rollDeciDegrees;                // Alignment for external mag on the roll (X) axis (0.1deg)
     int16_t pitchDeciDegrees;               // Alignment for external mag on the pitch (Y) axis (0.1deg)
     int16_t yawDeciDegrees;                 // Alignment for external mag on the yaw (Z) axis (0.1deg)
@@ -77,6 +81,7 @@ PG_DECLARE(compassConfig_t, compassConfig);
 bool compassDetect(magDev_t *dev, magSensor_e magHardwareToUse);
 bool compassInit(void);
 void compassUpdate(timeUs_t currentTimeUs);
+void compassPublishSample(timeUs_t sampleTimeUs);
 bool compassIsReady(void);
 bool compassIsHealthy(void);
 bool compassIsCalibrationComplete(void);
@@ -63,7 +63,12 @@
 
 #include "build/debug.h"
 
+#ifdef USE_OPFLOW
+static sensorSample_t opflowSamples[SENSOR_SAMPLE_RING_DEPTH];
+opflow_t opflow = { .samples = SENSOR_SAMPLE_RING_INITIALIZER(opflowSamples) };
+#else
 opflow_t opflow;
+#endif
 
 #ifdef USE_OPFLOW
 static bool opflowIsCalibrating = false;
@@ -160,6 +165,18 @@ void opflowStartCalibration(void)
     opflowCalibrationFlowAcc = 0;
 }
 
+static void opflowPublishSample(timeUs_t sampleTimeUs)
+{
+    const float values[] = {
+        [OPFLOW_SAMPLE_FLOW_RATE_X] = opflow.flowRate[X],
+        [OPFLOW_SAMPLE_FLOW_RATE_Y] = opflow.flowRate[Y],
+        [OPFLOW_SAMPLE_BODY_RATE_X] = opflow.bodyRate[X],
+        [OPFLOW_SAMPLE_BODY_RATE_Y] = opflow.bodyRate[Y],
+    };
+
+    sensorSampleRingPush(&opflow.samples, sampleTimeUs, values, ARRAYLEN(values));
+}
+
 /*
  * This is called periodically by the scheduler
  */
@@ -196,6 +213,24 @@ void opflowUpdate(timeUs_t currentTimeUs)
         opflow.bodyRate[Y] = 0;
 
         // In the following code we operate deg/s and do conversion to rad/s in the last step
+        /*
+         * Gyro is integrated in the PID loop and may already be past the end of this flow frame.
+         * Move the part after the frame timestamp to the next frame so both cover the same timeframe.
+         */
+        const timeUs_t frameTimeUs = opflow.dev.rawData.timestamp ? opflow.dev.rawData.timestamp : currentTimeUs;
+        const timeDelta_t gyroExcessUs = cmpTimeUs(opflow.gyroLastUpdateUs, frameTimeUs);
+        float gyroCarryAcc[2] = { 0.0f, 0.0f };
+        timeUs_t gyroCarryTimeUs = 0;
+
+        if (gyroExcessUs > 0 && (timeUs_t)gyroExcessUs < opflow.gyroBodyRateTimeUs) {
+            for (int axis = 0; axis < 2; axis++) {
+                gyroCarryAcc[axis] = opflow.gyroLastRate[axis] * gyroExcessUs;
+                opflow.gyroBodyRateAcc[axis] -= gyroCarryAcc[axis];
+            }
+            gyroCarryTimeUs = gyroExcessUs;
+            opflow.gyroBodyRateTimeUs -= gyroExcessUs;
+        }
+
         // Calculate body rates
         if (opflow.gyroBodyRateTimeUs > 0) {
             opflow.bodyRate[X] = opflow.gyroBodyRateAcc[X] / opflow.gyroBodyRateTimeUs;
@@ -250,6 +285,11 @@ void opflowUpdate(timeUs_t currentTimeUs)
 
         // Zero out gyro accumulators to calculate rotation per flow update
         opflowZeroBodyGyroAcc();
+        opflow.gyroBodyRateAcc[X] = gyroCarryAcc[X];
+        opflow.gyroBodyRateAcc[Y] = gyroCarryAcc[Y];
+        opflow.gyroBodyRateTimeUs = gyroCarryTimeUs;
+
+        opflowPublishSample(currentTimeUs);
     }
     else {
         // No new data available
@@ -265,21 +305,34 @@ void opflowUpdate(timeUs_t currentTimeUs)
             opflow.bodyRate[Y] = 0;
 
             opflowZeroBodyGyroAcc();
+
+            // Let consumers see the sensor going invalid
+            opflowPublishSample(currentTimeUs);
         }
     }
 }
 
-/* Run a simple gyro update integrator to estimate average body rate between two optical flow updates */
-void opflowGyroUpdateCallback(timeUs_t gyroUpdateDeltaUs)
+/*
+ * Run a simple gyro update integrator to estimate average body rate between two optical flow updates.
+ * Called from the PID loop with filtered gyro, timestamps let opflowUpdate() cut the integral at the flow frame time.
+ */
+void opflowGyroUpdateCallback(timeUs_t currentTimeUs, timeDelta_t gyroUpdateDeltaUs)
 {
     if (!opflow.isHwHealty)
         return;
 
     for (int axis = 0; axis < 2; axis++) {
+        opflow.gyroLastRate[axis] = gyro.gyroADCf[axis];
         opflow.gyroBodyRateAcc[axis] += gyro.gyroADCf[axis] * gyroUpdateDeltaUs;
     }
 
     opflow.gyroBodyRateTimeUs += gyroUpdateDeltaUs;
+    opflow.gyroLastUpdateUs = currentTimeUs;
+}
+
+bool opflowHasPendingData(void)
+{
+    return opflow.dev.hasNewDataFn && opflow.dev.hasNewDataFn(&opflow.dev);
 }
 
 bool opflowIsHealthy(void)
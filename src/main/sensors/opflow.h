@@ -28,6 +28,8 @@
 #include "config/parameter_group.h"
 #include "drivers/opflow/opflow.h"
 
+#include "sensors/sample_ring.h"
+
 typedef enum {
     OPFLOW_NONE         = 0,
     OPFLOW_CXOF         = 1,
@@ -59,13 +61,25 @@ typedef struct opflow_s {
 
     float           gyroBodyRateAcc[2];
     timeUs_t        gyroBodyRateTimeUs;
+    timeUs_t        gyroLastUpdateUs;   // End of the gyro integration window
+    float           gyroLastRate[2];    // Rate used for the last integration step
 
     uint8_t         rawQuality;
+
+    sensorSampleRing_t samples;
 } opflow_t;
 
+typedef enum {
+    OPFLOW_SAMPLE_FLOW_RATE_X = 0,
+    OPFLOW_SAMPLE_FLOW_RATE_Y,
+    OPFLOW_SAMPLE_BODY_RATE_X,
+    OPFLOW_SAMPLE_BODY_RATE_Y,
+} opflowSampleValue_e;
+
 extern opflow_t opflow;
 
-void opflowGyroUpdateCallback(timeUs_t gyroUpdateDeltaUs);
+void opflowGyroUpdateCallback(timeUs_t currentTimeUs, timeDelta_t gyroUpdateDeltaUs);
+bool opflowHasPendingData(void);
 bool opflowInit(void);
 void opflowUpdate(timeUs_t currentTimeUs);
 bool opflowIsHealthy(void);
@@ -56,7 +56,8 @@
 
 extern baro_t baro;
 
-pitot_t pitot = {.lastMeasurementUs = 0, .lastSeenHealthyMs = 0};
+static sensorSample_t pitotSamples[SENSOR_SAMPLE_RING_DEPTH];
+pitot_t pitot = {.lastMeasurementUs = 0, .lastSeenHealthyMs = 0, .samples = SENSOR_SAMPLE_RING_INITIALIZER(pitotSamples)};
 
 PG_REGISTER_WITH_RESET_TEMPLATE(pitotmeterConfig_t, pitotmeterConfig, PG_PITOTMETER_CONFIG, 2);
 
@@ -285,6 +286,13 @@ STATIC_PROTOTHREAD(pitotThread)
             pitot.airSpeed = simulatorData.airSpeed;
         }
 #endif
+
+        const float values[] = {
+            [PITOT_SAMPLE_AIRSPEED] = pitot.airSpeed,
+            [PITOT_SAMPLE_PRESSURE] = pitot.pressure,
+            [PITOT_SAMPLE_TEMPERATURE] = pitot.temperature,
+        };
+        sensorSampleRingPush(&pitot.samples, micros(), values, ARRAYLEN(values));
     }
 
     ptEnd(0);
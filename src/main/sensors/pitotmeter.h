@@ -23,6 +23,8 @@
 
 #include "drivers/pitotmeter/pitotmeter.h"
 
+#include "sensors/sample_ring.h"
+
 typedef enum {
     PITOT_NONE = 0,
     PITOT_AUTODETECT = 1,
@@ -57,8 +59,16 @@ typedef struct pito_s {
     float pressureZero;
     float pressure;
     float temperature;
+
+    sensorSampleRing_t samples;
 } pitot_t;
 
+typedef enum {
+    PITOT_SAMPLE_AIRSPEED = 0,
+    PITOT_SAMPLE_PRESSURE,
+    PITOT_SAMPLE_TEMPERATURE,
+} pitotSampleValue_e;
+
 #ifdef USE_PITOT
 
 extern pitot_t pitot;
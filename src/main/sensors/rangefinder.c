@@ -56,7 +56,12 @@
 
 #include "scheduler/scheduler.h"
 
+#ifdef USE_RANGEFINDER
+static sensorSample_t rangefinderSamples[SENSOR_SAMPLE_RING_DEPTH];
+rangefinder_t rangefinder = { .samples = SENSOR_SAMPLE_RING_INITIALIZER(rangefinderSamples) };
+#else
 rangefinder_t rangefinder;
+#endif
 
 #define RANGEFINDER_HARDWARE_TIMEOUT_MS         500     // Accept 500ms of non-responsive sensor, report HW failure otherwise
 
@@ -281,6 +286,12 @@ bool rangefinderProcess(float cosTiltAngle)
         rangefinder.calculatedAltitude = rangefinder.rawAltitude * cosTiltAngle;
     }
 
+    const float values[] = {
+        [RANGEFINDER_SAMPLE_CALCULATED_ALTITUDE] = rangefinder.calculatedAltitude,
+        [RANGEFINDER_SAMPLE_RAW_ALTITUDE] = rangefinder.rawAltitude,
+    };
+    sensorSampleRingPush(&rangefinder.samples, micros(), values, ARRAYLEN(values));
+
     return true;
 }
 
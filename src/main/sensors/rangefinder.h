@@ -21,6 +21,8 @@
 #include "config/parameter_group.h"
 #include "drivers/rangefinder/rangefinder.h"
 
+#include "sensors/sample_ring.h"
+
 typedef enum {
     RANGEFINDER_NONE                = 0,
     RANGEFINDER_SRF10               = 1,
@@ -49,8 +51,14 @@ typedef struct rangefinder_s {
     int32_t rawAltitude;
     int32_t calculatedAltitude;
     timeMs_t lastValidResponseTimeMs;
+    sensorSampleRing_t samples;
 } rangefinder_t;
 
+typedef enum {
+    RANGEFINDER_SAMPLE_CALCULATED_ALTITUDE = 0,
+    RANGEFINDER_SAMPLE_RAW_ALTITUDE,
+} rangefinderSampleValue_e;
+
 extern rangefinder_t rangefinder;
 
 bool rangefinderInit(void);
@@ -0,0 +1,173 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+
+#include "common/maths.h"
+#include "common/utils.h"
+
+#include "sensors/sample_ring.h"
+
+// A reader may be interrupted by the producer at most this many times before giving up
+#define SENSOR_SAMPLE_RING_MAX_RETRIES  3
+
+void sensorSampleRingInit(sensorSampleRing_t * ring, sensorSample_t * samples, uint32_t depth)
+{
+    ring->samples = samples;
+    ring->depthMask = depth - 1;
+    sensorSampleRingReset(ring);
+}
+
+void sensorSampleRingReset(sensorSampleRing_t * ring)
+{
+    ring->writeCount = 0;
+    __sync_synchronize();
+}
+
+void sensorSampleRingPush(sensorSampleRing_t * ring, timeUs_t timeUs, const float * values, uint8_t count)
+{
+    const uint32_t writeCount = ring->writeCount;
+    sensorSample_t * slot = &ring->samples[writeCount & ring->depthMask];
+
+    count = MIN(count, SENSOR_SAMPLE_MAX_VALUES);
+    slot->timeUs = timeUs;
+    for (int i = 0; i < SENSOR_SAMPLE_MAX_VALUES; i++) {
+        slot->value[i] = (i < count) ? values[i] : 0.0f;
+    }
+
+    // Slot must be complete before readers can see it
+    __sync_synchronize();
+    ring->writeCount = writeCount + 1;
+}
+
+uint32_t sensorSampleRingCount(const sensorSampleRing_t * ring)
+{
+    return ring->writeCount;
+}
+
+bool sensorSampleRingHasNewSample(const sensorSampleRing_t * ring, uint32_t * lastSeenCount)
+{
+    const uint32_t writeCount = ring->writeCount;
+
+    if (writeCount == *lastSeenCount) {
+        return false;
+    }
+
+    *lastSeenCount = writeCount;
+    return true;
+}
+
+/*
+ * Copies sample number "index" and verifies the producer did not start overwriting its slot in the meantime.
+ * Producer writes slot (n & depthMask) while writeCount == n, so the copy is good as long as writeCount has
+ * not reached index + depth. This leaves depth - 1 samples of usable history.
+ */
+static bool sensorSampleRingCopy(const sensorSampleRing_t * ring, uint32_t index, sensorSample_t * sample)
+{
+    *sample = ring->samples[index & ring->depthMask];
+    __sync_synchronize();
+    return (ring->writeCount - index) <= ring->depthMask;
+}
+
+bool sensorSampleRingGetLatest(const sensorSampleRing_t * ring, sensorSample_t * sample)
+{
+    for (int retry = 0; retry < SENSOR_SAMPLE_RING_MAX_RETRIES; retry++) {
+        const uint32_t writeCount = ring->writeCount;
+        if (writeCount == 0) {
+            return false;
+        }
+
+        __sync_synchronize();
+        if (sensorSampleRingCopy(ring, writeCount - 1, sample)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Walks from newest to oldest looking for the newest sample taken at or before timeUs. On success "sample"
+ * holds it and "newer" (if given) the sample following it. hasNewer is false if the match is the newest one.
+ */
+static bool sensorSampleRingFind(const sensorSampleRing_t * ring, timeUs_t timeUs, sensorSample_t * sample, sensorSample_t * newer, bool * hasNewer)
+{
+    const uint32_t writeCount = ring->writeCount;
+    // Oldest slot is the one the producer writes next, it is never handed out
+    const uint32_t available = MIN(writeCount, ring->depthMask);
+
+    __sync_synchronize();
+
+    *hasNewer = false;
+    for (uint32_t age = 1; age <= available; age++) {
+        sensorSample_t candidate;
+
+        // If this slot got overwritten, everything older is gone as well
+        if (!sensorSampleRingCopy(ring, writeCount - age, &candidate)) {
+            return false;
+        }
+
+        if (cmpTimeUs(timeUs, candidate.timeUs) >= 0) {
+            *sample = candidate;
+            return true;
+        }
+
+        if (newer) {
+            *newer = candidate;
+        }
+        *hasNewer = true;
+    }
+
+    return false;
+}
+
+bool sensorSampleRingGetAt(const sensorSampleRing_t * ring, timeUs_t timeUs, sensorSample_t * sample)
+{
+    bool hasNewer;
+    return sensorSampleRingFind(ring, timeUs, sample, NULL, &hasNewer);
+}
+
+bool sensorSampleRingGetInterpolated(const sensorSampleRing_t * ring, timeUs_t timeUs, sensorSample_t * sample)
+{
+    sensorSample_t older;
+    sensorSample_t newer;
+    bool hasNewer;
+
+    if (!sensorSampleRingFind(ring, timeUs, &older, &newer, &hasNewer)) {
+        return false;
+    }
+
+    *sample = older;
+
+    // Past the newest sample the latest value is held, no extrapolation
+    if (hasNewer) {
+        const timeDelta_t span = cmpTimeUs(newer.timeUs, older.timeUs);
+        if (span > 0) {
+            const float k = (float)cmpTimeUs(timeUs, older.timeUs) / span;
+            for (int i = 0; i < SENSOR_SAMPLE_MAX_VALUES; i++) {
+                sample->value[i] = older.value[i] + (newer.value[i] - older.value[i]) * k;
+            }
+        }
+        sample->timeUs = timeUs;
+    }
+
+    return true;
+}
@@ -0,0 +1,61 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/time.h"
+#include "common/utils.h"
+
+// Ring size per slow sensor, must be a power of two. DEPTH - 1 samples are readable, targets short on RAM may override it.
+#ifndef SENSOR_SAMPLE_RING_DEPTH
+#define SENSOR_SAMPLE_RING_DEPTH    8
+#endif
+
+#define SENSOR_SAMPLE_MAX_VALUES    4
+
+typedef struct sensorSample_s {
+    timeUs_t timeUs;                            // Time the measurement was taken
+    float value[SENSOR_SAMPLE_MAX_VALUES];      // Sensor specific payload
+} sensorSample_t;
+
+/*
+ * Single producer ring of timestamped samples. The producer may run from an interrupt,
+ * readers never block it: they copy a slot and re-check the write counter afterwards,
+ * retrying if the slot was overwritten while it was being copied.
+ */
+typedef struct sensorSampleRing_s {
+    sensorSample_t * samples;
+    uint32_t depthMask;
+    volatile uint32_t writeCount;               // Total number of samples pushed, slot index is writeCount & depthMask
+} sensorSampleRing_t;
+
+// Static initializer so producers can push before (or without) the sensor being initialised
+#define SENSOR_SAMPLE_RING_INITIALIZER(storage) { .samples = (storage), .depthMask = ARRAYLEN(storage) - 1, .writeCount = 0 }
+
+void sensorSampleRingInit(sensorSampleRing_t * ring, sensorSample_t * samples, uint32_t depth);
+void sensorSampleRingReset(sensorSampleRing_t * ring);
+void sensorSampleRingPush(sensorSampleRing_t * ring, timeUs_t timeUs, const float * values, uint8_t count);
+
+uint32_t sensorSampleRingCount(const sensorSampleRing_t * ring);
+bool sensorSampleRingHasNewSample(const sensorSampleRing_t * ring, uint32_t * lastSeenCount);
+
+bool sensorSampleRingGetLatest(const sensorSampleRing_t * ring, sensorSample_t * sample);
+bool sensorSampleRingGetAt(const sensorSampleRing_t * ring, timeUs_t timeUs, sensorSample_t * sample);
+bool sensorSampleRingGetInterpolated(const sensorSampleRing_t * ring, timeUs_t timeUs, sensorSample_t * sample);
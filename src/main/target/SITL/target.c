@@ -199,6 +199,7 @@ void printCmdLineOptions(void)
     printVersion();
     fprintf(stderr, "Avaiable options:\n");
     fprintf(stderr, "--path=[path]                  Path and filename of eeprom.bin. If not specified 'eeprom.bin' in program directory is used.\n");
+    fprintf(stderr, "--eepromsync                   Wait for eeprom.bin to reach the disk on each save.\n");
     fprintf(stderr, "--sim=[rf|xp]                  Simulator interface: rf = RealFligt, xp = XPlane. Example: --sim=rf\n");
     fprintf(stderr, "--simip=[ip]                   IP-Address oft the simulator host. If not specified localhost (127.0.0.1) is used.\n");
     fprintf(stderr, "--simport=[port]               Port oft the simulator host.\n");
@@ -239,6 +240,7 @@ void parseArguments(int argc, char *argv[])
             {"stopbits", required_argument, 0, '3'},
             {"parity", required_argument, 0, '4'},
             {"fcproxy", no_argument, 0, '5'},
+            {"eepromsync", no_argument, 0, '6'},
             {NULL, 0, NULL, 0}
         };
 
@@ -324,6 +326,9 @@ void parseArguments(int argc, char *argv[])
             case '5':
                 serialFCProxy = true;
                 break;
+            case '6':
+                configFileSetSync(true);
+                break;
 
             default:
                 printCmdLineOptions();
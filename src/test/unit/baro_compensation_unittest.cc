@@ -0,0 +1,180 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <chrono>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "drivers/barometer/barometer_compensation.h"
+}
+
+#include "gtest/gtest.h"
+
+// Calibration data and raw values from the MS5611 datasheet
+static const uint16_t ms5611Prom[BARO_MS56XX_PROM_SIZE] = { 0x0000, 40127, 36924, 23317, 23282, 33464, 28312, 0x0000 };
+
+// Calibration data and raw values from the MS5607 datasheet
+static const uint16_t ms5607Prom[BARO_MS56XX_PROM_SIZE] = { 0x0000, 46372, 43981, 29059, 27842, 31553, 28165, 0x0000 };
+
+// Calibration data recorded from a BMP280
+static const baroBmp280Calibration_t bmp280Cal = {
+    .dig_T1 = 27504, .dig_T2 = 26435, .dig_T3 = -1000,
+    .dig_P1 = 36477, .dig_P2 = -10685, .dig_P3 = 3024, .dig_P4 = 2855, .dig_P5 = 140,
+    .dig_P6 = -7, .dig_P7 = 15500, .dig_P8 = -14600, .dig_P9 = 6000,
+};
+
+// Calibration data recorded from a DPS310
+static const baroDpsCalibration_t dpsCal = {
+    .c0 = 204, .c1 = -261, .c00 = 80469, .c10 = -54769,
+    .c01 = -2770, .c11 = 1202, .c20 = -11330, .c21 = 197, .c30 = -1500,
+};
+
+static void ms56xxCompensate(const uint16_t * prom, bool isMs5607, uint32_t ut, uint32_t up, int32_t * pressure, int32_t * temperature)
+{
+    baroMs56xxCompensation_t comp;
+    baroMs56xxCompensateTemperature(&comp, prom, isMs5607, ut);
+    *pressure = baroMs56xxCompensatePressure(&comp, up);
+    *temperature = comp.temperature;
+}
+
+TEST(BaroCompensationTest, TestMs5611)
+{
+    int32_t pressure, temperature;
+
+    ms56xxCompensate(ms5611Prom, false, 8569150, 9085466, &pressure, &temperature);
+    EXPECT_EQ(2007, temperature);   // 20.07 degC
+    EXPECT_EQ(100009, pressure);    // 1000.09 mbar
+
+    // Second order compensation below 20 degC
+    ms56xxCompensate(ms5611Prom, false, 8069150, 9085466, &pressure, &temperature);
+    EXPECT_EQ(205, temperature);
+    EXPECT_EQ(96512, pressure);
+
+    // Below -15 degC
+    ms56xxCompensate(ms5611Prom, false, 7369150, 9085466, &pressure, &temperature);
+    EXPECT_EQ(-2710, temperature);
+    EXPECT_EQ(90613, pressure);
+}
+
+TEST(BaroCompensationTest, TestMs5607)
+{
+    int32_t pressure, temperature;
+
+    ms56xxCompensate(ms5607Prom, true, 8077636, 6465444, &pressure, &temperature);
+    EXPECT_EQ(2000, temperature);   // 20.00 degC
+    EXPECT_EQ(110002, pressure);    // 1100.02 mbar
+}
+
+TEST(BaroCompensationTest, TestBmp280)
+{
+    baroBmp280Compensation_t comp;
+
+    baroBmp280CompensateTemperature(&comp, &bmp280Cal, 519888);
+    EXPECT_EQ(2508, comp.temperature);  // 25.08 degC
+    EXPECT_EQ(100653, baroBmp280CompensatePressure(&comp, 415148));
+    EXPECT_EQ(135382, baroBmp280CompensatePressure(&comp, 215148));
+
+    // P1 = 0 would divide by zero, reports 0 Pa instead
+    baroBmp280Calibration_t zeroP1 = bmp280Cal;
+    zeroP1.dig_P1 = 0;
+    baroBmp280CompensateTemperature(&comp, &zeroP1, 519888);
+    EXPECT_EQ(0, baroBmp280CompensatePressure(&comp, 415148));
+}
+
+// Floating point formula from the DPS310 datasheet, section 4.9
+static void dpsReference(int32_t rawPressure, int32_t rawTemperature, double scale, double * pressure, double * temperature)
+{
+    const double psc = rawPressure / scale;
+    const double tsc = rawTemperature / scale;
+
+    *pressure = dpsCal.c00 + psc * (dpsCal.c10 + psc * (dpsCal.c20 + psc * dpsCal.c30)) + tsc * dpsCal.c01 + tsc * psc * (dpsCal.c11 + psc * dpsCal.c21);
+    *temperature = (dpsCal.c0 * 0.5 + dpsCal.c1 * tsc) * 100;
+}
+
+TEST(BaroCompensationTest, TestDpsMatchesReference)
+{
+    static const struct {
+        uint8_t oversampling;
+        double scale;
+    } rates[] = {
+        { 1, 524288 }, { 2, 1572864 }, { 4, 3670016 }, { 8, 7864320 },
+        { 16, 253952 }, { 32, 516096 }, { 64, 1040384 }, { 128, 2088960 },
+    };
+
+    for (const auto & rate : rates) {
+        // Sweep -40..+85 degC and roughly 300..1100 hPa worth of raw values
+        for (double tsc = -0.2; tsc <= 0.9; tsc += 0.05) {
+            const int32_t rawTemperature = tsc * rate.scale;
+            baroDpsCompensation_t comp;
+            baroDpsCompensateTemperature(&comp, &dpsCal, rawTemperature, rate.oversampling);
+
+            for (double psc = -1.2; psc <= 0.4; psc += 0.01) {
+                const int32_t rawPressure = psc * rate.scale;
+                double refPressure, refTemperature;
+                dpsReference(rawPressure, rawTemperature, rate.scale, &refPressure, &refTemperature);
+
+                EXPECT_NEAR(refPressure, baroDpsCompensatePressure(&comp, rawPressure, rate.oversampling), 1.0) << "osr " << (int)rate.oversampling;
+                EXPECT_NEAR(refTemperature, comp.temperature, 1.0) << "osr " << (int)rate.oversampling;
+            }
+        }
+    }
+}
+
+TEST(BaroCompensationTest, TestPerSampleCost)
+{
+    const int samples = 1000000;
+    volatile int32_t sink = 0;
+
+    baroMs56xxCompensation_t ms56xx;
+    baroMs56xxCompensateTemperature(&ms56xx, ms5611Prom, false, 8569150);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < samples; i++) {
+        sink = sink + baroMs56xxCompensatePressure(&ms56xx, 9085466 + (i & 1023));
+    }
+    const double ms56xxNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / samples;
+
+    baroBmp280Compensation_t bmp280;
+    baroBmp280CompensateTemperature(&bmp280, &bmp280Cal, 519888);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < samples; i++) {
+        sink = sink + baroBmp280CompensatePressure(&bmp280, 415148 + (i & 1023));
+    }
+    const double bmp280Ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / samples;
+
+    baroDpsCompensation_t dps;
+    baroDpsCompensateTemperature(&dps, &dpsCal, 74900, 16);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < samples; i++) {
+        sink = sink + baroDpsCompensatePressure(&dps, -101580 + (i & 1023), 16);
+    }
+    const double dpsNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / samples;
+
+    // Temperature stage included, i.e. the cost without caching
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < samples; i++) {
+        baroDpsCompensateTemperature(&dps, &dpsCal, 74900 + (i & 1023), 16);
+        sink = sink + baroDpsCompensatePressure(&dps, -101580 + (i & 1023), 16);
+    }
+    const double dpsFullNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / samples;
+
+    // Informational only, not asserted
+    printf("MS56xx pressure: %.1f ns/sample\n", ms56xxNs);
+    printf("BMP280 pressure: %.1f ns/sample\n", bmp280Ns);
+    printf("DPS310 pressure: %.1f ns/sample, %.1f ns/sample with temperature\n", dpsNs, dpsFullNs);
+}
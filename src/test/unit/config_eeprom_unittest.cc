@@ -0,0 +1,349 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/crc.h"
+
+    #include "config/config_eeprom.h"
+    #include "config/parameter_group.h"
+    #include "config/parameter_group_ids.h"
+
+    #include "drivers/system.h"
+
+    #include "fc/config.h"
+
+    typedef struct testConfig_s {
+        uint32_t value;
+        uint8_t data[100];
+    } testConfig_t;
+
+    typedef struct testProfile_s {
+        uint16_t value;
+    } testProfile_t;
+
+    PG_DECLARE(testConfig_t, testConfig);
+    PG_REGISTER(testConfig_t, testConfig, PG_RESERVED_FOR_TESTING_1, 0);
+
+    PG_DECLARE_PROFILE(testProfile_t, testProfile);
+    PG_REGISTER_PROFILE(testProfile_t, testProfile, PG_RESERVED_FOR_TESTING_2, 0);
+
+    extern testProfile_t testProfile_Storage[MAX_PROFILE_COUNT];
+
+    int failureModeCalls;
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+// Records are 8 bytes followed by the PG, the commit record closing
+// each save is padded to the 4 byte RAM streamer buffer.
+#define RECORD_SIZE(pg) (8 + sizeof(pg))
+#define LIVE_SIZE (1 + RECORD_SIZE(testConfig_t) + MAX_PROFILE_COUNT * RECORD_SIZE(testProfile_t))
+
+class ConfigEepromTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        memset(eepromData, 0, sizeof(eepromData));
+        pgResetAll(MAX_PROFILE_COUNT);
+        failureModeCalls = 0;
+    }
+
+    void TearDown() override
+    {
+        EXPECT_EQ(0, failureModeCalls);
+    }
+
+    // Bytes up to the last programmed one. The RAM backend erases to 0xFF.
+    static size_t usedSize(void)
+    {
+        size_t size = sizeof(eepromData);
+        while (size > 0 && eepromData[size - 1] == 0xFF) {
+            size--;
+        }
+        return size;
+    }
+
+    // Clobbers the PGs and loads them back from the saved config
+    static bool reload(void)
+    {
+        memset(testConfigMutable(), 0xAA, sizeof(testConfig_t));
+        memset(testProfile_Storage, 0xAA, sizeof(testProfile_Storage));
+
+        if (!isEEPROMContentValid()) {
+            return false;
+        }
+        return loadEEPROM();
+    }
+
+    static void setValues(uint32_t value)
+    {
+        testConfigMutable()->value = value;
+        testConfigMutable()->data[value % sizeof(testConfig()->data)] = value;
+        testProfile_Storage[value % MAX_PROFILE_COUNT].value = value;
+    }
+
+    static void expectValues(const testConfig_t &config, const testProfile_t (&profiles)[MAX_PROFILE_COUNT])
+    {
+        EXPECT_EQ(0, memcmp(&config, testConfig(), sizeof(config)));
+        EXPECT_EQ(0, memcmp(profiles, testProfile_Storage, sizeof(profiles)));
+    }
+};
+
+TEST_F(ConfigEepromTest, AppendAndReload)
+{
+    EXPECT_FALSE(isEEPROMContentValid());
+    EXPECT_EQ(0, getEEPROMConfigSize());
+
+    writeConfigToEEPROM();
+    const size_t compacted = usedSize();
+    EXPECT_GE(compacted, LIVE_SIZE);
+    EXPECT_EQ(LIVE_SIZE, getEEPROMConfigSize());
+
+    testConfigMutable()->value = 1234;
+    testProfile_Storage[1].value = 7;
+    writeConfigToEEPROM();
+
+    // Only the two changed PG instances and a commit are appended
+    const size_t appended = usedSize() - compacted;
+    EXPECT_GE(appended, RECORD_SIZE(testConfig_t) + RECORD_SIZE(testProfile_t));
+    EXPECT_LT(appended, compacted);
+    EXPECT_EQ(LIVE_SIZE, getEEPROMConfigSize());
+
+    const testConfig_t config = *testConfig();
+    testProfile_t profiles[MAX_PROFILE_COUNT];
+    memcpy(profiles, testProfile_Storage, sizeof(profiles));
+
+    ASSERT_TRUE(reload());
+    EXPECT_EQ(1234U, testConfig()->value);
+    EXPECT_EQ(7, testProfile_Storage[1].value);
+    expectValues(config, profiles);
+
+    // Saving without changes doesn't write anything
+    std::vector<uint8_t> saved(eepromData, eepromData + sizeof(eepromData));
+    writeConfigToEEPROM();
+    EXPECT_EQ(0, memcmp(saved.data(), eepromData, sizeof(eepromData)));
+}
+
+TEST_F(ConfigEepromTest, InterruptedSave)
+{
+    writeConfigToEEPROM();
+    const size_t compacted = usedSize();
+    setValues(1);
+    writeConfigToEEPROM();
+    setValues(2);
+    writeConfigToEEPROM();
+
+    const testConfig_t config = *testConfig();
+    testProfile_t profiles[MAX_PROFILE_COUNT];
+    memcpy(profiles, testProfile_Storage, sizeof(profiles));
+    std::vector<uint8_t> before(eepromData, eepromData + sizeof(eepromData));
+
+    setValues(3);
+    writeConfigToEEPROM();
+    std::vector<uint8_t> after(eepromData, eepromData + sizeof(eepromData));
+
+    size_t first = 0;
+    while (before[first] == after[first]) {
+        first++;
+    }
+    size_t last = sizeof(eepromData) - 1;
+    while (before[last] == after[last]) {
+        last--;
+    }
+    ASSERT_LT(first, last);
+
+    // Power lost before the last byte of the save was written: the save
+    // is ignored
+    for (size_t cut = first; cut <= last; cut++) {
+        memcpy(eepromData, after.data(), cut);
+        memcpy(eepromData + cut, before.data() + cut, sizeof(eepromData) - cut);
+
+        ASSERT_TRUE(reload()) << "cut at " << cut;
+        expectValues(config, profiles);
+    }
+
+    // The partial save isn't erased memory, the next one compacts
+    setValues(4);
+    writeConfigToEEPROM();
+    EXPECT_EQ(compacted, usedSize());
+    ASSERT_TRUE(reload());
+    EXPECT_EQ(4U, testConfig()->value);
+}
+
+TEST_F(ConfigEepromTest, StaleRecordsAfterCompaction)
+{
+    writeConfigToEEPROM();
+    const size_t compacted = usedSize();
+
+    std::vector<uint8_t> before;
+    size_t used = compacted;
+    uint32_t value = 0;
+    do {
+        before.assign(eepromData, eepromData + sizeof(eepromData));
+        used = usedSize();
+        setValues(++value);
+        writeConfigToEEPROM();
+        ASSERT_LT(value, 1000U);
+    } while (usedSize() > used);
+
+    // Same PGs as the first save, so the compacted log ends where the
+    // first one did
+    ASSERT_EQ(compacted, usedSize());
+
+    // Leave the old log behind the compacted one, like a backend that
+    // doesn't erase. It continues with the complete records and commit of
+    // the second save.
+    memcpy(eepromData + compacted, before.data() + compacted, sizeof(eepromData) - compacted);
+
+    ASSERT_TRUE(reload());
+    EXPECT_EQ(value, testConfig()->value);
+    EXPECT_EQ(LIVE_SIZE, getEEPROMConfigSize());
+
+    // The stale records aren't erased memory, the next save compacts again
+    setValues(++value);
+    writeConfigToEEPROM();
+    EXPECT_EQ(compacted, usedSize());
+    ASSERT_TRUE(reload());
+    EXPECT_EQ(value, testConfig()->value);
+}
+
+TEST_F(ConfigEepromTest, NotErasedForcesCompaction)
+{
+    writeConfigToEEPROM();
+    const size_t compacted = usedSize();
+
+    setValues(1);
+    writeConfigToEEPROM();
+    const size_t used = usedSize();
+    ASSERT_GT(used, compacted);
+
+    // Programmed memory where the next save would be appended
+    eepromData[used + RECORD_SIZE(testConfig_t) / 2] = 0x00;
+
+    setValues(2);
+    writeConfigToEEPROM();
+    EXPECT_EQ(compacted, usedSize());
+
+    const testConfig_t config = *testConfig();
+    testProfile_t profiles[MAX_PROFILE_COUNT];
+    memcpy(profiles, testProfile_Storage, sizeof(profiles));
+
+    ASSERT_TRUE(reload());
+    expectValues(config, profiles);
+}
+
+TEST_F(ConfigEepromTest, FullLog)
+{
+    writeConfigToEEPROM();
+    const size_t compacted = usedSize();
+
+    int compactions = 0;
+    size_t used = compacted;
+    for (uint32_t value = 1; value <= 200; value++) {
+        setValues(value);
+        writeConfigToEEPROM();
+
+        if (usedSize() < used) {
+            EXPECT_EQ(compacted, usedSize());
+            compactions++;
+        }
+        used = usedSize();
+        EXPECT_LE(used, sizeof(eepromData));
+
+        const testConfig_t config = *testConfig();
+        testProfile_t profiles[MAX_PROFILE_COUNT];
+        memcpy(profiles, testProfile_Storage, sizeof(profiles));
+
+        ASSERT_TRUE(reload());
+        expectValues(config, profiles);
+    }
+    EXPECT_GE(compactions, 2);
+}
+
+// Writes the config in the format used before the log
+static void writeLegacyConfig(void)
+{
+    uint8_t *p = eepromData;
+    *p++ = 126;
+
+    auto addRecord = [&p](pgn_t pgn, uint8_t flags, const void *data, uint16_t size) {
+        const uint16_t recordSize = 6 + size;
+        memcpy(p, &recordSize, sizeof(recordSize));
+        memcpy(p + 2, &pgn, sizeof(pgn));
+        p[4] = 0;
+        p[5] = flags;
+        memcpy(p + 6, data, size);
+        p += recordSize;
+    };
+
+    addRecord(PG_RESERVED_FOR_TESTING_1, 0, testConfig(), sizeof(testConfig_t));
+    for (int profileIndex = 0; profileIndex < MAX_PROFILE_COUNT; profileIndex++) {
+        addRecord(PG_RESERVED_FOR_TESTING_2, profileIndex + 1, &testProfile_Storage[profileIndex], sizeof(testProfile_t));
+    }
+
+    // The footer is a zero size terminator
+    memset(p, 0, 2);
+    p += 2;
+
+    const uint16_t crc = crc16_ccitt_update(0, eepromData, p - eepromData);
+    memcpy(p, &crc, sizeof(crc));
+}
+
+TEST_F(ConfigEepromTest, LegacyFormat)
+{
+    setValues(1);
+    setValues(2);
+    const testConfig_t config = *testConfig();
+    testProfile_t profiles[MAX_PROFILE_COUNT];
+    memcpy(profiles, testProfile_Storage, sizeof(profiles));
+
+    writeLegacyConfig();
+    ASSERT_TRUE(reload());
+    expectValues(config, profiles);
+    EXPECT_EQ(1 + 6 + sizeof(testConfig_t) + MAX_PROFILE_COUNT * (6 + sizeof(testProfile_t)), getEEPROMConfigSize());
+
+    // Saving converts it, even without changes
+    writeConfigToEEPROM();
+    EXPECT_EQ(EEPROM_CONF_VERSION, eepromData[0]);
+    EXPECT_EQ(LIVE_SIZE, getEEPROMConfigSize());
+    ASSERT_TRUE(reload());
+    expectValues(config, profiles);
+
+    // A bad checksum resets to defaults
+    writeLegacyConfig();
+    eepromData[10] ^= 1;
+    EXPECT_FALSE(isEEPROMContentValid());
+}
+
+// STUBS
+
+extern "C" {
+
+void failureMode(failureMode_e mode)
+{
+    UNUSED(mode);
+    failureModeCalls++;
+}
+
+}
@@ -0,0 +1,110 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/utils.h"
+
+    #include "config/config_streamer.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+typedef std::vector<uint8_t> image_t;
+
+// Streams data from src + offset to eepromData + base, one write for each
+// entry of sizes. Returns the resulting image.
+static image_t stream(uintptr_t base, const uint8_t *src, const std::vector<uint32_t> &sizes)
+{
+    memset(eepromData, 0x55, sizeof(eepromData));
+
+    config_streamer_t streamer;
+    config_streamer_init(&streamer);
+    config_streamer_start(&streamer, (uintptr_t)&eepromData[base], sizeof(eepromData) - base);
+
+    for (uint32_t size : sizes) {
+        EXPECT_EQ(0, config_streamer_write(&streamer, src, size));
+        src += size;
+    }
+
+    EXPECT_EQ(0, config_streamer_flush(&streamer));
+    EXPECT_EQ(0, config_streamer_finish(&streamer));
+
+    return image_t(eepromData, eepromData + sizeof(eepromData));
+}
+
+TEST(ConfigStreamerTest, BulkMatchesBytes)
+{
+    srand(1);
+
+    // Aligned for the streamer, with room to misalign it
+    alignas(config_streamer_buffer_align_type_t) uint8_t source[2048 + 8];
+    for (size_t ii = 0; ii < sizeof(source); ii++) {
+        source[ii] = rand();
+    }
+
+    for (int run = 0; run < 200; run++) {
+        const size_t alignment = rand() % 8;
+        const uintptr_t base = (rand() % 2) ? 0 : CONFIG_STREAMER_BUFFER_SIZE * (1 + rand() % 16);
+
+        std::vector<uint32_t> sizes;
+        uint32_t total = 0;
+        while (true) {
+            // Mostly small writes, like record headers, with some long ones
+            const uint32_t size = (rand() % 4) ? rand() % 16 : rand() % 300;
+            if (total + size > 2048) {
+                break;
+            }
+            sizes.push_back(size);
+            total += size;
+        }
+
+        const image_t bulk = stream(base, source + alignment, sizes);
+        const image_t bytes = stream(base, source + alignment, std::vector<uint32_t>(total, 1));
+        ASSERT_EQ(bytes, bulk) << "run " << run;
+
+        // The data, padded with zeros to the end of the last buffer
+        const uint32_t padded = (total + CONFIG_STREAMER_BUFFER_SIZE - 1) / CONFIG_STREAMER_BUFFER_SIZE * CONFIG_STREAMER_BUFFER_SIZE;
+        EXPECT_EQ(0, memcmp(&bulk[base], source + alignment, total));
+        for (uint32_t ii = total; ii < padded; ii++) {
+            EXPECT_EQ(0, bulk[base + ii]);
+        }
+        // Starting at the beginning erases the rest
+        EXPECT_EQ(base == 0 ? 0xFF : 0x55, bulk[base + padded]);
+    }
+}
+
+TEST(ConfigStreamerTest, WritePastEnd)
+{
+    const uint8_t data[2 * CONFIG_STREAMER_BUFFER_SIZE] = { 0 };
+
+    config_streamer_t streamer;
+    config_streamer_init(&streamer);
+    config_streamer_start(&streamer, (uintptr_t)ARRAYEND(eepromData) - CONFIG_STREAMER_BUFFER_SIZE, CONFIG_STREAMER_BUFFER_SIZE);
+
+    EXPECT_EQ(-1, config_streamer_write(&streamer, data, sizeof(data)));
+    EXPECT_EQ(0, config_streamer_write(&streamer, data, CONFIG_STREAMER_BUFFER_SIZE));
+    EXPECT_EQ(0, config_streamer_flush(&streamer));
+    EXPECT_EQ(0, config_streamer_finish(&streamer));
+}
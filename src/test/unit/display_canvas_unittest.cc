@@ -0,0 +1,275 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/time.h"
+
+    #include "drivers/display_canvas.h"
+    #include "drivers/time.h"
+}
+
+#include "gtest/gtest.h"
+
+static timeMs_t simulatedTimeMs;
+
+/*
+ * Canvas driver counting the bytes a serial pixel OSD would receive, using
+ * the FrSky OSD encoding: one command byte, 3 bytes per point and 6 per rect.
+ */
+static uint32_t sentBytes;
+static uint32_t sentCommands;
+static uint32_t resets;
+
+static void countCommand(unsigned payload)
+{
+    sentBytes += 1 + payload;
+    sentCommands++;
+}
+
+static void setStrokeColor(displayCanvas_t *, displayCanvasColor_e) { countCommand(1); }
+static void setFillColor(displayCanvas_t *, displayCanvasColor_e) { countCommand(1); }
+static void setLineOutlineType(displayCanvas_t *, displayCanvasOutlineType_e) { countCommand(1); }
+static void clipToRect(displayCanvas_t *, int, int, int, int) { countCommand(6); }
+static void clearRect(displayCanvas_t *, int, int, int, int) { countCommand(6); }
+static void resetDrawingState(displayCanvas_t *) { countCommand(0); resets++; }
+static void drawString(displayCanvas_t *, int, int, const char *s, displayCanvasBitmapOption_t) { countCommand(3 + 1 + 1 + strlen(s) + 1); }
+static void moveToPoint(displayCanvas_t *, int, int) { countCommand(3); }
+static void strokeLineToPoint(displayCanvas_t *, int, int) { countCommand(3); }
+static void fillStrokeTriangle(displayCanvas_t *, int, int, int, int, int, int) { countCommand(9); }
+static void ctmTranslate(displayCanvas_t *, float, float) { countCommand(8); }
+static void contextPush(displayCanvas_t *) { countCommand(0); }
+static void contextPop(displayCanvas_t *) { countCommand(0); }
+
+static displayCanvasVTable_t countingVTable;
+
+static void initCountingVTable(void)
+{
+    memset(&countingVTable, 0, sizeof(countingVTable));
+    countingVTable.setStrokeColor = setStrokeColor;
+    countingVTable.setFillColor = setFillColor;
+    countingVTable.setLineOutlineType = setLineOutlineType;
+    countingVTable.clipToRect = clipToRect;
+    countingVTable.clearRect = clearRect;
+    countingVTable.resetDrawingState = resetDrawingState;
+    countingVTable.drawString = drawString;
+    countingVTable.moveToPoint = moveToPoint;
+    countingVTable.strokeLineToPoint = strokeLineToPoint;
+    countingVTable.fillStrokeTriangle = fillStrokeTriangle;
+    countingVTable.ctmTranslate = ctmTranslate;
+    countingVTable.contextPush = contextPush;
+    countingVTable.contextPop = contextPop;
+}
+
+/*
+ * A typical HUD: an artificial horizon with a pitch ladder and a heading tape,
+ * both quantized to pixels like the OSD canvas elements.
+ */
+typedef struct {
+    float pitch;
+    float roll;
+} ahiState_t;
+
+static void drawAhi(displayCanvas_t *canvas, const void *ctx)
+{
+    const ahiState_t *ahi = (const ahiState_t *)ctx;
+    const int cx = canvas->width / 2;
+    const int cy = canvas->height / 2;
+    const float s = sinf(ahi->roll);
+    const float c = cosf(ahi->roll);
+
+    displayCanvasClearRect(canvas, cx - 72, cy - 81, 144, 162);
+    displayCanvasContextPush(canvas);
+    displayCanvasCtmTranslate(canvas, 0, roundf(ahi->pitch * 3.5f));
+    displayCanvasSetStrokeColor(canvas, DISPLAY_CANVAS_COLOR_WHITE);
+    displayCanvasSetLineOutlineType(canvas, DISPLAY_CANVAS_OUTLINE_TYPE_BOTTOM);
+    for (int level = -20; level <= 20; level += 10) {
+        const int y = level * 3.5f;
+        displayCanvasMoveToPoint(canvas, cx + roundf(-40 * c - y * s), cy + roundf(-40 * s + y * c));
+        displayCanvasStrokeLineToPoint(canvas, cx + roundf(40 * c - y * s), cy + roundf(40 * s + y * c));
+    }
+    displayCanvasContextPop(canvas);
+}
+
+static void drawHeading(displayCanvas_t *canvas, const void *ctx)
+{
+    const int heading = *(const int *)ctx;
+    const int offset = ((heading % 225) * 12) / 225;
+
+    displayCanvasClipToRect(canvas, 126, 0, 108, 18);
+    displayCanvasDrawString(canvas, 126 - offset + 1, 0, "N|:|E|:|S|", DISPLAY_CANVAS_BITMAP_OPT_ERASE_TRANSPARENT);
+    displayCanvasSetStrokeColor(canvas, DISPLAY_CANVAS_COLOR_BLACK);
+    displayCanvasSetFillColor(canvas, DISPLAY_CANVAS_COLOR_WHITE);
+    displayCanvasFillStrokeTriangle(canvas, 178, -1, 182, -1, 180, 1);
+}
+
+class DisplayCanvasTest : public ::testing::Test {
+protected:
+    displayCanvasRegionCache_t regions;
+    displayCanvas_t canvas;
+
+    virtual void SetUp()
+    {
+        memset(&regions, 0, sizeof(regions));
+        memset(&canvas, 0, sizeof(canvas));
+        initCountingVTable();
+        canvas.vTable = &countingVTable;
+        canvas.width = 360;
+        canvas.height = 288;
+        canvas.regions = &regions;
+        simulatedTimeMs = 100;
+        sentBytes = 0;
+        sentCommands = 0;
+        resets = 0;
+    }
+};
+
+TEST_F(DisplayCanvasTest, TestUnchangedRegionIsSkipped)
+{
+    ahiState_t ahi = { .pitch = 5.0f, .roll = 0.2f };
+
+    displayCanvasDrawRegion(&canvas, 0, 0, drawAhi, &ahi);
+    const uint32_t firstBytes = sentBytes;
+    EXPECT_GT(firstBytes, 0u);
+    EXPECT_EQ(1u, resets);
+
+    // Sub-pixel change, same commands
+    simulatedTimeMs += 50;
+    ahi.pitch = 5.01f;
+    displayCanvasDrawRegion(&canvas, 0, 0, drawAhi, &ahi);
+    EXPECT_EQ(firstBytes, sentBytes);
+    EXPECT_EQ(1u, regions.skipped);
+
+    // Visible change
+    simulatedTimeMs += 50;
+    ahi.roll = 0.5f;
+    displayCanvasDrawRegion(&canvas, 0, 0, drawAhi, &ahi);
+    EXPECT_EQ(firstBytes * 2, sentBytes);
+    EXPECT_EQ(2u, resets);
+}
+
+TEST_F(DisplayCanvasTest, TestRegionsAreIndependent)
+{
+    ahiState_t ahi = { .pitch = 0, .roll = 0 };
+    int heading = 100;
+
+    displayCanvasDrawRegion(&canvas, 0, 0, drawAhi, &ahi);
+    displayCanvasDrawRegion(&canvas, 1, 0, drawHeading, &heading);
+    const uint32_t bytes = sentBytes;
+
+    heading = 200;
+    displayCanvasDrawRegion(&canvas, 0, 0, drawAhi, &ahi);
+    displayCanvasDrawRegion(&canvas, 1, 0, drawHeading, &heading);
+    EXPECT_EQ(1u, regions.skipped);
+    EXPECT_GT(sentBytes, bytes);
+}
+
+TEST_F(DisplayCanvasTest, TestSeedChangeForcesRedraw)
+{
+    ahiState_t ahi = { .pitch = 0, .roll = 0 };
+
+    displayCanvasDrawRegion(&canvas, 0, 1, drawAhi, &ahi);
+    const uint32_t bytes = sentBytes;
+
+    // The screen was cleared in between
+    displayCanvasDrawRegion(&canvas, 0, 2, drawAhi, &ahi);
+    EXPECT_EQ(bytes * 2, sentBytes);
+    EXPECT_EQ(0u, regions.skipped);
+}
+
+TEST_F(DisplayCanvasTest, TestMaxAgeForcesRedraw)
+{
+    ahiState_t ahi = { .pitch = 0, .roll = 0 };
+
+    displayCanvasDrawRegion(&canvas, 0, 0, drawAhi, &ahi);
+    simulatedTimeMs += DISPLAY_CANVAS_REGION_MAX_AGE_MS - 1;
+    displayCanvasDrawRegion(&canvas, 0, 0, drawAhi, &ahi);
+    EXPECT_EQ(1u, regions.skipped);
+
+    simulatedTimeMs += 1;
+    displayCanvasDrawRegion(&canvas, 0, 0, drawAhi, &ahi);
+    EXPECT_EQ(1u, regions.skipped);
+    EXPECT_EQ(2u, resets);
+}
+
+TEST_F(DisplayCanvasTest, TestWithoutCacheDrawsDirectly)
+{
+    ahiState_t ahi = { .pitch = 0, .roll = 0 };
+
+    canvas.regions = NULL;
+    displayCanvasDrawRegion(&canvas, 0, 0, drawAhi, &ahi);
+    displayCanvasDrawRegion(&canvas, 0, 0, drawAhi, &ahi);
+    EXPECT_EQ(0u, resets);
+    EXPECT_EQ(2 * 16u, sentCommands);
+}
+
+static void runHud(displayCanvas_t *canvas, int frames, uint32_t *bytesPerFrame, double *usPerFrame)
+{
+    ahiState_t ahi;
+    int heading;
+
+    sentBytes = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < frames; ii++) {
+        // Slow attitude and heading changes with sensor noise, 50Hz refresh
+        simulatedTimeMs += 20;
+        ahi.pitch = 3.0f + 2.0f * sinf(ii * 0.01f) + 0.02f * ((ii * 7919) % 5 - 2);
+        ahi.roll = 0.1f * sinf(ii * 0.007f);
+        heading = 900 + ii / 4;
+        displayCanvasDrawRegion(canvas, 0, 0, drawAhi, &ahi);
+        displayCanvasDrawRegion(canvas, 1, 0, drawHeading, &heading);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    *bytesPerFrame = sentBytes / frames;
+    *usPerFrame = std::chrono::duration<double, std::micro>(elapsed).count() / frames;
+}
+
+TEST_F(DisplayCanvasTest, TestHudTrafficPerFrame)
+{
+    const int frames = 2000;
+    uint32_t directBytes, regionBytes;
+    double directUs, regionUs;
+
+    canvas.regions = NULL;
+    runHud(&canvas, frames, &directBytes, &directUs);
+
+    canvas.regions = &regions;
+    runHud(&canvas, frames, &regionBytes, &regionUs);
+
+    // Timings are informational only, not asserted
+    printf("[ HUD      ] direct:  %u bytes/frame, %.2f us/frame\n", directBytes, directUs);
+    printf("[ HUD      ] regions: %u bytes/frame, %.2f us/frame (%u regions skipped)\n", regionBytes, regionUs, regions.skipped);
+
+    EXPECT_LT(regionBytes, directBytes);
+}
+
+// STUBS
+
+extern "C" {
+
+timeMs_t millis(void)
+{
+    return simulatedTimeMs;
+}
+
+}
@@ -19,11 +19,23 @@
 #include "gtest/gtest.h"
 #include "unittest_macros.h"
 
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <stdio.h>
 
-#include "io/gps_ublox_utils.h"
+extern "C" {
+    #include "platform.h"
+
+    #include "drivers/serial.h"
+    #include "drivers/time.h"
+
+    #include "io/gps.h"
+    #include "io/gps_private.h"
+    #include "io/gps_ublox_utils.h"
+}
 
 void dumpCfg(const ubx_config_data8_t *cfg, int valuesAdded)
 {
@@ -87,4 +99,507 @@ TEST(GPSUbloxTest, TestUbloxCfgFillBytes)
     // osdFormatCentiNumber(buf, 12345, 1, 2, 3, 7);
     // std::cout << "'" << buf << "'" << std::endl;
     //EXPECT_FALSE(strcmp(buf, " 123.45"));
-}
\ No newline at end of file
+}
+
+// Frame as seen by the protocol parser
+struct UbloxTestFrame {
+    uint8_t msgClass;
+    uint8_t msgId;
+    std::vector<uint8_t> payload;
+
+    bool operator==(const UbloxTestFrame &other) const
+    {
+        return msgClass == other.msgClass && msgId == other.msgId && payload == other.payload;
+    }
+};
+
+// Byte at a time state machine the UBX driver used before the span based framer
+class LegacyUbloxParser {
+public:
+    std::vector<UbloxTestFrame> frames;
+    uint32_t errors = 0;
+    uint32_t packetCount = 0;
+    bool keepFrames = true;
+
+    void feed(const uint8_t *data, size_t len)
+    {
+        while (len--) {
+            newFrame(*data++);
+        }
+    }
+
+private:
+    uint8_t ck_a = 0, ck_b = 0;
+    bool skipPacket = false;
+    uint8_t step = 0;
+    uint8_t msgClass = 0, msgId = 0;
+    uint16_t payloadLength = 0, payloadCounter = 0;
+    uint8_t buffer[MAX_UBLOX_PAYLOAD_SIZE];
+
+    void newFrame(uint8_t data)
+    {
+        switch (step) {
+            case 0:
+                if (PREAMBLE1 == data) {
+                    skipPacket = false;
+                    step++;
+                }
+                break;
+            case 1:
+                step = (PREAMBLE2 == data) ? step + 1 : 0;
+                break;
+            case 2:
+                step++;
+                msgClass = data;
+                ck_b = ck_a = data;
+                break;
+            case 3:
+                step++;
+                ck_b += (ck_a += data);
+                msgId = data;
+                break;
+            case 4:
+                step++;
+                ck_b += (ck_a += data);
+                payloadLength = data;
+                break;
+            case 5:
+                step++;
+                ck_b += (ck_a += data);
+                payloadLength |= (uint16_t)(data << 8);
+                if (payloadLength > MAX_UBLOX_PAYLOAD_SIZE) {
+                    errors++;
+                    step = 0;
+                    break;
+                }
+                payloadCounter = 0;
+                if (payloadLength == 0) {
+                    step = 7;
+                }
+                break;
+            case 6:
+                ck_b += (ck_a += data);
+                if (payloadCounter < MAX_UBLOX_PAYLOAD_SIZE) {
+                    buffer[payloadCounter] = data;
+                }
+                if (payloadCounter == payloadLength - 1) {
+                    step++;
+                }
+                payloadCounter++;
+                break;
+            case 7:
+                step++;
+                if (ck_a != data) {
+                    skipPacket = true;
+                    errors++;
+                    step = 0;
+                }
+                break;
+            case 8:
+                step = 0;
+                if (ck_b != data) {
+                    errors++;
+                    break;
+                }
+                packetCount++;
+                if (skipPacket || !keepFrames) {
+                    break;
+                }
+                frames.push_back({ msgClass, msgId, std::vector<uint8_t>(buffer, buffer + payloadLength) });
+                break;
+        }
+    }
+};
+
+// Span based framer fed the way the driver feeds it, in chunks of arbitrary size
+class FramerUbloxParser {
+public:
+    std::vector<UbloxTestFrame> frames;
+    uint32_t errors = 0;
+    uint32_t packetCount = 0;
+
+    FramerUbloxParser()
+    {
+        ubxFramerInit(&framer, framerBuffer, sizeof(framerBuffer));
+    }
+
+    void feed(const uint8_t *data, size_t len, bool keepFrames = true)
+    {
+        while (len) {
+            ubxFrame_t frame;
+            size_t consumed;
+            const ubxFramerResult_e result = ubxFramerFeed(&framer, data, len, &consumed, &frame);
+            data += consumed;
+            len -= consumed;
+
+            if (result == UBX_FRAMER_ERROR) {
+                errors++;
+            } else if (result == UBX_FRAMER_FRAME) {
+                packetCount++;
+                if (keepFrames) {
+                    frames.push_back({ frame.msgClass, frame.msgId, std::vector<uint8_t>(frame.payload, frame.payload + frame.length) });
+                }
+            }
+        }
+    }
+
+private:
+    ubxFramer_t framer;
+    uint8_t framerBuffer[UBX_FRAME_OVERHEAD + MAX_UBLOX_PAYLOAD_SIZE];
+};
+
+static void appendUbxFrame(std::vector<uint8_t> &stream, uint8_t msgClass, uint8_t msgId, const std::vector<uint8_t> &payload)
+{
+    const size_t start = stream.size();
+    stream.push_back(PREAMBLE1);
+    stream.push_back(PREAMBLE2);
+    stream.push_back(msgClass);
+    stream.push_back(msgId);
+    stream.push_back(payload.size() & 0xFF);
+    stream.push_back(payload.size() >> 8);
+    stream.insert(stream.end(), payload.begin(), payload.end());
+
+    uint8_t ck_a, ck_b;
+    ublox_update_checksum(&stream[start + 2], payload.size() + 4, &ck_a, &ck_b);
+    stream.push_back(ck_a);
+    stream.push_back(ck_b);
+}
+
+static uint8_t randomNonSyncByte(void)
+{
+    uint8_t value;
+    do {
+        value = rand();
+    } while (value == PREAMBLE1);
+    return value;
+}
+
+static std::vector<uint8_t> randomPayload(size_t length)
+{
+    std::vector<uint8_t> payload(length);
+    for (auto &byte : payload) {
+        byte = randomNonSyncByte();
+    }
+    return payload;
+}
+
+// Synthesized receiver output: 25Hz NAV-PVT with ACKs, line noise, corrupted and oversized frames
+static std::vector<uint8_t> makeUbloxStream(int epochs)
+{
+    std::vector<uint8_t> stream;
+
+    for (int i = 0; i < epochs; i++) {
+        ubx_nav_pvt pvt = {};
+        pvt.fix_type = 3;
+        pvt.fix_status = 1;
+        pvt.satellites = 12 + i % 8;
+        pvt.longitude = 174000000 + i * 37;
+        pvt.latitude = -368000000 - i * 11;
+        pvt.altitude_msl = 120000 + i;
+        pvt.horizontal_accuracy = 900 + (i % 50);
+        pvt.vertical_accuracy = 1500;
+        pvt.ned_north = 1000 - i;
+        pvt.ned_east = -250 + i;
+        pvt.ned_down = 15;
+        pvt.speed_2d = 1100;
+        pvt.heading_2d = 4500000 + i * 1000;
+        pvt.position_DOP = 120;
+
+        std::vector<uint8_t> payload((uint8_t *)&pvt, (uint8_t *)&pvt + sizeof(pvt));
+        payload.resize(92);     // NAV-PVT as sent by M8 and later receivers
+        appendUbxFrame(stream, CLASS_NAV, MSG_PVT, payload);
+
+        switch (i % 10) {
+            case 1:
+                appendUbxFrame(stream, CLASS_ACK, MSG_ACK_ACK, { CLASS_CFG, MSG_CFG_RATE });
+                break;
+            case 3:
+                appendUbxFrame(stream, CLASS_NAV, MSG_POSLLH, randomPayload(28));
+                break;
+            case 4: {
+                // Garbage between frames
+                const std::vector<uint8_t> noise = randomPayload(1 + rand() % 40);
+                stream.insert(stream.end(), noise.begin(), noise.end());
+                break;
+            }
+            case 6:
+                // Corrupted checksum
+                appendUbxFrame(stream, CLASS_NAV, MSG_VELNED, randomPayload(36));
+                stream.back() ^= 0x01;
+                break;
+            case 7:
+                appendUbxFrame(stream, CLASS_MON, MSG_VER, randomPayload(0));
+                break;
+            case 8: {
+                // Length beyond anything the driver accepts, payload is skipped as noise
+                const std::vector<uint8_t> header = { PREAMBLE1, PREAMBLE2, CLASS_NAV, MSG_SVINFO, 0x00, 0x03 };
+                const std::vector<uint8_t> noise = randomPayload(20);
+                stream.insert(stream.end(), header.begin(), header.end());
+                stream.insert(stream.end(), noise.begin(), noise.end());
+                break;
+            }
+        }
+    }
+
+    return stream;
+}
+
+TEST(GPSUbloxTest, TestChecksumAccumulate)
+{
+    const std::vector<uint8_t> data = randomPayload(300);
+
+    for (size_t len = 0; len < data.size(); len += 7) {
+        uint8_t ref_a = 0, ref_b = 0;
+        for (size_t i = 0; i < len; i++) {
+            ref_a += data[i];
+            ref_b += ref_a;
+        }
+
+        // Accumulation split at an arbitrary point must match a single pass
+        uint8_t ck_a = 0, ck_b = 0;
+        ubloxChecksumAccumulate(data.data(), len / 3, &ck_a, &ck_b);
+        ubloxChecksumAccumulate(data.data() + len / 3, len - len / 3, &ck_a, &ck_b);
+        EXPECT_EQ(ref_a, ck_a);
+        EXPECT_EQ(ref_b, ck_b);
+    }
+}
+
+TEST(GPSUbloxTest, TestFramerMatchesLegacyParser)
+{
+    srand(0x5542);
+    const std::vector<uint8_t> stream = makeUbloxStream(500);
+
+    LegacyUbloxParser legacy;
+    legacy.feed(stream.data(), stream.size());
+
+    // Single span, byte at a time, and random chunks as the serial port would deliver them
+    for (int mode = 0; mode < 3; mode++) {
+        FramerUbloxParser framer;
+
+        size_t pos = 0;
+        while (pos < stream.size()) {
+            const size_t chunk = (mode == 0) ? stream.size() : (mode == 1) ? 1 : 1 + rand() % 128;
+            const size_t len = std::min(chunk, stream.size() - pos);
+            framer.feed(&stream[pos], len);
+            pos += len;
+        }
+
+        EXPECT_EQ(legacy.errors, framer.errors);
+        EXPECT_EQ(legacy.packetCount, framer.packetCount);
+        EXPECT_TRUE(legacy.frames == framer.frames);
+    }
+}
+
+TEST(GPSUbloxTest, TestFramerResync)
+{
+    std::vector<uint8_t> stream = { PREAMBLE1, PREAMBLE1 };
+    appendUbxFrame(stream, CLASS_ACK, MSG_ACK_ACK, { CLASS_CFG, MSG_CFG_RATE });
+
+    // A repeated sync byte must not hide the frame that follows, whichever way the data is split
+    for (size_t split = 0; split <= stream.size(); split++) {
+        FramerUbloxParser framer;
+        framer.feed(stream.data(), split);
+        framer.feed(stream.data() + split, stream.size() - split);
+
+        ASSERT_EQ(1u, framer.frames.size());
+        EXPECT_EQ(MSG_ACK_ACK, framer.frames[0].msgId);
+        EXPECT_EQ(0u, framer.errors);
+    }
+}
+
+TEST(GPSUbloxTest, TestFramerThroughput)
+{
+    srand(0x7a31);
+    const std::vector<uint8_t> stream = makeUbloxStream(20000);
+    const int passes = 10;
+    const double megabytes = (double)stream.size() * passes / (1024 * 1024);
+
+    auto start = std::chrono::steady_clock::now();
+    uint32_t legacyPackets = 0;
+    for (int i = 0; i < passes; i++) {
+        LegacyUbloxParser legacy;
+        legacy.keepFrames = false;
+        legacy.feed(stream.data(), stream.size());
+        legacyPackets += legacy.packetCount;
+    }
+    const double legacySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    uint32_t framerPackets = 0;
+    for (int i = 0; i < passes; i++) {
+        FramerUbloxParser framer;
+        for (size_t pos = 0; pos < stream.size(); pos += 128) {
+            framer.feed(&stream[pos], std::min<size_t>(128, stream.size() - pos), false);
+        }
+        framerPackets += framer.packetCount;
+    }
+    const double framerSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_EQ(legacyPackets, framerPackets);
+
+    // Informational only, not asserted
+
+    printf("UBX legacy parser: %.1f MB/s\n", megabytes / legacySeconds);
+    printf("UBX span framer:   %.1f MB/s\n", megabytes / framerSeconds);
+}
+
+// Receiver output fed to the driver through the GPS serial port
+static std::vector<uint8_t> serialRxData;
+static size_t serialRxPos;
+static size_t serialRxChunk;
+static std::vector<gpsSolutionData_t> driverSolutions;
+
+TEST(GPSUbloxTest, TestDriverSolutions)
+{
+    srand(0x9c17);
+    const int epochs = 500;
+    const std::vector<uint8_t> stream = makeUbloxStream(epochs);
+
+    static serialPort_t gpsPort;
+    static gpsConfig_t config;
+    config.provider = GPS_UBLOX;
+    config.autoBaud = GPS_AUTOBAUD_OFF;
+    gpsState.gpsConfig = &config;
+    gpsState.gpsPort = &gpsPort;
+    gpsRestartUBLOX();
+
+    serialRxData = stream;
+    serialRxPos = 0;
+    serialRxChunk = 0;
+    driverSolutions.clear();
+
+    // The serial port receives random chunks, the task runs while anything is pending
+    while (serialRxPos < serialRxData.size() || gpsHasPendingDataUBLOX()) {
+        serialRxChunk = 1 + rand() % 64;
+        if (gpsHasPendingDataUBLOX() || serialRxBytesWaiting(&gpsPort)) {
+            gpsHandleUBLOX();
+        }
+        serialRxChunk = std::min(serialRxChunk, serialRxData.size() - serialRxPos);
+        serialRxPos += serialRxChunk;
+        serialRxChunk = 0;
+    }
+
+    ASSERT_EQ((size_t)epochs, driverSolutions.size());
+    for (int i = 0; i < epochs; i++) {
+        const gpsSolutionData_t &sol = driverSolutions[i];
+        EXPECT_EQ(GPS_FIX_3D, sol.fixType);
+        EXPECT_EQ(174000000 + i * 37, sol.llh.lon);
+        EXPECT_EQ(-368000000 - i * 11, sol.llh.lat);
+        EXPECT_EQ((120000 + i) / 10, sol.llh.alt);                  // mm to cm
+        EXPECT_EQ((1000 - i) / 10, sol.velNED[0]);                  // mm/s to cm/s
+        EXPECT_EQ((-250 + i) / 10, sol.velNED[1]);
+        EXPECT_EQ(1, sol.velNED[2]);
+        EXPECT_EQ(110, sol.groundSpeed);
+        EXPECT_EQ((4500000 + i * 1000) / 10000, sol.groundCourse); // deg * 100000 to deg * 10
+        EXPECT_EQ(12 + i % 8, sol.numSat);
+        EXPECT_EQ((900 + i % 50) / 10, sol.eph);
+        EXPECT_EQ(150, sol.epv);
+        EXPECT_EQ(120, sol.hdop);
+        EXPECT_TRUE(sol.flags.validVelNE);
+        EXPECT_TRUE(sol.flags.validEPE);
+    }
+}
+
+// STUBS
+
+extern "C" {
+
+gpsConfig_t gpsConfig_System;
+gpsReceiverData_t gpsState;
+gpsStatistics_t gpsStats;
+gpsSolutionData_t gpsSolDRV;
+baudRate_e gpsToSerialBaudRate[GPS_BAUDRATE_COUNT];
+const uint32_t baudRates[BAUD_MAX + 1] = { 0 };
+
+void gpsProcessNewDriverData(void)
+{
+    driverSolutions.push_back(gpsSolDRV);
+}
+
+void gpsSetProtocolTimeout(timeMs_t timeoutMs)
+{
+    UNUSED(timeoutMs);
+}
+
+void gpsSetState(gpsState_e state)
+{
+    UNUSED(state);
+}
+
+void gpsProcessNewSolutionData(bool timeout)
+{
+    UNUSED(timeout);
+}
+
+int gpsBaudRateToInt(gpsBaudRate_e baudrate)
+{
+    UNUSED(baudrate);
+    return 0;
+}
+
+uint16_t gpsConstrainEPE(uint32_t epe)
+{
+    return (epe > 9999) ? 9999 : epe;
+}
+
+uint16_t gpsConstrainHDOP(uint32_t hdop)
+{
+    return (hdop > 9999) ? 9999 : hdop;
+}
+
+uint32_t serialRxBytesWaiting(const serialPort_t *instance)
+{
+    UNUSED(instance);
+    return serialRxChunk;
+}
+
+uint8_t serialRead(serialPort_t *instance)
+{
+    UNUSED(instance);
+    serialRxChunk--;
+    return serialRxData[serialRxPos++];
+}
+
+void serialWriteBuf(serialPort_t *instance, const uint8_t *data, int count)
+{
+    UNUSED(instance);
+    UNUSED(data);
+    UNUSED(count);
+}
+
+void serialPrint(serialPort_t *instance, const char *str)
+{
+    UNUSED(instance);
+    UNUSED(str);
+}
+
+void serialSetBaudRate(serialPort_t *instance, uint32_t baudRate)
+{
+    UNUSED(instance);
+    UNUSED(baudRate);
+}
+
+bool isSerialTransmitBufferEmpty(const serialPort_t *instance)
+{
+    UNUSED(instance);
+    return true;
+}
+
+timeMs_t millis(void)
+{
+    return 0;
+}
+
+timeUs_t micros(void)
+{
+    return 0;
+}
+
+// BSD extension used by the driver, missing from the host libc
+char *strnstr(const char *s, const char *find, size_t slen)
+{
+    UNUSED(slen);
+    return (char *)strstr(s, find);
+}
+
+}
@@ -236,3 +236,67 @@ TEST(MathsUnittest, TestSensorScaleUnitTest)
 }
 */
 #endif
+
+TEST(MathsUnittest, TestSensorEllipsoidCalibration)
+{
+    // Field of 500 distorted by a symmetric soft iron matrix and a hard iron offset
+    const float offset[3] = { 120, -340, 75 };
+    const float distortion[3][3] = {
+        { 1.10f, 0.08f, -0.05f },
+        { 0.08f, 0.92f, 0.03f },
+        { -0.05f, 0.03f, 1.02f },
+    };
+
+    sensorEllipsoidCalibrationState_t state;
+    sensorEllipsoidCalibrationReset(&state, 1.0f);
+
+    for (int n = 0; n < 400; n++) {
+        // Points of a spiral over the whole sphere, visited in scrambled order like a hand held calibration
+        const int i = (n * 97) % 400;
+        const float z = 1.0f - 2.0f * (i + 0.5f) / 400;
+        const float r = sqrtf(1 - z * z);
+        const float phi = i * 2.39996323f;
+        const float field[3] = { 500 * r * cosf(phi), 500 * r * sinf(phi), 500 * z };
+
+        float sample[3];
+        for (int axis = 0; axis < 3; axis++) {
+            sample[axis] = offset[axis] + distortion[axis][0] * field[0] + distortion[axis][1] * field[1] + distortion[axis][2] * field[2];
+        }
+
+        sensorEllipsoidCalibrationPushSample(&state, sample);
+    }
+
+    EXPECT_EQ(SENSOR_ELLIPSOID_COVERAGE_BINS, sensorEllipsoidCalibrationCoverage(&state, 3));
+
+    sensorEllipsoidCalibration_t result;
+    ASSERT_TRUE(sensorEllipsoidCalibrationSolve(&state, &result));
+
+    for (int axis = 0; axis < 3; axis++) {
+        EXPECT_NEAR(offset[axis], result.offset[axis], 0.5f);
+    }
+
+    // Correction must undo the distortion: softIron * distortion == I / 500
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            float product = 0;
+            for (int k = 0; k < 3; k++) {
+                product += result.softIron[i][k] * distortion[k][j];
+            }
+            EXPECT_NEAR((i == j) ? 1.0f : 0.0f, product * 500, 1e-3f);
+        }
+    }
+}
+
+TEST(MathsUnittest, TestSensorEllipsoidCalibrationCoverage)
+{
+    sensorEllipsoidCalibrationState_t state;
+    sensorEllipsoidCalibrationReset(&state, 1.0f);
+
+    // Rotating about a single axis only sweeps a ring and must not count as covered
+    for (int i = 0; i < 200; i++) {
+        const float sample[3] = { 400 * cosf(i * 0.1f), 400 * sinf(i * 0.1f), 30 };
+        sensorEllipsoidCalibrationPushSample(&state, sample);
+    }
+
+    EXPECT_LT(sensorEllipsoidCalibrationCoverage(&state, 3), SENSOR_ELLIPSOID_COVERAGE_BINS);
+}
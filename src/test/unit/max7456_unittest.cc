@@ -0,0 +1,371 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/time.h"
+    #include "common/utils.h"
+
+    #include "drivers/bus.h"
+    #include "drivers/max7456.h"
+    #include "drivers/osd.h"
+    #include "drivers/time.h"
+}
+
+#include "gtest/gtest.h"
+
+/*
+ * Fake MAX7456 on the other end of the SPI bus. It decodes the byte
+ * stream like the chip does: register/value pairs, or one character
+ * per byte while in auto-increment mode, until 0xFF.
+ */
+#define REG_VM0     0x00
+#define REG_DMM     0x04
+#define REG_DMAH    0x05
+#define REG_DMAL    0x06
+#define REG_DMDI    0x07
+#define REG_STAT    0xA0
+#define REG_READ    0x80
+
+#define DMM_8BIT            (1 << 6)
+#define DMM_CLEAR           (1 << 2)
+#define DMM_AUTOINCREMENT   (1 << 0)
+#define DMM_ATTR_MASK       (MAX7456_MODE_INVERT | MAX7456_MODE_BLINK | MAX7456_MODE_SOLID_BG)
+#define DMAH_ATTR           (1 << 1)
+#define MODE_EXT            (1 << 2)
+
+#define CHIP_CHARS          512
+
+static struct {
+    uint8_t vm0;
+    uint8_t dmm;
+    uint8_t dmah;
+    uint8_t dmal;
+    bool autoIncrement;
+    unsigned address;
+    bool haveRegister;
+    uint8_t reg;
+    uint8_t chars[CHIP_CHARS];
+    uint8_t attrs[CHIP_CHARS];  // DMM attribute bits, plus MODE_EXT for chars above 255
+
+    unsigned transfers;
+    unsigned bytes;
+    unsigned maxTransferBytes;
+} chip;
+
+static void chipWriteRegister(uint8_t reg, uint8_t data)
+{
+    const unsigned address = ((chip.dmah & 1) << 8) | chip.dmal;
+
+    switch (reg) {
+        case REG_VM0:
+            chip.vm0 = data & ~0x02; // Reset completes immediately
+            break;
+        case REG_DMM:
+            if (data & DMM_CLEAR) {
+                memset(chip.chars, 0, sizeof(chip.chars));
+                memset(chip.attrs, 0, sizeof(chip.attrs));
+            }
+            if (data & DMM_AUTOINCREMENT) {
+                chip.autoIncrement = true;
+                chip.address = address;
+            }
+            chip.dmm = data & ~(DMM_CLEAR | DMM_AUTOINCREMENT);
+            break;
+        case REG_DMAH:
+            chip.dmah = data;
+            break;
+        case REG_DMAL:
+            chip.dmal = data;
+            break;
+        case REG_DMDI:
+            if (chip.dmah & DMAH_ATTR) {
+                chip.attrs[address] = data >> 2;
+            } else {
+                chip.chars[address] = data;
+                if (!(chip.dmm & DMM_8BIT)) {
+                    chip.attrs[address] = chip.dmm & DMM_ATTR_MASK;
+                }
+            }
+            break;
+    }
+}
+
+static void chipReceive(uint8_t byte)
+{
+    if (chip.autoIncrement) {
+        if (byte == 0xFF) {
+            chip.autoIncrement = false;
+        } else {
+            ASSERT_LT(chip.address, (unsigned)CHIP_CHARS);
+            chip.chars[chip.address] = byte;
+            chip.attrs[chip.address] = chip.dmm & DMM_ATTR_MASK;
+            chip.address++;
+        }
+    } else if (!chip.haveRegister) {
+        chip.reg = byte;
+        chip.haveRegister = true;
+    } else {
+        chip.haveRegister = false;
+        chipWriteRegister(chip.reg, byte);
+    }
+}
+
+static void chipReset(void)
+{
+    memset(&chip, 0, sizeof(chip));
+}
+
+// Checks the chip display memory against the driver's character grid
+static void expectChipMatchesGrid(void)
+{
+    const unsigned screenSize = max7456GetScreenSize();
+    for (unsigned pos = 0; pos < screenSize; pos++) {
+        const uint8_t chr = osdCharacterGridBuffer[pos] >> 8;
+        const uint8_t mode = osdCharacterGridBuffer[pos] & 0xFF;
+        if ((chr == 0x20 || chr == 0x00) && !(mode & MODE_EXT) && chip.chars[pos] == 0 && chip.attrs[pos] == 0) {
+            // Blank after clearing the display
+            continue;
+        }
+        ASSERT_EQ(chr, chip.chars[pos]) << "pos " << pos;
+        ASSERT_EQ(mode, chip.attrs[pos]) << "pos " << pos;
+    }
+}
+
+// Sends everything that's dirty, returns the number of updates needed
+static unsigned drawAll(void)
+{
+    unsigned updates = 0;
+    do {
+        max7456Update();
+        updates++;
+    } while (max7456GetStats()->lastUpdateChars > 0 && updates < 1000);
+    return updates - 1;
+}
+
+class Max7456Test : public ::testing::Test {
+protected:
+    static void SetUpTestCase()
+    {
+        chipReset();
+        max7456Init(VIDEO_SYSTEM_PAL);
+        drawAll();
+    }
+
+    virtual void SetUp()
+    {
+        max7456ClearScreen();
+        drawAll();
+        expectChipMatchesGrid();
+    }
+
+    uint32_t bytesBefore;
+    uint32_t runsBefore;
+
+    void startCounting(void)
+    {
+        bytesBefore = max7456GetStats()->bytes;
+        runsBefore = max7456GetStats()->runs;
+    }
+};
+
+TEST_F(Max7456Test, TestStringIsSentAsOneRun)
+{
+    startCounting();
+    max7456Write(2, 3, "ALTITUDE 123M", 0);
+    max7456Update();
+
+    EXPECT_EQ(13u, max7456GetStats()->lastUpdateChars);
+    EXPECT_EQ(1u, max7456GetStats()->runs - runsBefore);
+    // DMAH, DMAL and DMM, one byte per char, END_STRING and DMM
+    EXPECT_EQ(3 * 2 + 13 + 1 + 2u, max7456GetStats()->bytes - bytesBefore);
+    expectChipMatchesGrid();
+}
+
+TEST_F(Max7456Test, TestScatteredCharsAreSentIndividually)
+{
+    startCounting();
+    max7456WriteChar(0, 0, 'A', 0);
+    max7456WriteChar(10, 0, 'B', 0);
+    max7456WriteChar(20, 5, 'C', MAX7456_MODE_BLINK);
+    max7456Update();
+
+    EXPECT_EQ(3u, max7456GetStats()->lastUpdateChars);
+    EXPECT_EQ(0u, max7456GetStats()->runs - runsBefore);
+    expectChipMatchesGrid();
+}
+
+TEST_F(Max7456Test, TestRunsBridgeShortGaps)
+{
+    max7456Write(0, 1, "12345678", 0);
+    drawAll();
+
+    startCounting();
+    // Only the digits that changed are dirty, the ones in between are resent
+    max7456Write(0, 1, "02040608", 0);
+    max7456Update();
+
+    EXPECT_EQ(1u, max7456GetStats()->runs - runsBefore);
+    EXPECT_EQ(7u, max7456GetStats()->lastUpdateChars);
+    expectChipMatchesGrid();
+}
+
+TEST_F(Max7456Test, TestRunsSplitOnModeAndSpecialChars)
+{
+    max7456Write(0, 2, "AAAA", 0);
+    max7456Write(4, 2, "BBBB", MAX7456_MODE_INVERT);
+    // Above 255, needs the 8 bit mode
+    max7456WriteChar(8, 2, 0x123, 0);
+    max7456Write(9, 2, "CCCC", 0);
+    // END_STRING can't be sent in auto-increment mode
+    max7456WriteChar(13, 2, 0xFF, 0);
+    max7456Write(14, 2, "DDDD", 0);
+    drawAll();
+
+    expectChipMatchesGrid();
+}
+
+TEST_F(Max7456Test, TestUpdatesStayWithinByteBudget)
+{
+    char line[MAX7456_CHARS_PER_LINE + 1];
+
+    chip.maxTransferBytes = 0;
+    startCounting();
+    for (int y = 0; y < MAX7456_LINES_PAL; y++) {
+        for (int x = 0; x < MAX7456_CHARS_PER_LINE; x++) {
+            line[x] = 'A' + (x + y) % 26;
+        }
+        line[MAX7456_CHARS_PER_LINE] = '\0';
+        max7456Write(0, y, line, y % 3 == 0 ? MAX7456_MODE_INVERT : 0);
+    }
+    const unsigned updates = drawAll();
+    expectChipMatchesGrid();
+
+    const unsigned chars = MAX7456_BUFFER_CHARS_PAL;
+    const unsigned bytes = max7456GetStats()->bytes - bytesBefore;
+    // Previous driver: 10 chars per update, 6 bytes per char
+    const unsigned charBudgetUpdates = (chars + 9) / 10;
+
+    EXPECT_LE(chip.maxTransferBytes, 10u * 14u);
+    EXPECT_LT(updates, charBudgetUpdates);
+    EXPECT_LT(bytes, chars * 6);
+}
+
+TEST_F(Max7456Test, TestRandomUpdates)
+{
+    srand(7456);
+    for (int iter = 0; iter < 500; iter++) {
+        const int changes = rand() % 20;
+        for (int ii = 0; ii < changes; ii++) {
+            const uint8_t x = rand() % MAX7456_CHARS_PER_LINE;
+            const uint8_t y = rand() % MAX7456_LINES_PAL;
+            const uint16_t c = rand() % 8 == 0 ? 0x100 + rand() % 256 : rand() % 256;
+            const uint8_t mode = rand() % 4 == 0 ? MAX7456_MODE_BLINK : 0;
+            max7456WriteChar(x, y, c, mode);
+        }
+        if (rand() % 3 == 0) {
+            max7456Write(rand() % 20, rand() % MAX7456_LINES_PAL, "RANDOM", 0);
+        }
+        max7456Update();
+    }
+    drawAll();
+    expectChipMatchesGrid();
+}
+
+// STUBS
+
+extern "C" {
+
+uint16_t osdCharacterGridBuffer[OSD_CHARACTER_GRID_BUFFER_SIZE] ALIGNED(4);
+
+static busDevice_t fakeBusDevice;
+static timeMs_t simulatedTimeMs;
+
+timeMs_t millis(void)
+{
+    // Advance on every call, the driver busy-waits on it during init
+    return simulatedTimeMs++;
+}
+
+busDevice_t * busDeviceInit(busType_e bus, devHardwareType_e hw, uint8_t tag, resourceOwner_e owner)
+{
+    UNUSED(bus);
+    UNUSED(hw);
+    UNUSED(tag);
+    UNUSED(owner);
+    return &fakeBusDevice;
+}
+
+void busSetSpeed(const busDevice_t * dev, busSpeed_e speed)
+{
+    UNUSED(dev);
+    UNUSED(speed);
+}
+
+bool busTransfer(const busDevice_t * dev, uint8_t * rxBuf, const uint8_t * txBuf, int length)
+{
+    UNUSED(dev);
+    UNUSED(rxBuf);
+    chip.transfers++;
+    chip.bytes += length;
+    if ((unsigned)length > chip.maxTransferBytes) {
+        chip.maxTransferBytes = length;
+    }
+    for (int ii = 0; ii < length; ii++) {
+        chipReceive(txBuf[ii]);
+    }
+    return true;
+}
+
+bool busWrite(const busDevice_t * busdev, uint8_t reg, uint8_t data)
+{
+    const uint8_t buf[] = { reg, data };
+    return busTransfer(busdev, NULL, buf, sizeof(buf));
+}
+
+bool busRead(const busDevice_t * busdev, uint8_t reg, uint8_t * data)
+{
+    UNUSED(busdev);
+    switch (reg) {
+        case REG_VM0 | REG_READ:
+            *data = chip.vm0;
+            break;
+        case REG_DMM | REG_READ:
+            *data = chip.dmm;
+            break;
+        case REG_STAT:
+            // PAL signal present
+            *data = 0x01;
+            break;
+        default:
+            *data = 0;
+            break;
+    }
+    return true;
+}
+
+void ledToggle(int led)
+{
+    UNUSED(led);
+}
+
+}
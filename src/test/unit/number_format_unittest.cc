@@ -0,0 +1,159 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <chrono>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/number_format.h"
+    #include "common/printf.h"
+
+    #include "drivers/serial.h"
+}
+
+#include "gtest/gtest.h"
+
+static const int32_t testValues[] = {
+    0, 1, -1, 7, -7, 9, 10, -10, 99, 100, -100, 999, -999, 1000, 12345, -12345,
+    65535, 99999, 100000, -100000, 1234567, INT32_MAX, INT32_MIN,
+};
+
+TEST(NumberFormatTest, TestSignedMatchesPrintf)
+{
+    char expected[32];
+    char actual[32];
+    char format[8];
+
+    for (int32_t value : testValues) {
+        for (int width = 0; width <= 6; width++) {
+            // tfp_sprintf() zero pads in front of the sign, checked separately below
+            for (int zeroPad = 0; zeroPad <= (value >= 0 ? 1 : 0); zeroPad++) {
+                snprintf(format, sizeof(format), zeroPad ? "%%0%dd" : "%%%dd", width);
+                tfp_sprintf(expected, format, (int)value);
+                char *end = formatSigned(actual, value, width, zeroPad);
+                EXPECT_STREQ(expected, actual) << "format " << format;
+                EXPECT_EQ(actual + strlen(actual), end);
+            }
+        }
+    }
+}
+
+TEST(NumberFormatTest, TestSignedZeroPadding)
+{
+    char actual[32];
+
+    formatSigned(actual, -1, 4, true);
+    EXPECT_STREQ("-001", actual);
+    formatSigned(actual, -1234, 4, true);
+    EXPECT_STREQ("-1234", actual);
+}
+
+TEST(NumberFormatTest, TestUnsigned)
+{
+    char actual[32];
+
+    formatUnsigned(actual, 0, 0, false);
+    EXPECT_STREQ("0", actual);
+    formatUnsigned(actual, 42, 5, false);
+    EXPECT_STREQ("   42", actual);
+    formatUnsigned(actual, 42, 5, true);
+    EXPECT_STREQ("00042", actual);
+    formatUnsigned(actual, UINT32_MAX, 3, false);
+    EXPECT_STREQ("4294967295", actual);
+}
+
+TEST(NumberFormatTest, TestFixedPoint)
+{
+    char actual[32];
+
+    formatFixedPoint(actual, 1234, 2, 0);
+    EXPECT_STREQ("12.34", actual);
+    formatFixedPoint(actual, -1234, 2, 0);
+    EXPECT_STREQ("-12.34", actual);
+    formatFixedPoint(actual, 5, 2, 0);
+    EXPECT_STREQ("0.05", actual);
+    formatFixedPoint(actual, -5, 2, 0);
+    EXPECT_STREQ("-0.05", actual);
+    formatFixedPoint(actual, 1005, 3, 7);
+    EXPECT_STREQ("  1.005", actual);
+    formatFixedPoint(actual, -42, 0, 4);
+    EXPECT_STREQ(" -42", actual);
+    formatFixedPoint(actual, INT32_MIN, 9, 0);
+    EXPECT_STREQ("-2.147483648", actual);
+}
+
+TEST(NumberFormatTest, TestChaining)
+{
+    char actual[32];
+
+    // Same as tfp_sprintf("%c%3d%c", 'M', 42, 'K')
+    formatChar(formatSigned(formatChar(actual, 'M'), 42, 3, false), 'K');
+    EXPECT_STREQ("M 42K", actual);
+
+    // Same as tfp_sprintf("%02d:%02d", 5, 7)
+    formatUnsigned(formatChar(formatUnsigned(actual, 5, 2, true), ':'), 7, 2, true);
+    EXPECT_STREQ("05:07", actual);
+}
+
+TEST(NumberFormatTest, TestSpeedAgainstPrintf)
+{
+    const int iterations = 1000000;
+    volatile char sink = 0;
+    char buff[32];
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        tfp_sprintf(buff, "%3d%c", i & 1023, 'K');
+        sink = sink + buff[0];
+    }
+    const double printfNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        formatChar(formatSigned(buff, i & 1023, 3, false), 'K');
+        sink = sink + buff[0];
+    }
+    const double formatNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        tfp_sprintf(buff, "%d.%02d%c", (i & 1023) / 100, (i & 1023) % 100, 'K');
+        sink = sink + buff[0];
+    }
+    const double printfFixedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        formatChar(formatFixedPoint(buff, i & 1023, 2, 0), 'K');
+        sink = sink + buff[0];
+    }
+    const double formatFixedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    // Informational only, not asserted
+    printf("\"%%3d%%c\":     tfp_sprintf %.1f ns, formatSigned %.1f ns\n", printfNs, formatNs);
+    printf("\"%%d.%%02d%%c\": tfp_sprintf %.1f ns, formatFixedPoint %.1f ns\n", printfFixedNs, formatFixedNs);
+}
+
+// STUBS
+
+extern "C" {
+    void serialWrite(serialPort_t *, uint8_t) {}
+    bool isSerialTransmitBufferEmpty(const serialPort_t *) { return true; }
+}
@@ -0,0 +1,727 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Host harness for the OSD renderer: io/osd.c and friends draw into an in-memory
+ * displayport while the flight state is faked below. The resulting character grid
+ * is compared against golden snapshots, and the draw time per element and per full
+ * refresh is reported.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "build/debug.h"
+
+    #include "common/time.h"
+
+    #include "config/feature.h"
+
+    #include "drivers/display.h"
+    #include "drivers/display_font_metadata.h"
+    #include "drivers/osd_symbols.h"
+    #include "drivers/serial.h"
+    #include "drivers/time.h"
+    #include "drivers/vtx_common.h"
+
+    #include "fc/config.h"
+    #include "fc/controlrate_profile.h"
+    #include "fc/fc_core.h"
+    #include "fc/rc_adjustments.h"
+    #include "fc/rc_controls.h"
+    #include "fc/rc_modes.h"
+    #include "fc/runtime_config.h"
+    #include "fc/settings.h"
+
+    #include "flight/failsafe.h"
+    #include "flight/imu.h"
+    #include "flight/mixer.h"
+    #include "flight/pid.h"
+    #include "flight/servos.h"
+
+    #include "io/gps.h"
+    #include "io/osd.h"
+    #include "io/osd/custom_elements.h"
+
+    #include "navigation/navigation.h"
+    #define _Static_assert static_assert
+    #include "navigation/navigation_private.h"
+
+    #include "programming/global_variables.h"
+    #include "programming/logic_condition.h"
+
+    #include "rx/rx.h"
+
+    #include "sensors/acceleration.h"
+    #include "sensors/battery.h"
+    #include "sensors/boardalignment.h"
+    #include "sensors/diagnostics.h"
+    #include "sensors/pitotmeter.h"
+    #include "sensors/sensors.h"
+    #include "sensors/temperature.h"
+
+    extern const osdConfig_t pgResetTemplate_osdConfig;
+    extern const osdRefreshConfig_t pgResetTemplate_osdRefreshConfig;
+    void pgResetFn_osdLayoutsConfig(osdLayoutsConfig_t *osdLayoutsConfig);
+    void osdDrawNextElement(void);
+}
+
+#include "gtest/gtest.h"
+
+#define TEST_OSD_ROWS   16
+#define TEST_OSD_COLS   30
+
+static timeUs_t simulatedTimeUs;
+
+/*
+ * In-memory displayport. Only the character grid is kept, attributes are dropped
+ * since they do not change what ends up on screen with an analog OSD chip.
+ */
+static uint16_t screen[TEST_OSD_ROWS][TEST_OSD_COLS];
+static uint32_t screenWrites;
+
+static int screenClear(displayPort_t *displayPort)
+{
+    UNUSED(displayPort);
+    // Like the OSD chips, a cleared screen reads back as blanks
+    for (int row = 0; row < TEST_OSD_ROWS; row++) {
+        for (int col = 0; col < TEST_OSD_COLS; col++) {
+            screen[row][col] = SYM_BLANK;
+        }
+    }
+    return 0;
+}
+
+static int screenWriteChar(displayPort_t *displayPort, uint8_t x, uint8_t y, uint16_t c, textAttributes_t attr)
+{
+    UNUSED(attr);
+    if (x < displayPort->cols && y < displayPort->rows) {
+        screen[y][x] = c;
+        screenWrites++;
+    }
+    return 0;
+}
+
+static int screenWriteString(displayPort_t *displayPort, uint8_t x, uint8_t y, const char *text, textAttributes_t attr)
+{
+    for (; *text; text++, x++) {
+        screenWriteChar(displayPort, x, y, (uint8_t)*text, attr);
+    }
+    return 0;
+}
+
+static bool screenReadChar(displayPort_t *displayPort, uint8_t x, uint8_t y, uint16_t *c, textAttributes_t *attr)
+{
+    if (x >= displayPort->cols || y >= displayPort->rows) {
+        return false;
+    }
+    *c = screen[y][x];
+    *attr = 0;
+    return true;
+}
+
+static int screenNoop(displayPort_t *displayPort)
+{
+    UNUSED(displayPort);
+    return 0;
+}
+
+static void screenResync(displayPort_t *displayPort)
+{
+    UNUSED(displayPort);
+}
+
+static int screenSize(const displayPort_t *displayPort)
+{
+    return displayPort->rows * displayPort->cols;
+}
+
+static bool screenIsTransferInProgress(const displayPort_t *displayPort)
+{
+    UNUSED(displayPort);
+    return false;
+}
+
+static uint32_t screenTxBytesFree(const displayPort_t *displayPort)
+{
+    UNUSED(displayPort);
+    return UINT32_MAX;
+}
+
+static bool screenGetFontMetadata(displayFontMetadata_t *metadata, const displayPort_t *displayPort)
+{
+    UNUSED(displayPort);
+    metadata->version = 3;
+    metadata->charCount = 512;
+    return true;
+}
+
+static bool screenIsReady(displayPort_t *displayPort)
+{
+    UNUSED(displayPort);
+    return true;
+}
+
+static const displayPortVTable_t screenVTable = {
+    .grab = screenNoop,
+    .release = screenNoop,
+    .clearScreen = screenClear,
+    .drawScreen = screenNoop,
+    .screenSize = screenSize,
+    .writeString = screenWriteString,
+    .writeChar = screenWriteChar,
+    .readChar = screenReadChar,
+    .isTransferInProgress = screenIsTransferInProgress,
+    .heartbeat = screenNoop,
+    .resync = screenResync,
+    .txBytesFree = screenTxBytesFree,
+    .supportedTextAttributes = NULL,
+    .getFontMetadata = screenGetFontMetadata,
+    .writeFontCharacter = NULL,
+    .isReady = screenIsReady,
+    .beginTransaction = NULL,
+    .commitTransaction = NULL,
+    .getCanvas = NULL,
+};
+
+static displayPort_t screenDisplayPort;
+
+// Printable ASCII as is, every other glyph as '*' so snapshots stay readable
+static std::string screenRow(int row)
+{
+    std::string text;
+    for (int col = 0; col < TEST_OSD_COLS; col++) {
+        const uint16_t c = screen[row][col];
+        text += (c >= 0x20 && c < 0x7f) ? (char)c : '*';
+    }
+    return text;
+}
+
+// FNV-1a over the raw grid, catches glyph changes the text view above hides
+static uint32_t screenChecksum(void)
+{
+    uint32_t hash = 2166136261U;
+    for (int row = 0; row < TEST_OSD_ROWS; row++) {
+        for (int col = 0; col < TEST_OSD_COLS; col++) {
+            hash = (hash ^ (screen[row][col] & 0xFF)) * 16777619U;
+            hash = (hash ^ (screen[row][col] >> 8)) * 16777619U;
+        }
+    }
+    return hash;
+}
+
+static void expectScreen(const char * const golden[TEST_OSD_ROWS], uint32_t goldenChecksum)
+{
+    bool match = true;
+    for (int row = 0; row < TEST_OSD_ROWS; row++) {
+        EXPECT_EQ(std::string(golden[row]), screenRow(row)) << "row " << row;
+        match = match && std::string(golden[row]) == screenRow(row);
+    }
+    EXPECT_EQ(goldenChecksum, screenChecksum());
+
+    if (!match || goldenChecksum != screenChecksum()) {
+        // Ready to paste as the new golden snapshot
+        printf("    static const char * const golden[TEST_OSD_ROWS] = {\n");
+        for (int row = 0; row < TEST_OSD_ROWS; row++) {
+            printf("        \"%s\",\n", screenRow(row).c_str());
+        }
+        printf("    };\n    0x%08X\n", (unsigned)screenChecksum());
+    }
+}
+
+/*
+ * Synthetic flight state
+ */
+static uint16_t simulatedVoltage;
+static int16_t simulatedAmperage;
+static int32_t simulatedMAhDrawn;
+static uint32_t simulatedFeatures;
+static controlRateConfig_t simulatedRateProfile;
+static batteryProfile_t simulatedBatteryProfile;
+static pidBank_t simulatedPidBank;
+static navigationPIDControllers_t simulatedNavPids;
+static int32_t simulatedGlobalVariables[MAX_GLOBAL_VARIABLES];
+static navigationFSMStateFlags_t simulatedNavStateFlags;
+static uint8_t simulatedLaunchState;
+static const char *simulatedLaunchMessage;
+
+static void simulateFlightState(void)
+{
+    attitude.values.roll = 150;     // decidegrees
+    attitude.values.pitch = -80;
+    attitude.values.yaw = 2710;
+
+    gpsSol.fixType = GPS_FIX_3D;
+    gpsSol.numSat = 14;
+    gpsSol.llh.lat = 473977420;
+    gpsSol.llh.lon = 85455940;
+    gpsSol.llh.alt = 52000;
+    gpsSol.groundSpeed = 1520;      // cm/s
+    gpsSol.groundCourse = 2710;
+    gpsSol.hdop = 120;
+    gpsSol.flags.validVelNE = true;
+    gpsSol.flags.validVelD = true;
+    gpsSol.flags.validEPE = true;
+
+    GPS_distanceToHome = 842;
+    GPS_directionToHome = 135;
+
+    posControl.actualState.abs.pos.z = 4567;    // cm, below osd_alt_alarm so it does not blink
+    posControl.actualState.abs.vel.z = 250;
+    posControl.actualState.agl.pos.z = 4567;
+
+    simulatedVoltage = 1623;
+    simulatedAmperage = 1234;
+    simulatedMAhDrawn = 456;
+    simulatedBatteryProfile.capacity.value = 1500;
+    simulatedFeatures = FEATURE_VBAT | FEATURE_GPS | FEATURE_CURRENT_METER;
+
+    sensorsSet(SENSOR_ACC | SENSOR_GPS | SENSOR_BARO);
+    ENABLE_STATE(GPS_FIX);
+    ENABLE_STATE(GPS_FIX_HOME);
+    ENABLE_FLIGHT_MODE(ANGLE_MODE);
+}
+
+// Steps the scheduler task with the given period until durationMs elapsed
+static void runOsd(timeMs_t durationMs)
+{
+    const timeUs_t endUs = simulatedTimeUs + durationMs * 1000;
+    while (cmpTimeUs(endUs, simulatedTimeUs) > 0) {
+        simulatedTimeUs += 10 * 1000;
+        osdUpdate(simulatedTimeUs);
+    }
+}
+
+static void setVisibleItems(const osd_items_e *items, int count, const uint16_t *positions)
+{
+    osdLayoutsConfig_t *layouts = osdLayoutsConfigMutable();
+    for (int item = 0; item < OSD_ITEM_COUNT; item++) {
+        layouts->item_pos[0][item] &= ~OSD_VISIBLE_FLAG;
+    }
+    for (int i = 0; i < count; i++) {
+        layouts->item_pos[0][items[i]] = (positions ? positions[i] : layouts->item_pos[0][items[i]]) | OSD_VISIBLE_FLAG;
+    }
+}
+
+class OsdRenderTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        memcpy(osdConfigMutable(), &pgResetTemplate_osdConfig, sizeof(osdConfig_t));
+        memcpy(osdRefreshConfigMutable(), &pgResetTemplate_osdRefreshConfig, sizeof(osdRefreshConfig_t));
+        pgResetFn_osdLayoutsConfig(osdLayoutsConfigMutable());
+        osdConfigMutable()->video_system = VIDEO_SYSTEM_AUTO;
+
+        simulatedTimeUs = 1000 * 1000;
+        simulateFlightState();
+
+        displayInit(&screenDisplayPort, &screenVTable);
+        screenDisplayPort.rows = TEST_OSD_ROWS;
+        screenDisplayPort.cols = TEST_OSD_COLS;
+
+        osdInit(&screenDisplayPort);
+        // Let the splash screen time out
+        runOsd(5000);
+    }
+};
+
+TEST_F(OsdRenderTest, TestDefaultLayoutSnapshot)
+{
+    runOsd(1000);
+
+    static const char * const golden[TEST_OSD_ROWS] = {
+        "   45v      d1***      *87    ",
+        "                              ",
+        " *DARM                        ",
+        "  1**j                        ",
+        "  456*                        ",
+        "                              ",
+        "                              ",
+        "                              ",
+        "                              ",
+        "                              ",
+        "                              ",
+        "**14                   *00:07 ",
+        "             ANGL             ",
+        "                              ",
+        "                              ",
+        "                              ",
+    };
+    expectScreen(golden, 0x741CAA44);
+}
+
+TEST_F(OsdRenderTest, TestNavigationLayoutSnapshot)
+{
+    static const osd_items_e items[] = {
+        OSD_ALTITUDE, OSD_VARIO_NUM, OSD_GPS_SPEED, OSD_HEADING, OSD_HOME_DIR, OSD_HOME_DIST,
+        OSD_GPS_SATS, OSD_GPS_HDOP, OSD_MAIN_BATT_VOLTAGE, OSD_CURRENT_DRAW, OSD_MAH_DRAWN,
+        OSD_CROSSHAIRS, OSD_ARTIFICIAL_HORIZON, OSD_HORIZON_SIDEBARS, OSD_FLYMODE,
+    };
+    static const uint16_t positions[] = {
+        OSD_POS(1, 1), OSD_POS(1, 2), OSD_POS(1, 13), OSD_POS(13, 1), OSD_POS(14, 2), OSD_POS(22, 1),
+        OSD_POS(1, 12), OSD_POS(8, 12), OSD_POS(22, 12), OSD_POS(22, 13), OSD_POS(22, 14),
+        0, 0, 0, OSD_POS(13, 14),
+    };
+    setVisibleItems(items, ARRAYLEN(items), positions);
+    osdStartFullRedraw();
+    runOsd(1000);
+
+    static const char * const golden[TEST_OSD_ROWS] = {
+        "                              ",
+        "   45v       *271*    *842z   ",
+        "  ***         *               ",
+        "                              ",
+        "                              ",
+        "        *             *       ",
+        "        *             *       ",
+        "        *             *       ",
+        "        **    ***    **       ",
+        "        *        **** *       ",
+        "        *   *****     *       ",
+        "        * **          *       ",
+        " **14   ****          d1***   ",
+        "  54*                 1**j    ",
+        "             ANGL      456*   ",
+        "                              ",
+    };
+    expectScreen(golden, 0xB9F995C0);
+
+    // Moving the aircraft must only change what depends on it
+    attitude.values.roll = -200;
+    GPS_distanceToHome = 960;
+    runOsd(1000);
+
+    static const char * const goldenMoved[TEST_OSD_ROWS] = {
+        "                              ",
+        "   45v       *271*    *960z   ",
+        "  ***         *               ",
+        "                              ",
+        "                              ",
+        "        *             *       ",
+        "        *             *       ",
+        "        *             *       ",
+        "        ***   ***    **       ",
+        "        *  ***        *       ",
+        "        *     ****    *       ",
+        "        *         *** *       ",
+        " **14   ****          d1***   ",
+        "  54*                 1**j    ",
+        "             ANGL      456*   ",
+        "                              ",
+    };
+    expectScreen(goldenMoved, 0xE45E624B);
+}
+
+TEST_F(OsdRenderTest, TestCustomElementsAndMessages)
+{
+    static const osd_items_e items[] = { OSD_CUSTOM_ELEMENT_1, OSD_MESSAGES };
+    static const uint16_t positions[] = { OSD_POS(1, 1), OSD_POS(1, 3) };
+    setVisibleItems(items, ARRAYLEN(items), positions);
+
+    osdCustomElement_t *element = osdCustomElementsMutable(0);
+    memset(element, 0, sizeof(*element));
+    element->part[0] = { CUSTOM_ELEMENT_TYPE_TEXT, 0 };
+    element->part[1] = { CUSTOM_ELEMENT_TYPE_GV_FLOAT, 0 };
+    element->part[2] = { CUSTOM_ELEMENT_TYPE_ICON_GV, 1 };
+    element->visibility = { CUSTOM_ELEMENT_VISIBILITY_GV, 2 };
+    strcpy(element->osdCustomElementText, "alt");
+    simulatedGlobalVariables[0] = 1234;
+    simulatedGlobalVariables[1] = 'X';
+    simulatedGlobalVariables[2] = 1;
+    customElementsCompile();
+    ENABLE_ARMING_FLAG(ARMING_DISABLED_THROTTLE);
+
+    osdStartFullRedraw();
+    runOsd(1000);
+    EXPECT_EQ(" ALT  1**4X                   ", screenRow(1));
+    EXPECT_EQ("     THROTTLE IS NOT LOW      ", screenRow(3));
+
+    // Values are evaluated on every draw, the layout only when compiled
+    simulatedGlobalVariables[0] = -50;
+    runOsd(1000);
+    EXPECT_EQ(" ALT  -**0X                   ", screenRow(1));
+
+    // Cached system messages follow the state that produced them
+    DISABLE_ARMING_FLAG(ARMING_DISABLED_THROTTLE);
+    simulatedGlobalVariables[2] = 0;
+    runOsd(100);
+    EXPECT_EQ("                              ", screenRow(1));
+    EXPECT_EQ("                              ", screenRow(3));
+
+    memset(simulatedGlobalVariables, 0, sizeof(simulatedGlobalVariables));
+    memset(element, 0, sizeof(*element));
+    customElementsCompile();
+}
+
+TEST_F(OsdRenderTest, TestLaunchStateMessage)
+{
+    char buff[64];
+
+    ENABLE_ARMING_FLAG(ARMED);
+    ENABLE_STATE(FIXED_WING_LEGACY);
+    simulatedNavStateFlags = NAV_CTL_LAUNCH;
+    simulatedLaunchState = FW_LAUNCH_DETECTED;
+    simulatedLaunchMessage = "READY TO LAUNCH";
+
+    // The launch state alternates with AUTOLAUNCH every osd_system_msg_display_time,
+    // start halfway through its turn. Arming rebuilds the cached messages.
+    simulatedTimeUs = ((millis() / 2000 + 1) * 2000 + 1500) * 1000;
+    osdGetSystemMessage(buff, sizeof(buff), false);
+    ASSERT_NE(nullptr, strstr(buff, "READY TO LAUNCH"));
+
+    // A new launch state is shown right away, not when the cached messages expire
+    simulatedLaunchState = FW_LAUNCH_FLYING;
+    simulatedLaunchMessage = "FINISHING";
+    simulatedTimeUs += 10 * 1000;
+    osdGetSystemMessage(buff, sizeof(buff), false);
+    EXPECT_NE(nullptr, strstr(buff, "FINISHING"));
+
+    DISABLE_ARMING_FLAG(ARMED);
+    DISABLE_STATE(FIXED_WING_LEGACY);
+    simulatedNavStateFlags = (navigationFSMStateFlags_t)0;
+    simulatedLaunchMessage = NULL;
+}
+
+#define RENDER_COST_BATCHES     5
+#define RENDER_COST_ITERATIONS  400
+
+/*
+ * Best of a few batches of osdDrawNextElement() calls, in us per call, and the characters written
+ * per call. With redraw set, the screen is cleared before every call, which drops all element
+ * fingerprints, so everything visible is drawn from scratch. The clear itself isn't timed.
+ * Otherwise only what changed since the previous call gets written.
+ */
+static double measureRefreshUs(bool redraw, timeMs_t stepMs, uint32_t *writes)
+{
+    double bestUs = 0;
+
+    screenWrites = 0;
+    for (int batch = 0; batch < RENDER_COST_BATCHES; batch++) {
+        std::chrono::steady_clock::duration elapsed(0);
+        for (int i = 0; i < RENDER_COST_ITERATIONS; i++) {
+            if (redraw) {
+                displayClearScreen(&screenDisplayPort);
+            }
+            simulatedTimeUs += stepMs * 1000;
+            const auto start = std::chrono::steady_clock::now();
+            osdDrawNextElement();
+            elapsed += std::chrono::steady_clock::now() - start;
+        }
+        const double us = std::chrono::duration<double, std::micro>(elapsed).count() / RENDER_COST_ITERATIONS;
+        bestUs = batch == 0 ? us : MIN(bestUs, us);
+    }
+    *writes = screenWrites / (RENDER_COST_BATCHES * RENDER_COST_ITERATIONS);
+
+    return bestUs;
+}
+
+TEST_F(OsdRenderTest, TestRenderCost)
+{
+    uint32_t writes;
+
+    // Refresh budget is measured against the frozen clock, let a single call draw everything
+    osdRefreshConfigMutable()->time_budget = UINT16_MAX;
+
+    // Timings are informational only, not asserted. Cost of walking the element list, subtracted
+    // from the per element figures.
+    setVisibleItems(NULL, 0, NULL);
+    const double baselineUs = measureRefreshUs(true, 1000, &writes);
+    printf("empty layout: %.3f us\n", baselineUs);
+
+    for (int item = 0; item < OSD_ITEM_COUNT; item++) {
+        const osd_items_e element = (osd_items_e)item;
+        const uint16_t pos = OSD_POS(1, 1);
+        setVisibleItems(&element, 1, &pos);
+
+        const double elementUs = measureRefreshUs(true, 1000, &writes);
+        if (writes) {
+            printf("element %3d: %7.3f us, %7.3f us above empty layout, %3u chars\n", item, elementUs, MAX(elementUs - baselineUs, 0.0), (unsigned)writes);
+        }
+    }
+
+    pgResetFn_osdLayoutsConfig(osdLayoutsConfigMutable());
+    uint32_t fullWrites;
+    const double fullUs = measureRefreshUs(true, 1000, &fullWrites);
+    printf("default layout, full refresh: %.3f us, %u chars\n", fullUs, (unsigned)fullWrites);
+
+    // Steady state at the scheduler rate, only the timers change. Elements writing to the display
+    // on their own are not covered by the fingerprints and still show up here.
+    uint32_t idleWrites;
+    const double idleUs = measureRefreshUs(false, 200, &idleWrites);
+    printf("default layout, unchanged refresh: %.3f us, %u chars\n", idleUs, (unsigned)idleWrites);
+
+    EXPECT_GT(fullWrites, 0u);
+    EXPECT_LT(idleWrites, fullWrites);
+}
+
+// STUBS
+
+extern "C" {
+
+int32_t debug[DEBUG32_VALUE_COUNT];
+
+attitudeEulerAngles_t attitude;
+fpVector3_t imuMeasuredAccelBF;
+gpsSolutionData_t gpsSol;
+gpsLocation_t GPS_home;
+uint32_t GPS_distanceToHome;
+int16_t GPS_directionToHome;
+navSystemStatus_t NAV_Status;
+navigationPosControl_t posControl;
+radar_pois_t radar_pois[RADAR_MAX_POIS];
+rxLinkStatistics_t rxLinkStatistics;
+int16_t servo[MAX_SUPPORTED_SERVOS];
+uint8_t requestedSensors[SENSOR_INDEX_COUNT];
+
+uint32_t armingFlags;
+uint32_t flightModeFlags;
+uint32_t stateFlags;
+static uint32_t enabledSensors;
+
+const controlRateConfig_t *currentControlRateProfile = &simulatedRateProfile;
+const batteryProfile_t *currentBatteryProfile = &simulatedBatteryProfile;
+
+boardAlignment_t boardAlignment_System;
+navConfig_t navConfig_System;
+rxConfig_t rxConfig_System;
+systemConfig_t systemConfig_System;
+servoParam_t servoParams_SystemArray[MAX_SUPPORTED_SERVOS];
+
+bool cmsInMenu;
+bool cmsDisplayPortRegister(displayPort_t *pDisplay) { UNUSED(pDisplay); return true; }
+
+timeUs_t micros(void) { return simulatedTimeUs; }
+timeMs_t millis(void) { return simulatedTimeUs / 1000; }
+bool rtcGetDateTimeLocal(dateTime_t *dt) { UNUSED(dt); return false; }
+
+bool feature(uint32_t mask) { return simulatedFeatures & mask; }
+bool sensors(uint32_t mask) { return enabledSensors & mask; }
+void sensorsSet(uint32_t mask) { enabledSensors |= mask; }
+armingFlag_e isArmingDisabledReason(void)
+{
+    const uint32_t reasons = armingFlags & ARMING_DISABLED_ALL_FLAGS;
+    return (armingFlag_e)(reasons & -reasons);
+}
+uint8_t getConfigProfile(void) { return 0; }
+disarmReason_t getDisarmReason(void) { return DISARM_NONE; }
+float getFlightTime(void) { return 125.0f; }
+void resetFlightTime(void) {}
+
+bool IS_RC_MODE_ACTIVE(boxId_e boxId) { UNUSED(boxId); return false; }
+bool checkStickPosition(stickPositions_e stickPos) { UNUSED(stickPos); return false; }
+bool isAdjustmentFunctionSelected(uint8_t adjustmentFunction) { UNUSED(adjustmentFunction); return false; }
+int16_t rxGetChannelValue(unsigned channelNumber) { UNUSED(channelNumber); return 1500; }
+uint16_t getRSSI(void) { return 900; }
+bool failsafeIsReceivingRxData(void) { return true; }
+failsafePhase_e failsafePhase(void) { return FAILSAFE_IDLE; }
+
+uint16_t getBatteryVoltage(void) { return simulatedVoltage; }
+uint16_t getBatteryRawVoltage(void) { return simulatedVoltage; }
+uint16_t getBatterySagCompensatedVoltage(void) { return simulatedVoltage; }
+uint16_t getBatteryRawAverageCellVoltage(void) { return simulatedVoltage / 4; }
+uint16_t getBatterySagCompensatedAverageCellVoltage(void) { return simulatedVoltage / 4; }
+uint8_t getBatteryCellCount(void) { return 4; }
+batteryState_e getBatteryState(void) { return BATTERY_OK; }
+batteryState_e checkBatteryVoltageState(void) { return BATTERY_OK; }
+bool batteryWasFullWhenPluggedIn(void) { return true; }
+bool batteryUsesCapacityThresholds(void) { return false; }
+uint32_t getBatteryRemainingCapacity(void) { return 1044; }
+uint8_t calculateBatteryPercentage(void) { return 70; }
+int16_t getAmperage(void) { return simulatedAmperage; }
+int32_t getPower(void) { return simulatedAmperage * simulatedVoltage / 100; }
+int32_t getMAhDrawn(void) { return simulatedMAhDrawn; }
+int32_t getMWhDrawn(void) { return simulatedMAhDrawn * 15; }
+bool isPowerSupplyImpedanceValid(void) { return false; }
+uint16_t getPowerSupplyImpedance(void) { return 0; }
+
+const acc_extremes_t* accGetMeasuredExtremes(void) { static acc_extremes_t extremes[XYZ_AXIS_COUNT]; return extremes; }
+float accGetMeasuredMaxG(void) { return 1.0f; }
+void resetGForceStats(void) {}
+float getAirspeedEstimate(void) { return 0.0f; }
+bool pitotIsHealthy(void) { return false; }
+bool getIMUTemperature(int16_t *temperature) { *temperature = 420; return true; }
+bool getBaroTemperature(int16_t *temperature) { *temperature = 310; return true; }
+bool isImuHeadingValid(void) { return true; }
+
+hardwareSensorStatus_e getHwGyroStatus(void) { return HW_SENSOR_OK; }
+hardwareSensorStatus_e getHwAccelerometerStatus(void) { return HW_SENSOR_OK; }
+hardwareSensorStatus_e getHwCompassStatus(void) { return HW_SENSOR_NONE; }
+hardwareSensorStatus_e getHwBarometerStatus(void) { return HW_SENSOR_OK; }
+hardwareSensorStatus_e getHwGPSStatus(void) { return HW_SENSOR_OK; }
+hardwareSensorStatus_e getHwRangefinderStatus(void) { return HW_SENSOR_NONE; }
+hardwareSensorStatus_e getHwPitotmeterStatus(void) { return HW_SENSOR_NONE; }
+
+int16_t getThrottlePercent(bool useScaled) { UNUSED(useScaled); return 42; }
+bool ifMotorstopFeatureEnabled(void) { return false; }
+const pidBank_t * pidBank(void) { return &simulatedPidBank; }
+pidType_e pidIndexGetType(pidIndex_e pidIndex) { UNUSED(pidIndex); return PID_TYPE_PID; }
+float getFixedWingLevelTrim(void) { return 0.0f; }
+bool isFixedWingLevelTrimActive(void) { return false; }
+bool isAngleHoldLevel(void) { return false; }
+
+float getEstimatedActualVelocity(int axis) { return posControl.actualState.abs.vel.v[axis]; }
+float getEstimatedActualPosition(int axis) { return posControl.actualState.abs.pos.v[axis]; }
+uint32_t getTotalTravelDistance(void) { return 1250; }
+const navigationPIDControllers_t* getNavigationPIDControllers(void) { return &simulatedNavPids; }
+navigationFSMStateFlags_t navGetCurrentStateFlags(void) { return simulatedNavStateFlags; }
+bool navigationRequiresAngleMode(void) { return false; }
+bool navigationPositionEstimateIsHealthy(void) { return true; }
+navArmingBlocker_e navigationIsBlockingArming(bool *usedBypass) { UNUSED(usedBypass); return NAV_ARMING_BLOCKER_NONE; }
+bool navigationIsControllingThrottle(void) { return false; }
+bool navigationIsExecutingAnEmergencyLanding(void) { return false; }
+int32_t navigationGetHomeHeading(void) { return 0; }
+int32_t navigationGetHeadingError(void) { return 0; }
+float navigationGetCrossTrackError(void) { return 0.0f; }
+int8_t navCheckActiveAngleHoldAxis(void) { return -1; }
+int32_t getCruiseHeadingAdjustment(void) { return 0; }
+bool isAdjustingPosition(void) { return false; }
+bool isAdjustingHeading(void) { return false; }
+bool isFixedWingAutoThrottleManuallyIncreased(void) { return false; }
+bool isWaypointListValid(void) { return false; }
+bool isWaypointMissionRTHActive(void) { return false; }
+bool isWaypointNavTrackingActive(void) { return false; }
+uint32_t distanceToFirstWP(void) { return 0; }
+uint8_t fixedWingLaunchStatus(void) { return simulatedLaunchState; }
+const char * fixedWingLaunchStateMessage(void) { return simulatedLaunchMessage; }
+uint32_t calculateDistanceToDestination(const fpVector3_t * destinationPos) { UNUSED(destinationPos); return 0; }
+int32_t calculateBearingToDestination(const fpVector3_t * destinationPos) { UNUSED(destinationPos); return 0; }
+geoAltitudeConversionMode_e waypointMissionAltConvMode(geoAltitudeDatumFlag_e datumFlag) { UNUSED(datumFlag); return GEO_ALT_RELATIVE; }
+bool geoConvertGeodeticToLocal(fpVector3_t *pos, const gpsOrigin_t *origin, const gpsLocation_t *llh, geoAltitudeConversionMode_e altConv)
+{
+    UNUSED(pos);
+    UNUSED(origin);
+    UNUSED(llh);
+    UNUSED(altConv);
+    return false;
+}
+
+int32_t gvGet(uint8_t index) { return simulatedGlobalVariables[index]; }
+int logicConditionGetValue(int8_t conditionId) { UNUSED(conditionId); return 0; }
+
+const setting_t *settingGet(unsigned index) { UNUSED(index); return NULL; }
+void settingGetName(const setting_t *val, char *buf) { UNUSED(val); buf[0] = '\0'; }
+bool settingsValidate(unsigned *invalidIndex) { UNUSED(invalidIndex); return true; }
+
+void serialWrite(serialPort_t *instance, uint8_t ch) { UNUSED(instance); UNUSED(ch); }
+bool isSerialTransmitBufferEmpty(const serialPort_t *instance) { UNUSED(instance); return true; }
+
+}
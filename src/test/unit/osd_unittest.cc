@@ -3,9 +3,27 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 extern "C" {
+#include "platform.h"
+
+#include "common/streambuf.h"
+
+#include "drivers/display.h"
+#include "drivers/osd_symbols.h"
+
+#include "fc/rc_modes.h"
+#include "fc/runtime_config.h"
+
+#include "io/displayport_msp.h"
+#include "io/displayport_msp_osd.h"
 #include "io/osd.h"
+#include "io/serial.h"
+
+#include "msp/msp_protocol.h"
+#include "msp/msp_protocol_v2_inav.h"
+#include "msp/msp_serial.h"
 };
 
 
@@ -14,6 +32,9 @@ TEST(OSDTest, TestCentiNumber)
    //bool osdFormatCentiNumber(char *buff, int32_t centivalue, uint32_t scale, int maxDecimals, int maxScaledDecimals, int length);
    char buf[11] = "0123456789";
 
+   // Plain decimal point instead of the half width font symbols
+   osdConfigMutable()->video_system = VIDEO_SYSTEM_DJICOMPAT;
+
    osdFormatCentiNumber(buf, 12345, 1, 2, 3, 7, false);
    std::cout << "'" << buf << "'" << std::endl;
    EXPECT_FALSE(strcmp(buf, " 123.45"));
@@ -68,4 +89,351 @@ TEST(OSDTest, TestCentiNumber)
 
    EXPECT_EQ(1, 1);
 
-}
\ No newline at end of file
+}
+
+#define TEST_MSP_MAX_PAYLOAD    480
+#define TEST_ROWS               16
+#define TEST_COLS               30
+
+typedef struct {
+    uint16_t cmd;
+    mspVersion_e version;
+    std::vector<uint8_t> payload;
+} mspFrame_t;
+
+static std::vector<mspFrame_t> sentFrames;
+static uint16_t requestCmd;
+static std::vector<uint8_t> requestPayload;
+static timeMs_t simulatedTimeMs;
+
+class MspOsdTest : public ::testing::Test
+{
+protected:
+    displayPort_t *displayPort;
+    uint8_t expected[TEST_ROWS][TEST_COLS];
+    uint8_t device[TEST_ROWS][TEST_COLS];
+
+    void SetUp() override
+    {
+        osdConfigMutable()->video_system = VIDEO_SYSTEM_PAL;
+        osdConfigMutable()->msp_displayport_fullframe_interval = -1;
+        displayPort = mspOsdDisplayPortInit(VIDEO_SYSTEM_PAL);
+        ASSERT_NE(nullptr, displayPort);
+        memset(expected, SYM_BLANK, sizeof(expected));
+        memset(device, SYM_BLANK, sizeof(device));
+    }
+
+    // Device asks for the given extensions, the display is resent in the new format on the next draw
+    void negotiate(uint8_t options)
+    {
+        requestCmd = MSP2_INAV_DISPLAYPORT_OPTIONS;
+        requestPayload = { options };
+        mspOsdSerialProcess(processCommand);
+        draw();
+        sentFrames.clear();
+    }
+
+    // drawScreen() only sends every DRAW_FREQ_DENOM-th call
+    void draw(void)
+    {
+        for (int ii = 0; ii < 4; ii++) {
+            displayPort->vTable->drawScreen(displayPort);
+        }
+    }
+
+    void write(uint8_t col, uint8_t row, const char *text)
+    {
+        displayPort->vTable->writeString(displayPort, col, row, text, TEXT_ATTRIBUTES_NONE);
+        memcpy(&expected[row][col], text, strlen(text));
+    }
+
+    // Applies the captured frames the way a device would
+    void receive(void)
+    {
+        for (const mspFrame_t &frame : sentFrames) {
+            const std::vector<uint8_t> &p = frame.payload;
+            ASSERT_EQ(MSP_DISPLAYPORT, frame.cmd);
+            ASSERT_LE(p.size(), (size_t)TEST_MSP_MAX_PAYLOAD);
+
+            switch (p[0]) {
+            case MSP_DP_CLEAR_SCREEN:
+                memset(device, SYM_BLANK, sizeof(device));
+                break;
+            case MSP_DP_WRITE_STRING:
+                memcpy(&device[p[1]][p[2]], &p[4], p.size() - 4);
+                break;
+            case MSP_DP_WRITE_BATCH:
+                for (size_t pos = 2; pos < p.size();) {
+                    const uint8_t row = p[pos], col = p[pos + 1], count = p[pos + 3] & ~DISPLAYPORT_MSP_BATCH_RLE;
+                    ASSERT_LE(col + count, TEST_COLS);
+                    if (p[pos + 3] & DISPLAYPORT_MSP_BATCH_RLE) {
+                        memset(&device[row][col], p[pos + 4], count);
+                        pos += 5;
+                    } else {
+                        memcpy(&device[row][col], &p[pos + 4], count);
+                        pos += 4 + count;
+                    }
+                    ASSERT_LE(pos, p.size());
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        sentFrames.clear();
+    }
+
+    void expectDeviceMatchesScreen(void)
+    {
+        receive();
+        for (int row = 0; row < TEST_ROWS; row++) {
+            EXPECT_EQ(std::string((char *)expected[row], TEST_COLS), std::string((char *)device[row], TEST_COLS)) << "row " << row;
+        }
+    }
+
+    static mspResult_e processCommand(mspPacket_t *cmd, mspPacket_t *reply, mspPostProcessFnPtr *mspPostProcessFn)
+    {
+        UNUSED(cmd);
+        UNUSED(reply);
+        UNUSED(mspPostProcessFn);
+        return MSP_RESULT_NO_REPLY;
+    }
+};
+
+TEST_F(MspOsdTest, TestBatchedRunLengthRecord)
+{
+    negotiate(DISPLAYPORT_MSP_OPTION_BATCH);
+    EXPECT_EQ(DISPLAYPORT_MSP_OPTION_BATCH, mspOsdGetOptions());
+
+    write(3, 2, "AAAAAAAAAAAAAAAAAAAA");
+    draw();
+
+    ASSERT_EQ(1u, sentFrames.size());
+    EXPECT_EQ(MSP_V2_NATIVE, sentFrames[0].version);
+    const std::vector<uint8_t> frame = { MSP_DP_WRITE_BATCH, DISPLAYPORT_MSP_BATCH_FLAG_DRAW, 2, 3, 0, DISPLAYPORT_MSP_BATCH_RLE | 20, 'A' };
+    EXPECT_EQ(frame, sentFrames[0].payload);
+}
+
+TEST_F(MspOsdTest, TestBatchedLiteralAndRepeats)
+{
+    negotiate(DISPLAYPORT_MSP_OPTION_BATCH);
+
+    // Six repeats are worth a record of their own, five are not
+    write(0, 1, "ABCAAAAAADEEEEEF");
+    draw();
+
+    ASSERT_EQ(1u, sentFrames.size());
+    const std::vector<uint8_t> frame = {
+        MSP_DP_WRITE_BATCH, DISPLAYPORT_MSP_BATCH_FLAG_DRAW,
+        1, 0, 0, 3, 'A', 'B', 'C',
+        1, 3, 0, DISPLAYPORT_MSP_BATCH_RLE | 6, 'A',
+        1, 9, 0, 7, 'D', 'E', 'E', 'E', 'E', 'E', 'F',
+    };
+    EXPECT_EQ(frame, sentFrames[0].payload);
+    expectDeviceMatchesScreen();
+}
+
+TEST_F(MspOsdTest, TestBatchedGapBridging)
+{
+    negotiate(DISPLAYPORT_MSP_OPTION_BATCH);
+
+    // Resending three clean characters is cheaper than a second record header
+    write(0, 4, "AB");
+    write(5, 4, "CD");
+    draw();
+
+    ASSERT_EQ(1u, sentFrames.size());
+    const std::vector<uint8_t> bridged = {
+        MSP_DP_WRITE_BATCH, DISPLAYPORT_MSP_BATCH_FLAG_DRAW,
+        4, 0, 0, 7, 'A', 'B', SYM_BLANK, SYM_BLANK, SYM_BLANK, 'C', 'D',
+    };
+    EXPECT_EQ(bridged, sentFrames[0].payload);
+    expectDeviceMatchesScreen();
+
+    // Four are not
+    write(10, 5, "AB");
+    write(16, 5, "CD");
+    draw();
+
+    ASSERT_EQ(1u, sentFrames.size());
+    const std::vector<uint8_t> split = {
+        MSP_DP_WRITE_BATCH, DISPLAYPORT_MSP_BATCH_FLAG_DRAW,
+        5, 10, 0, 2, 'A', 'B',
+        5, 16, 0, 2, 'C', 'D',
+    };
+    EXPECT_EQ(split, sentFrames[0].payload);
+    expectDeviceMatchesScreen();
+}
+
+TEST_F(MspOsdTest, TestBatchedFrameSplit)
+{
+    negotiate(DISPLAYPORT_MSP_OPTION_BATCH);
+
+    // A full screen without repeats does not fit a single frame
+    char line[TEST_COLS + 1];
+    for (int row = 0; row < TEST_ROWS; row++) {
+        for (int col = 0; col < TEST_COLS; col++) {
+            line[col] = 'A' + (row + col) % 26;
+        }
+        line[TEST_COLS] = '\0';
+        write(0, row, line);
+    }
+    draw();
+
+    ASSERT_EQ(2u, sentFrames.size());
+    // Records are never split, the first frame holds as many full rows as fit
+    EXPECT_EQ(2u + 14 * (4 + TEST_COLS), sentFrames[0].payload.size());
+    EXPECT_EQ(0, sentFrames[0].payload[1]);
+    EXPECT_EQ(DISPLAYPORT_MSP_BATCH_FLAG_DRAW, sentFrames[1].payload[1]);
+    expectDeviceMatchesScreen();
+}
+
+TEST_F(MspOsdTest, TestBatchedRandomUpdates)
+{
+    negotiate(DISPLAYPORT_MSP_OPTION_BATCH);
+
+    srand(0x0d5d);
+    for (int frame = 0; frame < 200; frame++) {
+        const int changes = rand() % 20;
+        for (int ii = 0; ii < changes; ii++) {
+            char text[TEST_COLS + 1];
+            const int col = rand() % TEST_COLS;
+            const int len = 1 + rand() % (TEST_COLS - col);
+            const char c = rand() % 2 ? SYM_BLANK : 'A' + rand() % 4;
+            for (int jj = 0; jj < len; jj++) {
+                text[jj] = rand() % 4 ? c : 'a' + rand() % 26;
+            }
+            text[len] = '\0';
+            write(col, rand() % TEST_ROWS, text);
+        }
+        draw();
+        expectDeviceMatchesScreen();
+    }
+}
+
+TEST_F(MspOsdTest, TestFallbackWithoutOptions)
+{
+    negotiate(0);
+    EXPECT_EQ(0, mspOsdGetOptions());
+
+    write(1, 1, "AB");
+    write(10, 1, "CD");
+    draw();
+
+    ASSERT_EQ(3u, sentFrames.size());
+    const std::vector<uint8_t> first = { MSP_DP_WRITE_STRING, 1, 1, 0, 'A', 'B' };
+    const std::vector<uint8_t> second = { MSP_DP_WRITE_STRING, 1, 10, 0, 'C', 'D' };
+    const std::vector<uint8_t> drawScreen = { MSP_DP_DRAW_SCREEN };
+    EXPECT_EQ(first, sentFrames[0].payload);
+    EXPECT_EQ(second, sentFrames[1].payload);
+    EXPECT_EQ(drawScreen, sentFrames[2].payload);
+    for (const mspFrame_t &frame : sentFrames) {
+        EXPECT_EQ(MSP_V1, frame.version);
+    }
+    expectDeviceMatchesScreen();
+}
+
+// STUBS
+
+extern "C" {
+
+bool cmsInMenu = false;
+uint8_t cliMode = 0;
+uint32_t armingFlags = 0;
+const uint32_t baudRates[BAUD_MAX + 1] = { 0 };
+
+osdConfig_t osdConfig_System;
+osdLayoutsConfig_t osdLayoutsConfig_System;
+
+timeMs_t millis(void)
+{
+    return simulatedTimeMs;
+}
+
+bool IS_RC_MODE_ACTIVE(boxId_e boxId)
+{
+    UNUSED(boxId);
+    return false;
+}
+
+int osdGetActiveLayout(bool *overridden)
+{
+    UNUSED(overridden);
+    return 0;
+}
+
+uint8_t osdIncElementIndex(uint8_t elementIndex)
+{
+    return (elementIndex + 1) % OSD_ITEM_COUNT;
+}
+
+bool osdItemIsFixed(osd_items_e item)
+{
+    UNUSED(item);
+    return false;
+}
+
+void displayInit(displayPort_t *instance, const displayPortVTable_t *vTable)
+{
+    instance->vTable = vTable;
+}
+
+void displayClearScreen(displayPort_t *instance)
+{
+    instance->vTable->clearScreen(instance);
+}
+
+serialPortConfig_t *findSerialPortConfig(serialPortFunction_e function)
+{
+    UNUSED(function);
+    static serialPortConfig_t config;
+    return &config;
+}
+
+serialPort_t *openSerialPort(serialPortIdentifier_e identifier, serialPortFunction_e function, serialReceiveCallbackPtr rxCallback,
+    void *rxCallbackData, uint32_t baudrate, portMode_t mode, portOptions_t options)
+{
+    UNUSED(identifier);
+    UNUSED(function);
+    UNUSED(rxCallback);
+    UNUSED(rxCallbackData);
+    UNUSED(baudrate);
+    UNUSED(mode);
+    UNUSED(options);
+    static serialPort_t port;
+    return &port;
+}
+
+void resetMspPort(mspPort_t *mspPortToReset, serialPort_t *serialPort)
+{
+    memset(mspPortToReset, 0, sizeof(*mspPortToReset));
+    mspPortToReset->port = serialPort;
+}
+
+void mspSerialProcessOnePort(mspPort_t * const mspPort, mspEvaluateNonMspData_e evaluateNonMspData, mspProcessCommandFnPtr mspProcessCommandFn)
+{
+    UNUSED(mspPort);
+    UNUSED(evaluateNonMspData);
+
+    uint8_t replyBuffer[16];
+    mspPacket_t cmd = { .buf = { .ptr = requestPayload.data(), .end = requestPayload.data() + requestPayload.size() }, .cmd = (int16_t)requestCmd, .flags = 0, .result = 0 };
+    mspPacket_t reply = { .buf = { .ptr = replyBuffer, .end = replyBuffer + sizeof(replyBuffer) }, .cmd = -1, .flags = 0, .result = 0 };
+    mspPostProcessFnPtr mspPostProcessFn = NULL;
+
+    mspProcessCommandFn(&cmd, &reply, &mspPostProcessFn);
+}
+
+int mspSerialPushPort(uint16_t cmd, const uint8_t *data, int datalen, mspPort_t *mspPort, mspVersion_e version)
+{
+    UNUSED(mspPort);
+    sentFrames.push_back({ cmd, version, std::vector<uint8_t>(data, data + datalen) });
+    return datalen;
+}
+
+uint32_t mspSerialTxBytesFree(serialPort_t *port)
+{
+    UNUSED(port);
+    return UINT32_MAX;
+}
+
+}
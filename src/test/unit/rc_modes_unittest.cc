@@ -0,0 +1,185 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/bitarray.h"
+    #include "common/maths.h"
+    #include "common/utils.h"
+
+    #include "fc/rc_controls.h"
+    #include "fc/rc_modes.h"
+    #include "fc/runtime_config.h"
+
+    #include "rx/rx.h"
+
+    int16_t rcData[MAX_SUPPORTED_RC_CHANNEL_COUNT];
+    int16_t rcCommand[4];
+    uint32_t stateFlags;
+    uint32_t armingFlags;
+    rcControlsConfig_t rcControlsConfig_System;
+
+    extern boxBitmask_t rcModeActivationMask;
+
+    int16_t rxGetChannelValue(unsigned channelNumber)
+    {
+        return rcData[channelNumber];
+    }
+
+    bool feature(uint32_t mask)
+    {
+        UNUSED(mask);
+        return false;
+    }
+}
+
+#include "gtest/gtest.h"
+
+static void resetModeActivationConditions(void)
+{
+    for (int i = 0; i < MAX_MODE_ACTIVATION_CONDITION_COUNT; i++) {
+        memset(modeActivationConditionsMutable(i), 0, sizeof(modeActivationCondition_t));
+    }
+}
+
+static void setModeActivationCondition(int index, boxId_e modeId, uint8_t auxChannelIndex, uint16_t start, uint16_t end)
+{
+    modeActivationConditionsMutable(index)->modeId = modeId;
+    modeActivationConditionsMutable(index)->auxChannelIndex = auxChannelIndex;
+    modeActivationConditionsMutable(index)->range.startStep = CHANNEL_VALUE_TO_STEP(start);
+    modeActivationConditionsMutable(index)->range.endStep = CHANNEL_VALUE_TO_STEP(end);
+}
+
+static void setAuxChannel(uint8_t auxChannelIndex, int16_t value)
+{
+    rcData[auxChannelIndex + NON_AUX_CHANNEL_COUNT] = value;
+}
+
+// Runs the incremental evaluation, then the full scan, and checks both produce the same mask
+static void expectIncrementalMatchesFullScan(void)
+{
+    updateActivatedModesOnChange(false);
+    const boxBitmask_t incremental = rcModeActivationMask;
+
+    updateActivatedModes();
+    EXPECT_EQ(0, memcmp(&incremental, &rcModeActivationMask, sizeof(boxBitmask_t)));
+}
+
+TEST(RcModesTest, TestIncrementalSwitchPositions)
+{
+    resetModeActivationConditions();
+    modeActivationOperatorConfigMutable()->modeActivationOperator = MODE_OPERATOR_OR;
+
+    // 3 position switch on AUX1, overlapping ranges on AUX2
+    setModeActivationCondition(0, BOXARM, 0, 1700, 2100);
+    setModeActivationCondition(1, BOXANGLE, 1, 900, 1300);
+    setModeActivationCondition(2, BOXHORIZON, 1, 1300, 1700);
+    setModeActivationCondition(3, BOXNAVRTH, 1, 1700, 2100);
+    setModeActivationCondition(4, BOXBEEPERON, 1, 1500, 2100);
+    updateUsedModeActivationConditionFlags();
+
+    setAuxChannel(0, 1000);
+    setAuxChannel(1, 1000);
+    expectIncrementalMatchesFullScan();
+    EXPECT_FALSE(IS_RC_MODE_ACTIVE(BOXARM));
+    EXPECT_TRUE(IS_RC_MODE_ACTIVE(BOXANGLE));
+
+    setAuxChannel(1, 1500);
+    expectIncrementalMatchesFullScan();
+    EXPECT_FALSE(IS_RC_MODE_ACTIVE(BOXANGLE));
+    EXPECT_TRUE(IS_RC_MODE_ACTIVE(BOXHORIZON));
+    EXPECT_TRUE(IS_RC_MODE_ACTIVE(BOXBEEPERON));
+
+    setAuxChannel(0, 2000);
+    setAuxChannel(1, 2000);
+    expectIncrementalMatchesFullScan();
+    EXPECT_TRUE(IS_RC_MODE_ACTIVE(BOXARM));
+    EXPECT_TRUE(IS_RC_MODE_ACTIVE(BOXNAVRTH));
+    EXPECT_FALSE(IS_RC_MODE_ACTIVE(BOXHORIZON));
+
+    // Range ends are exclusive, values outside CHANNEL_RANGE_MIN..MAX match nothing
+    setAuxChannel(1, 2100);
+    expectIncrementalMatchesFullScan();
+    EXPECT_FALSE(IS_RC_MODE_ACTIVE(BOXNAVRTH));
+
+    setAuxChannel(1, 850);
+    expectIncrementalMatchesFullScan();
+    EXPECT_FALSE(IS_RC_MODE_ACTIVE(BOXANGLE));
+
+    // Moving within a step does not need a re-evaluation
+    setAuxChannel(1, 1000);
+    expectIncrementalMatchesFullScan();
+    setAuxChannel(1, 1010);
+    EXPECT_FALSE(updateActivatedModesOnChange(false));
+}
+
+TEST(RcModesTest, TestIncrementalAndOperator)
+{
+    resetModeActivationConditions();
+    modeActivationOperatorConfigMutable()->modeActivationOperator = MODE_OPERATOR_OR;
+
+    setModeActivationCondition(0, BOXNAVPOSHOLD, 0, 1300, 2100);
+    setModeActivationCondition(1, BOXNAVPOSHOLD, 2, 1700, 2100);
+    updateUsedModeActivationConditionFlags();
+
+    setAuxChannel(0, 1500);
+    setAuxChannel(2, 1000);
+    expectIncrementalMatchesFullScan();
+    EXPECT_TRUE(IS_RC_MODE_ACTIVE(BOXNAVPOSHOLD));
+
+    // Operator change alone must be picked up
+    modeActivationOperatorConfigMutable()->modeActivationOperator = MODE_OPERATOR_AND;
+    expectIncrementalMatchesFullScan();
+    EXPECT_FALSE(IS_RC_MODE_ACTIVE(BOXNAVPOSHOLD));
+
+    setAuxChannel(2, 1800);
+    expectIncrementalMatchesFullScan();
+    EXPECT_TRUE(IS_RC_MODE_ACTIVE(BOXNAVPOSHOLD));
+}
+
+TEST(RcModesTest, TestIncrementalMatchesFullScanRandomized)
+{
+    srand(0x1234);
+
+    for (int config = 0; config < 50; config++) {
+        resetModeActivationConditions();
+        modeActivationOperatorConfigMutable()->modeActivationOperator = (config & 1) ? MODE_OPERATOR_AND : MODE_OPERATOR_OR;
+
+        const int conditionCount = 1 + rand() % MAX_MODE_ACTIVATION_CONDITION_COUNT;
+        for (int i = 0; i < conditionCount; i++) {
+            modeActivationConditionsMutable(i)->modeId = (boxId_e)(rand() % CHECKBOX_ITEM_COUNT);
+            modeActivationConditionsMutable(i)->auxChannelIndex = rand() % 8;
+            // Includes empty and inverted ranges which must be ignored
+            modeActivationConditionsMutable(i)->range.startStep = rand() % (MAX_MODE_RANGE_STEP + 1);
+            modeActivationConditionsMutable(i)->range.endStep = rand() % (MAX_MODE_RANGE_STEP + 1);
+        }
+        updateUsedModeActivationConditionFlags();
+
+        for (int frame = 0; frame < 200; frame++) {
+            // Move a few switches per frame, including values outside of the usable range
+            for (int moves = rand() % 3; moves >= 0; moves--) {
+                setAuxChannel(rand() % 8, 800 + rand() % 1500);
+            }
+            expectIncrementalMatchesFullScan();
+        }
+    }
+}
@@ -0,0 +1,260 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <vector>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "drivers/barometer/barometer.h"
+    #include "drivers/time.h"
+
+    #include "fc/runtime_config.h"
+
+    #include "sensors/barometer.h"
+    #include "sensors/sensors.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define UT_DELAY    5000
+#define UP_DELAY    10000
+
+typedef std::vector<uint32_t> delays_t;
+
+// Fake sensor with a separate temperature conversion. The temperature
+// moves by fakeTemperatureStep on each read.
+static int32_t fakeTemperature;
+static int32_t fakeTemperatureStep;
+static int32_t fakePressure;
+static int temperatureReads;
+static int pressureReads;
+
+static bool fakeStart(baroDev_t *dev)
+{
+    UNUSED(dev);
+    return true;
+}
+
+static bool fakeGetUt(baroDev_t *dev)
+{
+    UNUSED(dev);
+    fakeTemperature += fakeTemperatureStep;
+    temperatureReads++;
+    return true;
+}
+
+static bool fakeGetUp(baroDev_t *dev)
+{
+    UNUSED(dev);
+    pressureReads++;
+    return true;
+}
+
+static bool fakeCalculate(baroDev_t *dev, int32_t *pressure, int32_t *temperature)
+{
+    UNUSED(dev);
+    *pressure = fakePressure;
+    *temperature = fakeTemperature;
+    return true;
+}
+
+static delays_t runCycles(int cycles);
+
+// baroUpdate() keeps its state across tests, so each test starts by
+// running it up to the next temperature conversion and through one
+// complete cycle with a constant temperature
+static void setupFakeBaro(uint16_t utDelay)
+{
+    baro.dev.ut_delay = utDelay;
+    baro.dev.up_delay = UP_DELAY;
+    baro.dev.start_ut = fakeStart;
+    baro.dev.get_ut = fakeGetUt;
+    baro.dev.start_up = fakeStart;
+    baro.dev.get_up = fakeGetUp;
+    baro.dev.calculate = fakeCalculate;
+
+    fakeTemperature = 2500;
+    fakeTemperatureStep = 0;
+    fakePressure = 101325;
+
+    int calls = 0;
+    while (baroUpdate() != utDelay) {
+        ASSERT_LT(++calls, 20);
+    }
+    runCycles(1);
+
+    temperatureReads = 0;
+    pressureReads = 0;
+}
+
+// Delays returned by baroUpdate() until it has started the given number
+// of temperature conversions
+static delays_t runCycles(int cycles)
+{
+    delays_t delays;
+
+    while (cycles > 0 && delays.size() < 100) {
+        delays.push_back(baroUpdate());
+        if (delays.back() == baro.dev.ut_delay) {
+            cycles--;
+        }
+    }
+
+    return delays;
+}
+
+static delays_t repeat(const delays_t &cycle, int count)
+{
+    delays_t delays;
+
+    for (int ii = 0; ii < count; ii++) {
+        delays.insert(delays.end(), cycle.begin(), cycle.end());
+    }
+
+    return delays;
+}
+
+TEST(SensorBaroTest, StableTemperatureIsSkipped)
+{
+    setupFakeBaro(UT_DELAY);
+
+    // Four skipped temperature conversions, then a forced one
+    const delays_t cycle = { UP_DELAY, UP_DELAY, UP_DELAY, UP_DELAY, UP_DELAY, UT_DELAY };
+    EXPECT_EQ(repeat(cycle, 3), runCycles(3));
+    EXPECT_EQ(3, temperatureReads);
+    EXPECT_EQ(15, pressureReads);
+}
+
+TEST(SensorBaroTest, StableTemperatureThreshold)
+{
+    const delays_t skipping = { UP_DELAY, UP_DELAY, UP_DELAY, UP_DELAY, UP_DELAY, UT_DELAY };
+    const delays_t notSkipping = { UP_DELAY, UT_DELAY };
+
+    setupFakeBaro(UT_DELAY);
+    fakeTemperatureStep = 9;
+    runCycles(1);
+    EXPECT_EQ(repeat(skipping, 3), runCycles(3));
+
+    fakeTemperatureStep = 10;
+    runCycles(1);
+    EXPECT_EQ(repeat(notSkipping, 3), runCycles(3));
+
+    fakeTemperatureStep = -10;
+    runCycles(1);
+    EXPECT_EQ(repeat(notSkipping, 3), runCycles(3));
+}
+
+TEST(SensorBaroTest, TemperatureChangeEndsSkipping)
+{
+    setupFakeBaro(UT_DELAY);
+    EXPECT_EQ(6U, runCycles(1).size());
+
+    // The jump is seen by the forced read. The pressure conversion
+    // started with it still skips, the next one doesn't.
+    fakeTemperature += 50;
+    EXPECT_EQ(delays_t({ UP_DELAY, UP_DELAY, UT_DELAY }), runCycles(1));
+    EXPECT_EQ(delays_t({ UP_DELAY, UT_DELAY }), runCycles(1));
+    EXPECT_EQ(6U, runCycles(1).size());
+}
+
+TEST(SensorBaroTest, NoSeparateTemperatureConversion)
+{
+    setupFakeBaro(0);
+
+    EXPECT_EQ(repeat({ UP_DELAY, 0 }, 3), runCycles(3));
+    EXPECT_EQ(3, pressureReads);
+}
+
+TEST(SensorBaroTest, MedianFilter)
+{
+    setupFakeBaro(0);
+
+    // Fill the history
+    for (int ii = 0; ii < 3; ii++) {
+        runCycles(1);
+    }
+    EXPECT_EQ(101325, baro.baroPressure);
+
+    // A single sample glitch is rejected
+    fakePressure = 90000;
+    runCycles(1);
+    EXPECT_EQ(101325, baro.baroPressure);
+    fakePressure = 101325;
+    runCycles(2);
+    EXPECT_EQ(101325, baro.baroPressure);
+
+    // A step is delayed by one sample
+    fakePressure = 101000;
+    runCycles(1);
+    EXPECT_EQ(101325, baro.baroPressure);
+    runCycles(1);
+    EXPECT_EQ(101000, baro.baroPressure);
+
+    // The median of three different samples
+    fakePressure = 100900;
+    runCycles(1);
+    EXPECT_EQ(101000, baro.baroPressure);
+    fakePressure = 100950;
+    runCycles(1);
+    EXPECT_EQ(100950, baro.baroPressure);
+
+    // Published samples are the filtered ones
+    sensorSample_t sample;
+    ASSERT_TRUE(sensorSampleRingGetLatest(&baro.samples, &sample));
+    EXPECT_EQ(100950, sample.value[BARO_SAMPLE_PRESSURE]);
+    EXPECT_EQ(2500, sample.value[BARO_SAMPLE_TEMPERATURE]);
+}
+
+// STUBS
+
+extern "C" {
+
+uint8_t requestedSensors[SENSOR_INDEX_COUNT];
+uint8_t detectedSensors[SENSOR_INDEX_COUNT];
+
+static timeUs_t fakeTimeUs;
+
+timeUs_t micros(void)
+{
+    return fakeTimeUs += 1000;
+}
+
+timeMs_t millis(void)
+{
+    return fakeTimeUs / 1000;
+}
+
+bool sensors(uint32_t mask)
+{
+    UNUSED(mask);
+    return true;
+}
+
+void sensorsSet(uint32_t mask)
+{
+    UNUSED(mask);
+}
+
+void sensorsClear(uint32_t mask)
+{
+    UNUSED(mask);
+}
+
+}
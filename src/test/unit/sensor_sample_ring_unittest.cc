@@ -0,0 +1,99 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "sensors/sample_ring.h"
+}
+
+#include "gtest/gtest.h"
+
+static sensorSample_t samples[4];
+static sensorSampleRing_t ring;
+
+static void pushValue(timeUs_t timeUs, float value)
+{
+    sensorSampleRingPush(&ring, timeUs, &value, 1);
+}
+
+TEST(SensorSampleRingTest, Empty)
+{
+    sensorSample_t sample;
+    uint32_t seen = 0;
+
+    sensorSampleRingInit(&ring, samples, ARRAYLEN(samples));
+
+    EXPECT_FALSE(sensorSampleRingGetLatest(&ring, &sample));
+    EXPECT_FALSE(sensorSampleRingGetAt(&ring, 1000, &sample));
+    EXPECT_FALSE(sensorSampleRingGetInterpolated(&ring, 1000, &sample));
+    EXPECT_FALSE(sensorSampleRingHasNewSample(&ring, &seen));
+}
+
+TEST(SensorSampleRingTest, LatestAndNewSample)
+{
+    sensorSample_t sample;
+    uint32_t seen = 0;
+
+    sensorSampleRingInit(&ring, samples, ARRAYLEN(samples));
+
+    pushValue(1000, 1.0f);
+    EXPECT_TRUE(sensorSampleRingHasNewSample(&ring, &seen));
+    EXPECT_FALSE(sensorSampleRingHasNewSample(&ring, &seen));
+
+    pushValue(2000, 2.0f);
+    pushValue(3000, 3.0f);
+    EXPECT_TRUE(sensorSampleRingHasNewSample(&ring, &seen));
+
+    EXPECT_TRUE(sensorSampleRingGetLatest(&ring, &sample));
+    EXPECT_EQ(3000u, sample.timeUs);
+    EXPECT_FLOAT_EQ(3.0f, sample.value[0]);
+    EXPECT_FLOAT_EQ(0.0f, sample.value[1]);
+}
+
+TEST(SensorSampleRingTest, QueryByTime)
+{
+    sensorSample_t sample;
+
+    sensorSampleRingInit(&ring, samples, ARRAYLEN(samples));
+
+    // Six samples through a four deep ring, only the last three are readable
+    for (int i = 1; i <= 6; i++) {
+        pushValue(i * 1000, i * 10.0f);
+    }
+
+    EXPECT_FALSE(sensorSampleRingGetAt(&ring, 3500, &sample));
+    EXPECT_FALSE(sensorSampleRingGetInterpolated(&ring, 3500, &sample));
+
+    EXPECT_TRUE(sensorSampleRingGetAt(&ring, 4000, &sample));
+    EXPECT_EQ(4000u, sample.timeUs);
+
+    EXPECT_TRUE(sensorSampleRingGetAt(&ring, 4999, &sample));
+    EXPECT_EQ(4000u, sample.timeUs);
+    EXPECT_FLOAT_EQ(40.0f, sample.value[0]);
+
+    EXPECT_TRUE(sensorSampleRingGetInterpolated(&ring, 4250, &sample));
+    EXPECT_EQ(4250u, sample.timeUs);
+    EXPECT_FLOAT_EQ(42.5f, sample.value[0]);
+
+    // Newer than the newest sample holds the latest value
+    EXPECT_TRUE(sensorSampleRingGetInterpolated(&ring, 9000, &sample));
+    EXPECT_EQ(6000u, sample.timeUs);
+    EXPECT_FLOAT_EQ(60.0f, sample.value[0]);
+}
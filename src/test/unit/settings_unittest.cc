@@ -0,0 +1,96 @@
+/*
+ * This file is part of INAV.
+ *
+ * INAV is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * INAV is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with INAV.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/utils.h"
+
+    #include "config/parameter_group.h"
+
+    #include "fc/settings.h"
+}
+
+#include "gtest/gtest.h"
+
+TEST(SettingsTest, TestFindEverySetting)
+{
+    char name[SETTING_MAX_NAME_LENGTH];
+
+    for (unsigned ii = 0; ii < SETTINGS_TABLE_COUNT; ii++) {
+        const setting_t *val = settingGet(ii);
+        settingGetName(val, name);
+        EXPECT_EQ(val, settingFind(name)) << name;
+    }
+}
+
+TEST(SettingsTest, TestUnknownNames)
+{
+    char name[SETTING_MAX_NAME_LENGTH + 1];
+
+    EXPECT_EQ(NULL, settingFind(""));
+    EXPECT_EQ(NULL, settingFind("not_a_setting"));
+    // Names are stored in lower case
+    EXPECT_EQ(NULL, settingFind("LOOPTIME"));
+    EXPECT_NE((const setting_t *)NULL, settingFind("looptime"));
+
+    // Prefixes and extensions of existing names
+    for (unsigned ii = 0; ii < SETTINGS_TABLE_COUNT; ii++) {
+        settingGetName(settingGet(ii), name);
+        const size_t len = strlen(name);
+        name[len] = 'x';
+        name[len + 1] = '\0';
+        EXPECT_EQ(NULL, settingFind(name)) << name;
+        name[len - 1] = '\0';
+        const setting_t *prefix = settingFind(name);
+        if (prefix) {
+            char found[SETTING_MAX_NAME_LENGTH];
+            settingGetName(prefix, found);
+            EXPECT_STREQ(name, found);
+        }
+    }
+}
+
+// STUBS
+
+extern "C" {
+
+const pgRegistry_t *pgFind(pgn_t pgn)
+{
+    UNUSED(pgn);
+    return NULL;
+}
+
+uint8_t getConfigProfile(void)
+{
+    return 0;
+}
+
+uint8_t getConfigBatteryProfile(void)
+{
+    return 0;
+}
+
+uint8_t getConfigMixerProfile(void)
+{
+    return 0;
+}
+
+}
@@ -52,3 +52,10 @@
 #define TARGET_IO_PORTB         0xffff
 #define TARGET_IO_PORTC         0xffff
 
+#if defined(CONFIG_IN_RAM)
+// As in common_post.h, which unit tests don't include
+#define EEPROM_SIZE     8192
+extern uint8_t eepromData[EEPROM_SIZE];
+#define __config_start (*eepromData)
+#define __config_end (*ARRAYEND(eepromData))
+#endif
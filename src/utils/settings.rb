@@ -38,6 +38,7 @@ DEBUG = false
 INFO = false
 
 SETTINGS_WORDS_BITS_PER_CHAR = 5
+SETTING_NAMES_WORDS_INDEX_STEP = 16
 
 def dputs(s)
     puts s if DEBUG
@@ -271,6 +272,71 @@ class ValueEncoder
     end
 end
 
+# Minimal perfect hash of the setting names (hash and displace). Names
+# are first distributed into buckets by their unseeded hash. Then, biggest
+# buckets first, a seed is chosen for each bucket so all its names land on
+# free slots. Buckets with a single name point directly to a free slot.
+# Keep name_hash() in sync with settingNameHash() in fc/settings.c.
+class NameHash
+    DIRECT_SLOT = 0x8000
+
+    attr_reader :buckets
+    attr_reader :slots
+
+    def self.name_hash(name, seed)
+        h = (2166136261 ^ ((seed * 0x9E3779B1) & 0xffffffff)) & 0xffffffff
+        name.each_byte do |c|
+            h = ((h ^ c) * 16777619) & 0xffffffff
+        end
+        return h
+    end
+
+    def initialize(names)
+        @names = names
+        count = names.length
+        raise "too many settings for the name hash: #{count}" if count >= DIRECT_SLOT
+        bucket_count = [(count + 3) / 4, 1].max
+        begin
+            build(bucket_count)
+        rescue RuntimeError
+            bucket_count += 1
+            retry if bucket_count <= count
+            raise
+        end
+    end
+
+    private
+    def build(bucket_count)
+        count = @names.length
+        members = Array.new(bucket_count) { [] }
+        @names.each_with_index do |name, ii|
+            members[NameHash.name_hash(name, 0) % bucket_count] << ii
+        end
+        @buckets = Array.new(bucket_count, 0)
+        @slots = Array.new(count)
+        order = (0...bucket_count).sort_by { |b| [-members[b].length, b] }
+        order.each do |b|
+            items = members[b]
+            case items.length
+            when 0
+                next
+            when 1
+                free = @slots.index(nil)
+                @slots[free] = items[0]
+                @buckets[b] = DIRECT_SLOT | free
+            else
+                seed = (1...DIRECT_SLOT).find do |seed|
+                    pos = items.map { |ii| NameHash.name_hash(@names[ii], seed) % count }
+                    pos.uniq.length == pos.length && pos.all? { |p| @slots[p].nil? }
+                end
+                raise "no seed found for bucket #{b}" if seed.nil?
+                items.each { |ii| @slots[NameHash.name_hash(@names[ii], seed) % count] = ii }
+                @buckets[b] = seed
+            end
+        end
+    end
+end
+
 OFF_ON_TABLE = Hash["name" => "off_on", "values" => ["OFF", "ON"]]
 
 class Generator
@@ -424,6 +490,7 @@ class Generator
 
         # Write #define'd constants for referencing each setting
         ii = 0
+        schema = StringIO.new
         foreach_enabled_member do |group, member|
             name = member["name"]
             type = member["type"]
@@ -457,8 +524,15 @@ class Generator
             buf << "#define #{setting_name}_MIN #{min}\n"
             buf << "#define #{setting_name}_MAX #{max}\n"
             ii += 1
+
+            table_values = member.has_key?("table") ? @tables[member["table"]]["values"] : []
+            schema << "#{name}:#{type}:#{value_type(group)}:#{min}:#{max}:#{table_values * ","}\n"
         end
 
+        # Identifies the order, types and ranges of the settings, so MSP
+        # clients can tell whether a settings blob matches their schema
+        buf << "#define SETTINGS_SCHEMA_HASH 0x#{NameHash.name_hash(schema.string, 0).to_s(16)}\n"
+
         File.open(file, 'w') {|file| file.write(buf.string)}
     end
 
@@ -517,7 +591,9 @@ class Generator
         symbols = Array.new
         acc = 0
         acc_bits = 0
+        encoded_chars = 0
         encode_byte = lambda do |c|
+            encoded_chars += 1
             if c == 0
                 chr = 0 # XXX: Remove this if we go for explicit lengths
             elsif c >= 'a'.ord && c <= 'z'.ord
@@ -548,7 +624,11 @@ class Generator
             end
             acc_bits = (acc_bits + word_bits) % 8
         end
-        @name_encoder.words.each do |w|
+        # Bit offset of every SETTING_NAMES_WORDS_INDEX_STEP-th word, so
+        # settingGetWord() doesn't need to walk the table from its start
+        words_index = []
+        @name_encoder.words.each_with_index do |w, ii|
+            words_index << encoded_chars * word_bits if ii % SETTING_NAMES_WORDS_INDEX_STEP == 0
             buf << "\t"
             w.each_byte {|c| encode_byte.call(c)}
             encode_byte.call(0)
@@ -562,6 +642,13 @@ class Generator
             buf << "\n"
         end
         buf << "};\n"
+        raise "words table too big for a 16 bit index" if encoded_chars * word_bits > 0xffff
+        buf << "#define SETTING_NAMES_WORDS_INDEX_STEP #{SETTING_NAMES_WORDS_INDEX_STEP}\n"
+        buf << "static const uint16_t settingNamesWordsIndex[] = {\n"
+        words_index.each_slice(16) do |s|
+            buf << "\t#{s * ", "},\n"
+        end
+        buf << "};\n"
 
         # Output symbol array
         buf << "static const char wordSymbols[] = {"
@@ -631,6 +718,25 @@ class Generator
         end
         buf << "};\n"
 
+        # Write the name hash used by settingFind()
+        names = []
+        foreach_enabled_member do |group, member|
+            names << member["name"]
+        end
+        name_hash = NameHash.new(names)
+        buf << "#define SETTING_NAME_HASH_BUCKETS #{name_hash.buckets.length}\n"
+        buf << "#define SETTING_NAME_HASH_DIRECT_SLOT 0x#{NameHash::DIRECT_SLOT.to_s(16)}\n"
+        buf << "static const uint16_t settingNameHashBuckets[] = {\n"
+        name_hash.buckets.each_slice(16) do |s|
+            buf << "\t#{s.map { |v| "0x#{v.to_s(16)}" } * ", "},\n"
+        end
+        buf << "};\n"
+        buf << "static const uint16_t settingNameHashSlots[] = {\n"
+        name_hash.slots.each_slice(16) do |s|
+            buf << "\t#{s * ", "},\n"
+        end
+        buf << "};\n"
+
         File.open(file, 'w') {|file| file.write(buf.string)}
     end
 